@@ -183,6 +183,9 @@ template<typename _MatrixType, int _UpLo> class LLT
     MatrixType m_matrix;
     bool m_isInitialized;
     ComputationInfo m_info;
+#ifndef __CUDACC__
+    typename internal::decomposition_workspace<MatrixType>::type m_workspace;
+#endif
 };
 
 namespace internal {
@@ -387,6 +390,10 @@ LLT<MatrixType,_UpLo>& LLT<MatrixType,_UpLo>::compute(const MatrixType& a)
   
   eigen_assert(a.rows()==a.cols());
   const Index size = a.rows();
+#ifndef __CUDACC__
+  // the temporaries of the blocked algorithm are kept for the next calls
+  typename internal::decomposition_workspace<MatrixType>::scope_type workspace(m_workspace);
+#endif
   m_matrix.resize(size, size);
   m_matrix = a;
 
@@ -283,7 +283,13 @@ struct dense_assignment_loop<Kernel, DefaultTraversal, NoUnrolling>
 {
   EIGEN_DEVICE_FUNC static void run(Kernel &kernel)
   {
-    for(Index outer = 0; outer < kernel.outerSize(); ++outer) {
+    run(kernel, 0, kernel.outerSize());
+  }
+
+  // assigns the outer vectors [outerStart,outerEnd)
+  EIGEN_DEVICE_FUNC static void run(Kernel &kernel, Index outerStart, Index outerEnd)
+  {
+    for(Index outer = outerStart; outer < outerEnd; ++outer) {
       for(Index inner = 0; inner < kernel.innerSize(); ++inner) {
         kernel.assignCoeffByOuterInner(outer, inner);
       }
@@ -306,11 +312,15 @@ struct dense_assignment_loop<Kernel, DefaultTraversal, InnerUnrolling>
 {
   typedef typename Kernel::StorageIndex StorageIndex;
   EIGEN_DEVICE_FUNC static EIGEN_STRONG_INLINE void run(Kernel &kernel)
+  {
+    run(kernel, 0, kernel.outerSize());
+  }
+
+  EIGEN_DEVICE_FUNC static EIGEN_STRONG_INLINE void run(Kernel &kernel, Index outerStart, Index outerEnd)
   {
     typedef typename Kernel::DstEvaluatorType::XprType DstXprType;
 
-    const Index outerSize = kernel.outerSize();
-    for(Index outer = 0; outer < outerSize; ++outer)
+    for(Index outer = outerStart; outer < outerEnd; ++outer)
       copy_using_evaluator_DefaultTraversal_InnerUnrolling<Kernel, 0, DstXprType::InnerSizeAtCompileTime>::run(kernel, outer);
   }
 };
@@ -357,7 +367,22 @@ struct unaligned_dense_assignment_loop<false>
 template<typename Kernel>
 struct dense_assignment_loop<Kernel, LinearVectorizedTraversal, NoUnrolling>
 {
+  enum { PacketSize = packet_traits<typename Kernel::Scalar>::size };
+
   EIGEN_DEVICE_FUNC static EIGEN_STRONG_INLINE void run(Kernel &kernel)
+  {
+    run(kernel, 0, kernel.size());
+  }
+
+  // index of the first coefficient assigned with an aligned packet
+  EIGEN_DEVICE_FUNC static EIGEN_STRONG_INLINE Index alignedStart(Kernel &kernel)
+  {
+    return Kernel::AssignmentTraits::DstIsAligned ? 0 : internal::first_aligned(&kernel.dstEvaluator().coeffRef(0), kernel.size());
+  }
+
+  // assigns the coefficients [start,end), where start and end are either the bounds of the whole range,
+  // or are in the aligned part at a multiple of PacketSize from alignedStart()
+  EIGEN_DEVICE_FUNC static EIGEN_STRONG_INLINE void run(Kernel &kernel, Index start, Index end)
   {
     const Index size = kernel.size();
     typedef packet_traits<typename Kernel::Scalar> PacketTraits;
@@ -367,15 +392,15 @@ struct dense_assignment_loop<Kernel, LinearVectorizedTraversal, NoUnrolling>
       dstAlignment = PacketTraits::AlignedOnScalar ? Aligned : dstIsAligned,
       srcAlignment = Kernel::AssignmentTraits::JointAlignment
     };
-    const Index alignedStart = dstIsAligned ? 0 : internal::first_aligned(&kernel.dstEvaluator().coeffRef(0), size);
-    const Index alignedEnd = alignedStart + ((size-alignedStart)/packetSize)*packetSize;
+    const Index alignedStart = (std::min)((std::max)(start, dense_assignment_loop::alignedStart(kernel)), end);
+    const Index alignedEnd = (std::max)(alignedStart, (std::min)(end, alignedStart + ((size-alignedStart)/packetSize)*packetSize));
 
-    unaligned_dense_assignment_loop<dstIsAligned!=0>::run(kernel, 0, alignedStart);
+    unaligned_dense_assignment_loop<dstIsAligned!=0>::run(kernel, start, alignedStart);
 
     for(Index index = alignedStart; index < alignedEnd; index += packetSize)
       kernel.template assignPacket<dstAlignment, srcAlignment>(index);
 
-    unaligned_dense_assignment_loop<>::run(kernel, alignedEnd, size);
+    unaligned_dense_assignment_loop<>::run(kernel, alignedEnd, end);
   }
 };
 
@@ -404,11 +429,15 @@ template<typename Kernel>
 struct dense_assignment_loop<Kernel, InnerVectorizedTraversal, NoUnrolling>
 {
   EIGEN_DEVICE_FUNC static inline void run(Kernel &kernel)
+  {
+    run(kernel, 0, kernel.outerSize());
+  }
+
+  EIGEN_DEVICE_FUNC static inline void run(Kernel &kernel, Index outerStart, Index outerEnd)
   {
     const Index innerSize = kernel.innerSize();
-    const Index outerSize = kernel.outerSize();
     const Index packetSize = packet_traits<typename Kernel::Scalar>::size;
-    for(Index outer = 0; outer < outerSize; ++outer)
+    for(Index outer = outerStart; outer < outerEnd; ++outer)
       for(Index inner = 0; inner < innerSize; inner+=packetSize)
         kernel.template assignPacketByOuterInner<Aligned, Aligned>(outer, inner);
   }
@@ -429,10 +458,14 @@ struct dense_assignment_loop<Kernel, InnerVectorizedTraversal, InnerUnrolling>
 {
   typedef typename Kernel::StorageIndex StorageIndex;
   EIGEN_DEVICE_FUNC static EIGEN_STRONG_INLINE void run(Kernel &kernel)
+  {
+    run(kernel, 0, kernel.outerSize());
+  }
+
+  EIGEN_DEVICE_FUNC static EIGEN_STRONG_INLINE void run(Kernel &kernel, Index outerStart, Index outerEnd)
   {
     typedef typename Kernel::DstEvaluatorType::XprType DstXprType;
-    const Index outerSize = kernel.outerSize();
-    for(Index outer = 0; outer < outerSize; ++outer)
+    for(Index outer = outerStart; outer < outerEnd; ++outer)
       copy_using_evaluator_innervec_InnerUnrolling<Kernel, 0, DstXprType::InnerSizeAtCompileTime>::run(kernel, outer);
   }
 };
@@ -444,10 +477,18 @@ struct dense_assignment_loop<Kernel, InnerVectorizedTraversal, InnerUnrolling>
 template<typename Kernel>
 struct dense_assignment_loop<Kernel, LinearTraversal, NoUnrolling>
 {
+  enum { PacketSize = 1 };
+
   EIGEN_DEVICE_FUNC static inline void run(Kernel &kernel)
   {
-    const Index size = kernel.size();
-    for(Index i = 0; i < size; ++i)
+    run(kernel, 0, kernel.size());
+  }
+
+  EIGEN_DEVICE_FUNC static inline Index alignedStart(Kernel &) { return 0; }
+
+  EIGEN_DEVICE_FUNC static inline void run(Kernel &kernel, Index start, Index end)
+  {
+    for(Index i = start; i < end; ++i)
       kernel.assignCoeff(i);
   }
 };
@@ -470,6 +511,11 @@ template<typename Kernel>
 struct dense_assignment_loop<Kernel, SliceVectorizedTraversal, NoUnrolling>
 {
   EIGEN_DEVICE_FUNC static inline void run(Kernel &kernel)
+  {
+    run(kernel, 0, kernel.outerSize());
+  }
+
+  EIGEN_DEVICE_FUNC static inline void run(Kernel &kernel, Index outerStart, Index outerEnd)
   {
     typedef typename Kernel::Scalar Scalar;
     typedef packet_traits<Scalar> PacketTraits;
@@ -479,19 +525,21 @@ struct dense_assignment_loop<Kernel, SliceVectorizedTraversal, NoUnrolling>
       dstIsAligned = Kernel::AssignmentTraits::DstIsAligned,
       dstAlignment = alignable ? Aligned : int(dstIsAligned)
     };
-    const Scalar *dst_ptr = &kernel.dstEvaluator().coeffRef(0,0);
+    if(outerStart>=outerEnd)
+      return;
+    const Scalar *dst_ptr = &kernel.dstEvaluator().coeffRef(kernel.rowIndexByOuterInner(outerStart,0), kernel.colIndexByOuterInner(outerStart,0));
     if((!bool(dstIsAligned)) && (Index(dst_ptr) % sizeof(Scalar))>0)
     {
       // the pointer is not aligend-on scalar, so alignment is not possible
-      return dense_assignment_loop<Kernel,DefaultTraversal,NoUnrolling>::run(kernel);
+      return dense_assignment_loop<Kernel,DefaultTraversal,NoUnrolling>::run(kernel, outerStart, outerEnd);
     }
     const Index packetAlignedMask = packetSize - 1;
     const Index innerSize = kernel.innerSize();
-    const Index outerSize = kernel.outerSize();
     const Index alignedStep = alignable ? (packetSize - kernel.outerStride() % packetSize) & packetAlignedMask : 0;
-    Index alignedStart = ((!alignable) || bool(dstIsAligned)) ? 0 : internal::first_aligned(dst_ptr, innerSize);
+    // the first outer vector of a sub-range is not necessarily aligned
+    Index alignedStart = ((!alignable) || (bool(dstIsAligned) && outerStart==0)) ? 0 : internal::first_aligned(dst_ptr, innerSize);
 
-    for(Index outer = 0; outer < outerSize; ++outer)
+    for(Index outer = outerStart; outer < outerEnd; ++outer)
     {
       const Index alignedEnd = alignedStart + ((innerSize-alignedStart) & ~packetAlignedMask);
       // do the non-vectorizable part of the assignment
@@ -534,7 +582,12 @@ public:
   typedef typename DstEvaluatorType::Scalar Scalar;
   typedef typename DstEvaluatorType::StorageIndex StorageIndex;
   typedef copy_using_evaluator_traits<DstEvaluatorTypeT, SrcEvaluatorTypeT, Functor> AssignmentTraits;
+  typedef typename packet_traits<Scalar>::type PacketType;
   
+  enum {
+    // otherwise, packets are gathered from and scattered to the destination
+    DstHasUnitInnerStride = int(inner_stride_at_compile_time<DstXprType>::ret)==1
+  };
   
   EIGEN_DEVICE_FUNC generic_dense_assignment_kernel(DstEvaluatorType &dst, const SrcEvaluatorType &src, const Functor &func, DstXprType& dstExpr)
     : m_dst(dst), m_src(src), m_functor(func), m_dstExpr(dstExpr)
@@ -581,13 +634,30 @@ public:
   template<int StoreMode, int LoadMode>
   EIGEN_DEVICE_FUNC void assignPacket(Index row, Index col)
   {
-    m_functor.template assignPacket<StoreMode>(&m_dst.coeffRef(row,col), m_src.template packet<LoadMode>(row,col));
+    if(DstHasUnitInnerStride)
+      m_functor.template assignPacket<StoreMode>(&m_dst.coeffRef(row,col), m_src.template packet<LoadMode>(row,col));
+    else
+    {
+      // the functors work on contiguous packets: apply it to a copy of the gathered destination packet
+      EIGEN_ALIGN_DEFAULT Scalar tmp[unpacket_traits<PacketType>::size];
+      pstore(tmp, m_dst.template packet<Unaligned>(row,col));
+      m_functor.template assignPacket<Aligned>(tmp, m_src.template packet<LoadMode>(row,col));
+      m_dst.template writePacket<Unaligned>(row, col, pload<PacketType>(tmp));
+    }
   }
   
   template<int StoreMode, int LoadMode>
   EIGEN_DEVICE_FUNC void assignPacket(Index index)
   {
-    m_functor.template assignPacket<StoreMode>(&m_dst.coeffRef(index), m_src.template packet<LoadMode>(index));
+    if(DstHasUnitInnerStride)
+      m_functor.template assignPacket<StoreMode>(&m_dst.coeffRef(index), m_src.template packet<LoadMode>(index));
+    else
+    {
+      EIGEN_ALIGN_DEFAULT Scalar tmp[unpacket_traits<PacketType>::size];
+      pstore(tmp, m_dst.template packet<Unaligned>(index));
+      m_functor.template assignPacket<Aligned>(tmp, m_src.template packet<LoadMode>(index));
+      m_dst.template writePacket<Unaligned>(index, pload<PacketType>(tmp));
+    }
   }
   
   template<int StoreMode, int LoadMode>
@@ -628,6 +698,85 @@ protected:
 * Part 5 : Entry point for dense rectangular assignment
 ***************************************************************************/
 
+#if (defined EIGEN_PARALLEL_ASSIGN_THRESHOLD) && !(defined __CUDA_ARCH__)
+
+// Assigns a chunk of outer vectors, or of the aligned packets for linear traversals
+template<typename Kernel, bool LinearAccess =    int(Kernel::AssignmentTraits::Traversal)==LinearVectorizedTraversal
+                                              || int(Kernel::AssignmentTraits::Traversal)==LinearTraversal>
+struct dense_assignment_chunk
+{
+  dense_assignment_chunk(Kernel& kernel) : m_kernel(kernel) {}
+
+  void operator()(Index start, Index length) const
+  {
+    dense_assignment_loop<Kernel>::run(m_kernel, start, start+length);
+  }
+
+  void parallelize(Index minCoeffsPerThread) const
+  {
+    Index innerSize = (std::max)(m_kernel.innerSize(), Index(1));
+    parallelize_range(*this, m_kernel.outerSize(), Index(1), (std::max)(Index(1), minCoeffsPerThread/innerSize));
+  }
+
+  Kernel& m_kernel;
+};
+
+template<typename Kernel>
+struct dense_assignment_chunk<Kernel,true>
+{
+  enum { PacketSize = dense_assignment_loop<Kernel>::PacketSize };
+
+  dense_assignment_chunk(Kernel& kernel)
+    : m_kernel(kernel), m_alignedStart(dense_assignment_loop<Kernel>::alignedStart(kernel)),
+      m_packets((kernel.size()-m_alignedStart)/PacketSize)
+  {}
+
+  void operator()(Index start, Index length) const
+  {
+    // the first and last chunks also process the unaligned head and tail
+    Index first = start==0                ? 0               : m_alignedStart + start*PacketSize;
+    Index last  = start+length==m_packets ? m_kernel.size() : m_alignedStart + (start+length)*PacketSize;
+    dense_assignment_loop<Kernel>::run(m_kernel, first, last);
+  }
+
+  void parallelize(Index minCoeffsPerThread) const
+  {
+    // chunks of 16 packets at least, to avoid the sharing of cache lines at the bounds of the chunks
+    parallelize_range(*this, m_packets, Index(16), minCoeffsPerThread/PacketSize);
+  }
+
+  Kernel& m_kernel;
+  Index m_alignedStart;
+  Index m_packets;
+};
+
+/* Multi-threaded assignment, enabled by defining EIGEN_PARALLEL_ASSIGN_THRESHOLD:
+ * Assignments of at least EIGEN_PARALLEL_ASSIGN_THRESHOLD coefficients are split across the threads of the
+ * parallel scheduler, in ranges of outer vectors, or in ranges of aligned packets for linear traversals. Each thread
+ * runs the usual vectorized and unrolled loops on its range. Small and fully unrolled assignments are not affected.
+ */
+template<typename Kernel, int Unrolling = Kernel::AssignmentTraits::Unrolling>
+struct parallel_dense_assignment_loop
+{
+  static void run(Kernel &kernel)
+  {
+    if(kernel.size() < Index(EIGEN_PARALLEL_ASSIGN_THRESHOLD))
+      return dense_assignment_loop<Kernel>::run(kernel);
+
+    // below this number of coefficients, a thread would not amortize its start-up cost
+    const Index minCoeffsPerThread = 4096;
+    dense_assignment_chunk<Kernel>(kernel).parallelize(minCoeffsPerThread);
+  }
+};
+
+template<typename Kernel>
+struct parallel_dense_assignment_loop<Kernel,CompleteUnrolling>
+{
+  static EIGEN_STRONG_INLINE void run(Kernel &kernel) { dense_assignment_loop<Kernel>::run(kernel); }
+};
+
+#endif // EIGEN_PARALLEL_ASSIGN_THRESHOLD
+
 template<typename DstXprType, typename SrcXprType, typename Functor>
 EIGEN_DEVICE_FUNC void call_dense_assignment_loop(const DstXprType& dst, const SrcXprType& src, const Functor &func)
 {
@@ -642,7 +791,11 @@ EIGEN_DEVICE_FUNC void call_dense_assignment_loop(const DstXprType& dst, const S
   typedef generic_dense_assignment_kernel<DstEvaluatorType,SrcEvaluatorType,Functor> Kernel;
   Kernel kernel(dstEvaluator, srcEvaluator, func, dst.const_cast_derived());
   
+#if (defined EIGEN_PARALLEL_ASSIGN_THRESHOLD) && !(defined __CUDA_ARCH__)
+  parallel_dense_assignment_loop<Kernel>::run(kernel);
+#else
   dense_assignment_loop<Kernel>::run(kernel);
+#endif
 }
 
 template<typename DstXprType, typename SrcXprType>
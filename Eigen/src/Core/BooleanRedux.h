@@ -68,6 +68,111 @@ struct any_unroller<Derived, Dynamic>
   static inline bool run(const Derived &) { return false; }
 };
 
+template<typename Derived, bool Vectorize = condition_evaluator<Derived>::PacketAccess>
+struct boolean_redux_impl
+{
+  static inline bool all(const Derived& mat)
+  {
+    typename evaluator<Derived>::type evaluator(mat);
+    for(Index j = 0; j < mat.cols(); ++j)
+      for(Index i = 0; i < mat.rows(); ++i)
+        if (!evaluator.coeff(i, j)) return false;
+    return true;
+  }
+
+  static inline bool any(const Derived& mat)
+  {
+    typename evaluator<Derived>::type evaluator(mat);
+    for(Index j = 0; j < mat.cols(); ++j)
+      for(Index i = 0; i < mat.rows(); ++i)
+        if (evaluator.coeff(i, j)) return true;
+    return false;
+  }
+
+  static inline Index count(const Derived& mat)
+  {
+    return mat.template cast<bool>().template cast<Index>().sum();
+  }
+};
+
+// comparisons are evaluated by packets of masks, whose lanes are gathered by pmovemask for all() and any()
+template<typename Derived>
+struct boolean_redux_impl<Derived, true>
+{
+  typedef condition_evaluator<Derived> Evaluator;
+  enum {
+    PacketSize = packet_traits<typename Evaluator::OperandScalar>::size,
+    IsRowMajor = (Evaluator::MaskFlags & RowMajorBit) ? 1 : 0,
+    AllSet = (1 << PacketSize) - 1
+  };
+
+  // Func is called on the moved masks of the packets, and on the coefficients of the remaining rows (or columns),
+  // until it returns true to stop early
+  template<typename Func>
+  static inline void run(const Derived& mat, Func& func)
+  {
+    Evaluator eval(mat);
+    const Index innerSize = IsRowMajor ? mat.cols() : mat.rows();
+    const Index outerSize = IsRowMajor ? mat.rows() : mat.cols();
+    const Index alignedEnd = (innerSize/PacketSize)*PacketSize;
+    for(Index j = 0; j < outerSize; ++j)
+    {
+      for(Index i = 0; i < alignedEnd; i += PacketSize)
+        if(func.mask(pmovemask(eval.template packet<Unaligned>(IsRowMajor ? j : i, IsRowMajor ? i : j))))
+          return;
+      for(Index i = alignedEnd; i < innerSize; ++i)
+        if(func.coeff(eval.coeff(IsRowMajor ? j : i, IsRowMajor ? i : j)))
+          return;
+    }
+  }
+
+  struct all_func
+  {
+    all_func() : res(true) {}
+    bool mask(int m) { res = m==AllSet; return !res; }
+    bool coeff(bool c) { res = c; return !res; }
+    bool res;
+  };
+
+  struct any_func
+  {
+    any_func() : res(false) {}
+    bool mask(int m) { res = m!=0; return res; }
+    bool coeff(bool c) { res = c; return res; }
+    bool res;
+  };
+
+  static inline bool all(const Derived& mat) { all_func func; run(mat, func); return func.res; }
+  static inline bool any(const Derived& mat) { any_func func; run(mat, func); return func.res; }
+
+  // the masks are turned into ones which are summed by packets, each lane counting exactly up to 4096
+  static inline Index count(const Derived& mat)
+  {
+    typedef typename Evaluator::OperandScalar Scalar;
+    typedef typename Evaluator::PacketScalar Packet;
+    Evaluator eval(mat);
+    const Index innerSize = IsRowMajor ? mat.cols() : mat.rows();
+    const Index outerSize = IsRowMajor ? mat.rows() : mat.cols();
+    const Index alignedEnd = (innerSize/PacketSize)*PacketSize;
+    const Packet one = pset1<Packet>(Scalar(1));
+    Index res = 0;
+    for(Index j = 0; j < outerSize; ++j)
+    {
+      for(Index i = 0; i < alignedEnd; )
+      {
+        const Index end = (std::min)(alignedEnd, i + 4096*PacketSize);
+        Packet acc = pset1<Packet>(Scalar(0));
+        for(; i < end; i += PacketSize)
+          acc = padd(acc, pand(one, eval.template packet<Unaligned>(IsRowMajor ? j : i, IsRowMajor ? i : j)));
+        res += Index(predux(acc));
+      }
+      for(Index i = alignedEnd; i < innerSize; ++i)
+        res += eval.coeff(IsRowMajor ? j : i, IsRowMajor ? i : j);
+    }
+    return res;
+  }
+};
+
 } // end namespace internal
 
 /** \returns true if all coefficients are true
@@ -87,16 +192,13 @@ inline bool DenseBase<Derived>::all() const
           && NumTraits<Scalar>::AddCost != Dynamic
           && SizeAtCompileTime * (Evaluator::CoeffReadCost + NumTraits<Scalar>::AddCost) <= EIGEN_UNROLLING_LIMIT
   };
-  Evaluator evaluator(derived());
   if(unroll)
-    return internal::all_unroller<Evaluator, unroll ? int(SizeAtCompileTime) : Dynamic>::run(evaluator);
-  else
   {
-    for(Index j = 0; j < cols(); ++j)
-      for(Index i = 0; i < rows(); ++i)
-        if (!evaluator.coeff(i, j)) return false;
-    return true;
+    Evaluator evaluator(derived());
+    return internal::all_unroller<Evaluator, unroll ? int(SizeAtCompileTime) : Dynamic>::run(evaluator);
   }
+  else
+    return internal::boolean_redux_impl<Derived>::all(derived());
 }
 
 /** \returns true if at least one coefficient is true
@@ -113,16 +215,13 @@ inline bool DenseBase<Derived>::any() const
           && NumTraits<Scalar>::AddCost != Dynamic
           && SizeAtCompileTime * (Evaluator::CoeffReadCost + NumTraits<Scalar>::AddCost) <= EIGEN_UNROLLING_LIMIT
   };
-  Evaluator evaluator(derived());
   if(unroll)
-    return internal::any_unroller<Evaluator, unroll ? int(SizeAtCompileTime) : Dynamic>::run(evaluator);
-  else
   {
-    for(Index j = 0; j < cols(); ++j)
-      for(Index i = 0; i < rows(); ++i)
-        if (evaluator.coeff(i, j)) return true;
-    return false;
+    Evaluator evaluator(derived());
+    return internal::any_unroller<Evaluator, unroll ? int(SizeAtCompileTime) : Dynamic>::run(evaluator);
   }
+  else
+    return internal::boolean_redux_impl<Derived>::any(derived());
 }
 
 /** \returns the number of coefficients which evaluate to true
@@ -132,7 +231,7 @@ inline bool DenseBase<Derived>::any() const
 template<typename Derived>
 inline Eigen::Index DenseBase<Derived>::count() const
 {
-  return derived().template cast<bool>().template cast<Index>().sum();
+  return internal::boolean_redux_impl<Derived>::count(derived());
 }
 
 /** \returns true is \c *this contains at least one Not A Number (NaN).
@@ -562,16 +562,15 @@ struct mapbase_evaluator : evaluator_base<Derived>
   enum {
     IsRowMajor = XprType::RowsAtCompileTime,
     ColsAtCompileTime = XprType::ColsAtCompileTime,
-    CoeffReadCost = NumTraits<Scalar>::ReadCost
+    CoeffReadCost = NumTraits<Scalar>::ReadCost,
+    // packets along a non unit inner stride are gathered and scattered
+    HasUnitInnerStride = internal::inner_stride_at_compile_time<Derived>::ret==1
   };
   
   EIGEN_DEVICE_FUNC explicit mapbase_evaluator(const XprType& map)
     : m_data(const_cast<PointerType>(map.data())),  
       m_xpr(map)
-  {
-    EIGEN_STATIC_ASSERT(EIGEN_IMPLIES(evaluator<Derived>::Flags&PacketAccessBit, internal::inner_stride_at_compile_time<Derived>::ret==1),
-                        PACKET_ACCESS_REQUIRES_TO_HAVE_INNER_STRIDE_FIXED_TO_1);
-  }
+  {}
  
   EIGEN_DEVICE_FUNC CoeffReturnType coeff(Index row, Index col) const
   {
@@ -597,26 +596,38 @@ struct mapbase_evaluator : evaluator_base<Derived>
   PacketReturnType packet(Index row, Index col) const 
   {
     PointerType ptr = m_data + row * m_xpr.rowStride() + col * m_xpr.colStride();
-    return internal::ploadt<PacketScalar, LoadMode>(ptr);
+    if(HasUnitInnerStride)
+      return internal::ploadt<PacketScalar, LoadMode>(ptr);
+    else
+      return internal::pgather<Scalar, PacketScalar>(ptr, m_xpr.innerStride());
   }
 
   template<int LoadMode> 
   PacketReturnType packet(Index index) const 
   {
-    return internal::ploadt<PacketScalar, LoadMode>(m_data + index * m_xpr.innerStride());
+    if(HasUnitInnerStride)
+      return internal::ploadt<PacketScalar, LoadMode>(m_data + index);
+    else
+      return internal::pgather<Scalar, PacketScalar>(m_data + index * m_xpr.innerStride(), m_xpr.innerStride());
   }
   
   template<int StoreMode> 
   void writePacket(Index row, Index col, const PacketScalar& x) 
   {
     PointerType ptr = m_data + row * m_xpr.rowStride() + col * m_xpr.colStride();
-    return internal::pstoret<Scalar, PacketScalar, StoreMode>(ptr, x);
+    if(HasUnitInnerStride)
+      internal::pstoret<Scalar, PacketScalar, StoreMode>(ptr, x);
+    else
+      internal::pscatter<Scalar, PacketScalar>(ptr, x, m_xpr.innerStride());
   }
   
   template<int StoreMode> 
   void writePacket(Index index, const PacketScalar& x) 
   {
-    internal::pstoret<Scalar, PacketScalar, StoreMode>(m_data + index * m_xpr.innerStride(), x);
+    if(HasUnitInnerStride)
+      internal::pstoret<Scalar, PacketScalar, StoreMode>(m_data + index, x);
+    else
+      internal::pscatter<Scalar, PacketScalar>(m_data + index * m_xpr.innerStride(), x, m_xpr.innerStride());
   }
  
 protected:
@@ -647,13 +658,15 @@ struct evaluator<Map<PlainObjectType, MapOptions, StrideType> >
     // TODO: should check for smaller packet types once we can handle multi-sized packet types
     AlignBytes = int(packet_traits<Scalar>::size) * sizeof(Scalar),
     
+    // dynamic size maps with an inner stride are vectorized through pgather/pscatter
     KeepsPacketAccess = bool(HasNoInnerStride)
-                        && ( bool(IsDynamicSize)
+                        ? ( bool(IsDynamicSize)
                            || HasNoOuterStride
                            || ( OuterStrideAtCompileTime!=Dynamic
-                           && ((static_cast<int>(sizeof(Scalar))*OuterStrideAtCompileTime) % AlignBytes)==0 ) ),
+                           && ((static_cast<int>(sizeof(Scalar))*OuterStrideAtCompileTime) % AlignBytes)==0 ) )
+                        : bool(IsDynamicSize),
     Flags0 = evaluator<PlainObjectType>::Flags,
-    Flags1 = IsAligned ? (int(Flags0) | AlignedBit) : (int(Flags0) & ~AlignedBit),
+    Flags1 = IsAligned && HasNoInnerStride ? (int(Flags0) | AlignedBit) : (int(Flags0) & ~AlignedBit),
     Flags2 = (bool(HasNoStride) || bool(PlainObjectType::IsVectorAtCompileTime))
            ? int(Flags1) : int(Flags1 & ~LinearAccessBit),
     Flags = KeepsPacketAccess ? int(Flags2) : (int(Flags2) & ~PacketAccessBit)
@@ -713,8 +726,10 @@ struct evaluator<Block<ArgType, BlockRows, BlockCols, InnerPanel> >
     OuterStrideAtCompileTime = HasSameStorageOrderAsArgType
                              ? int(outer_stride_at_compile_time<ArgType>::ret)
                              : int(inner_stride_at_compile_time<ArgType>::ret),
-    MaskPacketAccessBit = (InnerSize == Dynamic || (InnerSize % packet_traits<Scalar>::size) == 0)
-                       && (InnerStrideAtCompileTime == 1)
+    // with direct access, packets along a non unit inner stride of a dynamic size block are gathered and scattered
+    MaskPacketAccessBit = ( (InnerSize == Dynamic || (InnerSize % packet_traits<Scalar>::size) == 0)
+                            && (InnerStrideAtCompileTime == 1) )
+                       || ( InnerSize == Dynamic && has_direct_access<ArgType>::ret )
                         ? PacketAccessBit : 0,
     
     // TODO: should check for smaller packet types once we can handle multi-sized packet types
@@ -845,18 +860,102 @@ struct block_evaluator<ArgType, BlockRows, BlockCols, InnerPanel, /* HasDirectAc
 // -------------------- Select --------------------
 // TODO shall we introduce a ternary_evaluator?
 
-// TODO enable vectorization for Select
+template<ComparisonName Cmp> struct pcmp_impl;
+template<> struct pcmp_impl<cmp_EQ>  { template<typename Packet> static Packet run(const Packet& a, const Packet& b) { return pcmp_eq(a,b); } };
+template<> struct pcmp_impl<cmp_NEQ> { template<typename Packet> static Packet run(const Packet& a, const Packet& b) { return pcmp_neq(a,b); } };
+template<> struct pcmp_impl<cmp_LT>  { template<typename Packet> static Packet run(const Packet& a, const Packet& b) { return pcmp_lt(a,b); } };
+template<> struct pcmp_impl<cmp_LE>  { template<typename Packet> static Packet run(const Packet& a, const Packet& b) { return pcmp_le(a,b); } };
+
+/* Evaluator of a boolean expression used as a condition by select() or the boolean reductions.
+ * Boolean coefficients cannot be packed, but comparisons of expressions with packet access can be evaluated
+ * as masks of the packet type of their operands, which is enabled by PacketAccess and MaskFlags.
+ */
+template<typename XprType>
+struct condition_evaluator
+{
+  typedef void OperandScalar;
+  enum {
+    CoeffReadCost = evaluator<XprType>::CoeffReadCost,
+    PacketAccess = 0,
+    MaskFlags = 0
+  };
+
+  EIGEN_DEVICE_FUNC explicit condition_evaluator(const XprType& xpr) : m_impl(xpr) {}
+
+  EIGEN_DEVICE_FUNC bool coeff(Index row, Index col) const { return m_impl.coeff(row, col); }
+  EIGEN_DEVICE_FUNC bool coeff(Index index) const { return m_impl.coeff(index); }
+
+protected:
+  typename evaluator<XprType>::nestedType m_impl;
+};
+
+template<typename Scalar, ComparisonName Cmp, typename Lhs, typename Rhs>
+struct condition_evaluator<CwiseBinaryOp<scalar_cmp_op<Scalar,Cmp>, Lhs, Rhs> >
+{
+  typedef CwiseBinaryOp<scalar_cmp_op<Scalar,Cmp>, Lhs, Rhs> XprType;
+  typedef Scalar OperandScalar;
+  typedef typename packet_traits<Scalar>::type PacketScalar;
+  enum {
+    CoeffReadCost = evaluator<XprType>::CoeffReadCost,
+    LhsFlags = evaluator<Lhs>::Flags,
+    RhsFlags = evaluator<Rhs>::Flags,
+    PacketAccess = packet_traits<Scalar>::HasCmp && Cmp!=cmp_UNORD
+                && (LhsFlags & RhsFlags & PacketAccessBit)
+                && ((LhsFlags ^ RhsFlags) & RowMajorBit)==0,
+    MaskFlags = PacketAccess ? (LhsFlags & RhsFlags & (RowMajorBit | PacketAccessBit | AlignedBit | LinearAccessBit)) : 0
+  };
+
+  EIGEN_DEVICE_FUNC explicit condition_evaluator(const XprType& xpr)
+    : m_functor(xpr.functor()), m_lhsImpl(xpr.lhs()), m_rhsImpl(xpr.rhs())
+  {}
+
+  EIGEN_DEVICE_FUNC bool coeff(Index row, Index col) const
+  { return m_functor(m_lhsImpl.coeff(row, col), m_rhsImpl.coeff(row, col)); }
+  EIGEN_DEVICE_FUNC bool coeff(Index index) const
+  { return m_functor(m_lhsImpl.coeff(index), m_rhsImpl.coeff(index)); }
+
+  template<int LoadMode>
+  PacketScalar packet(Index row, Index col) const
+  {
+    return pcmp_impl<Cmp>::run(m_lhsImpl.template packet<LoadMode>(row, col),
+                               m_rhsImpl.template packet<LoadMode>(row, col));
+  }
+
+  template<int LoadMode>
+  PacketScalar packet(Index index) const
+  {
+    return pcmp_impl<Cmp>::run(m_lhsImpl.template packet<LoadMode>(index),
+                               m_rhsImpl.template packet<LoadMode>(index));
+  }
+
+protected:
+  const scalar_cmp_op<Scalar,Cmp> m_functor;
+  typename evaluator<Lhs>::nestedType m_lhsImpl;
+  typename evaluator<Rhs>::nestedType m_rhsImpl;
+};
+
 template<typename ConditionMatrixType, typename ThenMatrixType, typename ElseMatrixType>
 struct evaluator<Select<ConditionMatrixType, ThenMatrixType, ElseMatrixType> >
   : evaluator_base<Select<ConditionMatrixType, ThenMatrixType, ElseMatrixType> >
 {
   typedef Select<ConditionMatrixType, ThenMatrixType, ElseMatrixType> XprType;
+  typedef condition_evaluator<ConditionMatrixType> ConditionEvaluator;
   enum {
-    CoeffReadCost = evaluator<ConditionMatrixType>::CoeffReadCost
+    CoeffReadCost = ConditionEvaluator::CoeffReadCost
                   + EIGEN_SIZE_MAX(evaluator<ThenMatrixType>::CoeffReadCost,
                                    evaluator<ElseMatrixType>::CoeffReadCost),
 
-    Flags = (unsigned int)evaluator<ThenMatrixType>::Flags & evaluator<ElseMatrixType>::Flags & HereditaryBits
+    ThenFlags = evaluator<ThenMatrixType>::Flags,
+    ElseFlags = evaluator<ElseMatrixType>::Flags,
+    MaskFlags = ConditionEvaluator::MaskFlags,
+    // the condition is evaluated as a mask of packets of the same type as the selected ones
+    PacketAccess = ConditionEvaluator::PacketAccess
+                && is_same<typename ConditionEvaluator::OperandScalar, typename XprType::Scalar>::value
+                && ((ThenFlags ^ ElseFlags) & RowMajorBit)==0
+                && ((ThenFlags ^ MaskFlags) & RowMajorBit)==0,
+
+    Flags = (unsigned int)(ThenFlags & ElseFlags & HereditaryBits)
+          | (PacketAccess ? (unsigned int)(ThenFlags & ElseFlags & MaskFlags & (PacketAccessBit | AlignedBit | LinearAccessBit)) : 0u)
   };
 
   inline EIGEN_DEVICE_FUNC  explicit evaluator(const XprType& select)
@@ -866,6 +965,7 @@ struct evaluator<Select<ConditionMatrixType, ThenMatrixType, ElseMatrixType> >
   { }
  
   typedef typename XprType::CoeffReturnType CoeffReturnType;
+  typedef typename XprType::PacketScalar PacketScalar;
 
   inline EIGEN_DEVICE_FUNC CoeffReturnType coeff(Index row, Index col) const
   {
@@ -882,9 +982,25 @@ struct evaluator<Select<ConditionMatrixType, ThenMatrixType, ElseMatrixType> >
     else
       return m_elseImpl.coeff(index);
   }
+
+  template<int LoadMode>
+  PacketScalar packet(Index row, Index col) const
+  {
+    return pselect(m_conditionImpl.template packet<LoadMode>(row, col),
+                   m_thenImpl.template packet<LoadMode>(row, col),
+                   m_elseImpl.template packet<LoadMode>(row, col));
+  }
+
+  template<int LoadMode>
+  PacketScalar packet(Index index) const
+  {
+    return pselect(m_conditionImpl.template packet<LoadMode>(index),
+                   m_thenImpl.template packet<LoadMode>(index),
+                   m_elseImpl.template packet<LoadMode>(index));
+  }
  
 protected:
-  typename evaluator<ConditionMatrixType>::nestedType m_conditionImpl;
+  ConditionEvaluator m_conditionImpl;
   typename evaluator<ThenMatrixType>::nestedType m_thenImpl;
   typename evaluator<ElseMatrixType>::nestedType m_elseImpl;
 };
@@ -56,6 +56,7 @@ struct default_packet_traits
     HasConj   = 1,
     HasSetLinear = 1,
     HasBlend  = 0,
+    HasCmp    = 0,
 
     HasDiv    = 0,
     HasSqrt   = 0,
@@ -64,6 +65,7 @@ struct default_packet_traits
     HasLog    = 0,
     HasLog10    = 0,
     HasPow    = 0,
+    HasErf    = 0,
 
     HasSin    = 0,
     HasCos    = 0,
@@ -278,6 +280,16 @@ template<typename Scalar, typename Packet> EIGEN_DEVICE_FUNC inline void pstoreu
  template<typename Scalar, typename Packet> EIGEN_DEVICE_FUNC inline void pscatter(Scalar* to, const Packet& from, Index /*stride*/)
  { pstore(to, from); }
 
+/** \internal \returns a packet with the elements \a from[indices[0]], \a from[indices[1]], ... */
+template<typename Scalar, typename Packet, typename IndexType> EIGEN_DEVICE_FUNC inline Packet pgather(const Scalar* from, const IndexType* indices)
+{
+  enum { PacketSize = unpacket_traits<Packet>::size };
+  EIGEN_ALIGN_DEFAULT Scalar elements[PacketSize];
+  for(int i=0; i<PacketSize; ++i)
+    elements[i] = from[indices[i]];
+  return pload<Packet>(elements);
+}
+
 /** \internal tries to do cache prefetching of \a addr */
 template<typename Scalar> inline void prefetch(const Scalar* addr)
 {
@@ -392,6 +404,14 @@ Packet ptanh(const Packet& a) { using std::tanh; return tanh(a); }
 template<typename Packet> EIGEN_DECLARE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS
 Packet pexp(const Packet& a) { using std::exp; return exp(a); }
 
+/** \internal \returns \a a raised to the power \a b (coeff-wise) */
+template<typename Packet> EIGEN_DECLARE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS
+Packet ppow(const Packet& a, const Packet& b) { return numext::pow(a, b); }
+
+/** \internal \returns the error function of \a a (coeff-wise) */
+template<typename Packet> EIGEN_DECLARE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS
+Packet perf(const Packet& a) { return numext::erf(a); }
+
 /** \internal \returns the log of \a a (coeff-wise) */
 template<typename Packet> EIGEN_DECLARE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS
 Packet plog(const Packet& a) { using std::log; return log(a); }
@@ -422,6 +442,15 @@ Packet pfloor(const Packet& a) { using numext::floor; return floor(a); }
 template<typename Packet> EIGEN_DECLARE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS
 Packet pceil(const Packet& a) { using numext::ceil; return ceil(a); }
 
+/** \internal \returns the significand of \a a in [0.5,1), its exponent being stored in \a exponent, as std::frexp does (coeff-wise).
+  * The vectorized versions only handle the finite normalized numbers. */
+template<typename Packet> EIGEN_DECLARE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS
+Packet pfrexp(const Packet& a, Packet& exponent) { using std::frexp; int e; Packet m = frexp(a, &e); exponent = Packet(e); return m; }
+
+/** \internal \returns \a a times two to the power \a exponent, the latter being integral, as std::ldexp does (coeff-wise) */
+template<typename Packet> EIGEN_DECLARE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS
+Packet pldexp(const Packet& a, const Packet& exponent) { using std::ldexp; return ldexp(a, int(exponent)); }
+
 /***************************************************************************
 * The following functions might not have to be overwritten for vectorized types
 ***************************************************************************/
@@ -441,6 +470,17 @@ pmadd(const Packet&  a,
          const Packet&  c)
 { return padd(pmul(a, b),c); }
 
+/** \internal \returns c plus the sums of the products of the two 16-bit integers held in each 32-bit lane of \a a and \a b,
+  * i.e., c + a.lo * b.lo + a.hi * b.hi (lane-wise) */
+template<typename Packet> EIGEN_DEVICE_FUNC inline Packet
+pmadd_int16_pairs(const Packet&  a,
+                  const Packet&  b,
+                  const Packet&  c)
+{
+  return c + int(static_cast<short>(a & 0xffff)) * int(static_cast<short>(b & 0xffff))
+           + int(static_cast<short>((a >> 16) & 0xffff)) * int(static_cast<short>((b >> 16) & 0xffff));
+}
+
 /** \internal \returns a packet version of \a *from.
   * If LoadMode equals #Aligned, \a from must be 16 bytes aligned */
 template<typename Packet, int LoadMode>
@@ -545,6 +585,45 @@ pblend(const Selector<unpacket_traits<Packet>::size>& ifPacket, const Packet& th
   return ifPacket.select[0] ? thenPacket : elsePacket;
 }
 
+/***************************************************************************
+ * Comparisons, returning masks whose words have all their bits set where
+ * the comparison holds, and cleared elsewhere.
+***************************************************************************/
+
+/** \internal \returns a mask with all its bits set */
+template<typename Packet> EIGEN_DEVICE_FUNC inline Packet
+ptrue(const Packet& /*a*/) { Packet b; memset(&b, 0xff, sizeof(b)); return b; }
+
+/** \internal \returns a mask with all its bits cleared */
+template<typename Packet> EIGEN_DEVICE_FUNC inline Packet
+pfalse(const Packet& /*a*/) { Packet b; memset(&b, 0, sizeof(b)); return b; }
+
+/** \internal \returns the mask of a==b */
+template<typename Packet> EIGEN_DEVICE_FUNC inline Packet
+pcmp_eq(const Packet& a, const Packet& b) { return a==b ? ptrue(a) : pfalse(a); }
+
+/** \internal \returns the mask of a!=b, which is set if a or b is NaN */
+template<typename Packet> EIGEN_DEVICE_FUNC inline Packet
+pcmp_neq(const Packet& a, const Packet& b) { return a!=b ? ptrue(a) : pfalse(a); }
+
+/** \internal \returns the mask of a<b */
+template<typename Packet> EIGEN_DEVICE_FUNC inline Packet
+pcmp_lt(const Packet& a, const Packet& b) { return a<b ? ptrue(a) : pfalse(a); }
+
+/** \internal \returns the mask of a<=b */
+template<typename Packet> EIGEN_DEVICE_FUNC inline Packet
+pcmp_le(const Packet& a, const Packet& b) { return a<=b ? ptrue(a) : pfalse(a); }
+
+/** \internal \returns an integer whose i-th bit is set if the i-th word of the mask \a mask is set */
+template<typename Packet> EIGEN_DEVICE_FUNC inline int
+pmovemask(const Packet& mask) { return *reinterpret_cast<const unsigned char*>(&mask) ? 1 : 0; }
+
+/** \internal \returns the words of \a thenPacket where the mask \a mask is set, and those of \a elsePacket elsewhere */
+template<typename Packet> EIGEN_DEVICE_FUNC inline Packet
+pselect(const Packet& mask, const Packet& thenPacket, const Packet& elsePacket) {
+  return pmovemask(mask) ? thenPacket : elsePacket;
+}
+
 } // end namespace internal
 
 } // end namespace Eigen
@@ -476,6 +476,32 @@ struct log1p_retval
   typedef Scalar type;
 };
 
+/****************************************************************************
+* Implementation of erf                                                     *
+****************************************************************************/
+
+template<typename Scalar>
+struct erf_impl
+{
+  static inline Scalar run(const Scalar& x)
+  {
+    EIGEN_STATIC_ASSERT_NON_INTEGER(Scalar)
+    #if EIGEN_HAS_CXX11_MATH
+    using std::erf;
+    return erf(x);
+    #else
+    // C99 function of the C library
+    return Scalar(::erf(double(x)));
+    #endif
+  }
+};
+
+template<typename Scalar>
+struct erf_retval
+{
+  typedef Scalar type;
+};
+
 /****************************************************************************
 * Implementation of pow                                                  *
 ****************************************************************************/
@@ -773,6 +799,13 @@ inline EIGEN_MATHFUNC_RETVAL(log1p, Scalar) log1p(const Scalar& x)
   return EIGEN_MATHFUNC_IMPL(log1p, Scalar)::run(x);
 }
 
+template<typename Scalar>
+EIGEN_DEVICE_FUNC
+inline EIGEN_MATHFUNC_RETVAL(erf, Scalar) erf(const Scalar& x)
+{
+  return EIGEN_MATHFUNC_IMPL(erf, Scalar)::run(x);
+}
+
 template<typename Scalar>
 EIGEN_DEVICE_FUNC
 inline EIGEN_MATHFUNC_RETVAL(pow, Scalar) pow(const Scalar& x, const Scalar& y)
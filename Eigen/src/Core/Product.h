@@ -213,7 +213,32 @@ class ProductImpl<Lhs,Rhs,Option,Dense>
       
       return typename internal::evaluator<Derived>::type(derived()).coeff(i);
     }
-    
+
+    /** \returns an expression of this product followed by the coefficient-wise operation \a epilogue,
+      * such as the addition of a bias followed by a clamping, or a scaling.
+      *
+      * \a epilogue must provide the two following const methods:
+      * \code
+      * Scalar operator()(const Scalar& x, Index row, Index col) const;
+      * template<typename Packet> Packet packetOp(const Packet& x, Index row, Index col) const;
+      * \endcode
+      * where \c x is the coefficient of the product at position (\c row, \c col). The packet version
+      * processes the coefficients \c row to \c row+size-1 of the column \c col.
+      *
+      * For large products into a column-major destination, the epilogue is applied by the matrix-matrix
+      * kernel while the results are still in the registers, which saves a second pass over the destination.
+      * Otherwise, it is applied once the product has been evaluated.
+      *
+      * Example:
+      * \code
+      * C.noalias() = (A*B).withEpilogue(my_bias_relu(bias));
+      * \endcode
+      */
+    template<typename Epilogue>
+    inline const internal::product_epilogue_retval<Derived,Epilogue> withEpilogue(const Epilogue& epilogue) const
+    {
+      return internal::product_epilogue_retval<Derived,Epilogue>(derived(), epilogue);
+    }
   
 };
 
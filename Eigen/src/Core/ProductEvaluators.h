@@ -191,6 +191,91 @@ struct Assignment<DstXprType, CwiseUnaryOp<internal::scalar_multiple_op<ScalarBi
   }
 };
 
+/* Applies the epilogue functor to all the coefficients of dst, when it cannot be fused in the product kernel */
+template<typename Dest, typename Epilogue>
+void apply_product_epilogue(Dest& dst, const Epilogue& epilogue)
+{
+  for(Index j=0; j<dst.cols(); ++j)
+    for(Index i=0; i<dst.rows(); ++i)
+      dst.coeffRef(i,j) = epilogue(dst.coeff(i,j), i, j);
+}
+
+// Only the matrix-matrix products fuse the epilogue into their kernel
+template< typename Lhs, typename Rhs,
+          typename LhsShape = typename evaluator_traits<Lhs>::Shape,
+          typename RhsShape = typename evaluator_traits<Rhs>::Shape,
+          int ProductType = internal::product_type<Lhs,Rhs>::value>
+struct product_epilogue_impl
+{
+  template<typename Dst, typename Epilogue>
+  static void evalTo(Dst& dst, const Lhs& lhs, const Rhs& rhs, const Epilogue& epilogue)
+  {
+    generic_product_impl<Lhs, Rhs>::evalTo(dst, lhs, rhs);
+    apply_product_epilogue(dst, epilogue);
+  }
+};
+
+template<typename Lhs, typename Rhs>
+struct product_epilogue_impl<Lhs,Rhs,DenseShape,DenseShape,GemmProduct>
+{
+  template<typename Dst, typename Epilogue>
+  static void evalTo(Dst& dst, const Lhs& lhs, const Rhs& rhs, const Epilogue& epilogue)
+  {
+    generic_product_impl<Lhs,Rhs,DenseShape,DenseShape,GemmProduct>::evalToWithEpilogue(dst, lhs, rhs, epilogue);
+  }
+};
+
+template<typename ProductType, typename Epilogue>
+struct traits<product_epilogue_retval<ProductType,Epilogue> >
+  : traits<typename ProductType::PlainObject>
+{
+  typedef typename ProductType::PlainObject ReturnType;
+};
+
+/* Expression of a product followed by a coefficient-wise epilogue, see ProductImpl::withEpilogue() */
+template<typename ProductType, typename Epilogue>
+struct product_epilogue_retval
+  : public ReturnByValue<product_epilogue_retval<ProductType,Epilogue> >
+{
+  typedef typename ProductType::Lhs Lhs;
+  typedef typename ProductType::Rhs Rhs;
+  typedef typename traits<product_epilogue_retval>::ReturnType ReturnType;
+
+  product_epilogue_retval(const ProductType& prod, const Epilogue& epilogue)
+    : m_product(prod), m_epilogue(epilogue)
+  {}
+
+  inline Index rows() const { return m_product.rows(); }
+  inline Index cols() const { return m_product.cols(); }
+
+  template<typename Dest> void evalTo(Dest& dst) const
+  {
+    if(extract_data(dst)!=0 && (extract_data(dst)==extract_data(m_product.lhs()) || extract_data(dst)==extract_data(m_product.rhs())))
+    {
+      // dst aliases one of the factors
+      ReturnType tmp(rows(), cols());
+      product_epilogue_impl<Lhs,Rhs>::evalTo(tmp, m_product.lhs(), m_product.rhs(), m_epilogue);
+      dst = tmp;
+    }
+    else
+      product_epilogue_impl<Lhs,Rhs>::evalTo(dst, m_product.lhs(), m_product.rhs(), m_epilogue);
+  }
+
+  const ProductType m_product;
+  const Epilogue m_epilogue;
+};
+
+// Dense.noalias() = Product.withEpilogue(), evaluated without temporary
+template< typename DstXprType, typename ProductType, typename Epilogue, typename Scalar>
+struct Assignment<DstXprType, product_epilogue_retval<ProductType,Epilogue>, internal::assign_op<Scalar>, Dense2Dense, Scalar>
+{
+  typedef product_epilogue_retval<ProductType,Epilogue> SrcXprType;
+  static void run(DstXprType &dst, const SrcXprType &src, const internal::assign_op<Scalar> &)
+  {
+    src.evalTo(dst);
+  }
+};
+
 
 template<typename Lhs, typename Rhs>
 struct generic_product_impl<Lhs,Rhs,DenseShape,DenseShape,InnerProduct>
@@ -576,7 +661,7 @@ struct etor_product_packet_impl<RowMajor, 0, Lhs, Rhs, Packet, LoadMode>
 {
   static EIGEN_STRONG_INLINE void run(Index /*row*/, Index /*col*/, const Lhs& /*lhs*/, const Rhs& /*rhs*/, Index /*innerDim*/, Packet &res)
   {
-    res = pset1<Packet>(0);
+    res = pset1<Packet>(typename unpacket_traits<Packet>::type(0));
   }
 };
 
@@ -585,7 +670,7 @@ struct etor_product_packet_impl<ColMajor, 0, Lhs, Rhs, Packet, LoadMode>
 {
   static EIGEN_STRONG_INLINE void run(Index /*row*/, Index /*col*/, const Lhs& /*lhs*/, const Rhs& /*rhs*/, Index /*innerDim*/, Packet &res)
   {
-    res = pset1<Packet>(0);
+    res = pset1<Packet>(typename unpacket_traits<Packet>::type(0));
   }
 };
 
@@ -594,7 +679,7 @@ struct etor_product_packet_impl<RowMajor, Dynamic, Lhs, Rhs, Packet, LoadMode>
 {
   static EIGEN_STRONG_INLINE void run(Index row, Index col, const Lhs& lhs, const Rhs& rhs, Index innerDim, Packet& res)
   {
-    res = pset1<Packet>(0);
+    res = pset1<Packet>(typename unpacket_traits<Packet>::type(0));
     for(Index i = 0; i < innerDim; ++i)
       res =  pmadd(pset1<Packet>(lhs.coeff(row, i)), rhs.template packet<LoadMode>(i, col), res);
   }
@@ -605,7 +690,7 @@ struct etor_product_packet_impl<ColMajor, Dynamic, Lhs, Rhs, Packet, LoadMode>
 {
   static EIGEN_STRONG_INLINE void run(Index row, Index col, const Lhs& lhs, const Rhs& rhs, Index innerDim, Packet& res)
   {
-    res = pset1<Packet>(0);
+    res = pset1<Packet>(typename unpacket_traits<Packet>::type(0));
     for(Index i = 0; i < innerDim; ++i)
       res =  pmadd(lhs.template packet<LoadMode>(row, i), pset1<Packet>(rhs.coeff(i, col)), res);
   }
@@ -331,6 +331,101 @@ struct redux_impl<Func, Derived, LinearVectorizedTraversal, CompleteUnrolling>
   }
 };
 
+/*** sums of 16 bits floating point scalars ***/
+
+// The sums of half and bfloat16 scalars are accumulated in single precision and rounded once, the packets being converted
+// by pcast. The small fixed size sums, which are unrolled, are directly accumulated in 16 bits.
+template<typename Derived, int Traversal>
+struct redux_float_sum_impl
+{
+  typedef typename Derived::Scalar Scalar;
+  static Scalar run(const Derived &mat)
+  {
+    float res = 0.f;
+    for(Index j = 0; j < mat.outerSize(); ++j)
+      for(Index i = 0; i < mat.innerSize(); ++i)
+        res += float(mat.coeffByOuterInner(j, i));
+    return Scalar(res);
+  }
+};
+
+template<typename Derived>
+struct redux_float_sum_impl<Derived, LinearVectorizedTraversal>
+{
+  typedef typename Derived::Scalar Scalar;
+  typedef typename packet_traits<Scalar>::type PacketScalar;
+  typedef typename packet_traits<float>::type PacketFloat;
+  enum { PacketSize = packet_traits<Scalar>::size };
+
+  static Scalar run(const Derived &mat)
+  {
+    EIGEN_STATIC_ASSERT(int(PacketSize)==int(packet_traits<float>::size), YOU_MADE_A_PROGRAMMING_MISTAKE)
+    const Index size = mat.size();
+    const Index alignedSize2 = (size/(2*PacketSize))*(2*PacketSize);
+    const Index alignedSize = (size/PacketSize)*PacketSize;
+    float res = 0.f;
+    if(alignedSize)
+    {
+      PacketFloat packet_res0 = pset1<PacketFloat>(0.f), packet_res1 = packet_res0;
+      for(Index index = 0; index < alignedSize2; index += 2*PacketSize)
+      {
+        packet_res0 = padd(packet_res0, pcast<PacketScalar,PacketFloat>(mat.template packet<Unaligned>(index)));
+        packet_res1 = padd(packet_res1, pcast<PacketScalar,PacketFloat>(mat.template packet<Unaligned>(index+PacketSize)));
+      }
+      if(alignedSize>alignedSize2)
+        packet_res0 = padd(packet_res0, pcast<PacketScalar,PacketFloat>(mat.template packet<Unaligned>(alignedSize2)));
+      res = predux(padd(packet_res0, packet_res1));
+    }
+    for(Index index = alignedSize; index < size; ++index)
+      res += float(mat.coeff(index));
+    return Scalar(res);
+  }
+};
+
+template<typename Derived>
+struct redux_float_sum_impl<Derived, SliceVectorizedTraversal>
+{
+  typedef typename Derived::Scalar Scalar;
+  typedef typename packet_traits<Scalar>::type PacketScalar;
+  typedef typename packet_traits<float>::type PacketFloat;
+  enum { PacketSize = packet_traits<Scalar>::size };
+
+  static Scalar run(const Derived &mat)
+  {
+    EIGEN_STATIC_ASSERT(int(PacketSize)==int(packet_traits<float>::size), YOU_MADE_A_PROGRAMMING_MISTAKE)
+    const Index innerSize = mat.innerSize();
+    const Index outerSize = mat.outerSize();
+    const Index packetedInnerSize = (innerSize/PacketSize)*PacketSize;
+    PacketFloat packet_res = pset1<PacketFloat>(0.f);
+    float res = 0.f;
+    for(Index j = 0; j < outerSize; ++j)
+    {
+      for(Index i = 0; i < packetedInnerSize; i += PacketSize)
+        packet_res = padd(packet_res, pcast<PacketScalar,PacketFloat>(mat.template packetByOuterInner<Unaligned>(j,i)));
+      for(Index i = packetedInnerSize; i < innerSize; ++i)
+        res += float(mat.coeffByOuterInner(j,i));
+    }
+    return Scalar(res + predux(packet_res));
+  }
+};
+
+#define EIGEN_MAKE_FLOAT_ACCUMULATING_SUM(SCALAR, TRAVERSAL) \
+template<typename Derived> \
+struct redux_impl<scalar_sum_op<SCALAR>, Derived, TRAVERSAL, NoUnrolling> \
+{ \
+  static SCALAR run(const Derived &mat, const scalar_sum_op<SCALAR>&) \
+  { return redux_float_sum_impl<Derived, TRAVERSAL>::run(mat); } \
+};
+
+EIGEN_MAKE_FLOAT_ACCUMULATING_SUM(half, DefaultTraversal)
+EIGEN_MAKE_FLOAT_ACCUMULATING_SUM(half, LinearVectorizedTraversal)
+EIGEN_MAKE_FLOAT_ACCUMULATING_SUM(half, SliceVectorizedTraversal)
+EIGEN_MAKE_FLOAT_ACCUMULATING_SUM(bfloat16, DefaultTraversal)
+EIGEN_MAKE_FLOAT_ACCUMULATING_SUM(bfloat16, LinearVectorizedTraversal)
+EIGEN_MAKE_FLOAT_ACCUMULATING_SUM(bfloat16, SliceVectorizedTraversal)
+
+#undef EIGEN_MAKE_FLOAT_ACCUMULATING_SUM
+
 // evaluator adaptor
 template<typename _XprType>
 class redux_evaluator
@@ -390,6 +485,180 @@ protected:
   const XprType &m_xpr;
 };
 
+#if (defined EIGEN_PARALLEL_REDUX_THRESHOLD) && !(defined __CUDA_ARCH__)
+
+/* Multi-threaded reductions, enabled by defining EIGEN_PARALLEL_REDUX_THRESHOLD:
+ * The coefficients are split into chunks of about redux_chunk_size coefficients whose bounds only depend on the
+ * sizes of the expression. Each chunk is reduced by the usual vectorized redux_impl, the chunks being distributed
+ * over the threads, and the partial results are then combined along a fixed pairwise tree. The result is thus
+ * bit-identical whatever the number of threads.
+ */
+enum { redux_chunk_size = 16384 };
+
+// range [start,start+size) of the coefficients of a redux_evaluator with linear access, seen as a column vector
+template<typename Evaluator>
+class redux_linear_range_evaluator
+{
+public:
+  typedef typename Evaluator::XprType XprType;
+  typedef typename Evaluator::Scalar Scalar;
+  typedef typename Evaluator::CoeffReturnType CoeffReturnType;
+  typedef typename Evaluator::PacketScalar PacketScalar;
+  typedef typename Evaluator::PacketReturnType PacketReturnType;
+
+  enum {
+    MaxRowsAtCompileTime = Dynamic,
+    MaxColsAtCompileTime = 1,
+    Flags = Evaluator::Flags & ~RowMajorBit,
+    IsRowMajor = 0,
+    SizeAtCompileTime = Dynamic,
+    InnerSizeAtCompileTime = Dynamic,
+    CoeffReadCost = Evaluator::CoeffReadCost
+  };
+
+  redux_linear_range_evaluator(const Evaluator& eval, Index start, Index size)
+    : m_eval(eval), m_start(start), m_size(size)
+  {}
+
+  Index rows() const { return m_size; }
+  Index cols() const { return 1; }
+  Index size() const { return m_size; }
+  Index innerSize() const { return m_size; }
+  Index outerSize() const { return 1; }
+
+  CoeffReturnType coeff(Index row, Index) const { return m_eval.coeff(m_start+row); }
+  CoeffReturnType coeff(Index index) const { return m_eval.coeff(m_start+index); }
+  CoeffReturnType coeffByOuterInner(Index, Index inner) const { return m_eval.coeff(m_start+inner); }
+
+  template<int LoadMode> PacketReturnType packet(Index row, Index) const { return m_eval.template packet<LoadMode>(m_start+row); }
+  template<int LoadMode> PacketReturnType packet(Index index) const { return m_eval.template packet<LoadMode>(m_start+index); }
+  template<int LoadMode> PacketReturnType packetByOuterInner(Index, Index inner) const { return m_eval.template packet<LoadMode>(m_start+inner); }
+
+protected:
+  const Evaluator& m_eval;
+  Index m_start, m_size;
+};
+
+// outer vectors [start,start+outerSize) of a redux_evaluator
+template<typename Evaluator>
+class redux_outer_range_evaluator
+{
+public:
+  typedef typename Evaluator::XprType XprType;
+  typedef typename Evaluator::Scalar Scalar;
+  typedef typename Evaluator::CoeffReturnType CoeffReturnType;
+  typedef typename Evaluator::PacketScalar PacketScalar;
+  typedef typename Evaluator::PacketReturnType PacketReturnType;
+
+  enum {
+    IsRowMajor = Evaluator::IsRowMajor,
+    MaxRowsAtCompileTime = IsRowMajor ? Dynamic : int(Evaluator::MaxRowsAtCompileTime),
+    MaxColsAtCompileTime = IsRowMajor ? int(Evaluator::MaxColsAtCompileTime) : Dynamic,
+    Flags = Evaluator::Flags & ~LinearAccessBit,
+    SizeAtCompileTime = Dynamic,
+    InnerSizeAtCompileTime = Evaluator::InnerSizeAtCompileTime,
+    CoeffReadCost = Evaluator::CoeffReadCost
+  };
+
+  redux_outer_range_evaluator(const Evaluator& eval, Index start, Index outerSize)
+    : m_eval(eval), m_start(start), m_outerSize(outerSize)
+  {}
+
+  Index rows() const { return IsRowMajor ? m_outerSize : m_eval.rows(); }
+  Index cols() const { return IsRowMajor ? m_eval.cols() : m_outerSize; }
+  Index size() const { return m_outerSize * m_eval.innerSize(); }
+  Index innerSize() const { return m_eval.innerSize(); }
+  Index outerSize() const { return m_outerSize; }
+
+  CoeffReturnType coeff(Index row, Index col) const
+  { return m_eval.coeff(IsRowMajor ? m_start+row : row, IsRowMajor ? col : m_start+col); }
+  CoeffReturnType coeffByOuterInner(Index outer, Index inner) const
+  { return m_eval.coeffByOuterInner(m_start+outer, inner); }
+
+  template<int LoadMode> PacketReturnType packet(Index row, Index col) const
+  { return m_eval.template packet<LoadMode>(IsRowMajor ? m_start+row : row, IsRowMajor ? col : m_start+col); }
+  template<int LoadMode> PacketReturnType packetByOuterInner(Index outer, Index inner) const
+  { return m_eval.template packetByOuterInner<LoadMode>(m_start+outer, inner); }
+
+protected:
+  const Evaluator& m_eval;
+  Index m_start, m_outerSize;
+};
+
+// reduces the chunks [start,start+length) into partials
+template<typename Func, typename Evaluator, bool LinearAccess = (int(Evaluator::Flags)&LinearAccessBit)!=0>
+struct redux_chunks
+{
+  typedef typename Evaluator::Scalar Scalar;
+  typedef redux_linear_range_evaluator<Evaluator> ChunkEvaluator;
+
+  redux_chunks(const Evaluator& eval, const Func& func) : m_eval(eval), m_func(func), m_partials(0) {}
+
+  Index count() const { return (m_eval.size() + redux_chunk_size - 1) / redux_chunk_size; }
+
+  void operator()(Index start, Index length) const
+  {
+    for(Index c = start; c < start+length; ++c)
+    {
+      Index first = c * redux_chunk_size;
+      ChunkEvaluator chunk(m_eval, first, (std::min)(Index(redux_chunk_size), m_eval.size()-first));
+      m_partials[c] = redux_impl<Func, ChunkEvaluator>::run(chunk, m_func);
+    }
+  }
+
+  const Evaluator& m_eval;
+  const Func& m_func;
+  Scalar* m_partials;
+};
+
+template<typename Func, typename Evaluator>
+struct redux_chunks<Func, Evaluator, false>
+{
+  typedef typename Evaluator::Scalar Scalar;
+  typedef redux_outer_range_evaluator<Evaluator> ChunkEvaluator;
+
+  redux_chunks(const Evaluator& eval, const Func& func)
+    : m_eval(eval), m_func(func), m_partials(0),
+      m_chunkOuterSize((std::max)(Index(1), Index(redux_chunk_size) / eval.innerSize()))
+  {}
+
+  Index count() const { return (m_eval.outerSize() + m_chunkOuterSize - 1) / m_chunkOuterSize; }
+
+  void operator()(Index start, Index length) const
+  {
+    for(Index c = start; c < start+length; ++c)
+    {
+      Index first = c * m_chunkOuterSize;
+      ChunkEvaluator chunk(m_eval, first, (std::min)(m_chunkOuterSize, m_eval.outerSize()-first));
+      m_partials[c] = redux_impl<Func, ChunkEvaluator>::run(chunk, m_func);
+    }
+  }
+
+  const Evaluator& m_eval;
+  const Func& m_func;
+  Scalar* m_partials;
+  Index m_chunkOuterSize;
+};
+
+template<typename Func, typename Evaluator>
+typename Evaluator::Scalar parallel_redux(const Evaluator& eval, const Func& func)
+{
+  typedef typename Evaluator::Scalar Scalar;
+  redux_chunks<Func, Evaluator> chunks(eval, func);
+  const Index count = chunks.count();
+  ei_declare_aligned_stack_constructed_variable(Scalar, partials, count, 0);
+  chunks.m_partials = partials;
+  parallelize_range(chunks, count, Index(1), Index(1));
+
+  // pairwise tree, which only depends on the number of chunks
+  for(Index stride = 1; stride < count; stride *= 2)
+    for(Index i = 0; i+stride < count; i += 2*stride)
+      partials[i] = func(partials[i], partials[i+stride]);
+  return partials[0];
+}
+
+#endif // EIGEN_PARALLEL_REDUX_THRESHOLD
+
 } // end namespace internal
 
 /***************************************************************************
@@ -424,6 +693,11 @@ DenseBase<Derived>::redux(const Func& func) const
   typedef typename internal::redux_evaluator<Derived> ThisEvaluator;
   ThisEvaluator thisEval(derived());
   
+#if (defined EIGEN_PARALLEL_REDUX_THRESHOLD) && !(defined __CUDA_ARCH__)
+  if(SizeAtCompileTime==Dynamic && this->size() >= Index(EIGEN_PARALLEL_REDUX_THRESHOLD))
+    return internal::parallel_redux(thisEval, func);
+#endif
+
   return internal::redux_impl<Func, ThisEvaluator>::run(thisEval, func);
 }
 
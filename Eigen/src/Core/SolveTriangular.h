@@ -84,22 +84,47 @@ struct triangular_solver_selector<Lhs,Rhs,Side,Mode,NoUnrolling,Dynamic>
   typedef typename Rhs::Scalar Scalar;
   typedef blas_traits<Lhs> LhsProductTraits;
   typedef typename LhsProductTraits::DirectLinearAccessType ActualLhsType;
+  typedef typename internal::add_const_on_value_type<ActualLhsType>::type ActualLhsRef;
 
-  static void run(const Lhs& lhs, Rhs& rhs)
+  // Solves for the columns (resp. rows) [start,start+length) of rhs when the triangular matrix is on the left (resp. right).
+  // These panels of the right hand side are independent, so that they can be processed by different threads.
+  struct panel_solver
   {
-    typename internal::add_const_on_value_type<ActualLhsType>::type actualLhs = LhsProductTraits::extract(lhs);
+    panel_solver(ActualLhsRef lhs, Rhs& rhs) : m_lhs(lhs), m_rhs(rhs) {}
 
-    const Index size = lhs.rows();
-    const Index othersize = Side==OnTheLeft? rhs.cols() : rhs.rows();
+    void operator()(Index start, Index length) const
+    {
+      typedef internal::gemm_blocking_space<(Rhs::Flags&RowMajorBit) ? RowMajor : ColMajor,Scalar,Scalar,
+                Rhs::MaxRowsAtCompileTime, Rhs::MaxColsAtCompileTime, Lhs::MaxRowsAtCompileTime,4> BlockingType;
+
+      const Index size = m_lhs.rows();
+      BlockingType blocking(Side==OnTheLeft ? m_rhs.rows() : length, Side==OnTheLeft ? length : m_rhs.cols(), size, 1, false);
 
-    typedef internal::gemm_blocking_space<(Rhs::Flags&RowMajorBit) ? RowMajor : ColMajor,Scalar,Scalar,
-              Rhs::MaxRowsAtCompileTime, Rhs::MaxColsAtCompileTime, Lhs::MaxRowsAtCompileTime,4> BlockingType;
+      triangular_solve_matrix<Scalar,Index,Side,Mode,LhsProductTraits::NeedToConjugate,(int(Lhs::Flags) & RowMajorBit) ? RowMajor : ColMajor,
+                                 (Rhs::Flags&RowMajorBit) ? RowMajor : ColMajor>
+        ::run(size, length, &m_lhs.coeffRef(0,0), m_lhs.outerStride(),
+              Side==OnTheLeft ? &m_rhs.coeffRef(0,start) : &m_rhs.coeffRef(start,0), m_rhs.outerStride(), blocking);
+    }
 
-    BlockingType blocking(rhs.rows(), rhs.cols(), size, 1, false);
+    ActualLhsRef m_lhs;
+    Rhs& m_rhs;
+  };
+
+  static void run(const Lhs& lhs, Rhs& rhs)
+  {
+    ActualLhsRef actualLhs = LhsProductTraits::extract(lhs);
+
+    const Index othersize = Side==OnTheLeft? rhs.cols() : rhs.rows();
+    enum {
+      OtherMaxSize = Side==OnTheLeft ? Rhs::MaxColsAtCompileTime : Rhs::MaxRowsAtCompileTime,
+      Parallelizable = OtherMaxSize==Dynamic || OtherMaxSize>32
+    };
 
-    triangular_solve_matrix<Scalar,Index,Side,Mode,LhsProductTraits::NeedToConjugate,(int(Lhs::Flags) & RowMajorBit) ? RowMajor : ColMajor,
-                               (Rhs::Flags&RowMajorBit) ? RowMajor : ColMajor>
-      ::run(size, othersize, &actualLhs.coeffRef(0,0), actualLhs.outerStride(), &rhs.coeffRef(0,0), rhs.outerStride(), blocking);
+    panel_solver solver(actualLhs, rhs);
+    if(Parallelizable && lhs.rows()>=32)
+      internal::parallelize_range(solver, othersize, Index(gebp_traits<Scalar,Scalar>::nr), Index(32));
+    else
+      solver(0, othersize);
   }
 };
 
@@ -14,7 +14,7 @@ namespace Eigen {
 
 namespace internal {
 
-template<typename Visitor, typename Derived, int UnrollCount>
+template<typename Visitor, typename Derived, int UnrollCount, bool Vectorize = false>
 struct visitor_impl
 {
   enum {
@@ -52,6 +52,68 @@ struct visitor_impl<Visitor, Derived, Dynamic>
   }
 };
 
+/* Vectorized path for the visitors reducing the coefficients to a single one, like min_coeff_visitor:
+ * the coefficients of each column (or of a row vector) are processed by blocks of a few packets. Each block is
+ * reduced to its best coefficient with the packet operations of the visitor, and the block is handed to the
+ * visitor as a whole through this coefficient and the position of its first element. Since the visitor only keeps
+ * a strictly better coefficient, the retained block is the first one containing the result, which is then located
+ * by a final scan of this block only.
+ */
+template<typename Visitor, typename Derived>
+struct visitor_impl<Visitor, Derived, Dynamic, true>
+{
+  typedef typename Derived::Scalar Scalar;
+  typedef typename packet_traits<Scalar>::type Packet;
+  enum {
+    PacketSize = packet_traits<Scalar>::size,
+    BlockSize = 16 * PacketSize,
+    IsRowVector = Derived::RowsAtCompileTime==1
+  };
+
+  // the j-th inner vector is either a column, or the row vector itself
+  static inline Scalar coeff(const Derived& mat, Index i, Index j)
+  { return IsRowVector ? mat.coeff(0, i) : mat.coeff(i, j); }
+  static inline Packet packet(const Derived& mat, Index i, Index j)
+  { return IsRowVector ? mat.template packet<Unaligned>(0, i) : mat.template packet<Unaligned>(i, j); }
+
+  static inline void run(const Derived& mat, Visitor& visitor)
+  {
+    const Index innerSize = IsRowVector ? mat.cols() : mat.rows();
+    const Index outerSize = IsRowVector ? 1 : mat.cols();
+    const Index alignedEnd = (innerSize/PacketSize)*PacketSize;
+
+    visitor.init(mat.coeff(0,0), 0, 0);
+    for(Index j = 0; j < outerSize; ++j)
+    {
+      for(Index i = 0; i < alignedEnd; i += BlockSize)
+      {
+        const Index end = (std::min)(i+BlockSize, alignedEnd);
+        Packet best = packet(mat, i, j);
+        for(Index k = i+PacketSize; k < end; k += PacketSize)
+          best = visitor.packetOp(best, packet(mat, k, j));
+        visitor(visitor.predux(best), i, j);
+      }
+      for(Index i = alignedEnd; i < innerSize; ++i)
+        visitor(coeff(mat, i, j), i, j);
+    }
+
+    // locate the first coefficient of the retained block equal to the result,
+    // the visitor holding its inner and outer indices so far
+    const Index start = visitor.row;
+    const Index j = visitor.col;
+    const Index end = (std::min)(start+BlockSize, innerSize);
+    for(Index i = start; i < end; ++i)
+    {
+      Scalar value = coeff(mat, i, j);
+      if(value == visitor.res)
+      {
+        visitor.init(value, IsRowVector ? 0 : i, IsRowVector ? i : j);
+        break;
+      }
+    }
+  }
+};
+
 // evaluator adaptor
 template<typename XprType>
 class visitor_evaluator
@@ -64,7 +126,8 @@ public:
   
   enum {
     RowsAtCompileTime = XprType::RowsAtCompileTime,
-    CoeffReadCost = internal::evaluator<XprType>::CoeffReadCost
+    CoeffReadCost = internal::evaluator<XprType>::CoeffReadCost,
+    Flags = internal::evaluator<XprType>::Flags
   };
   
   Index rows() const { return m_xpr.rows(); }
@@ -73,6 +136,10 @@ public:
 
   CoeffReturnType coeff(Index row, Index col) const
   { return m_evaluator.coeff(row, col); }
+
+  template<int LoadMode>
+  typename packet_traits<Scalar>::type packet(Index row, Index col) const
+  { return m_evaluator.template packet<LoadMode>(row, col); }
   
 protected:
   typename internal::evaluator<XprType>::nestedType m_evaluator;
@@ -109,8 +176,15 @@ void DenseBase<Derived>::visit(Visitor& visitor) const
                 &&  (SizeAtCompileTime == 1 || internal::functor_traits<Visitor>::Cost != Dynamic)
                 &&  SizeAtCompileTime * ThisEvaluator::CoeffReadCost + (SizeAtCompileTime-1) * internal::functor_traits<Visitor>::Cost
                 <= EIGEN_UNROLLING_LIMIT };
+  // the coefficients of dynamic size expressions are visited by packets if the visitor supports it,
+  // and if they are stored along the columns, or form a row vector
+  enum { vectorize =  !unroll
+                &&  internal::functor_traits<Visitor>::PacketAccess
+                &&  internal::packet_traits<Scalar>::size > 1
+                &&  (ThisEvaluator::Flags & PacketAccessBit)
+                &&  (RowsAtCompileTime==1 ? (ThisEvaluator::Flags & RowMajorBit) : !(ThisEvaluator::Flags & RowMajorBit)) };
   return internal::visitor_impl<Visitor, ThisEvaluator,
-      unroll ? int(SizeAtCompileTime) : Dynamic
+      unroll ? int(SizeAtCompileTime) : Dynamic, bool(vectorize)
     >::run(thisEval, visitor);
 }
 
@@ -142,6 +216,10 @@ template <typename Derived>
 struct min_coeff_visitor : coeff_visitor<Derived>
 {
   typedef typename Derived::Scalar Scalar;
+  template<typename Packet>
+  Packet packetOp(const Packet& a, const Packet& b) const { return internal::pmin(a,b); }
+  template<typename Packet>
+  Scalar predux(const Packet& a) const { return internal::predux_min(a); }
   void operator() (const Scalar& value, Index i, Index j)
   {
     if(value < this->res)
@@ -153,10 +231,12 @@ struct min_coeff_visitor : coeff_visitor<Derived>
   }
 };
 
-template<typename Scalar>
-struct functor_traits<min_coeff_visitor<Scalar> > {
+template<typename Derived>
+struct functor_traits<min_coeff_visitor<Derived> > {
+  typedef typename Derived::Scalar Scalar;
   enum {
-    Cost = NumTraits<Scalar>::AddCost
+    Cost = NumTraits<Scalar>::AddCost,
+    PacketAccess = packet_traits<Scalar>::HasMin
   };
 };
 
@@ -169,6 +249,10 @@ template <typename Derived>
 struct max_coeff_visitor : coeff_visitor<Derived>
 {
   typedef typename Derived::Scalar Scalar;
+  template<typename Packet>
+  Packet packetOp(const Packet& a, const Packet& b) const { return internal::pmax(a,b); }
+  template<typename Packet>
+  Scalar predux(const Packet& a) const { return internal::predux_max(a); }
   void operator() (const Scalar& value, Index i, Index j)
   {
     if(value > this->res)
@@ -180,10 +264,12 @@ struct max_coeff_visitor : coeff_visitor<Derived>
   }
 };
 
-template<typename Scalar>
-struct functor_traits<max_coeff_visitor<Scalar> > {
+template<typename Derived>
+struct functor_traits<max_coeff_visitor<Derived> > {
+  typedef typename Derived::Scalar Scalar;
   enum {
-    Cost = NumTraits<Scalar>::AddCost
+    Cost = NumTraits<Scalar>::AddCost,
+    PacketAccess = packet_traits<Scalar>::HasMax
   };
 };
 
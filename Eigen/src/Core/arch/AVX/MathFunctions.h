@@ -433,6 +433,25 @@ Packet4d prsqrt<Packet4d>(const Packet4d& x) {
   return _mm256_div_pd(p4d_one, _mm256_sqrt_pd(x));
 }
 
+// Functions for doubles, implemented in terms of the packet primitives (see GenericPacketMathFunctions.h).
+template <> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED
+Packet4d plog<Packet4d>(const Packet4d& x) { return plog_double(x); }
+
+template <> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED
+Packet4d psin<Packet4d>(const Packet4d& x) { return psin_double(x); }
+
+template <> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED
+Packet4d pcos<Packet4d>(const Packet4d& x) { return pcos_double(x); }
+
+template <> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED
+Packet4d ptanh<Packet4d>(const Packet4d& x) { return ptanh_double(x); }
+
+template <> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED
+Packet4d perf<Packet4d>(const Packet4d& x) { return perf_double(x); }
+
+template <> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED
+Packet4d ppow<Packet4d>(const Packet4d& x, const Packet4d& y) { return ppow_double(x, y); }
+
 
 }  // end namespace internal
 
@@ -66,7 +66,8 @@ template<> struct packet_traits<float>  : default_packet_traits
     HasExp  = 1,
     HasSqrt = 1,
     HasRsqrt = 1,
-    HasBlend = 1
+    HasBlend = 1,
+    HasCmp = 1
   };
 };
 template<> struct packet_traits<double> : default_packet_traits
@@ -81,9 +82,16 @@ template<> struct packet_traits<double> : default_packet_traits
 
     HasDiv  = 1,
     HasExp  = 1,
+    HasLog  = 1,
+    HasPow  = 1,
+    HasErf  = 1,
+    HasSin  = 1,
+    HasCos  = 1,
+    HasTanh = 1,
     HasSqrt = 1,
     HasRsqrt = 1,
-    HasBlend = 1
+    HasBlend = 1,
+    HasCmp = 1
   };
 };
 
@@ -170,6 +178,11 @@ template<> EIGEN_STRONG_INLINE Packet4d pmadd(const Packet4d& a, const Packet4d&
 }
 #endif
 
+#ifdef EIGEN_VECTORIZE_AVX2
+template<> EIGEN_STRONG_INLINE Packet8i padd<Packet8i>(const Packet8i& a, const Packet8i& b) { return _mm256_add_epi32(a,b); }
+template<> EIGEN_STRONG_INLINE Packet8i pmadd_int16_pairs(const Packet8i& a, const Packet8i& b, const Packet8i& c) { return _mm256_add_epi32(_mm256_madd_epi16(a,b), c); }
+#endif
+
 template<> EIGEN_STRONG_INLINE Packet8f pmin<Packet8f>(const Packet8f& a, const Packet8f& b) { return _mm256_min_ps(a,b); }
 template<> EIGEN_STRONG_INLINE Packet4d pmin<Packet4d>(const Packet4d& a, const Packet4d& b) { return _mm256_min_pd(a,b); }
 
@@ -244,6 +257,15 @@ template<> EIGEN_DEVICE_FUNC inline Packet4d pgather<double, Packet4d>(const dou
 {
   return _mm256_set_pd(from[3*stride], from[2*stride], from[1*stride], from[0*stride]);
 }
+template<> EIGEN_DEVICE_FUNC inline Packet8f pgather<float, Packet8f, int>(const float* from, const int* indices)
+{
+  return _mm256_set_ps(from[indices[7]], from[indices[6]], from[indices[5]], from[indices[4]],
+                       from[indices[3]], from[indices[2]], from[indices[1]], from[indices[0]]);
+}
+template<> EIGEN_DEVICE_FUNC inline Packet4d pgather<double, Packet4d, int>(const double* from, const int* indices)
+{
+  return _mm256_set_pd(from[indices[3]], from[indices[2]], from[indices[1]], from[indices[0]]);
+}
 
 template<> EIGEN_DEVICE_FUNC inline void pscatter<float, Packet8f>(float* to, const Packet8f& from, Index stride)
 {
@@ -326,6 +348,25 @@ template<> EIGEN_STRONG_INLINE Packet4d pabs(const Packet4d& a)
   return _mm256_and_pd(a,mask);
 }
 
+template<> EIGEN_STRONG_INLINE Packet4d pfloor<Packet4d>(const Packet4d& a) { return _mm256_floor_pd(a); }
+
+// the exponents are handled by the SSE versions, AVX lacking the 256 bits integer shifts
+template<> EIGEN_STRONG_INLINE Packet4d pfrexp<Packet4d>(const Packet4d& a, Packet4d& exponent)
+{
+  Packet2d e_lo, e_hi;
+  const Packet2d lo = pfrexp(_mm256_castpd256_pd128(a), e_lo);
+  const Packet2d hi = pfrexp(_mm256_extractf128_pd(a, 1), e_hi);
+  exponent = _mm256_insertf128_pd(_mm256_castpd128_pd256(e_lo), e_hi, 1);
+  return _mm256_insertf128_pd(_mm256_castpd128_pd256(lo), hi, 1);
+}
+
+template<> EIGEN_STRONG_INLINE Packet4d pldexp<Packet4d>(const Packet4d& a, const Packet4d& exponent)
+{
+  const Packet2d lo = pldexp(_mm256_castpd256_pd128(a), _mm256_castpd256_pd128(exponent));
+  const Packet2d hi = pldexp(_mm256_extractf128_pd(a, 1), _mm256_extractf128_pd(exponent, 1));
+  return _mm256_insertf128_pd(_mm256_castpd128_pd256(lo), hi, 1);
+}
+
 // preduxp should be ok
 // FIXME: why is this ok? why isn't the simply implementation working as expected?
 template<> EIGEN_STRONG_INLINE Packet8f preduxp<Packet8f>(const Packet8f* vecs)
@@ -585,6 +626,211 @@ template<> EIGEN_STRONG_INLINE Packet4d pblend(const Selector<4>& ifPacket, cons
   return _mm256_blendv_pd(thenPacket, elsePacket, false_mask);
 }
 
+template<> EIGEN_STRONG_INLINE Packet8f pcmp_eq(const Packet8f& a, const Packet8f& b) { return _mm256_cmp_ps(a,b,_CMP_EQ_OQ); }
+template<> EIGEN_STRONG_INLINE Packet8f pcmp_neq(const Packet8f& a, const Packet8f& b) { return _mm256_cmp_ps(a,b,_CMP_NEQ_UQ); }
+template<> EIGEN_STRONG_INLINE Packet8f pcmp_lt(const Packet8f& a, const Packet8f& b) { return _mm256_cmp_ps(a,b,_CMP_LT_OQ); }
+template<> EIGEN_STRONG_INLINE Packet8f pcmp_le(const Packet8f& a, const Packet8f& b) { return _mm256_cmp_ps(a,b,_CMP_LE_OQ); }
+template<> EIGEN_STRONG_INLINE Packet4d pcmp_eq(const Packet4d& a, const Packet4d& b) { return _mm256_cmp_pd(a,b,_CMP_EQ_OQ); }
+template<> EIGEN_STRONG_INLINE Packet4d pcmp_neq(const Packet4d& a, const Packet4d& b) { return _mm256_cmp_pd(a,b,_CMP_NEQ_UQ); }
+template<> EIGEN_STRONG_INLINE Packet4d pcmp_lt(const Packet4d& a, const Packet4d& b) { return _mm256_cmp_pd(a,b,_CMP_LT_OQ); }
+template<> EIGEN_STRONG_INLINE Packet4d pcmp_le(const Packet4d& a, const Packet4d& b) { return _mm256_cmp_pd(a,b,_CMP_LE_OQ); }
+
+template<> EIGEN_STRONG_INLINE int pmovemask(const Packet8f& mask) { return _mm256_movemask_ps(mask); }
+template<> EIGEN_STRONG_INLINE int pmovemask(const Packet4d& mask) { return _mm256_movemask_pd(mask); }
+
+template<> EIGEN_STRONG_INLINE Packet8f pselect(const Packet8f& mask, const Packet8f& thenPacket, const Packet8f& elsePacket) {
+  // the mask is complete, and unlike blendv, this is not turned into lane-wise branches by some compilers
+  return _mm256_or_ps(_mm256_and_ps(mask, thenPacket), _mm256_andnot_ps(mask, elsePacket));
+}
+template<> EIGEN_STRONG_INLINE Packet4d pselect(const Packet4d& mask, const Packet4d& thenPacket, const Packet4d& elsePacket) {
+  // the mask is complete, and unlike blendv, this is not turned into lane-wise branches by some compilers
+  return _mm256_or_pd(_mm256_and_pd(mask, thenPacket), _mm256_andnot_pd(mask, elsePacket));
+}
+
+
+#ifdef EIGEN_VECTORIZE_F16C
+
+/* Packets of half precision scalars: the eight coefficients are stored in a SSE register, and converted on the fly
+ * to and from a Packet8f by the F16C instructions, the arithmetic being performed in single precision.
+ * The wrapper makes Packet8h a different type than Packet4i.
+ */
+struct Packet8h { __m128i x; };
+
+template<> struct is_arithmetic<Packet8h> { enum { value = true }; };
+
+template<> struct packet_traits<Eigen::half> : default_packet_traits
+{
+  typedef Packet8h type;
+  typedef Packet8h half;
+  enum {
+    Vectorizable = 1,
+    AlignedOnScalar = 1,
+    size = 8,
+    HasHalfPacket = 0,
+
+    HasDiv = 1,
+    HasSetLinear = 0
+  };
+};
+
+template<> struct unpacket_traits<Packet8h> { typedef Eigen::half type; typedef Packet8h half; enum {size=8}; };
+
+EIGEN_STRONG_INLINE Packet8f half2float(const Packet8h& a) { return _mm256_cvtph_ps(a.x); }
+EIGEN_STRONG_INLINE Packet8h float2half(const Packet8f& a)
+{
+  Packet8h res;
+  res.x = _mm256_cvtps_ph(a, _MM_FROUND_TO_NEAREST_INT);
+  return res;
+}
+EIGEN_STRONG_INLINE Packet8h make_packet8h(const __m128i& x)
+{
+  Packet8h res;
+  res.x = x;
+  return res;
+}
+
+template<> EIGEN_STRONG_INLINE Packet8h pset1<Packet8h>(const Eigen::half& from) { return make_packet8h(_mm_set1_epi16(from.x)); }
+
+template<> EIGEN_STRONG_INLINE Packet8h pload<Packet8h>(const Eigen::half* from) { EIGEN_DEBUG_ALIGNED_LOAD return make_packet8h(_mm_load_si128(reinterpret_cast<const __m128i*>(from))); }
+template<> EIGEN_STRONG_INLINE Packet8h ploadu<Packet8h>(const Eigen::half* from) { EIGEN_DEBUG_UNALIGNED_LOAD return make_packet8h(_mm_loadu_si128(reinterpret_cast<const __m128i*>(from))); }
+
+template<> EIGEN_STRONG_INLINE void pstore<Eigen::half>(Eigen::half* to, const Packet8h& from) { EIGEN_DEBUG_ALIGNED_STORE _mm_store_si128(reinterpret_cast<__m128i*>(to), from.x); }
+template<> EIGEN_STRONG_INLINE void pstoreu<Eigen::half>(Eigen::half* to, const Packet8h& from) { EIGEN_DEBUG_UNALIGNED_STORE _mm_storeu_si128(reinterpret_cast<__m128i*>(to), from.x); }
+
+template<> EIGEN_DEVICE_FUNC inline Packet8h pgather<Eigen::half, Packet8h>(const Eigen::half* from, Index stride)
+{
+  return make_packet8h(_mm_set_epi16(from[7*stride].x, from[6*stride].x, from[5*stride].x, from[4*stride].x,
+                                     from[3*stride].x, from[2*stride].x, from[1*stride].x, from[0*stride].x));
+}
+template<> EIGEN_DEVICE_FUNC inline void pscatter<Eigen::half, Packet8h>(Eigen::half* to, const Packet8h& from, Index stride)
+{
+  EIGEN_ALIGN16 Eigen::half values[8];
+  pstore(values, from);
+  for(Index i = 0; i < 8; ++i)
+    to[stride*i] = values[i];
+}
+
+template<> EIGEN_STRONG_INLINE Eigen::half pfirst<Packet8h>(const Packet8h& a) {
+  return Eigen::internal::raw_uint16_to_half(static_cast<unsigned short>(_mm_cvtsi128_si32(a.x)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8h padd<Packet8h>(const Packet8h& a, const Packet8h& b) { return float2half(_mm256_add_ps(half2float(a), half2float(b))); }
+template<> EIGEN_STRONG_INLINE Packet8h psub<Packet8h>(const Packet8h& a, const Packet8h& b) { return float2half(_mm256_sub_ps(half2float(a), half2float(b))); }
+template<> EIGEN_STRONG_INLINE Packet8h pmul<Packet8h>(const Packet8h& a, const Packet8h& b) { return float2half(_mm256_mul_ps(half2float(a), half2float(b))); }
+template<> EIGEN_STRONG_INLINE Packet8h pdiv<Packet8h>(const Packet8h& a, const Packet8h& b) { return float2half(_mm256_div_ps(half2float(a), half2float(b))); }
+template<> EIGEN_STRONG_INLINE Packet8h pmadd(const Packet8h& a, const Packet8h& b, const Packet8h& c) {
+  return float2half(pmadd(half2float(a), half2float(b), half2float(c)));
+}
+template<> EIGEN_STRONG_INLINE Packet8h pmin<Packet8h>(const Packet8h& a, const Packet8h& b) { return float2half(_mm256_min_ps(half2float(a), half2float(b))); }
+template<> EIGEN_STRONG_INLINE Packet8h pmax<Packet8h>(const Packet8h& a, const Packet8h& b) { return float2half(_mm256_max_ps(half2float(a), half2float(b))); }
+
+// the sign is handled on the bits, without conversions
+template<> EIGEN_STRONG_INLINE Packet8h pnegate(const Packet8h& a) { return make_packet8h(_mm_xor_si128(a.x, _mm_set1_epi16(short(0x8000)))); }
+template<> EIGEN_STRONG_INLINE Packet8h pabs(const Packet8h& a) { return make_packet8h(_mm_and_si128(a.x, _mm_set1_epi16(0x7fff))); }
+template<> EIGEN_STRONG_INLINE Packet8h pconj(const Packet8h& a) { return a; }
+
+template<> EIGEN_STRONG_INLINE Packet8h preverse(const Packet8h& a)
+{
+  return make_packet8h(_mm_shuffle_epi8(a.x, _mm_set_epi8(1,0,3,2,5,4,7,6,9,8,11,10,13,12,15,14)));
+}
+
+template<> EIGEN_STRONG_INLINE Eigen::half predux<Packet8h>(const Packet8h& a) { return Eigen::half(predux(half2float(a))); }
+template<> EIGEN_STRONG_INLINE Eigen::half predux_mul<Packet8h>(const Packet8h& a) { return Eigen::half(predux_mul(half2float(a))); }
+template<> EIGEN_STRONG_INLINE Eigen::half predux_min<Packet8h>(const Packet8h& a) { return Eigen::half(predux_min(half2float(a))); }
+template<> EIGEN_STRONG_INLINE Eigen::half predux_max<Packet8h>(const Packet8h& a) { return Eigen::half(predux_max(half2float(a))); }
+
+#endif // EIGEN_VECTORIZE_F16C
+
+/* Packets of eight bfloat16 stored in a SSE register: they are unpacked to and packed from a Packet8f by 16 bits
+ * shifts of the two SSE halves of the latter, the arithmetic being performed in single precision.
+ */
+struct Packet8bf { __m128i x; };
+
+template<> struct is_arithmetic<Packet8bf> { enum { value = true }; };
+
+template<> struct packet_traits<Eigen::bfloat16> : default_packet_traits
+{
+  typedef Packet8bf type;
+  typedef Packet8bf half;
+  enum {
+    Vectorizable = 1,
+    AlignedOnScalar = 1,
+    size = 8,
+    HasHalfPacket = 0,
+
+    HasDiv = 1,
+    HasSetLinear = 0
+  };
+};
+
+template<> struct unpacket_traits<Packet8bf> { typedef Eigen::bfloat16 type; typedef Packet8bf half; enum {size=8}; };
+
+EIGEN_STRONG_INLINE Packet8bf make_packet8bf(const __m128i& x)
+{
+  Packet8bf res;
+  res.x = x;
+  return res;
+}
+EIGEN_STRONG_INLINE Packet8f bfloat162float(const Packet8bf& a)
+{
+  return _mm256_insertf128_ps(_mm256_castps128_ps256(pbfloat16_lo_to_float(a.x)), pbfloat16_hi_to_float(a.x), 1);
+}
+EIGEN_STRONG_INLINE Packet8bf float2bfloat16(const Packet8f& a)
+{
+  return make_packet8bf(_mm_packs_epi32(pfloat_to_bfloat16_bits(_mm256_castps256_ps128(a)),
+                                        pfloat_to_bfloat16_bits(_mm256_extractf128_ps(a, 1))));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pset1<Packet8bf>(const Eigen::bfloat16& from) { return make_packet8bf(_mm_set1_epi16(from.x)); }
+
+template<> EIGEN_STRONG_INLINE Packet8bf pload<Packet8bf>(const Eigen::bfloat16* from) { EIGEN_DEBUG_ALIGNED_LOAD return make_packet8bf(_mm_load_si128(reinterpret_cast<const __m128i*>(from))); }
+template<> EIGEN_STRONG_INLINE Packet8bf ploadu<Packet8bf>(const Eigen::bfloat16* from) { EIGEN_DEBUG_UNALIGNED_LOAD return make_packet8bf(_mm_loadu_si128(reinterpret_cast<const __m128i*>(from))); }
+
+template<> EIGEN_STRONG_INLINE void pstore<Eigen::bfloat16>(Eigen::bfloat16* to, const Packet8bf& from) { EIGEN_DEBUG_ALIGNED_STORE _mm_store_si128(reinterpret_cast<__m128i*>(to), from.x); }
+template<> EIGEN_STRONG_INLINE void pstoreu<Eigen::bfloat16>(Eigen::bfloat16* to, const Packet8bf& from) { EIGEN_DEBUG_UNALIGNED_STORE _mm_storeu_si128(reinterpret_cast<__m128i*>(to), from.x); }
+
+template<> EIGEN_DEVICE_FUNC inline Packet8bf pgather<Eigen::bfloat16, Packet8bf>(const Eigen::bfloat16* from, Index stride)
+{
+  return make_packet8bf(_mm_set_epi16(from[7*stride].x, from[6*stride].x, from[5*stride].x, from[4*stride].x,
+                                      from[3*stride].x, from[2*stride].x, from[1*stride].x, from[0*stride].x));
+}
+template<> EIGEN_DEVICE_FUNC inline void pscatter<Eigen::bfloat16, Packet8bf>(Eigen::bfloat16* to, const Packet8bf& from, Index stride)
+{
+  EIGEN_ALIGN16 Eigen::bfloat16 values[8];
+  pstore(values, from);
+  for(Index i = 0; i < 8; ++i)
+    to[stride*i] = values[i];
+}
+
+template<> EIGEN_STRONG_INLINE Eigen::bfloat16 pfirst<Packet8bf>(const Packet8bf& a) {
+  return Eigen::internal::raw_uint16_to_bfloat16(static_cast<unsigned short>(_mm_cvtsi128_si32(a.x)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf padd<Packet8bf>(const Packet8bf& a, const Packet8bf& b) { return float2bfloat16(_mm256_add_ps(bfloat162float(a), bfloat162float(b))); }
+template<> EIGEN_STRONG_INLINE Packet8bf psub<Packet8bf>(const Packet8bf& a, const Packet8bf& b) { return float2bfloat16(_mm256_sub_ps(bfloat162float(a), bfloat162float(b))); }
+template<> EIGEN_STRONG_INLINE Packet8bf pmul<Packet8bf>(const Packet8bf& a, const Packet8bf& b) { return float2bfloat16(_mm256_mul_ps(bfloat162float(a), bfloat162float(b))); }
+template<> EIGEN_STRONG_INLINE Packet8bf pdiv<Packet8bf>(const Packet8bf& a, const Packet8bf& b) { return float2bfloat16(_mm256_div_ps(bfloat162float(a), bfloat162float(b))); }
+template<> EIGEN_STRONG_INLINE Packet8bf pmadd(const Packet8bf& a, const Packet8bf& b, const Packet8bf& c) {
+  return float2bfloat16(pmadd(bfloat162float(a), bfloat162float(b), bfloat162float(c)));
+}
+template<> EIGEN_STRONG_INLINE Packet8bf pmin<Packet8bf>(const Packet8bf& a, const Packet8bf& b) { return float2bfloat16(_mm256_min_ps(bfloat162float(a), bfloat162float(b))); }
+template<> EIGEN_STRONG_INLINE Packet8bf pmax<Packet8bf>(const Packet8bf& a, const Packet8bf& b) { return float2bfloat16(_mm256_max_ps(bfloat162float(a), bfloat162float(b))); }
+
+// the sign is handled on the bits, without conversions
+template<> EIGEN_STRONG_INLINE Packet8bf pnegate(const Packet8bf& a) { return make_packet8bf(_mm_xor_si128(a.x, _mm_set1_epi16(short(0x8000)))); }
+template<> EIGEN_STRONG_INLINE Packet8bf pabs(const Packet8bf& a) { return make_packet8bf(_mm_and_si128(a.x, _mm_set1_epi16(0x7fff))); }
+template<> EIGEN_STRONG_INLINE Packet8bf pconj(const Packet8bf& a) { return a; }
+
+template<> EIGEN_STRONG_INLINE Packet8bf preverse(const Packet8bf& a)
+{
+  return make_packet8bf(_mm_shuffle_epi8(a.x, _mm_set_epi8(1,0,3,2,5,4,7,6,9,8,11,10,13,12,15,14)));
+}
+
+template<> EIGEN_STRONG_INLINE Eigen::bfloat16 predux<Packet8bf>(const Packet8bf& a) { return Eigen::bfloat16(predux(bfloat162float(a))); }
+template<> EIGEN_STRONG_INLINE Eigen::bfloat16 predux_mul<Packet8bf>(const Packet8bf& a) { return Eigen::bfloat16(predux_mul(bfloat162float(a))); }
+template<> EIGEN_STRONG_INLINE Eigen::bfloat16 predux_min<Packet8bf>(const Packet8bf& a) { return Eigen::bfloat16(predux_min(bfloat162float(a))); }
+template<> EIGEN_STRONG_INLINE Eigen::bfloat16 predux_max<Packet8bf>(const Packet8bf& a) { return Eigen::bfloat16(predux_max(bfloat162float(a))); }
+
 } // end namespace internal
 
 } // end namespace Eigen
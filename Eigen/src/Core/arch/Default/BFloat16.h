@@ -0,0 +1,204 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_BFLOAT16_H
+#define EIGEN_BFLOAT16_H
+
+namespace Eigen {
+
+struct bfloat16;
+
+namespace internal {
+
+/* Conversions between single precision and bfloat16 floating point numbers:
+ * a bfloat16 is the upper half of the corresponding float, so that the conversions are 16 bits shifts,
+ * the lower half being rounded to nearest even. The NaNs are kept quiet.
+ */
+
+inline float bfloat16_to_float(unsigned short h)
+{
+  half_float_bits o;
+  o.u = static_cast<unsigned int>(h) << 16;
+  return o.f;
+}
+
+inline unsigned short float_to_bfloat16_rtne(float ff)
+{
+  half_float_bits f;
+  f.f = ff;
+  if((f.u & 0x7fffffffu) > 0x7f800000u)             // NaN
+    return static_cast<unsigned short>((f.u >> 16) | 0x0040u);
+  f.u += 0x7fffu + ((f.u >> 16) & 1u);              // rounding bias, the overflows giving infinities
+  return static_cast<unsigned short>(f.u >> 16);
+}
+
+inline bfloat16 raw_uint16_to_bfloat16(unsigned short x);
+
+} // end namespace internal
+
+/** \class bfloat16
+  * \ingroup Core_Module
+  *
+  * \brief Brain floating point scalar: the 16 upper bits of a single precision float
+  *
+  * This 16 bits scalar type has the range of a float, with a 8 bits significand. It halves the memory footprint
+  * and the bandwidth of large matrices, such as the weights of neural networks, and the conversions to and from
+  * float are mere shifts, which are vectorized with SSE and AVX.
+  *
+  * As for \ref half, this is a storage type: the arithmetic is performed in single precision, and the reductions
+  * such as sum() and the matrix products accumulate in single precision, rounding only the final results.
+  *
+  * Conversions from the built-in arithmetic types are explicit, while a bfloat16 implicitly converts to a float.
+  */
+struct bfloat16
+{
+  unsigned short x;
+
+  bfloat16() {}
+  explicit bfloat16(float f) : x(internal::float_to_bfloat16_rtne(f)) {}
+  template<typename T>
+  explicit bfloat16(const T& v) : x(internal::float_to_bfloat16_rtne(static_cast<float>(v))) {}
+
+  operator float() const { return internal::bfloat16_to_float(x); }
+
+  bfloat16& operator+=(const bfloat16& other) { *this = bfloat16(float(*this) + float(other)); return *this; }
+  bfloat16& operator-=(const bfloat16& other) { *this = bfloat16(float(*this) - float(other)); return *this; }
+  bfloat16& operator*=(const bfloat16& other) { *this = bfloat16(float(*this) * float(other)); return *this; }
+  bfloat16& operator/=(const bfloat16& other) { *this = bfloat16(float(*this) / float(other)); return *this; }
+};
+
+namespace internal {
+
+inline bfloat16 raw_uint16_to_bfloat16(unsigned short x)
+{
+  bfloat16 h;
+  h.x = x;
+  return h;
+}
+
+} // end namespace internal
+
+inline bfloat16 operator+(const bfloat16& a, const bfloat16& b) { return bfloat16(float(a) + float(b)); }
+inline bfloat16 operator-(const bfloat16& a, const bfloat16& b) { return bfloat16(float(a) - float(b)); }
+inline bfloat16 operator*(const bfloat16& a, const bfloat16& b) { return bfloat16(float(a) * float(b)); }
+inline bfloat16 operator/(const bfloat16& a, const bfloat16& b) { return bfloat16(float(a) / float(b)); }
+inline bfloat16 operator-(const bfloat16& a) { return internal::raw_uint16_to_bfloat16(a.x ^ 0x8000); }
+
+inline bool operator==(const bfloat16& a, const bfloat16& b) { return float(a) == float(b); }
+inline bool operator!=(const bfloat16& a, const bfloat16& b) { return float(a) != float(b); }
+inline bool operator< (const bfloat16& a, const bfloat16& b) { return float(a) <  float(b); }
+inline bool operator<=(const bfloat16& a, const bfloat16& b) { return float(a) <= float(b); }
+inline bool operator> (const bfloat16& a, const bfloat16& b) { return float(a) >  float(b); }
+inline bool operator>=(const bfloat16& a, const bfloat16& b) { return float(a) >= float(b); }
+
+inline bfloat16 abs(const bfloat16& a) { return internal::raw_uint16_to_bfloat16(a.x & 0x7fff); }
+inline bfloat16 sqrt(const bfloat16& a) { return bfloat16(std::sqrt(float(a))); }
+inline bfloat16 exp(const bfloat16& a) { return bfloat16(std::exp(float(a))); }
+inline bfloat16 log(const bfloat16& a) { return bfloat16(std::log(float(a))); }
+inline bfloat16 log10(const bfloat16& a) { return bfloat16(std::log10(float(a))); }
+inline bfloat16 pow(const bfloat16& a, const bfloat16& b) { return bfloat16(std::pow(float(a), float(b))); }
+inline bfloat16 sin(const bfloat16& a) { return bfloat16(std::sin(float(a))); }
+inline bfloat16 cos(const bfloat16& a) { return bfloat16(std::cos(float(a))); }
+inline bfloat16 tan(const bfloat16& a) { return bfloat16(std::tan(float(a))); }
+inline bfloat16 asin(const bfloat16& a) { return bfloat16(std::asin(float(a))); }
+inline bfloat16 acos(const bfloat16& a) { return bfloat16(std::acos(float(a))); }
+inline bfloat16 atan(const bfloat16& a) { return bfloat16(std::atan(float(a))); }
+inline bfloat16 sinh(const bfloat16& a) { return bfloat16(std::sinh(float(a))); }
+inline bfloat16 cosh(const bfloat16& a) { return bfloat16(std::cosh(float(a))); }
+inline bfloat16 tanh(const bfloat16& a) { return bfloat16(std::tanh(float(a))); }
+inline bfloat16 floor(const bfloat16& a) { return bfloat16(std::floor(float(a))); }
+inline bfloat16 ceil(const bfloat16& a) { return bfloat16(std::ceil(float(a))); }
+
+} // end namespace Eigen
+
+namespace std {
+
+template<>
+struct numeric_limits<Eigen::bfloat16>
+{
+  static const bool is_specialized = true;
+  static const bool is_signed = true;
+  static const bool is_integer = false;
+  static const bool is_exact = false;
+  static const bool has_infinity = true;
+  static const bool has_quiet_NaN = true;
+  static const bool has_signaling_NaN = true;
+  static const float_denorm_style has_denorm = denorm_present;
+  static const bool has_denorm_loss = false;
+  static const std::float_round_style round_style = std::round_to_nearest;
+  static const bool is_iec559 = false;
+  static const bool is_bounded = true;
+  static const bool is_modulo = false;
+  static const int digits = 8;
+  static const int digits10 = 2;
+  static const int radix = 2;
+  static const int min_exponent = -125;
+  static const int min_exponent10 = -37;
+  static const int max_exponent = 128;
+  static const int max_exponent10 = 38;
+  static const bool traps = false;
+  static const bool tinyness_before = false;
+
+  static Eigen::bfloat16 (min)() { return Eigen::internal::raw_uint16_to_bfloat16(0x0080); }
+  static Eigen::bfloat16 lowest() { return Eigen::internal::raw_uint16_to_bfloat16(0xff7f); }
+  static Eigen::bfloat16 (max)() { return Eigen::internal::raw_uint16_to_bfloat16(0x7f7f); }
+  static Eigen::bfloat16 epsilon() { return Eigen::internal::raw_uint16_to_bfloat16(0x3c00); }
+  static Eigen::bfloat16 round_error() { return Eigen::internal::raw_uint16_to_bfloat16(0x3f00); }
+  static Eigen::bfloat16 infinity() { return Eigen::internal::raw_uint16_to_bfloat16(0x7f80); }
+  static Eigen::bfloat16 quiet_NaN() { return Eigen::internal::raw_uint16_to_bfloat16(0x7fc0); }
+  static Eigen::bfloat16 signaling_NaN() { return Eigen::internal::raw_uint16_to_bfloat16(0x7fa0); }
+  static Eigen::bfloat16 denorm_min() { return Eigen::internal::raw_uint16_to_bfloat16(0x0001); }
+};
+
+} // end namespace std
+
+namespace Eigen {
+
+template<> struct NumTraits<bfloat16>
+  : GenericNumTraits<bfloat16>
+{
+  enum {
+    RequireInitialization = 0
+  };
+
+  static inline bfloat16 epsilon() { return internal::raw_uint16_to_bfloat16(0x3c00); }
+  static inline bfloat16 dummy_precision() { return bfloat16(5e-2f); }
+  static inline bfloat16 highest() { return internal::raw_uint16_to_bfloat16(0x7f7f); }
+  static inline bfloat16 lowest() { return internal::raw_uint16_to_bfloat16(0xff7f); }
+  static inline bfloat16 infinity() { return internal::raw_uint16_to_bfloat16(0x7f80); }
+  static inline bfloat16 quiet_NaN() { return internal::raw_uint16_to_bfloat16(0x7fc0); }
+};
+
+namespace internal {
+
+template<> struct random_impl<bfloat16>
+{
+  static inline bfloat16 run(const bfloat16& x, const bfloat16& y)
+  {
+    return bfloat16(random_impl<float>::run(float(x), float(y)));
+  }
+  static inline bfloat16 run()
+  {
+    return run(bfloat16(-1.f), bfloat16(1.f));
+  }
+};
+
+} // end namespace internal
+
+namespace numext {
+
+template<> inline bool (isnan)(const bfloat16& a) { return (a.x & 0x7fff) > 0x7f80; }
+template<> inline bool (isinf)(const bfloat16& a) { return (a.x & 0x7fff) == 0x7f80; }
+template<> inline bool (isfinite)(const bfloat16& a) { return (a.x & 0x7fff) < 0x7f80; }
+
+} // end namespace numext
+
+} // end namespace Eigen
+
+#endif // EIGEN_BFLOAT16_H
@@ -0,0 +1,313 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_GENERIC_PACKET_MATH_FUNCTIONS_H
+#define EIGEN_GENERIC_PACKET_MATH_FUNCTIONS_H
+
+/* Double precision transcendental functions written in terms of the packet primitives only (arithmetic, comparisons,
+ * pselect, pfloor, pfrexp and pldexp), so that the SIMD architectures providing these primitives for their packets
+ * of doubles only have to forward plog, psin, pcos, ptanh, ppow and perf to the following functions.
+ *
+ * The rational approximations are the ones of the cephes library, and the results are within a few ulps of the
+ * C library. The rare arguments the reductions cannot handle (huge arguments of sin and cos, special values and
+ * underflowing or overflowing results of pow) are delegated to the C library, coefficient by coefficient.
+ */
+
+namespace Eigen {
+
+namespace internal {
+
+// evaluates the polynomial coeff[0] x^(N-1) + ... + coeff[N-1] by the Horner scheme
+template<typename Packet, int N>
+EIGEN_STRONG_INLINE Packet ppolevl(const Packet& x, const double (&coeff)[N])
+{
+  Packet y = pset1<Packet>(coeff[0]);
+  for(int i=1; i<N; ++i)
+    y = pmadd(y, x, pset1<Packet>(coeff[i]));
+  return y;
+}
+
+// same as ppolevl, with an implicit leading coefficient equal to 1
+template<typename Packet, int N>
+EIGEN_STRONG_INLINE Packet pp1evl(const Packet& x, const double (&coeff)[N])
+{
+  Packet y = padd(x, pset1<Packet>(coeff[0]));
+  for(int i=1; i<N; ++i)
+    y = pmadd(y, x, pset1<Packet>(coeff[i]));
+  return y;
+}
+
+// hi + lo = a * b exactly
+template<typename Packet>
+EIGEN_STRONG_INLINE void ptwo_prod(const Packet& a, const Packet& b, Packet& hi, Packet& lo)
+{
+#ifdef EIGEN_VECTORIZE_FMA
+  // hi is computed by a fused multiply-add too, so that the compiler cannot contract it with the additions consuming it
+  hi = pmadd(a, b, pset1<Packet>(0.0));
+  lo = pmadd(a, b, pnegate(hi));
+#else
+  hi = pmul(a, b);
+  // Dekker's product, the operands being split into halves of 26 bits
+  const Packet split = pset1<Packet>(134217729.0);
+  Packet t = pmul(a, split);
+  const Packet a_hi = psub(t, psub(t, a));
+  const Packet a_lo = psub(a, a_hi);
+  t = pmul(b, split);
+  const Packet b_hi = psub(t, psub(t, b));
+  const Packet b_lo = psub(b, b_hi);
+  lo = padd(padd(padd(psub(pmul(a_hi, b_hi), hi), pmul(a_hi, b_lo)), pmul(a_lo, b_hi)), pmul(a_lo, b_lo));
+#endif
+}
+
+// hi + lo = a + b exactly
+template<typename Packet>
+EIGEN_STRONG_INLINE void ptwo_sum(const Packet& a, const Packet& b, Packet& hi, Packet& lo)
+{
+  hi = padd(a, b);
+  const Packet bb = psub(hi, a);
+  lo = padd(psub(a, psub(hi, bb)), psub(b, bb));
+}
+
+// hi + lo = a + b exactly, provided that |a| >= |b|; the outputs may alias the inputs
+template<typename Packet>
+EIGEN_STRONG_INLINE void pfast_two_sum(const Packet& a, const Packet& b, Packet& hi, Packet& lo)
+{
+  const Packet s = padd(a, b);
+  lo = psub(b, psub(s, a));
+  hi = s;
+}
+
+// recomputes the coefficients of res whose bit is set in mask by the scalar function func
+template<typename Packet, typename Func>
+Packet pscalar_fallback(int mask, const Packet& a, const Packet& res, Func func)
+{
+  typedef typename unpacket_traits<Packet>::type Scalar;
+  enum { Size = unpacket_traits<Packet>::size };
+  Scalar as[Size], rs[Size];
+  pstoreu(as, a);
+  pstoreu(rs, res);
+  for(int i=0; i<Size; ++i)
+    if(mask & (1<<i))
+      rs[i] = func(as[i]);
+  return ploadu<Packet>(rs);
+}
+
+template<typename Packet, typename Func>
+Packet pscalar_fallback(int mask, const Packet& a, const Packet& b, const Packet& res, Func func)
+{
+  typedef typename unpacket_traits<Packet>::type Scalar;
+  enum { Size = unpacket_traits<Packet>::size };
+  Scalar as[Size], bs[Size], rs[Size];
+  pstoreu(as, a);
+  pstoreu(bs, b);
+  pstoreu(rs, res);
+  for(int i=0; i<Size; ++i)
+    if(mask & (1<<i))
+      rs[i] = func(as[i], bs[i]);
+  return ploadu<Packet>(rs);
+}
+
+inline double std_sin(double x) { using std::sin; return sin(x); }
+inline double std_cos(double x) { using std::cos; return cos(x); }
+inline double std_pow(double x, double y) { using std::pow; return pow(x, y); }
+
+/** \internal \returns the natural logarithm of the doubles of \a _x, including the denormals and the special values */
+template<typename Packet>
+Packet plog_double(const Packet& _x)
+{
+  static const double P[] = { 1.01875663804580931796E-4, 4.97494994976747001425E-1, 4.70579119878881725854E0,
+                              1.44989225341610930846E1, 1.79368678507819816313E1, 7.70838733755885391666E0 };
+  static const double Q[] = { 1.12873587189167450590E1, 4.52279145837532221105E1, 8.29875266912776603211E1,
+                              7.11544750618563894466E1, 2.31251620126765340583E1 };
+  const Packet zero = pset1<Packet>(0.0);
+  const Packet one = pset1<Packet>(1.0);
+  const Packet inf = pset1<Packet>(std::numeric_limits<double>::infinity());
+
+  // the denormals are scaled by 2^54 to be normalized
+  const Packet denormal = pcmp_lt(_x, pset1<Packet>((std::numeric_limits<double>::min)()));
+  Packet x = pselect(denormal, pmul(_x, pset1<Packet>(18014398509481984.0)), _x);
+  Packet e;
+  x = pfrexp(x, e);
+  e = psub(e, pand(denormal, pset1<Packet>(54.0)));
+
+  // x = 2^e (1+f), with 1+f in [sqrt(1/2),sqrt(2))
+  const Packet small = pcmp_lt(x, pset1<Packet>(0.70710678118654752440));
+  e = psub(e, pand(small, one));
+  x = psub(padd(x, pand(small, x)), one);
+
+  // log(1+f) = f - f^2/2 + f^3 P(f)/Q(f), and log(2) = C1 + C2, e*C1 being exact
+  const Packet z = pmul(x, x);
+  Packet y = pmul(pmul(x, z), pdiv(ppolevl(x, P), pp1evl(x, Q)));
+  y = pmadd(e, pset1<Packet>(-2.121944400546905827679e-4), y);
+  y = psub(y, pmul(z, pset1<Packet>(0.5)));
+  Packet res = pmadd(e, pset1<Packet>(0.693359375), padd(x, y));
+
+  res = pselect(pcmp_eq(_x, inf), inf, res);
+  res = pselect(pcmp_eq(_x, zero), pnegate(inf), res);
+  // the negative numbers and the NaNs give NaN
+  return pselect(pcmp_le(zero, _x), res, pset1<Packet>(std::numeric_limits<double>::quiet_NaN()));
+}
+
+/** \internal \returns the sine (ComputeSine) or the cosine of the doubles of \a x */
+template<bool ComputeSine, typename Packet>
+Packet psincos_double(const Packet& x)
+{
+  static const double sincof[] = { 1.58962301576546568060E-10, -2.50507477628578072866E-8, 2.75573136213857245213E-6,
+                                   -1.98412698295895385996E-4, 8.33333333332211858878E-3, -1.66666666666666307295E-1 };
+  static const double coscof[] = { -1.13585365213876817300E-11, 2.08757008419747316778E-9, -2.75573141792967388112E-7,
+                                   2.48015872888517045348E-5, -1.38888888888730564116E-3, 4.16666666666665929218E-2 };
+  const Packet one = pset1<Packet>(1.0);
+  const Packet two = pset1<Packet>(2.0);
+
+  // x = q pi/2 + r, with q integral and r in [-pi/4,pi/4], pi/2 being split in three parts whose products by q are exact
+  Packet q = pfloor(pmadd(x, pset1<Packet>(0.63661977236758134308), pset1<Packet>(0.5)));
+  Packet r = pmadd(q, pset1<Packet>(-1.57079625129699707031), x);
+  r = pmadd(q, pset1<Packet>(-7.54978941586159635336E-8), r);
+  r = pmadd(q, pset1<Packet>(-5.39030285815811905290E-15), r);
+
+  // cos(x) = sin(x + pi/2), and the quadrant q mod 4 selects between +-sin(r) and +-cos(r)
+  if(!ComputeSine)
+    q = padd(q, one);
+  q = psub(q, pmul(pset1<Packet>(4.0), pfloor(pmul(q, pset1<Packet>(0.25)))));
+
+  const Packet z = pmul(r, r);
+  const Packet sin_r = pmadd(pmul(r, z), ppolevl(z, sincof), r);
+  const Packet cos_r = padd(psub(one, pmul(z, pset1<Packet>(0.5))), pmul(pmul(z, z), ppolevl(z, coscof)));
+  Packet res = pselect(por(pcmp_eq(q, one), pcmp_eq(q, pset1<Packet>(3.0))), cos_r, sin_r);
+  res = pselect(pcmp_le(two, q), pnegate(res), res);
+
+  // the reduction loses its accuracy beyond 1e8
+  const int huge = pmovemask(pcmp_lt(pset1<Packet>(1e8), pabs(x)));
+  if(huge)
+    res = pscalar_fallback(huge, x, res, ComputeSine ? std_sin : std_cos);
+  return res;
+}
+
+template<typename Packet> Packet psin_double(const Packet& x) { return psincos_double<true>(x); }
+template<typename Packet> Packet pcos_double(const Packet& x) { return psincos_double<false>(x); }
+
+/** \internal \returns the hyperbolic tangent of the doubles of \a x */
+template<typename Packet>
+Packet ptanh_double(const Packet& x)
+{
+  static const double P[] = { -9.64399179425052238628E-1, -9.92877231001918586564E1, -1.61468768441708447952E3 };
+  static const double Q[] = { 1.12811678491632931402E2, 2.23548839060100448583E3, 4.84406305325125486048E3 };
+  const Packet one = pset1<Packet>(1.0);
+  const Packet a = pabs(x);
+
+  // |x| < 0.625: tanh(x) = x + x^3 P(x^2)/Q(x^2)
+  const Packet z = pmul(x, x);
+  const Packet small = pmadd(pmul(x, z), pdiv(ppolevl(z, P), pp1evl(z, Q)), x);
+
+  // otherwise tanh(|x|) = 1 - 2/(exp(2|x|)+1), exp overflowing to infinity for the large arguments
+  Packet large = psub(one, pdiv(pset1<Packet>(2.0), padd(pexp(padd(a, a)), one)));
+  large = pselect(pcmp_lt(x, pset1<Packet>(0.0)), pnegate(large), large);
+
+  const Packet res = pselect(pcmp_lt(a, pset1<Packet>(0.625)), small, large);
+  return pselect(pcmp_eq(x, x), res, x);
+}
+
+/** \internal \returns the error function of the doubles of \a x */
+template<typename Packet>
+Packet perf_double(const Packet& x)
+{
+  static const double T[] = { 9.60497373987051638749E0, 9.00260197203842689217E1, 2.23200534594684319226E3,
+                              7.00332514112805075473E3, 5.55923013010394962768E4 };
+  static const double U[] = { 3.35617141647503099647E1, 5.21357949780152679795E2, 4.59432382970980127987E3,
+                              2.26290000613890934246E4, 4.92673942608635921086E4 };
+  static const double P[] = { 2.46196981473530512524E-10, 5.64189564831068821977E-1, 7.46321056442269912687E0,
+                              4.86371970985681366614E1, 1.96520832956077098242E2, 5.26445194995477358631E2,
+                              9.34528527171957607540E2, 1.02755188689515710272E3, 5.57535335369399327526E2 };
+  static const double Q[] = { 1.32281951154744992508E1, 8.67072140885989742329E1, 3.54937778887819891062E2,
+                              9.75708501743205489753E2, 1.82390916687909736289E3, 2.24633760818710981792E3,
+                              1.65666309194161350182E3, 5.57535340817727675546E2 };
+  const Packet one = pset1<Packet>(1.0);
+  const Packet a = pabs(x);
+
+  // |x| < 1: erf(x) = x T(x^2)/U(x^2)
+  const Packet z = pmul(x, x);
+  const Packet small = pdiv(pmul(x, ppolevl(z, T)), pp1evl(z, U));
+
+  // otherwise erf(|x|) = 1 - exp(-x^2) P(|x|)/Q(|x|), x^2 being a double-word and erf(6) rounding to 1
+  const Packet b = pmin(a, pset1<Packet>(6.0));
+  Packet b2_hi, b2_lo;
+  ptwo_prod(b, b, b2_hi, b2_lo);
+  const Packet e = pmul(pexp(pnegate(b2_hi)), psub(one, b2_lo));
+  Packet large = psub(one, pdiv(pmul(e, ppolevl(b, P)), pp1evl(b, Q)));
+  large = pselect(pcmp_lt(x, pset1<Packet>(0.0)), pnegate(large), large);
+
+  const Packet res = pselect(pcmp_lt(a, one), small, large);
+  return pselect(pcmp_eq(x, x), res, x);
+}
+
+/** \internal \returns the doubles of \a x raised to the powers \a y
+  *
+  * The logarithm of x is computed as a double-word, so that the error of y log(x) is smaller than the ulp of the
+  * result, which is obtained as exp(w_hi) (1 + w_lo). The negative, denormal and non-finite x, the huge or
+  * non-finite y, and the underflowing or overflowing results are computed by the C library.
+  */
+template<typename Packet>
+Packet ppow_double(const Packet& x, const Packet& y)
+{
+  // log(1+f) = 2s + s R(s^2), with s = f/(2+f)
+  static const double Lg[] = { 1.479819860511658591e-01, 1.531383769920937332e-01, 1.818357216161805012e-01,
+                               2.222219843214978396e-01, 2.857142874366239149e-01, 3.999999999940941908e-01,
+                               6.666666666666735130e-01 };
+  const Packet one = pset1<Packet>(1.0);
+  const Packet two = pset1<Packet>(2.0);
+
+  // x = 2^e (1+f), with 1+f in [sqrt(1/2),sqrt(2)), f being exact
+  Packet e;
+  Packet m = pfrexp(x, e);
+  const Packet small = pcmp_lt(m, pset1<Packet>(0.70710678118654752440));
+  e = psub(e, pand(small, one));
+  m = padd(m, pand(small, m));
+  const Packet f = psub(m, one);
+
+  // s = f/(2+f) as a double-word, 2+f being a double-word too
+  const Packet t_hi = padd(two, f);
+  const Packet t_lo = psub(f, psub(t_hi, two));
+  // s_lo being the exactly computed residual of s_hi divided by 2+f, a single division is needed
+  const Packet inv_t = pdiv(one, t_hi);
+  const Packet s_hi = pmul(f, inv_t);
+  Packet p_hi, p_lo;
+  ptwo_prod(s_hi, t_hi, p_hi, p_lo);
+  const Packet s_lo = pmul(psub(psub(psub(f, p_hi), p_lo), pmul(s_hi, t_lo)), inv_t);
+
+  // log(x) = e log(2) + 2s + s R(s^2), log(2) being split so that e*ln2_hi is exact
+  const Packet z = pmul(s_hi, s_hi);
+  Packet l_hi, l_lo;
+  ptwo_sum(pmul(e, pset1<Packet>(6.93147180369123816490e-01)), padd(s_hi, s_hi), l_hi, l_lo);
+  l_lo = padd(l_lo, padd(pmadd(e, pset1<Packet>(1.90821492927058770002e-10), padd(s_lo, s_lo)),
+                         pmul(s_hi, pmul(z, ppolevl(z, Lg)))));
+  pfast_two_sum(l_hi, l_lo, l_hi, l_lo);
+
+  // w = y log(x)
+  Packet w_hi, w_lo;
+  ptwo_prod(y, l_hi, w_hi, w_lo);
+  w_lo = pmadd(y, l_lo, w_lo);
+  pfast_two_sum(w_hi, w_lo, w_hi, w_lo);
+  Packet res = pmul(pexp(w_hi), padd(one, w_lo));
+
+  // the comparisons are false for the NaNs
+  const Packet valid = pand(pand(pcmp_le(pset1<Packet>((std::numeric_limits<double>::min)()), x),
+                                 pcmp_le(x, pset1<Packet>((std::numeric_limits<double>::max)()))),
+                            pand(pcmp_le(pabs(y), pset1<Packet>(1152921504606846976.0)),
+                                 pcmp_le(pabs(w_hi), pset1<Packet>(700.0))));
+  const int invalid = ~pmovemask(valid) & ((1 << unpacket_traits<Packet>::size) - 1);
+  if(invalid)
+    res = pscalar_fallback(invalid, x, y, res, std_pow);
+  return res;
+}
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_GENERIC_PACKET_MATH_FUNCTIONS_H
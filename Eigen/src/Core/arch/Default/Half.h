@@ -0,0 +1,250 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_HALF_H
+#define EIGEN_HALF_H
+
+namespace Eigen {
+
+struct half;
+
+namespace internal {
+
+/* Conversions between IEEE 754 single and half precision floating point numbers:
+ * the software versions handle denormals, infinities and NaNs, and round to nearest even as the F16C instructions do.
+ */
+
+union half_float_bits { unsigned int u; float f; };
+
+inline float half_to_float(unsigned short h)
+{
+#ifdef EIGEN_VECTORIZE_F16C
+  return _cvtsh_ss(h);
+#else
+  const half_float_bits magic = { 113u << 23 };
+  const unsigned int shifted_exp = 0x7c00u << 13;   // exponent mask after shift
+  half_float_bits o;
+  o.u = (h & 0x7fffu) << 13;                        // exponent and mantissa
+  unsigned int exp = shifted_exp & o.u;
+  o.u += (127u - 15u) << 23;                        // exponent adjustment
+  if(exp == shifted_exp)                            // Inf or NaN
+    o.u += (128u - 16u) << 23;
+  else if(exp == 0)                                 // zero or denormal, renormalized by the FPU
+  {
+    o.u += 1u << 23;
+    o.f -= magic.f;
+  }
+  o.u |= (h & 0x8000u) << 16;                       // sign
+  return o.f;
+#endif
+}
+
+inline unsigned short float_to_half_rtne(float ff)
+{
+#ifdef EIGEN_VECTORIZE_F16C
+  return static_cast<unsigned short>(_cvtss_sh(ff, 0));
+#else
+  const half_float_bits f32infty = { 255u << 23 };
+  const half_float_bits f16max = { (127u + 16u) << 23 };
+  const half_float_bits denorm_magic = { ((127u - 15u) + (23u - 10u) + 1u) << 23 };
+  half_float_bits f;
+  f.f = ff;
+  unsigned short o;
+  const unsigned int sign = f.u & 0x80000000u;
+  f.u ^= sign;
+
+  if(f.u >= f16max.u)                               // overflows to Inf, or NaN
+    o = (f.u > f32infty.u) ? 0x7e00 : 0x7c00;
+  else if(f.u < (113u << 23))                       // denormal or zero: the addition rounds the mantissa
+  {
+    f.f += denorm_magic.f;
+    o = static_cast<unsigned short>(f.u - denorm_magic.u);
+  }
+  else
+  {
+    const unsigned int mant_odd = (f.u >> 13) & 1u; // resulting mantissa is odd
+    f.u += 0xc8000fffu;                             // exponent adjustment ((15-127)<<23) and rounding bias
+    f.u += mant_odd;
+    o = static_cast<unsigned short>(f.u >> 13);
+  }
+  return static_cast<unsigned short>(o | (sign >> 16));
+#endif
+}
+
+inline half raw_uint16_to_half(unsigned short x);
+
+} // end namespace internal
+
+/** \class half
+  * \ingroup Core_Module
+  *
+  * \brief IEEE 754 half precision floating point scalar
+  *
+  * This 16 bits scalar type halves the memory footprint and the bandwidth of large matrices whose precision
+  * requirements are low. It is a storage type: the arithmetic operators convert their operands to float, and round
+  * the result back to half precision. On AVX processors supporting the F16C extension, the conversions are
+  * vectorized, eight coefficients at once.
+  *
+  * Moreover, the reductions such as sum() and the matrix products accumulate in single precision,
+  * rounding only the final results, so that their accuracy does not degrade with the size of the problem.
+  *
+  * Conversions from the built-in arithmetic types are explicit, while a half implicitly converts to a float:
+  * \code
+  * Matrix<half,Dynamic,Dynamic> A = MatrixXf::Random(n,n).cast<half>();
+  * float s = A.sum();
+  * \endcode
+  */
+struct half
+{
+  unsigned short x;
+
+  half() {}
+  explicit half(float f) : x(internal::float_to_half_rtne(f)) {}
+  template<typename T>
+  explicit half(const T& v) : x(internal::float_to_half_rtne(static_cast<float>(v))) {}
+
+  operator float() const { return internal::half_to_float(x); }
+
+  half& operator+=(const half& other) { *this = half(float(*this) + float(other)); return *this; }
+  half& operator-=(const half& other) { *this = half(float(*this) - float(other)); return *this; }
+  half& operator*=(const half& other) { *this = half(float(*this) * float(other)); return *this; }
+  half& operator/=(const half& other) { *this = half(float(*this) / float(other)); return *this; }
+};
+
+namespace internal {
+
+inline half raw_uint16_to_half(unsigned short x)
+{
+  half h;
+  h.x = x;
+  return h;
+}
+
+} // end namespace internal
+
+inline half operator+(const half& a, const half& b) { return half(float(a) + float(b)); }
+inline half operator-(const half& a, const half& b) { return half(float(a) - float(b)); }
+inline half operator*(const half& a, const half& b) { return half(float(a) * float(b)); }
+inline half operator/(const half& a, const half& b) { return half(float(a) / float(b)); }
+inline half operator-(const half& a) { return internal::raw_uint16_to_half(a.x ^ 0x8000); }
+
+inline bool operator==(const half& a, const half& b) { return float(a) == float(b); }
+inline bool operator!=(const half& a, const half& b) { return float(a) != float(b); }
+inline bool operator< (const half& a, const half& b) { return float(a) <  float(b); }
+inline bool operator<=(const half& a, const half& b) { return float(a) <= float(b); }
+inline bool operator> (const half& a, const half& b) { return float(a) >  float(b); }
+inline bool operator>=(const half& a, const half& b) { return float(a) >= float(b); }
+
+// The math functions are found by argument dependent lookup from the generic code,
+// which calls them after a using declaration of the standard ones.
+inline half abs(const half& a) { return internal::raw_uint16_to_half(a.x & 0x7fff); }
+inline half sqrt(const half& a) { return half(std::sqrt(float(a))); }
+inline half exp(const half& a) { return half(std::exp(float(a))); }
+inline half log(const half& a) { return half(std::log(float(a))); }
+inline half log10(const half& a) { return half(std::log10(float(a))); }
+inline half pow(const half& a, const half& b) { return half(std::pow(float(a), float(b))); }
+inline half sin(const half& a) { return half(std::sin(float(a))); }
+inline half cos(const half& a) { return half(std::cos(float(a))); }
+inline half tan(const half& a) { return half(std::tan(float(a))); }
+inline half asin(const half& a) { return half(std::asin(float(a))); }
+inline half acos(const half& a) { return half(std::acos(float(a))); }
+inline half atan(const half& a) { return half(std::atan(float(a))); }
+inline half sinh(const half& a) { return half(std::sinh(float(a))); }
+inline half cosh(const half& a) { return half(std::cosh(float(a))); }
+inline half tanh(const half& a) { return half(std::tanh(float(a))); }
+inline half floor(const half& a) { return half(std::floor(float(a))); }
+inline half ceil(const half& a) { return half(std::ceil(float(a))); }
+
+} // end namespace Eigen
+
+namespace std {
+
+template<>
+struct numeric_limits<Eigen::half>
+{
+  static const bool is_specialized = true;
+  static const bool is_signed = true;
+  static const bool is_integer = false;
+  static const bool is_exact = false;
+  static const bool has_infinity = true;
+  static const bool has_quiet_NaN = true;
+  static const bool has_signaling_NaN = true;
+  static const float_denorm_style has_denorm = denorm_present;
+  static const bool has_denorm_loss = false;
+  static const std::float_round_style round_style = std::round_to_nearest;
+  static const bool is_iec559 = true;
+  static const bool is_bounded = true;
+  static const bool is_modulo = false;
+  static const int digits = 11;
+  static const int digits10 = 3;
+  static const int radix = 2;
+  static const int min_exponent = -13;
+  static const int min_exponent10 = -4;
+  static const int max_exponent = 16;
+  static const int max_exponent10 = 4;
+  static const bool traps = false;
+  static const bool tinyness_before = false;
+
+  static Eigen::half (min)() { return Eigen::internal::raw_uint16_to_half(0x0400); }
+  static Eigen::half lowest() { return Eigen::internal::raw_uint16_to_half(0xfbff); }
+  static Eigen::half (max)() { return Eigen::internal::raw_uint16_to_half(0x7bff); }
+  static Eigen::half epsilon() { return Eigen::internal::raw_uint16_to_half(0x1400); }
+  static Eigen::half round_error() { return Eigen::internal::raw_uint16_to_half(0x3800); }
+  static Eigen::half infinity() { return Eigen::internal::raw_uint16_to_half(0x7c00); }
+  static Eigen::half quiet_NaN() { return Eigen::internal::raw_uint16_to_half(0x7e00); }
+  static Eigen::half signaling_NaN() { return Eigen::internal::raw_uint16_to_half(0x7d00); }
+  static Eigen::half denorm_min() { return Eigen::internal::raw_uint16_to_half(0x0001); }
+};
+
+} // end namespace std
+
+namespace Eigen {
+
+template<> struct NumTraits<half>
+  : GenericNumTraits<half>
+{
+  enum {
+    RequireInitialization = 0
+  };
+
+  static inline half epsilon() { return internal::raw_uint16_to_half(0x1400); }
+  static inline half dummy_precision() { return half(1e-2f); }
+  static inline half highest() { return internal::raw_uint16_to_half(0x7bff); }
+  static inline half lowest() { return internal::raw_uint16_to_half(0xfbff); }
+  static inline half infinity() { return internal::raw_uint16_to_half(0x7c00); }
+  static inline half quiet_NaN() { return internal::raw_uint16_to_half(0x7e00); }
+};
+
+namespace internal {
+
+template<> struct random_impl<half>
+{
+  static inline half run(const half& x, const half& y)
+  {
+    return half(random_impl<float>::run(float(x), float(y)));
+  }
+  static inline half run()
+  {
+    return run(half(-1.f), half(1.f));
+  }
+};
+
+} // end namespace internal
+
+namespace numext {
+
+template<> inline bool (isnan)(const half& a) { return (a.x & 0x7fff) > 0x7c00; }
+template<> inline bool (isinf)(const half& a) { return (a.x & 0x7fff) == 0x7c00; }
+template<> inline bool (isfinite)(const half& a) { return (a.x & 0x7fff) < 0x7c00; }
+
+} // end namespace numext
+
+} // end namespace Eigen
+
+#endif // EIGEN_HALF_H
@@ -109,7 +109,8 @@ template<> struct packet_traits<float>  : default_packet_traits
     HasExp  = 1,
     HasSqrt = 1,
     HasRsqrt = 1,
-    HasBlend = 1
+    HasBlend = 1,
+    HasCmp = 1
   };
 };
 template<> struct packet_traits<double> : default_packet_traits
@@ -124,9 +125,15 @@ template<> struct packet_traits<double> : default_packet_traits
 
     HasDiv  = 1,
     HasExp  = 1,
+    HasLog  = 1,
+    HasErf  = 1,
+    HasSin  = 1,
+    HasCos  = 1,
+    HasTanh = 1,
     HasSqrt = 1,
     HasRsqrt = 1,
-    HasBlend = 1
+    HasBlend = 1,
+    HasCmp = 1
   };
 };
 #endif
@@ -140,7 +147,8 @@ template<> struct packet_traits<int>    : default_packet_traits
     AlignedOnScalar = 1,
     size=4,
 
-    HasBlend = 1
+    HasBlend = 1,
+    HasCmp = 1
   };
 };
 
@@ -232,6 +240,7 @@ template<> EIGEN_STRONG_INLINE Packet4i pdiv<Packet4i>(const Packet4i& /*a*/, co
 
 // for some weird raisons, it has to be overloaded for packet of integers
 template<> EIGEN_STRONG_INLINE Packet4i pmadd(const Packet4i& a, const Packet4i& b, const Packet4i& c) { return padd(pmul(a,b), c); }
+template<> EIGEN_STRONG_INLINE Packet4i pmadd_int16_pairs(const Packet4i& a, const Packet4i& b, const Packet4i& c) { return _mm_add_epi32(_mm_madd_epi16(a,b), c); }
 #ifdef __FMA__
 template<> EIGEN_STRONG_INLINE Packet4f pmadd(const Packet4f& a, const Packet4f& b, const Packet4f& c) { return _mm_fmadd_ps(a,b,c); }
 template<> EIGEN_STRONG_INLINE Packet2d pmadd(const Packet2d& a, const Packet2d& b, const Packet2d& c) { return _mm_fmadd_pd(a,b,c); }
@@ -400,6 +409,14 @@ template<> EIGEN_DEVICE_FUNC inline Packet4i pgather<int, Packet4i>(const int* f
 {
  return _mm_set_epi32(from[3*stride], from[2*stride], from[1*stride], from[0*stride]);
  }
+template<> EIGEN_DEVICE_FUNC inline Packet4f pgather<float, Packet4f, int>(const float* from, const int* indices)
+{
+ return _mm_set_ps(from[indices[3]], from[indices[2]], from[indices[1]], from[indices[0]]);
+}
+template<> EIGEN_DEVICE_FUNC inline Packet2d pgather<double, Packet2d, int>(const double* from, const int* indices)
+{
+ return _mm_set_pd(from[indices[1]], from[indices[0]]);
+}
 
 template<> EIGEN_DEVICE_FUNC inline void pscatter<float, Packet4f>(float* to, const Packet4f& from, Index stride)
 {
@@ -508,6 +525,51 @@ template<> EIGEN_STRONG_INLINE Packet4i pabs(const Packet4i& a)
   #endif
 }
 
+template<> EIGEN_STRONG_INLINE Packet2d pfloor<Packet2d>(const Packet2d& a)
+{
+#ifdef EIGEN_VECTORIZE_SSE4_1
+  return _mm_floor_pd(a);
+#else
+  // the magic number 2^52 rounds the magnitudes to the nearest integers, the larger ones being already integral
+  const Packet2d limit = pset1<Packet2d>(4503599627370496.0);
+  const Packet2d abs_a = pabs(a);
+  Packet2d r = psub(padd(abs_a, limit), limit);
+  r = _mm_or_pd(r, _mm_xor_pd(a, abs_a));
+  r = psub(r, _mm_and_pd(_mm_cmplt_pd(a, r), pset1<Packet2d>(1.0)));
+  const Packet2d mask = _mm_cmplt_pd(abs_a, limit);
+  return _mm_or_pd(_mm_and_pd(mask, r), _mm_andnot_pd(mask, a));
+#endif
+}
+
+template<> EIGEN_STRONG_INLINE Packet2d pfrexp<Packet2d>(const Packet2d& a, Packet2d& exponent)
+{
+  const Packet2d exponent_mask = _mm_castsi128_pd(_mm_setr_epi32(0,0x7FF00000,0,0x7FF00000));
+  const Packet2d magic = pset1<Packet2d>(4503599627370496.0);
+  // the biased exponent is converted to a double by adding its bits to the ones of 2^52
+  const Packet4i biased = _mm_srli_epi64(_mm_castpd_si128(_mm_and_pd(a, exponent_mask)), 52);
+  exponent = psub(_mm_or_pd(_mm_castsi128_pd(biased), magic), pset1<Packet2d>(4503599627370496.0 + 1022.0));
+  return _mm_or_pd(_mm_andnot_pd(exponent_mask, a), pset1<Packet2d>(0.5));
+}
+
+// builds the powers of two 2^n, the integral exponents n being in [-1022,1023]
+EIGEN_STRONG_INLINE Packet2d ppower_of_two(const Packet2d& n)
+{
+  Packet4i e = _mm_add_epi32(_mm_cvtpd_epi32(n), _mm_set1_epi32(1023));
+  e = _mm_shuffle_epi32(e, _MM_SHUFFLE(3,1,2,0));
+  return _mm_castsi128_pd(_mm_slli_epi64(e, 52));
+}
+
+template<> EIGEN_STRONG_INLINE Packet2d pldexp<Packet2d>(const Packet2d& a, const Packet2d& exponent)
+{
+  // 2^e is split into 2^b * 2^b * 2^b * 2^(e-3b), with b = floor(e/4), so that each factor is a normalized number
+  const Packet2d max_exponent = pset1<Packet2d>(2099.0);
+  const Packet2d e = pmin(pmax(exponent, pnegate(max_exponent)), max_exponent);
+  const Packet2d b = pfloor(pmul(e, pset1<Packet2d>(0.25)));
+  const Packet2d c = ppower_of_two(b);
+  const Packet2d res = pmul(pmul(pmul(a, c), c), c);
+  return pmul(res, ppower_of_two(psub(e, pmul(pset1<Packet2d>(3.0), b))));
+}
+
 // with AVX, the default implementations based on pload1 are faster
 #ifndef __AVX__
 template<> EIGEN_STRONG_INLINE void
@@ -868,6 +930,147 @@ template<> EIGEN_STRONG_INLINE Packet2d pblend(const Selector<2>& ifPacket, cons
 #endif
 }
 
+template<> EIGEN_STRONG_INLINE Packet4f pcmp_eq(const Packet4f& a, const Packet4f& b) { return _mm_cmpeq_ps(a,b); }
+template<> EIGEN_STRONG_INLINE Packet4f pcmp_neq(const Packet4f& a, const Packet4f& b) { return _mm_cmpneq_ps(a,b); }
+template<> EIGEN_STRONG_INLINE Packet4f pcmp_lt(const Packet4f& a, const Packet4f& b) { return _mm_cmplt_ps(a,b); }
+template<> EIGEN_STRONG_INLINE Packet4f pcmp_le(const Packet4f& a, const Packet4f& b) { return _mm_cmple_ps(a,b); }
+template<> EIGEN_STRONG_INLINE Packet2d pcmp_eq(const Packet2d& a, const Packet2d& b) { return _mm_cmpeq_pd(a,b); }
+template<> EIGEN_STRONG_INLINE Packet2d pcmp_neq(const Packet2d& a, const Packet2d& b) { return _mm_cmpneq_pd(a,b); }
+template<> EIGEN_STRONG_INLINE Packet2d pcmp_lt(const Packet2d& a, const Packet2d& b) { return _mm_cmplt_pd(a,b); }
+template<> EIGEN_STRONG_INLINE Packet2d pcmp_le(const Packet2d& a, const Packet2d& b) { return _mm_cmple_pd(a,b); }
+template<> EIGEN_STRONG_INLINE Packet4i pcmp_eq(const Packet4i& a, const Packet4i& b) { return _mm_cmpeq_epi32(a,b); }
+template<> EIGEN_STRONG_INLINE Packet4i pcmp_neq(const Packet4i& a, const Packet4i& b) { return _mm_xor_si128(_mm_cmpeq_epi32(a,b), _mm_cmpeq_epi32(a,a)); }
+template<> EIGEN_STRONG_INLINE Packet4i pcmp_lt(const Packet4i& a, const Packet4i& b) { return _mm_cmplt_epi32(a,b); }
+template<> EIGEN_STRONG_INLINE Packet4i pcmp_le(const Packet4i& a, const Packet4i& b) { return _mm_or_si128(_mm_cmplt_epi32(a,b), _mm_cmpeq_epi32(a,b)); }
+
+template<> EIGEN_STRONG_INLINE int pmovemask(const Packet4f& mask) { return _mm_movemask_ps(mask); }
+template<> EIGEN_STRONG_INLINE int pmovemask(const Packet2d& mask) { return _mm_movemask_pd(mask); }
+template<> EIGEN_STRONG_INLINE int pmovemask(const Packet4i& mask) { return _mm_movemask_ps(_mm_castsi128_ps(mask)); }
+
+template<> EIGEN_STRONG_INLINE Packet4f pselect(const Packet4f& mask, const Packet4f& thenPacket, const Packet4f& elsePacket) {
+#ifdef EIGEN_VECTORIZE_SSE4_1
+  return _mm_blendv_ps(elsePacket, thenPacket, mask);
+#else
+  return _mm_or_ps(_mm_and_ps(mask, thenPacket), _mm_andnot_ps(mask, elsePacket));
+#endif
+}
+template<> EIGEN_STRONG_INLINE Packet2d pselect(const Packet2d& mask, const Packet2d& thenPacket, const Packet2d& elsePacket) {
+#ifdef EIGEN_VECTORIZE_SSE4_1
+  return _mm_blendv_pd(elsePacket, thenPacket, mask);
+#else
+  return _mm_or_pd(_mm_and_pd(mask, thenPacket), _mm_andnot_pd(mask, elsePacket));
+#endif
+}
+template<> EIGEN_STRONG_INLINE Packet4i pselect(const Packet4i& mask, const Packet4i& thenPacket, const Packet4i& elsePacket) {
+#ifdef EIGEN_VECTORIZE_SSE4_1
+  return _mm_blendv_epi8(elsePacket, thenPacket, mask);
+#else
+  return _mm_or_si128(_mm_and_si128(mask, thenPacket), _mm_andnot_si128(mask, elsePacket));
+#endif
+}
+
+/* bfloat16 <-> float conversions: a bfloat16 being the upper half of a float, the unpacking is a 16 bits shift.
+ * The packing rounds to nearest even and keeps the NaNs quiet. Its 16 bits results are sign extended in the
+ * 32 bits lanes, so that they are exactly packed by _mm_packs_epi32.
+ * They are shared by the packets of bfloat16 of SSE and AVX.
+ */
+EIGEN_STRONG_INLINE Packet4f pbfloat16_lo_to_float(const __m128i& a) { return _mm_castsi128_ps(_mm_unpacklo_epi16(_mm_setzero_si128(), a)); }
+EIGEN_STRONG_INLINE Packet4f pbfloat16_hi_to_float(const __m128i& a) { return _mm_castsi128_ps(_mm_unpackhi_epi16(_mm_setzero_si128(), a)); }
+EIGEN_STRONG_INLINE __m128i pfloat_to_bfloat16_bits(const Packet4f& a)
+{
+  const __m128i u = _mm_castps_si128(a);
+  const __m128i bias = _mm_add_epi32(_mm_and_si128(_mm_srli_epi32(u, 16), _mm_set1_epi32(1)), _mm_set1_epi32(0x7fff));
+  const __m128i rounded = _mm_srai_epi32(_mm_add_epi32(u, bias), 16);
+  const __m128i quiet_nan = _mm_or_si128(_mm_srai_epi32(u, 16), _mm_set1_epi32(0x0040));
+  const __m128i is_nan = _mm_castps_si128(_mm_cmpunord_ps(a, a));
+  return _mm_or_si128(_mm_and_si128(is_nan, quiet_nan), _mm_andnot_si128(is_nan, rounded));
+}
+
+#ifndef EIGEN_VECTORIZE_AVX
+
+/* Packets of four bfloat16 stored in the lower half of a SSE register, so that they are converted to and from
+ * a Packet4f, the arithmetic being performed in single precision.
+ * The wrapper makes Packet4bf a different type than Packet4i.
+ */
+struct Packet4bf { __m128i x; };
+
+template<> struct is_arithmetic<Packet4bf> { enum { value = true }; };
+
+template<> struct packet_traits<Eigen::bfloat16> : default_packet_traits
+{
+  typedef Packet4bf type;
+  typedef Packet4bf half;
+  enum {
+    Vectorizable = 1,
+    AlignedOnScalar = 1,
+    size = 4,
+    HasHalfPacket = 0,
+
+    HasDiv = 1,
+    HasSetLinear = 0
+  };
+};
+
+template<> struct unpacket_traits<Packet4bf> { typedef Eigen::bfloat16 type; typedef Packet4bf half; enum {size=4}; };
+
+EIGEN_STRONG_INLINE Packet4bf make_packet4bf(const __m128i& x)
+{
+  Packet4bf res;
+  res.x = x;
+  return res;
+}
+EIGEN_STRONG_INLINE Packet4f bfloat162float(const Packet4bf& a) { return pbfloat16_lo_to_float(a.x); }
+EIGEN_STRONG_INLINE Packet4bf float2bfloat16(const Packet4f& a) { return make_packet4bf(_mm_packs_epi32(pfloat_to_bfloat16_bits(a), _mm_setzero_si128())); }
+
+template<> EIGEN_STRONG_INLINE Packet4bf pset1<Packet4bf>(const Eigen::bfloat16& from) { return make_packet4bf(_mm_set1_epi16(from.x)); }
+
+// a packet spans 8 bytes, the loads and stores of which do not require any alignment
+template<> EIGEN_STRONG_INLINE Packet4bf pload<Packet4bf>(const Eigen::bfloat16* from) { EIGEN_DEBUG_ALIGNED_LOAD return make_packet4bf(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(from))); }
+template<> EIGEN_STRONG_INLINE Packet4bf ploadu<Packet4bf>(const Eigen::bfloat16* from) { EIGEN_DEBUG_UNALIGNED_LOAD return make_packet4bf(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(from))); }
+
+template<> EIGEN_STRONG_INLINE void pstore<Eigen::bfloat16>(Eigen::bfloat16* to, const Packet4bf& from) { EIGEN_DEBUG_ALIGNED_STORE _mm_storel_epi64(reinterpret_cast<__m128i*>(to), from.x); }
+template<> EIGEN_STRONG_INLINE void pstoreu<Eigen::bfloat16>(Eigen::bfloat16* to, const Packet4bf& from) { EIGEN_DEBUG_UNALIGNED_STORE _mm_storel_epi64(reinterpret_cast<__m128i*>(to), from.x); }
+
+template<> EIGEN_DEVICE_FUNC inline Packet4bf pgather<Eigen::bfloat16, Packet4bf>(const Eigen::bfloat16* from, Index stride)
+{
+  return make_packet4bf(_mm_set_epi16(0, 0, 0, 0, from[3*stride].x, from[2*stride].x, from[1*stride].x, from[0*stride].x));
+}
+template<> EIGEN_DEVICE_FUNC inline void pscatter<Eigen::bfloat16, Packet4bf>(Eigen::bfloat16* to, const Packet4bf& from, Index stride)
+{
+  EIGEN_ALIGN16 Eigen::bfloat16 values[8];
+  pstore(values, from);
+  for(Index i = 0; i < 4; ++i)
+    to[stride*i] = values[i];
+}
+
+template<> EIGEN_STRONG_INLINE Eigen::bfloat16 pfirst<Packet4bf>(const Packet4bf& a) {
+  return Eigen::internal::raw_uint16_to_bfloat16(static_cast<unsigned short>(_mm_cvtsi128_si32(a.x)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf padd<Packet4bf>(const Packet4bf& a, const Packet4bf& b) { return float2bfloat16(_mm_add_ps(bfloat162float(a), bfloat162float(b))); }
+template<> EIGEN_STRONG_INLINE Packet4bf psub<Packet4bf>(const Packet4bf& a, const Packet4bf& b) { return float2bfloat16(_mm_sub_ps(bfloat162float(a), bfloat162float(b))); }
+template<> EIGEN_STRONG_INLINE Packet4bf pmul<Packet4bf>(const Packet4bf& a, const Packet4bf& b) { return float2bfloat16(_mm_mul_ps(bfloat162float(a), bfloat162float(b))); }
+template<> EIGEN_STRONG_INLINE Packet4bf pdiv<Packet4bf>(const Packet4bf& a, const Packet4bf& b) { return float2bfloat16(_mm_div_ps(bfloat162float(a), bfloat162float(b))); }
+template<> EIGEN_STRONG_INLINE Packet4bf pmadd(const Packet4bf& a, const Packet4bf& b, const Packet4bf& c) {
+  return float2bfloat16(pmadd(bfloat162float(a), bfloat162float(b), bfloat162float(c)));
+}
+template<> EIGEN_STRONG_INLINE Packet4bf pmin<Packet4bf>(const Packet4bf& a, const Packet4bf& b) { return float2bfloat16(_mm_min_ps(bfloat162float(a), bfloat162float(b))); }
+template<> EIGEN_STRONG_INLINE Packet4bf pmax<Packet4bf>(const Packet4bf& a, const Packet4bf& b) { return float2bfloat16(_mm_max_ps(bfloat162float(a), bfloat162float(b))); }
+
+// the sign is handled on the bits, without conversions
+template<> EIGEN_STRONG_INLINE Packet4bf pnegate(const Packet4bf& a) { return make_packet4bf(_mm_xor_si128(a.x, _mm_set1_epi16(short(0x8000)))); }
+template<> EIGEN_STRONG_INLINE Packet4bf pabs(const Packet4bf& a) { return make_packet4bf(_mm_and_si128(a.x, _mm_set1_epi16(0x7fff))); }
+template<> EIGEN_STRONG_INLINE Packet4bf pconj(const Packet4bf& a) { return a; }
+
+template<> EIGEN_STRONG_INLINE Packet4bf preverse(const Packet4bf& a) { return make_packet4bf(_mm_shufflelo_epi16(a.x, 0x1B)); }
+
+template<> EIGEN_STRONG_INLINE Eigen::bfloat16 predux<Packet4bf>(const Packet4bf& a) { return Eigen::bfloat16(predux(bfloat162float(a))); }
+template<> EIGEN_STRONG_INLINE Eigen::bfloat16 predux_mul<Packet4bf>(const Packet4bf& a) { return Eigen::bfloat16(predux_mul(bfloat162float(a))); }
+template<> EIGEN_STRONG_INLINE Eigen::bfloat16 predux_min<Packet4bf>(const Packet4bf& a) { return Eigen::bfloat16(predux_min(bfloat162float(a))); }
+template<> EIGEN_STRONG_INLINE Eigen::bfloat16 predux_max<Packet4bf>(const Packet4bf& a) { return Eigen::bfloat16(predux_max(bfloat162float(a))); }
+
+#endif // EIGEN_VECTORIZE_AVX
+
 } // end namespace internal
 
 } // end namespace Eigen
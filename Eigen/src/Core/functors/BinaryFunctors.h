@@ -233,10 +233,12 @@ template<typename Scalar, typename OtherScalar> struct scalar_binary_pow_op {
   EIGEN_EMPTY_STRUCT_CTOR(scalar_binary_pow_op)
   EIGEN_DEVICE_FUNC
   inline Scalar operator() (const Scalar& a, const OtherScalar& b) const { return numext::pow(a, b); }
+  template<typename Packet>
+  inline Packet packetOp(const Packet& a, const Packet& b) const { return internal::ppow(a, b); }
 };
 template<typename Scalar, typename OtherScalar>
 struct functor_traits<scalar_binary_pow_op<Scalar,OtherScalar> > {
-  enum { Cost = 5 * NumTraits<Scalar>::MulCost, PacketAccess = false };
+  enum { Cost = 5 * NumTraits<Scalar>::MulCost, PacketAccess = is_same<Scalar,OtherScalar>::value && packet_traits<Scalar>::HasPow };
 };
 
 
@@ -481,11 +483,13 @@ struct scalar_pow_op {
   inline scalar_pow_op(const Scalar& exponent) : m_exponent(exponent) {}
   EIGEN_DEVICE_FUNC
   inline Scalar operator() (const Scalar& a) const { return numext::pow(a, m_exponent); }
+  template<typename Packet>
+  inline Packet packetOp(const Packet& a) const { return internal::ppow(a, pset1<Packet>(m_exponent)); }
   const Scalar m_exponent;
 };
 template<typename Scalar>
 struct functor_traits<scalar_pow_op<Scalar> >
-{ enum { Cost = 5 * NumTraits<Scalar>::MulCost, PacketAccess = false }; };
+{ enum { Cost = 5 * NumTraits<Scalar>::MulCost, PacketAccess = packet_traits<Scalar>::HasPow }; };
 
 /** \internal
   * \brief Template functor to compute the quotient between a scalar and array entries.
@@ -0,0 +1,338 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_FLOAT_ACCUMULATING_PRODUCT_H
+#define EIGEN_FLOAT_ACCUMULATING_PRODUCT_H
+
+namespace Eigen {
+
+namespace internal {
+
+/* Matrix products of 16 bits floating point scalars (half and bfloat16):
+ * The operands are converted by blocks to single precision, the blocks being multiplied by the float kernels,
+ * and the products are accumulated in single precision over the whole depth before being rounded once.
+ * The conversions of a mc x kc block are amortized over the kc x nc block of the rhs, so that the matrix products
+ * run at the speed of the float ones, while streaming half the data.
+ * The matrix-vector products accumulate the columns (or the dot products of the rows) in single precision.
+ */
+
+// Loads and stores of packets of scalars converted to floats, through pcast when the conversions are vectorized
+template<typename Scalar,
+         bool Vectorized = type_casting_traits<Scalar,float>::VectorizedCast && type_casting_traits<float,Scalar>::VectorizedCast>
+struct float_conversion_traits
+{
+  typedef float PacketFloat;
+  enum { PacketSize = 1 };
+  static EIGEN_STRONG_INLINE PacketFloat load(const Scalar* from) { return float(*from); }
+  static EIGEN_STRONG_INLINE void store(Scalar* to, const PacketFloat& from) { *to = Scalar(from); }
+};
+
+template<typename Scalar>
+struct float_conversion_traits<Scalar,true>
+{
+  typedef typename packet_traits<Scalar>::type PacketScalar;
+  typedef typename packet_traits<float>::type PacketFloat;
+  enum { PacketSize = packet_traits<float>::size };
+  static EIGEN_STRONG_INLINE PacketFloat load(const Scalar* from) { return pcast<PacketScalar,PacketFloat>(ploadu<PacketScalar>(from)); }
+  static EIGEN_STRONG_INLINE void store(Scalar* to, const PacketFloat& from) { pstoreu(to, pcast<PacketFloat,PacketScalar>(from)); }
+};
+
+// dst[i] = float(src[i]) for i in [0,size)
+template<typename Scalar>
+void convert_to_float(const Scalar* src, float* dst, Index size)
+{
+  typedef float_conversion_traits<Scalar> Conv;
+  Index i = 0;
+  for(; i+Conv::PacketSize<=size; i+=Conv::PacketSize)
+    pstoreu(dst+i, Conv::load(src+i));
+  for(; i<size; ++i)
+    dst[i] = float(src[i]);
+}
+
+// dst[i] += alpha * src[i] for i in [0,size), the sums being rounded once
+template<typename Scalar>
+void accumulate_from_float(const float* src, float alpha, Scalar* dst, Index size)
+{
+  typedef float_conversion_traits<Scalar> Conv;
+  typedef typename Conv::PacketFloat PacketFloat;
+  const PacketFloat palpha = pset1<PacketFloat>(alpha);
+  Index i = 0;
+  for(; i+Conv::PacketSize<=size; i+=Conv::PacketSize)
+    Conv::store(dst+i, pmadd(palpha, ploadu<PacketFloat>(src+i), Conv::load(dst+i)));
+  for(; i<size; ++i)
+    dst[i] = Scalar(float(dst[i]) + alpha*src[i]);
+}
+
+// converts the rows x cols block of a matrix to a packed float block having the same storage order
+template<typename Scalar, int StorageOrder>
+void convert_block_to_float(const Scalar* src, Index srcStride, float* dst, Index rows, Index cols)
+{
+  const Index outerSize = StorageOrder==ColMajor ? cols : rows;
+  const Index innerSize = StorageOrder==ColMajor ? rows : cols;
+  for(Index j=0; j<outerSize; ++j)
+    convert_to_float(src + j*srcStride, dst + j*innerSize, innerSize);
+}
+
+template<typename Scalar, typename Epilogue>
+EIGEN_STRONG_INLINE void float_gemm_apply_epilogue(const Epilogue& epilogue, Scalar* res, Index size, Index row, Index col)
+{
+  for(Index i=0; i<size; ++i)
+    res[i] = epilogue(res[i], row+i, col);
+}
+
+template<typename Scalar>
+EIGEN_STRONG_INLINE void float_gemm_apply_epilogue(const gemm_no_epilogue&, Scalar*, Index, Index, Index)
+{}
+
+/* C += alpha * A * B for a col-major result */
+template<typename Index, typename Scalar, int LhsStorageOrder, int RhsStorageOrder>
+struct float_accumulating_gemm
+{
+  typedef general_matrix_matrix_product<Index,float,LhsStorageOrder,false,float,RhsStorageOrder,false,ColMajor> FloatGemm;
+
+  template<typename Epilogue>
+  static void run(Index rows, Index cols, Index depth,
+                  const Scalar* _lhs, Index lhsStride,
+                  const Scalar* _rhs, Index rhsStride,
+                  Scalar* res, Index resStride,
+                  Scalar alpha,
+                  const Epilogue& epilogue, Index epilogueRow, Index epilogueCol)
+  {
+    const_blas_data_mapper<Scalar, Index, LhsStorageOrder> lhs(_lhs, lhsStride);
+    const_blas_data_mapper<Scalar, Index, RhsStorageOrder> rhs(_rhs, rhsStride);
+
+    // the float blocks are sized as the blocks of a float product, which thus runs on each of them at once
+    gemm_blocking_space<ColMajor,float,float,Dynamic,Dynamic,Dynamic> blocking(rows, cols, depth, 1, true);
+    const Index kc = blocking.kc();
+    const Index mc = (std::min)(rows,blocking.mc());
+    const Index nc = (std::min)(cols,blocking.nc());
+    blocking.allocateAll();
+
+    ei_declare_aligned_stack_constructed_variable(float, blockA, kc*mc, 0);
+    ei_declare_aligned_stack_constructed_variable(float, blockB, kc*nc, 0);
+    ei_declare_aligned_stack_constructed_variable(float, blockC, mc*nc, 0);
+
+    const float falpha = float(alpha);
+    const bool convert_rhs_once = depth<=kc;
+
+    for(Index j2=0; j2<cols; j2+=nc)
+    {
+      const Index actual_nc = (std::min)(j2+nc,cols)-j2;
+      if(convert_rhs_once)
+        convert_block_to_float<Scalar,RhsStorageOrder>(&rhs(0,j2), rhsStride, blockB, depth, actual_nc);
+
+      for(Index i2=0; i2<rows; i2+=mc)
+      {
+        const Index actual_mc = (std::min)(i2+mc,rows)-i2;
+        std::fill(blockC, blockC+actual_mc*actual_nc, 0.f);
+
+        // the whole depth is accumulated in single precision
+        for(Index k2=0; k2<depth; k2+=kc)
+        {
+          const Index actual_kc = (std::min)(k2+kc,depth)-k2;
+          convert_block_to_float<Scalar,LhsStorageOrder>(&lhs(i2,k2), lhsStride, blockA, actual_mc, actual_kc);
+          if(!convert_rhs_once)
+            convert_block_to_float<Scalar,RhsStorageOrder>(&rhs(k2,j2), rhsStride, blockB, actual_kc, actual_nc);
+          FloatGemm::run(actual_mc, actual_nc, actual_kc,
+                         blockA, LhsStorageOrder==ColMajor ? actual_mc : actual_kc,
+                         blockB, RhsStorageOrder==ColMajor ? actual_kc : actual_nc,
+                         blockC, actual_mc, 1.f, blocking);
+        }
+
+        for(Index j=0; j<actual_nc; ++j)
+        {
+          Scalar* r = res + i2 + (j2+j)*resStride;
+          accumulate_from_float(blockC + j*actual_mc, falpha, r, actual_mc);
+          float_gemm_apply_epilogue(epilogue, r, actual_mc, epilogueRow+i2, epilogueCol+j2+j);
+        }
+      }
+    }
+  }
+};
+
+/* res += alpha * A * x for a col-major matrix: the columns are accumulated four at once in a float buffer,
+ * by blocks of rows fitting in the L1 cache */
+template<typename Index, typename Scalar, typename LhsMapper, typename RhsMapper, int StorageOrder>
+struct float_accumulating_gemv
+{
+  enum { BlockRows = 4096 };
+
+  EIGEN_DONT_INLINE static void run(Index rows, Index cols, const LhsMapper& lhs, const RhsMapper& rhs,
+                                    Scalar* res, Index resIncr, Scalar alpha)
+  {
+    typedef float_conversion_traits<Scalar> Conv;
+    typedef typename Conv::PacketFloat PacketFloat;
+    enum { PacketSize = Conv::PacketSize };
+
+    ei_declare_aligned_stack_constructed_variable(float, x, cols, 0);
+    for(Index j=0; j<cols; ++j)
+      x[j] = float(rhs(j,0));
+
+    const Index blockRows = (std::min)(rows,Index(BlockRows));
+    ei_declare_aligned_stack_constructed_variable(float, y, blockRows, 0);
+    const Index peeledCols = (cols/4)*4;
+    for(Index i2=0; i2<rows; i2+=blockRows)
+    {
+      const Index actualRows = (std::min)(i2+blockRows,rows)-i2;
+      const Index peeledRows = (actualRows/PacketSize)*PacketSize;
+      std::fill(y, y+actualRows, 0.f);
+      for(Index j=0; j<peeledCols; j+=4)
+      {
+        const Scalar *a0 = &lhs(i2,j), *a1 = &lhs(i2,j+1), *a2 = &lhs(i2,j+2), *a3 = &lhs(i2,j+3);
+        const PacketFloat x0 = pset1<PacketFloat>(x[j]),   x1 = pset1<PacketFloat>(x[j+1]),
+                          x2 = pset1<PacketFloat>(x[j+2]), x3 = pset1<PacketFloat>(x[j+3]);
+        for(Index i=0; i<peeledRows; i+=PacketSize)
+        {
+          PacketFloat yi = pload<PacketFloat>(y+i);
+          yi = pmadd(Conv::load(a0+i), x0, yi);
+          yi = pmadd(Conv::load(a1+i), x1, yi);
+          yi = pmadd(Conv::load(a2+i), x2, yi);
+          yi = pmadd(Conv::load(a3+i), x3, yi);
+          pstore(y+i, yi);
+        }
+        for(Index i=peeledRows; i<actualRows; ++i)
+          y[i] += float(a0[i])*x[j] + float(a1[i])*x[j+1] + float(a2[i])*x[j+2] + float(a3[i])*x[j+3];
+      }
+      for(Index j=peeledCols; j<cols; ++j)
+      {
+        const Scalar *a0 = &lhs(i2,j);
+        const PacketFloat x0 = pset1<PacketFloat>(x[j]);
+        for(Index i=0; i<peeledRows; i+=PacketSize)
+          pstore(y+i, pmadd(Conv::load(a0+i), x0, pload<PacketFloat>(y+i)));
+        for(Index i=peeledRows; i<actualRows; ++i)
+          y[i] += float(a0[i])*x[j];
+      }
+
+      if(resIncr==1)
+        accumulate_from_float(y, float(alpha), res+i2, actualRows);
+      else
+        for(Index i=0; i<actualRows; ++i)
+          res[(i2+i)*resIncr] = Scalar(float(res[(i2+i)*resIncr]) + float(alpha)*y[i]);
+    }
+  }
+};
+
+/* res += alpha * A * x for a row-major matrix: the dot products of four rows are accumulated at once in float packets */
+template<typename Index, typename Scalar, typename LhsMapper, typename RhsMapper>
+struct float_accumulating_gemv<Index,Scalar,LhsMapper,RhsMapper,RowMajor>
+{
+  EIGEN_DONT_INLINE static void run(Index rows, Index cols, const LhsMapper& lhs, const RhsMapper& rhs,
+                                    Scalar* res, Index resIncr, Scalar alpha)
+  {
+    typedef float_conversion_traits<Scalar> Conv;
+    typedef typename Conv::PacketFloat PacketFloat;
+    enum { PacketSize = Conv::PacketSize };
+
+    ei_declare_aligned_stack_constructed_variable(float, x, cols, 0);
+    for(Index j=0; j<cols; ++j)
+      x[j] = float(rhs(j,0));
+
+    const Index peeledCols = (cols/PacketSize)*PacketSize;
+    const Index peeledRows = (rows/4)*4;
+    const float falpha = float(alpha);
+    for(Index i=0; i<peeledRows; i+=4)
+    {
+      const Scalar *a0 = &lhs(i,0), *a1 = &lhs(i+1,0), *a2 = &lhs(i+2,0), *a3 = &lhs(i+3,0);
+      PacketFloat acc0 = pset1<PacketFloat>(0.f), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+      for(Index j=0; j<peeledCols; j+=PacketSize)
+      {
+        const PacketFloat xj = pload<PacketFloat>(x+j);
+        acc0 = pmadd(Conv::load(a0+j), xj, acc0);
+        acc1 = pmadd(Conv::load(a1+j), xj, acc1);
+        acc2 = pmadd(Conv::load(a2+j), xj, acc2);
+        acc3 = pmadd(Conv::load(a3+j), xj, acc3);
+      }
+      float s0 = predux(acc0), s1 = predux(acc1), s2 = predux(acc2), s3 = predux(acc3);
+      for(Index j=peeledCols; j<cols; ++j)
+      {
+        s0 += float(a0[j])*x[j];
+        s1 += float(a1[j])*x[j];
+        s2 += float(a2[j])*x[j];
+        s3 += float(a3[j])*x[j];
+      }
+      res[(i+0)*resIncr] = Scalar(float(res[(i+0)*resIncr]) + falpha*s0);
+      res[(i+1)*resIncr] = Scalar(float(res[(i+1)*resIncr]) + falpha*s1);
+      res[(i+2)*resIncr] = Scalar(float(res[(i+2)*resIncr]) + falpha*s2);
+      res[(i+3)*resIncr] = Scalar(float(res[(i+3)*resIncr]) + falpha*s3);
+    }
+    for(Index i=peeledRows; i<rows; ++i)
+    {
+      const Scalar *a0 = &lhs(i,0);
+      PacketFloat acc0 = pset1<PacketFloat>(0.f);
+      for(Index j=0; j<peeledCols; j+=PacketSize)
+        acc0 = pmadd(Conv::load(a0+j), pload<PacketFloat>(x+j), acc0);
+      float s0 = predux(acc0);
+      for(Index j=peeledCols; j<cols; ++j)
+        s0 += float(a0[j])*x[j];
+      res[i*resIncr] = Scalar(float(res[i*resIncr]) + falpha*s0);
+    }
+  }
+};
+
+/*********************************************************************************
+*  Specializations of the product kernels for half and bfloat16
+**********************************************************************************/
+
+// the blocks of a multi-threaded matrix product are processed independently, so that info can be ignored
+#define EIGEN_MAKE_FLOAT_ACCUMULATING_PRODUCTS(SCALAR) \
+template<typename Index, int LhsStorageOrder, bool ConjugateLhs, int RhsStorageOrder, bool ConjugateRhs> \
+struct general_matrix_matrix_product<Index,SCALAR,LhsStorageOrder,ConjugateLhs,SCALAR,RhsStorageOrder,ConjugateRhs,ColMajor> \
+{ \
+  typedef gebp_traits<SCALAR,SCALAR> Traits; \
+  typedef float_accumulating_gemm<Index,SCALAR,LhsStorageOrder,RhsStorageOrder> Impl; \
+ \
+  static void run(Index rows, Index cols, Index depth, \
+                  const SCALAR* lhs, Index lhsStride, \
+                  const SCALAR* rhs, Index rhsStride, \
+                  SCALAR* res, Index resStride, \
+                  SCALAR alpha, \
+                  level3_blocking<SCALAR,SCALAR>& /*blocking*/, \
+                  GemmParallelInfo<Index>* /*info*/ = 0) \
+  { \
+    Impl::run(rows, cols, depth, lhs, lhsStride, rhs, rhsStride, res, resStride, alpha, gemm_no_epilogue(), 0, 0); \
+  } \
+ \
+  template<typename Epilogue> \
+  static void run(Index rows, Index cols, Index depth, \
+                  const SCALAR* lhs, Index lhsStride, \
+                  const SCALAR* rhs, Index rhsStride, \
+                  SCALAR* res, Index resStride, \
+                  SCALAR alpha, \
+                  level3_blocking<SCALAR,SCALAR>& /*blocking*/, \
+                  GemmParallelInfo<Index>* /*info*/, \
+                  const Epilogue& epilogue, Index epilogueRow, Index epilogueCol) \
+  { \
+    Impl::run(rows, cols, depth, lhs, lhsStride, rhs, rhsStride, res, resStride, alpha, epilogue, epilogueRow, epilogueCol); \
+  } \
+}; \
+ \
+template<typename Index, typename LhsMapper, bool ConjugateLhs, typename RhsMapper, bool ConjugateRhs, int Version> \
+struct general_matrix_vector_product<Index,SCALAR,LhsMapper,ColMajor,ConjugateLhs,SCALAR,RhsMapper,ConjugateRhs,Version> \
+  : float_accumulating_gemv<Index,SCALAR,LhsMapper,RhsMapper,ColMajor> \
+{ \
+  typedef SCALAR ResScalar; \
+}; \
+ \
+template<typename Index, typename LhsMapper, bool ConjugateLhs, typename RhsMapper, bool ConjugateRhs, int Version> \
+struct general_matrix_vector_product<Index,SCALAR,LhsMapper,RowMajor,ConjugateLhs,SCALAR,RhsMapper,ConjugateRhs,Version> \
+  : float_accumulating_gemv<Index,SCALAR,LhsMapper,RhsMapper,RowMajor> \
+{ \
+  typedef SCALAR ResScalar; \
+};
+
+EIGEN_MAKE_FLOAT_ACCUMULATING_PRODUCTS(half)
+EIGEN_MAKE_FLOAT_ACCUMULATING_PRODUCTS(bfloat16)
+
+#undef EIGEN_MAKE_FLOAT_ACCUMULATING_PRODUCTS
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_FLOAT_ACCUMULATING_PRODUCT_H
@@ -279,6 +279,256 @@ inline bool useSpecificBlockingSizes(Index& k, Index& m, Index& n)
   return false;
 }
 
+/** \internal Identifies the scalar types for which blocking sizes can be tabulated, 0 meaning not supported */
+template<typename LhsScalar, typename RhsScalar> struct blocking_sizes_scalar_id { enum { value = 0 }; };
+template<> struct blocking_sizes_scalar_id<float,float> { enum { value = 1 }; };
+template<> struct blocking_sizes_scalar_id<double,double> { enum { value = 2 }; };
+template<> struct blocking_sizes_scalar_id<std::complex<float>,std::complex<float> > { enum { value = 3 }; };
+template<> struct blocking_sizes_scalar_id<std::complex<double>,std::complex<double> > { enum { value = 4 }; };
+
+/** \internal \returns the name of the scalar type \a id in the blocking sizes files */
+inline const char* blocking_sizes_scalar_name(int id)
+{
+  static const char* names[] = { 0, "float", "double", "cfloat", "cdouble" };
+  return (id>0 && id<5) ? names[id] : 0;
+}
+
+/** \internal \returns the rounded base 2 logarithm of \a x, defining the size classes of the blocking sizes table */
+inline int blocking_sizes_size_class(Index x)
+{
+  int l = 0;
+  while((Index(2)<<l)<=x) ++l;
+  // round to the closest power of two
+  if(x-(Index(1)<<l) > (Index(2)<<l)-x) ++l;
+  return l;
+}
+
+/** \internal
+  * Table of blocking sizes measured on the target machine, indexed by the scalar type,
+  * the size class (i.e., the rounded log2) of the product dimensions, and the number of threads.
+  * It is filled by setProductBlockingSizes() or loadProductBlockingSizes(),
+  * and is used by computeProductBlockingSizes() in place of the cache size based heuristic.
+  *
+  * The text format has one entry per line, each entry being:
+  * \code <scalar> <threads> <k> <m> <n> <kc> <mc> <nc> \endcode
+  * where \c scalar is one of \c float, \c double, \c cfloat, \c cdouble, \c k, \c m, \c n are the
+  * power of two dimensions of the product, and \c kc, \c mc, \c nc are the respective blocking sizes.
+  * Empty lines and lines starting with \c # are ignored.
+  */
+class product_blocking_sizes_table
+{
+  public:
+    struct Entry
+    {
+      int scalar, threads;
+      int k, m, n;        // size classes
+      Index kc, mc, nc;
+    };
+
+    product_blocking_sizes_table() : m_entries(0), m_size(0), m_capacity(0) {}
+    ~product_blocking_sizes_table() { std::free(m_entries); }
+
+    static product_blocking_sizes_table& instance()
+    {
+      static product_blocking_sizes_table* table = create();
+      return *table;
+    }
+
+    Index size() const { return m_size; }
+    const Entry& entry(Index i) const { return m_entries[i]; }
+
+    void clear() { m_size = 0; }
+
+    /** Inserts \a e, or replaces the entry with the same scalar, threads and size classes */
+    void insert(const Entry& e)
+    {
+      Entry* existing = findExact(e.scalar, e.threads, e.k, e.m, e.n);
+      if(existing)
+      {
+        *existing = e;
+        return;
+      }
+      if(m_size==m_capacity)
+      {
+        Index capacity = (std::max<Index>)(16, 2*m_capacity);
+        Entry* entries = static_cast<Entry*>(std::realloc(m_entries, capacity*sizeof(Entry)));
+        if(entries==0)
+          throw_std_bad_alloc();
+        m_entries = entries;
+        m_capacity = capacity;
+      }
+      m_entries[m_size++] = e;
+    }
+
+    /** \returns the entry whose sizes are the closest to the given product, or a null pointer if there is
+      * no entry for this scalar type and number of threads whose size classes differ by at most one from the
+      * ones of the product in each dimension. The distance is measured between the size classes. */
+    const Entry* find(int scalar, Index threads, Index k, Index m, Index n) const
+    {
+      int kc = blocking_sizes_size_class(k), mc = blocking_sizes_size_class(m), nc = blocking_sizes_size_class(n);
+      const Entry* best = 0;
+      int bestDistance = 0;
+      for(Index i=0; i<m_size; ++i)
+      {
+        const Entry& e = m_entries[i];
+        if(e.scalar!=scalar || e.threads!=threads)
+          continue;
+        // the blocking sizes of a product of a much different shape are not relevant
+        if(std::abs(e.k-kc)>1 || std::abs(e.m-mc)>1 || std::abs(e.n-nc)>1)
+          continue;
+        int distance = std::abs(e.k-kc) + std::abs(e.m-mc) + std::abs(e.n-nc);
+        if(best==0 || distance<bestDistance)
+        {
+          best = &e;
+          bestDistance = distance;
+        }
+      }
+      return best;
+    }
+
+    /** Parses the entries of \a text and adds them to the table.
+      * \returns false if a line is ill-formed, in which case the following lines are ignored. */
+    bool parse(const char* text)
+    {
+      while(*text)
+      {
+        while(*text==' ' || *text=='\t' || *text=='\r' || *text=='\n') ++text;
+        if(*text=='\0')
+          break;
+        if(*text=='#')
+        {
+          while(*text && *text!='\n') ++text;
+          continue;
+        }
+
+        Entry e;
+        e.scalar = 0;
+        for(int id=1; blocking_sizes_scalar_name(id); ++id)
+        {
+          const char* name = blocking_sizes_scalar_name(id);
+          std::size_t len = std::strlen(name);
+          if(std::strncmp(text, name, len)==0 && (text[len]==' ' || text[len]=='\t'))
+          {
+            e.scalar = id;
+            text += len;
+            break;
+          }
+        }
+        if(e.scalar==0)
+          return false;
+
+        long values[7];
+        for(int i=0; i<7; ++i)
+        {
+          char* end;
+          values[i] = std::strtol(text, &end, 10);
+          if(end==text || values[i]<=0)
+            return false;
+          text = end;
+        }
+        e.threads = int(values[0]);
+        e.k = blocking_sizes_size_class(values[1]);
+        e.m = blocking_sizes_size_class(values[2]);
+        e.n = blocking_sizes_size_class(values[3]);
+        e.kc = values[4];
+        e.mc = values[5];
+        e.nc = values[6];
+        insert(e);
+      }
+      return true;
+    }
+
+  protected:
+    static product_blocking_sizes_table* create()
+    {
+      static product_blocking_sizes_table table;
+#ifdef EIGEN_PRODUCT_BLOCKING_SIZES_FILE
+      table.load(EIGEN_PRODUCT_BLOCKING_SIZES_FILE);
+#endif
+      return &table;
+    }
+
+  public:
+    /** Adds the entries of the file \a filename. \returns false if the file cannot be read or is ill-formed. */
+    bool load(const char* filename)
+    {
+      std::FILE* file = std::fopen(filename, "rb");
+      if(file==0)
+        return false;
+      std::fseek(file, 0, SEEK_END);
+      long length = std::ftell(file);
+      std::fseek(file, 0, SEEK_SET);
+      bool ok = length>=0;
+      if(ok)
+      {
+        char* text = static_cast<char*>(std::malloc(length+1));
+        ok = text!=0 && std::fread(text, 1, length, file)==std::size_t(length);
+        if(ok)
+        {
+          text[length] = '\0';
+          ok = parse(text);
+        }
+        std::free(text);
+      }
+      std::fclose(file);
+      return ok;
+    }
+
+    /** Writes the table to the file \a filename. \returns false on failure. */
+    bool save(const char* filename) const
+    {
+      std::FILE* file = std::fopen(filename, "w");
+      if(file==0)
+        return false;
+      std::fprintf(file, "# scalar threads k m n kc mc nc\n");
+      for(Index i=0; i<m_size; ++i)
+      {
+        const Entry& e = m_entries[i];
+        std::fprintf(file, "%s %d %ld %ld %ld %ld %ld %ld\n", blocking_sizes_scalar_name(e.scalar), e.threads,
+                     long(1)<<e.k, long(1)<<e.m, long(1)<<e.n, long(e.kc), long(e.mc), long(e.nc));
+      }
+      return std::fclose(file)==0;
+    }
+
+  protected:
+    Entry* findExact(int scalar, int threads, int k, int m, int n)
+    {
+      for(Index i=0; i<m_size; ++i)
+      {
+        Entry& e = m_entries[i];
+        if(e.scalar==scalar && e.threads==threads && e.k==k && e.m==m && e.n==n)
+          return &e;
+      }
+      return 0;
+    }
+
+    Entry* m_entries;
+    Index m_size;
+    Index m_capacity;
+
+  private:
+    product_blocking_sizes_table(const product_blocking_sizes_table&);
+    product_blocking_sizes_table& operator=(const product_blocking_sizes_table&);
+};
+
+template<typename LhsScalar, typename RhsScalar, int KcFactor>
+inline bool useTabulatedBlockingSizes(Index& k, Index& m, Index& n, Index num_threads)
+{
+  // the tabulated sizes are measured for the general matrix product only
+  enum { ScalarId = blocking_sizes_scalar_id<LhsScalar,RhsScalar>::value };
+  if(ScalarId==0 || KcFactor!=1)
+    return false;
+
+  const product_blocking_sizes_table::Entry* e
+    = product_blocking_sizes_table::instance().find(ScalarId, num_threads, k, m, n);
+  if(e==0)
+    return false;
+  k = std::min<Index>(k, e->kc);
+  m = std::min<Index>(m, e->mc);
+  n = std::min<Index>(n, e->nc);
+  return true;
+}
+
 /** \brief Computes the blocking parameters for a m x k times k x n matrix product
   *
   * \param[in,out] k Input: the third dimension of the product. Output: the blocking size along the same dimension.
@@ -291,6 +541,7 @@ inline bool useSpecificBlockingSizes(Index& k, Index& m, Index& n)
   *
   * The blocking size parameters may be evaluated:
   *   - either by a heuristic based on cache sizes;
+  *   - or from a table of sizes measured on the target machine, see loadProductBlockingSizes();
   *   - or using fixed prescribed values (for testing purposes).
   *
   * \sa setCpuCacheSizes */
@@ -298,7 +549,7 @@ inline bool useSpecificBlockingSizes(Index& k, Index& m, Index& n)
 template<typename LhsScalar, typename RhsScalar, int KcFactor>
 void computeProductBlockingSizes(Index& k, Index& m, Index& n, Index num_threads = 1)
 {
-  if (!useSpecificBlockingSizes(k, m, n)) {
+  if (!useSpecificBlockingSizes(k, m, n) && !useTabulatedBlockingSizes<LhsScalar,RhsScalar,KcFactor>(k, m, n, num_threads)) {
     evaluateProductBlockingSizesHeuristic<LhsScalar, RhsScalar, KcFactor>(k, m, n, num_threads);
   }
 
@@ -2233,6 +2484,60 @@ inline void setCpuCacheSizes(std::ptrdiff_t l1, std::ptrdiff_t l2, std::ptrdiff_
   internal::manage_caching_sizes(SetAction, &l1, &l2, &l3);
 }
 
+/** Sets the blocking sizes \a kc, \a mc, \a nc to be used for the products of \a Scalar matrices
+  * of size \a m x \a k times \a k x \a n running on \a threads threads.
+  * These blocking sizes then replace the ones estimated from the cache sizes for the products of similar sizes:
+  * each product uses the entry whose dimensions, rounded to powers of two, are the closest to its own,
+  * provided they differ by at most a factor of two in each dimension. The other products keep using the cache
+  * size based heuristic.
+  *
+  * Only \c float, \c double, \c std::complex<float> and \c std::complex<double> are supported.
+  * The table of blocking sizes is not thread-safe: it must be set up before calling Eigen from multiple threads.
+  *
+  * \sa loadProductBlockingSizes(), saveProductBlockingSizes(), clearProductBlockingSizes() */
+template<typename Scalar>
+inline void setProductBlockingSizes(Index k, Index m, Index n, Index threads, Index kc, Index mc, Index nc)
+{
+  EIGEN_STATIC_ASSERT((internal::blocking_sizes_scalar_id<Scalar,Scalar>::value!=0), YOU_MADE_A_PROGRAMMING_MISTAKE);
+  internal::product_blocking_sizes_table::Entry e;
+  e.scalar = internal::blocking_sizes_scalar_id<Scalar,Scalar>::value;
+  e.threads = int(threads);
+  e.k = internal::blocking_sizes_size_class(k);
+  e.m = internal::blocking_sizes_size_class(m);
+  e.n = internal::blocking_sizes_size_class(n);
+  e.kc = kc;
+  e.mc = mc;
+  e.nc = nc;
+  internal::product_blocking_sizes_table::instance().insert(e);
+}
+
+/** Adds the blocking sizes stored in the file \a filename to the table of blocking sizes, see setProductBlockingSizes().
+  * Such a file is generated by the \c autotune action of \c bench/benchmark-blocking-sizes.cpp.
+  *
+  * Alternatively, defining EIGEN_PRODUCT_BLOCKING_SIZES_FILE to the name of the file loads it on the first matrix product.
+  *
+  * \returns false if the file cannot be read or is ill-formed.
+  * \sa saveProductBlockingSizes(), setProductBlockingSizes() */
+inline bool loadProductBlockingSizes(const char* filename)
+{
+  return internal::product_blocking_sizes_table::instance().load(filename);
+}
+
+/** Writes the current table of blocking sizes to the file \a filename.
+  * \returns false on failure.
+  * \sa loadProductBlockingSizes(), setProductBlockingSizes() */
+inline bool saveProductBlockingSizes(const char* filename)
+{
+  return internal::product_blocking_sizes_table::instance().save(filename);
+}
+
+/** Removes all the entries of the table of blocking sizes, such that the blocking sizes are again estimated from the cache sizes.
+  * \sa setProductBlockingSizes() */
+inline void clearProductBlockingSizes()
+{
+  internal::product_blocking_sizes_table::instance().clear();
+}
+
 } // end namespace Eigen
 
 #endif // EIGEN_GENERAL_BLOCK_PANEL_H
@@ -63,13 +63,31 @@ static void run(Index rows, Index cols, Index depth,
   ResScalar alpha,
   level3_blocking<LhsScalar,RhsScalar>& blocking,
   GemmParallelInfo<Index>* info = 0)
+{
+  run(rows, cols, depth, _lhs, lhsStride, _rhs, rhsStride, _res, resStride, alpha, blocking, info, gemm_no_epilogue(), 0, 0);
+}
+
+// Same as above, but the result tiles of the last depth panel are written through the epilogue functor,
+// (epilogueRow,epilogueCol) being the position of _res in the whole result.
+template<typename Epilogue>
+static void run(Index rows, Index cols, Index depth,
+  const LhsScalar* _lhs, Index lhsStride,
+  const RhsScalar* _rhs, Index rhsStride,
+  ResScalar* _res, Index resStride,
+  ResScalar alpha,
+  level3_blocking<LhsScalar,RhsScalar>& blocking,
+  GemmParallelInfo<Index>* info,
+  const Epilogue& epilogue, Index epilogueRow, Index epilogueCol)
 {
   typedef const_blas_data_mapper<LhsScalar, Index, LhsStorageOrder> LhsMapper;
   typedef const_blas_data_mapper<RhsScalar, Index, RhsStorageOrder> RhsMapper;
   typedef blas_data_mapper<typename Traits::ResScalar, Index, ColMajor> ResMapper;
+  typedef gemm_epilogue_traits<typename Traits::ResScalar, Index, Epilogue> EpilogueTraits;
+  typedef typename EpilogueTraits::Mapper LastResMapper;
   LhsMapper lhs(_lhs,lhsStride);
   RhsMapper rhs(_rhs,rhsStride);
   ResMapper res(_res, resStride);
+  LastResMapper last_res = EpilogueTraits::mapper(_res, resStride, epilogueRow, epilogueCol, epilogue);
 
   Index kc = blocking.kc();                   // cache block size along the K direction
   Index mc = (std::min)(rows,blocking.mc());  // cache block size along the M direction
@@ -78,13 +96,15 @@ static void run(Index rows, Index cols, Index depth,
   gemm_pack_lhs<LhsScalar, Index, LhsMapper, Traits::mr, Traits::LhsProgress, LhsStorageOrder> pack_lhs;
   gemm_pack_rhs<RhsScalar, Index, RhsMapper, Traits::nr, RhsStorageOrder> pack_rhs;
   gebp_kernel<LhsScalar, RhsScalar, Index, ResMapper, Traits::mr, Traits::nr, ConjugateLhs, ConjugateRhs> gebp;
+  gebp_kernel<LhsScalar, RhsScalar, Index, LastResMapper, Traits::mr, Traits::nr, ConjugateLhs, ConjugateRhs> last_gebp;
 
-#ifdef EIGEN_HAS_OPENMP
+#ifdef EIGEN_HAS_PARALLELIZER
   if(info)
   {
     // this is the parallel version!
-    Index tid = omp_get_thread_num();
-    Index threads = omp_get_num_threads();
+    Index tid = info->logical_thread_id;
+    Index threads = info->num_threads;
+    GemmParallelTaskInfo<Index>* task_info = info->task_info;
     
     LhsScalar* blockA = blocking.blockA();
     eigen_internal_assert(blockA!=0);
@@ -96,6 +116,7 @@ static void run(Index rows, Index cols, Index depth,
     for(Index k=0; k<depth; k+=kc)
     {
       const Index actual_kc = (std::min)(k+kc,depth)-k; // => rows of B', and cols of the A'
+      const bool last = k+kc>=depth;
 
       // In order to reduce the chance that a thread has to wait for the other,
       // let's start by packing B'.
@@ -107,13 +128,13 @@ static void run(Index rows, Index cols, Index depth,
       // However, before copying to A'_i, we have to make sure that no other thread is still using it,
       // i.e., we test that info[tid].users equals 0.
       // Then, we set info[tid].users to the number of threads to mark that all other threads are going to use it.
-      while(info[tid].users!=0) {}
-      info[tid].users += threads;
+      while(task_info[tid].users!=0) {}
+      task_info[tid].users += threads;
 
-      pack_lhs(blockA+info[tid].lhs_start*actual_kc, lhs.getSubMapper(info[tid].lhs_start,k), actual_kc, info[tid].lhs_length);
+      pack_lhs(blockA+task_info[tid].lhs_start*actual_kc, lhs.getSubMapper(task_info[tid].lhs_start,k), actual_kc, task_info[tid].lhs_length);
 
       // Notify the other threads that the part A'_i is ready to go.
-      info[tid].sync = k;
+      task_info[tid].sync = k;
       
       // Computes C_i += A' * B' per A'_i
       for(Index shift=0; shift<threads; ++shift)
@@ -124,11 +145,14 @@ static void run(Index rows, Index cols, Index depth,
         // we use testAndSetOrdered to mimic a volatile access.
         // However, no need to wait for the B' part which has been updated by the current thread!
         if (shift>0) {
-          while(info[i].sync!=k) {
+          while(task_info[i].sync!=k) {
           }
         }
 
-        gebp(res.getSubMapper(info[i].lhs_start, 0), blockA+info[i].lhs_start*actual_kc, blockB, info[i].lhs_length, actual_kc, nc, alpha);
+        if(last)
+          last_gebp(last_res.getSubMapper(task_info[i].lhs_start, 0), blockA+task_info[i].lhs_start*actual_kc, blockB, task_info[i].lhs_length, actual_kc, nc, alpha);
+        else
+          gebp(res.getSubMapper(task_info[i].lhs_start, 0), blockA+task_info[i].lhs_start*actual_kc, blockB, task_info[i].lhs_length, actual_kc, nc, alpha);
       }
 
       // Then keep going as usual with the remaining B'
@@ -140,21 +164,29 @@ static void run(Index rows, Index cols, Index depth,
         pack_rhs(blockB, rhs.getSubMapper(k,j), actual_kc, actual_nc);
 
         // C_j += A' * B'
-        gebp(res.getSubMapper(0, j), blockA, blockB, rows, actual_kc, actual_nc, alpha);
+        if(last)
+          last_gebp(last_res.getSubMapper(0, j), blockA, blockB, rows, actual_kc, actual_nc, alpha);
+        else
+          gebp(res.getSubMapper(0, j), blockA, blockB, rows, actual_kc, actual_nc, alpha);
       }
 
       // Release all the sub blocks A'_i of A' for the current thread,
       // i.e., we simply decrement the number of users by 1
+#if EIGEN_HAS_CXX11_ATOMIC
+      for(Index i=0; i<threads; ++i)
+        --(task_info[i].users);
+#else
       #pragma omp critical
       {
       for(Index i=0; i<threads; ++i)
         #pragma omp atomic
-        --(info[i].users);
+        --(task_info[i].users);
       }
+#endif
     }
   }
   else
-#endif // EIGEN_HAS_OPENMP
+#endif // EIGEN_HAS_PARALLELIZER
   {
     EIGEN_UNUSED_VARIABLE(info);
 
@@ -194,7 +226,10 @@ static void run(Index rows, Index cols, Index depth,
             pack_rhs(blockB, rhs.getSubMapper(k2,j2), actual_kc, actual_nc);
           
           // Everything is packed, we can now call the panel * block kernel:
-          gebp(res.getSubMapper(i2, j2), blockA, blockB, actual_mc, actual_kc, actual_nc, alpha);
+          if(k2+kc>=depth)
+            last_gebp(last_res.getSubMapper(i2, j2), blockA, blockB, actual_mc, actual_kc, actual_nc, alpha);
+          else
+            gebp(res.getSubMapper(i2, j2), blockA, blockB, actual_mc, actual_kc, actual_nc, alpha);
         }
       }
     }
@@ -208,11 +243,13 @@ static void run(Index rows, Index cols, Index depth,
 *  implementation of the high level wrapper to general_matrix_matrix_product
 **********************************************************************************/
 
-template<typename Scalar, typename Index, typename Gemm, typename Lhs, typename Rhs, typename Dest, typename BlockingType>
+template<typename Scalar, typename Index, typename Gemm, typename Lhs, typename Rhs, typename Dest, typename BlockingType,
+         typename Epilogue = gemm_no_epilogue>
 struct gemm_functor
 {
-  gemm_functor(const Lhs& lhs, const Rhs& rhs, Dest& dest, const Scalar& actualAlpha, BlockingType& blocking)
-    : m_lhs(lhs), m_rhs(rhs), m_dest(dest), m_actualAlpha(actualAlpha), m_blocking(blocking)
+  gemm_functor(const Lhs& lhs, const Rhs& rhs, Dest& dest, const Scalar& actualAlpha, BlockingType& blocking,
+               const Epilogue& epilogue = Epilogue())
+    : m_lhs(lhs), m_rhs(rhs), m_dest(dest), m_actualAlpha(actualAlpha), m_blocking(blocking), m_epilogue(epilogue)
   {}
 
   void initParallelSession(Index num_threads) const
@@ -226,23 +263,40 @@ struct gemm_functor
     if(cols==-1)
       cols = m_rhs.cols();
 
-    Gemm::run(rows, cols, m_lhs.cols(),
-              &m_lhs.coeffRef(row,0), m_lhs.outerStride(),
-              &m_rhs.coeffRef(0,col), m_rhs.outerStride(),
-              (Scalar*)&(m_dest.coeffRef(row,col)), m_dest.outerStride(),
-              m_actualAlpha, m_blocking, info);
+    run(row, rows, col, cols, info, m_epilogue);
   }
   
   typedef typename Gemm::Traits Traits;
 
   protected:
+    void run(Index row, Index rows, Index col, Index cols, GemmParallelInfo<Index>* info, const gemm_no_epilogue&) const
+    {
+      Gemm::run(rows, cols, m_lhs.cols(),
+                &m_lhs.coeffRef(row,0), m_lhs.outerStride(),
+                &m_rhs.coeffRef(0,col), m_rhs.outerStride(),
+                (Scalar*)&(m_dest.coeffRef(row,col)), m_dest.outerStride(),
+                m_actualAlpha, m_blocking, info);
+    }
+
+    template<typename OtherEpilogue>
+    void run(Index row, Index rows, Index col, Index cols, GemmParallelInfo<Index>* info, const OtherEpilogue& epilogue) const
+    {
+      Gemm::run(rows, cols, m_lhs.cols(),
+                &m_lhs.coeffRef(row,0), m_lhs.outerStride(),
+                &m_rhs.coeffRef(0,col), m_rhs.outerStride(),
+                (Scalar*)&(m_dest.coeffRef(row,col)), m_dest.outerStride(),
+                m_actualAlpha, m_blocking, info, epilogue, row, col);
+    }
+
     const Lhs& m_lhs;
     const Rhs& m_rhs;
     Dest& m_dest;
     Scalar m_actualAlpha;
     BlockingType& m_blocking;
+    Epilogue m_epilogue;
 };
 
+
 template<int StorageOrder, typename LhsScalar, typename RhsScalar, int MaxRows, int MaxCols, int MaxDepth, int KcFactor=1,
 bool FiniteAtCompileTime = MaxRows!=Dynamic && MaxCols!=Dynamic && MaxDepth != Dynamic> class gemm_blocking_space;
 
@@ -330,10 +384,14 @@ class gemm_blocking_space<StorageOrder,_LhsScalar,_RhsScalar,MaxRows, MaxCols, M
 
     Index m_sizeA;
     Index m_sizeB;
+    // the scratch allocators the blocks are taken from
+    ScratchAllocator* m_allocatorA;
+    ScratchAllocator* m_allocatorB;
 
   public:
 
     gemm_blocking_space(Index rows, Index cols, Index depth, Index num_threads, bool l3_blocking)
+      : m_allocatorA(0), m_allocatorB(0)
     {
       this->m_mc = Transpose ? cols : rows;
       this->m_nc = Transpose ? rows : cols;
@@ -370,13 +428,19 @@ class gemm_blocking_space<StorageOrder,_LhsScalar,_RhsScalar,MaxRows, MaxCols, M
     void allocateA()
     {
       if(this->m_blockA==0)
-        this->m_blockA = aligned_new<LhsScalar>(m_sizeA);
+      {
+        m_allocatorA = current_scratch_allocator();
+        this->m_blockA = scratch_new<LhsScalar>(m_sizeA);
+      }
     }
 
     void allocateB()
     {
       if(this->m_blockB==0)
-        this->m_blockB = aligned_new<RhsScalar>(m_sizeB);
+      {
+        m_allocatorB = current_scratch_allocator();
+        this->m_blockB = scratch_new<RhsScalar>(m_sizeB);
+      }
     }
 
     void allocateAll()
@@ -387,8 +451,9 @@ class gemm_blocking_space<StorageOrder,_LhsScalar,_RhsScalar,MaxRows, MaxCols, M
 
     ~gemm_blocking_space()
     {
-      aligned_delete(this->m_blockA, m_sizeA);
-      aligned_delete(this->m_blockB, m_sizeB);
+      // in reverse order of the usual allocations, see ScratchAllocator
+      if(this->m_blockB) scratch_delete(this->m_blockB, m_sizeB, m_allocatorB);
+      if(this->m_blockA) scratch_delete(this->m_blockA, m_sizeA, m_allocatorA);
     }
 };
 
@@ -448,8 +513,42 @@ struct generic_product_impl<Lhs,Rhs,DenseShape,DenseShape,GemmProduct>
       scaleAndAddTo(dst, lhs, rhs, Scalar(-1));
   }
   
+  template<typename Dest, typename Epilogue>
+  static void evalToWithEpilogue(Dest& dst, const Lhs& lhs, const Rhs& rhs, const Epilogue& epilogue)
+  {
+    // The epilogue is fused into the kernel for column-major destinations only, since its packet
+    // operation processes the coefficients of a column.
+#ifndef EIGEN_USE_BLAS
+    enum { Fused = !(Dest::Flags&RowMajorBit) };
+#else
+    enum { Fused = false };
+#endif
+    if(Fused && (rhs.rows()+dst.rows()+dst.cols())>=20 && lhs.cols()>0 && dst.size()>0)
+    {
+      dst.setZero();
+      scaleAndAddTo(dst, lhs, rhs, Scalar(1), epilogue, typename conditional<Fused,true_type,false_type>::type());
+    }
+    else
+    {
+      evalTo(dst, lhs, rhs);
+      apply_product_epilogue(dst, epilogue);
+    }
+  }
+
   template<typename Dest>
   static void scaleAndAddTo(Dest& dst, const Lhs& a_lhs, const Rhs& a_rhs, const Scalar& alpha)
+  {
+    scaleAndAddTo(dst, a_lhs, a_rhs, alpha, gemm_no_epilogue(), true_type());
+  }
+
+  protected:
+
+  template<typename Dest, typename Epilogue>
+  static void scaleAndAddTo(Dest&, const Lhs&, const Rhs&, const Scalar&, const Epilogue&, false_type)
+  {}
+
+  template<typename Dest, typename Epilogue>
+  static void scaleAndAddTo(Dest& dst, const Lhs& a_lhs, const Rhs& a_rhs, const Scalar& alpha, const Epilogue& epilogue, true_type)
   {
     eigen_assert(dst.rows()==a_lhs.rows() && dst.cols()==a_rhs.cols());
     if(a_lhs.cols()==0 || a_lhs.rows()==0 || a_rhs.cols()==0)
@@ -471,11 +570,11 @@ struct generic_product_impl<Lhs,Rhs,DenseShape,DenseShape,GemmProduct>
         LhsScalar, (ActualLhsTypeCleaned::Flags&RowMajorBit) ? RowMajor : ColMajor, bool(LhsBlasTraits::NeedToConjugate),
         RhsScalar, (ActualRhsTypeCleaned::Flags&RowMajorBit) ? RowMajor : ColMajor, bool(RhsBlasTraits::NeedToConjugate),
         (Dest::Flags&RowMajorBit) ? RowMajor : ColMajor>,
-      ActualLhsTypeCleaned, ActualRhsTypeCleaned, Dest, BlockingType> GemmFunctor;
+      ActualLhsTypeCleaned, ActualRhsTypeCleaned, Dest, BlockingType, Epilogue> GemmFunctor;
 
     BlockingType blocking(dst.rows(), dst.cols(), lhs.cols(), 1, true);
     internal::parallelize_gemm<(Dest::MaxRowsAtCompileTime>32 || Dest::MaxRowsAtCompileTime==Dynamic)>
-                              (GemmFunctor(lhs, rhs, dst, actualAlpha, blocking), a_lhs.rows(), a_rhs.cols(), Dest::Flags&RowMajorBit);
+                              (GemmFunctor(lhs, rhs, dst, actualAlpha, blocking, epilogue), a_lhs.rows(), a_rhs.cols(), Dest::Flags&RowMajorBit);
   }
 };
 
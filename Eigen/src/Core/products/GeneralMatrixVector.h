@@ -611,6 +611,102 @@ EIGEN_DONT_INLINE void general_matrix_vector_product<Index,LhsScalar,LhsMapper,R
   #undef _EIGEN_ACCUMULATE_PACKETS
 }
 
+/* Multi-threaded matrix * vector product, enabled by defining EIGEN_PARALLEL_GEMV_THRESHOLD:
+ * The products of matrices having at least EIGEN_PARALLEL_GEMV_THRESHOLD coefficients are split across the threads
+ * of the parallel scheduler, each thread calling the sequential Kernel on a block of the matrix:
+ * - for a row-major matrix, each thread computes a contiguous range of coefficients of the result,
+ * - for a col-major matrix, each thread processes a range of columns and accumulates its contribution to the whole
+ *   result in a local buffer, the buffers being then combined. The rows are split instead when there are
+ *   not enough columns to feed all the threads.
+ */
+
+template<typename Kernel, typename Index, typename LhsMapper, typename RhsMapper, typename ResScalar, typename AlphaScalar>
+struct gemv_rows_functor
+{
+  gemv_rows_functor(Index cols, const LhsMapper& lhs, const RhsMapper& rhs, ResScalar* res, Index resIncr, AlphaScalar alpha)
+    : m_cols(cols), m_lhs(lhs), m_rhs(rhs), m_res(res), m_resIncr(resIncr), m_alpha(alpha)
+  {}
+
+  void operator()(Index start, Index length) const
+  {
+    Kernel::run(length, m_cols, m_lhs.getSubMapper(start,0), m_rhs, m_res + start*m_resIncr, m_resIncr, m_alpha);
+  }
+
+  Index m_cols;
+  const LhsMapper& m_lhs;
+  const RhsMapper& m_rhs;
+  ResScalar* m_res;
+  Index m_resIncr;
+  AlphaScalar m_alpha;
+};
+
+template<typename Kernel, typename Index, typename LhsMapper, typename RhsMapper, typename ResScalar, typename AlphaScalar>
+struct gemv_cols_functor
+{
+  gemv_cols_functor(Index rows, Index cols, const LhsMapper& lhs, const RhsMapper& rhs, AlphaScalar alpha)
+    : m_rows(rows), m_cols(cols), m_lhs(lhs), m_rhs(rhs), m_alpha(alpha)
+  {}
+
+  // the kernel processes the columns 4 at once
+  Index bound(Index t, Index count) const { return t==count ? m_cols : t*((m_cols/count) & ~Index(3)); }
+
+  void operator()(Index start, Index length, ResScalar* res) const
+  {
+    Kernel::run(m_rows, length, m_lhs.getSubMapper(0,start), m_rhs.getSubMapper(start,0), res, 1, m_alpha);
+  }
+
+  Index m_rows, m_cols;
+  const LhsMapper& m_lhs;
+  const RhsMapper& m_rhs;
+  AlphaScalar m_alpha;
+};
+
+template<typename Kernel>
+struct parallel_gemv<Kernel,ColMajor>
+{
+  template<typename Index, typename LhsMapper, typename RhsMapper, typename ResScalar, typename AlphaScalar>
+  static void run(Index rows, Index cols, const LhsMapper& lhs, const RhsMapper& rhs, ResScalar* res, Index resIncr, AlphaScalar alpha)
+  {
+#if (defined EIGEN_HAS_PARALLELIZER) && (defined EIGEN_PARALLEL_GEMV_THRESHOLD) && !(defined EIGEN_USE_BLAS)
+    if(double(rows)*double(cols) >= double(EIGEN_PARALLEL_GEMV_THRESHOLD))
+    {
+      eigen_internal_assert(resIncr==1);
+      const Index minColsPerThread = 32;
+      if(cols >= minColsPerThread*Index(nbThreads()))
+      {
+        gemv_cols_functor<Kernel,Index,LhsMapper,RhsMapper,ResScalar,AlphaScalar> func(rows, cols, lhs, rhs, alpha);
+        parallelize_accumulate(func, cols/minColsPerThread, res, rows);
+      }
+      else
+      {
+        gemv_rows_functor<Kernel,Index,LhsMapper,RhsMapper,ResScalar,AlphaScalar> func(cols, lhs, rhs, res, resIncr, alpha);
+        parallelize_range(func, rows, Index(16), Index(1024));
+      }
+      return;
+    }
+#endif
+    Kernel::run(rows, cols, lhs, rhs, res, resIncr, alpha);
+  }
+};
+
+template<typename Kernel>
+struct parallel_gemv<Kernel,RowMajor>
+{
+  template<typename Index, typename LhsMapper, typename RhsMapper, typename ResScalar, typename AlphaScalar>
+  static void run(Index rows, Index cols, const LhsMapper& lhs, const RhsMapper& rhs, ResScalar* res, Index resIncr, AlphaScalar alpha)
+  {
+#if (defined EIGEN_HAS_PARALLELIZER) && (defined EIGEN_PARALLEL_GEMV_THRESHOLD) && !(defined EIGEN_USE_BLAS)
+    if(double(rows)*double(cols) >= double(EIGEN_PARALLEL_GEMV_THRESHOLD))
+    {
+      gemv_rows_functor<Kernel,Index,LhsMapper,RhsMapper,ResScalar,AlphaScalar> func(cols, lhs, rhs, res, resIncr, alpha);
+      parallelize_range(func, rows, Index(4), Index(64));
+      return;
+    }
+#endif
+    Kernel::run(rows, cols, lhs, rhs, res, resIncr, alpha);
+  }
+};
+
 } // end namespace internal
 
 } // end namespace Eigen
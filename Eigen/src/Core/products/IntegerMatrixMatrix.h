@@ -0,0 +1,316 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_INTEGER_MATRIX_MATRIX_H
+#define EIGEN_INTEGER_MATRIX_MATRIX_H
+
+namespace Eigen {
+
+namespace internal {
+
+/* Products of 8-bit or 16-bit integer matrices accumulated in 32-bit integers.
+ * The operands are widened to 16 bits while they are packed, and two consecutive coefficients k and k+1
+ * of the depth dimension are stored in the low and high halves of a 32-bit integer. The micro kernel then
+ * multiplies and sums these pairs with pmadd_int16_pairs (pmaddwd on x86). Each packet holds twice as many
+ * products as a float packet, but pmaddwd is followed by an addition, such that the kernel is at most twice
+ * as fast as the float kernel without FMA, and about 1.5 times as fast with FMA. */
+struct integer_gemm_traits
+{
+#if defined(EIGEN_VECTORIZE_AVX2)
+  typedef Packet8i Packet;
+#elif defined(EIGEN_VECTORIZE_SSE2)
+  typedef Packet4i Packet;
+#else
+  typedef int Packet;
+#endif
+  enum {
+    PacketSize = unpacket_traits<Packet>::size,
+    mr = 2*PacketSize,  // number of rows of a micro tile
+    nr = 4              // number of columns of a micro tile
+  };
+};
+
+template<typename Scalar> struct is_integer_gemm_scalar { enum { value = false }; };
+template<> struct is_integer_gemm_scalar<signed char> { enum { value = true }; };
+template<> struct is_integer_gemm_scalar<short> { enum { value = true }; };
+
+// default output stage storing the 32-bit accumulators
+struct integer_gemm_no_stage
+{
+  int operator()(int x, Index, Index) const { return x; }
+};
+
+inline int integer_gemm_pair(int lo, int hi)
+{
+  return static_cast<int>(static_cast<unsigned int>(static_cast<unsigned short>(lo))
+                       | (static_cast<unsigned int>(static_cast<unsigned short>(hi)) << 16));
+}
+
+// Packs the rows [i2,i2+mc) and the depth pairs [k2/2,k2/2+kcp) of lhs into panels of mr rows padded with zeros
+template<typename LhsMapper>
+void integer_gemm_pack_lhs(int* blockA, const LhsMapper& lhs, Index rows, Index depth, Index i2, Index mc, Index k2, Index kcp)
+{
+  enum { mr = integer_gemm_traits::mr };
+  for(Index i=i2; i<i2+mc; i+=mr)
+  {
+    const Index actual_mr = (std::min)(Index(mr), rows-i);
+    for(Index kp=0; kp<kcp; ++kp)
+    {
+      const Index k = k2 + 2*kp;
+      Index r = 0;
+      if(k+1<depth)
+        for(; r<actual_mr; ++r)
+          blockA[r] = integer_gemm_pair(lhs(i+r,k), lhs(i+r,k+1));
+      else
+        for(; r<actual_mr; ++r)
+          blockA[r] = integer_gemm_pair(lhs(i+r,k), 0);
+      for(; r<mr; ++r)
+        blockA[r] = 0;
+      blockA += mr;
+    }
+  }
+}
+
+// Packs the columns [j2,j2+nc) and the depth pairs [k2/2,k2/2+kcp) of rhs into panels of nr columns padded with zeros
+template<typename RhsMapper>
+void integer_gemm_pack_rhs(int* blockB, const RhsMapper& rhs, Index depth, Index cols, Index j2, Index nc, Index k2, Index kcp)
+{
+  enum { nr = integer_gemm_traits::nr };
+  for(Index j=j2; j<j2+nc; j+=nr)
+  {
+    const Index actual_nr = (std::min)(Index(nr), cols-j);
+    for(Index kp=0; kp<kcp; ++kp)
+    {
+      const Index k = k2 + 2*kp;
+      Index c = 0;
+      if(k+1<depth)
+        for(; c<actual_nr; ++c)
+          blockB[c] = integer_gemm_pair(rhs(k,j+c), rhs(k+1,j+c));
+      else
+        for(; c<actual_nr; ++c)
+          blockB[c] = integer_gemm_pair(rhs(k,j+c), 0);
+      for(; c<nr; ++c)
+        blockB[c] = 0;
+      blockB += nr;
+    }
+  }
+}
+
+// Computes the mr x nr tile of the product of a packed lhs panel by a packed rhs panel,
+// and stores it in column-major order into the aligned buffer tile
+EIGEN_DONT_INLINE inline void integer_gemm_kernel(const int* blockA, const int* blockB, Index kcp, int* tile)
+{
+  typedef integer_gemm_traits::Packet Packet;
+  enum { PacketSize = integer_gemm_traits::PacketSize, mr = integer_gemm_traits::mr, nr = integer_gemm_traits::nr };
+
+  Packet C0 = pset1<Packet>(0), C1 = C0, C2 = C0, C3 = C0, C4 = C0, C5 = C0, C6 = C0, C7 = C0;
+  for(Index k=0; k<kcp; ++k)
+  {
+    Packet A0 = pload<Packet>(blockA);
+    Packet A1 = pload<Packet>(blockA + PacketSize);
+    Packet B;
+    B = pset1<Packet>(blockB[0]);
+    C0 = pmadd_int16_pairs(A0, B, C0);
+    C1 = pmadd_int16_pairs(A1, B, C1);
+    B = pset1<Packet>(blockB[1]);
+    C2 = pmadd_int16_pairs(A0, B, C2);
+    C3 = pmadd_int16_pairs(A1, B, C3);
+    B = pset1<Packet>(blockB[2]);
+    C4 = pmadd_int16_pairs(A0, B, C4);
+    C5 = pmadd_int16_pairs(A1, B, C5);
+    B = pset1<Packet>(blockB[3]);
+    C6 = pmadd_int16_pairs(A0, B, C6);
+    C7 = pmadd_int16_pairs(A1, B, C7);
+    blockA += mr;
+    blockB += nr;
+  }
+  pstore(tile + 0*PacketSize, C0);
+  pstore(tile + 1*PacketSize, C1);
+  pstore(tile + 2*PacketSize, C2);
+  pstore(tile + 3*PacketSize, C3);
+  pstore(tile + 4*PacketSize, C4);
+  pstore(tile + 5*PacketSize, C5);
+  pstore(tile + 6*PacketSize, C6);
+  pstore(tile + 7*PacketSize, C7);
+}
+
+/* Computes dst = stage(lhs * rhs) for the rows x depth lhs and depth x cols rhs, read through blas data mappers.
+ * The partial sums of the depth blocks are accumulated in acc, which is dst itself when there is no output stage,
+ * and the output stage is applied to the sums of the last depth block before they are stored into dst. */
+template<typename LhsMapper, typename RhsMapper, typename Acc, typename Dest, typename OutputStage>
+void integer_gemm_product(const LhsMapper& lhs, const RhsMapper& rhs, Index rows, Index cols, Index depth,
+                          Acc& acc, Dest& dst, const OutputStage& stage, Index kc)
+{
+  enum { mr = integer_gemm_traits::mr, nr = integer_gemm_traits::nr };
+
+  // a pair of panels fits in the L1 cache, the lhs block in half of the L2 cache and the rhs block in half of the L3 cache
+  std::ptrdiff_t l1, l2, l3;
+  manage_caching_sizes(GetAction, &l1, &l2, &l3);
+  const Index kcp = (std::max)(Index(1), (std::min)((depth+1)/2, kc/2));
+  const Index mc = (std::min)(((rows+mr-1)/mr)*mr, (std::max)(Index(1), Index(l2/2/(4*kcp*mr)))*mr);
+  const Index nc = (std::min)(((cols+nr-1)/nr)*nr, (std::max)(Index(1), Index((std::max)(l2,l3)/2/(4*kcp*nr)))*nr);
+
+  ei_declare_aligned_stack_constructed_variable(int, blockA, mc*kcp, 0);
+  ei_declare_aligned_stack_constructed_variable(int, blockB, nc*kcp, 0);
+  EIGEN_ALIGN_DEFAULT int tile[mr*nr];
+
+  for(Index j2=0; j2<cols; j2+=nc)
+  {
+    const Index actual_nc = (std::min)(j2+nc,cols)-j2;
+    for(Index k2=0; k2<depth; k2+=2*kcp)
+    {
+      const Index actual_kcp = ((std::min)(k2+2*kcp,depth)-k2+1)/2;
+      const bool first = k2==0;
+      const bool last = k2+2*kcp>=depth;
+      integer_gemm_pack_rhs(blockB, rhs, depth, cols, j2, actual_nc, k2, actual_kcp);
+
+      for(Index i2=0; i2<rows; i2+=mc)
+      {
+        const Index actual_mc = (std::min)(i2+mc,rows)-i2;
+        integer_gemm_pack_lhs(blockA, lhs, rows, depth, i2, actual_mc, k2, actual_kcp);
+
+        for(Index j=0; j<actual_nc; j+=nr)
+        {
+          const Index actual_nr = (std::min)(Index(nr), actual_nc-j);
+          for(Index i=0; i<actual_mc; i+=mr)
+          {
+            const Index actual_mr = (std::min)(Index(mr), actual_mc-i);
+            integer_gemm_kernel(blockA + i*actual_kcp, blockB + j*actual_kcp, actual_kcp, tile);
+
+            for(Index c=0; c<actual_nr; ++c)
+            {
+              const Index col = j2+j+c;
+              for(Index r=0; r<actual_mr; ++r)
+              {
+                const Index row = i2+i+r;
+                int x = first ? tile[c*mr+r] : acc.coeff(row,col) + tile[c*mr+r];
+                if(last)
+                  dst.coeffRef(row,col) = stage(x, row, col);
+                else
+                  acc.coeffRef(row,col) = x;
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+} // end namespace internal
+
+/** \class Requantize
+  * \ingroup Core_Module
+  *
+  * \brief Output stage of integerProduct() mapping the 32-bit accumulators to a narrower integer type
+  *
+  * The accumulator \c x of a coefficient is mapped to round(\c x * \a scale) + \a zeroPoint, saturated
+  * to the range of \a Scalar.
+  *
+  * \sa integerProduct()
+  */
+template<typename Scalar> class Requantize
+{
+  public:
+    Requantize(double scale, int zeroPoint = 0) : m_scale(scale), m_zeroPoint(zeroPoint) {}
+
+    Scalar operator()(int x, Index, Index) const
+    {
+      double v = std::floor(double(x) * m_scale + 0.5) + double(m_zeroPoint);
+      v = (std::max)(v, double((std::numeric_limits<Scalar>::min)()));
+      v = (std::min)(v, double((std::numeric_limits<Scalar>::max)()));
+      return Scalar(v);
+    }
+
+  protected:
+    double m_scale;
+    int m_zeroPoint;
+};
+
+/** \ingroup Core_Module
+  *
+  * Computes \a dst = \a lhs * \a rhs for matrices of 8-bit (\c signed \c char) or 16-bit (\c short) integers,
+  * the products being accumulated in 32-bit integers. \a dst is a matrix of \c int which is resized if needed,
+  * and it must not alias \a lhs or \a rhs.
+  *
+  * Unlike \c lhs.cast<int>()*rhs.cast<int>(), the products are computed with SIMD instructions multiplying
+  * pairs of 16-bit integers (e.g., \c pmaddwd with SSE2 and AVX2). The sums of two products of 16-bit
+  * integers overflow only if all four factors equal -32768.
+  *
+  * \sa integerProduct(const MatrixBase<Lhs>&, const MatrixBase<Rhs>&, MatrixBase<Dest>&, const OutputStage&)
+  */
+template<typename Lhs, typename Rhs, typename Dest>
+void integerProduct(const MatrixBase<Lhs>& lhs, const MatrixBase<Rhs>& rhs, MatrixBase<Dest>& dst)
+{
+  EIGEN_STATIC_ASSERT((internal::is_same<typename Dest::Scalar,int>::value), THE_MATRIX_OR_EXPRESSION_THAT_YOU_PASSED_DOES_NOT_HAVE_THE_EXPECTED_TYPE);
+  integerProduct(lhs, rhs, dst, internal::integer_gemm_no_stage());
+}
+
+/** \ingroup Core_Module
+  *
+  * Computes \a dst = \a stage(\a lhs * \a rhs) for matrices of 8-bit or 16-bit integers. The 32-bit accumulator
+  * \c x of each coefficient (\c row, \c col) is mapped to the scalar type of \a dst by \c stage(x,row,col), right
+  * after the last update of the accumulator, such that no 32-bit intermediate result is stored when the
+  * depth of the product fits in one block. See class Requantize for the typical output stage of quantized
+  * computations.
+  *
+  * Example:
+  * \code
+  * Matrix<signed char,Dynamic,Dynamic> A, B, C;
+  * integerProduct(A, B, C, Requantize<signed char>(0.01, 5));
+  * \endcode
+  */
+template<typename Lhs, typename Rhs, typename Dest, typename OutputStage>
+void integerProduct(const MatrixBase<Lhs>& lhs, const MatrixBase<Rhs>& rhs, MatrixBase<Dest>& dst, const OutputStage& stage)
+{
+  EIGEN_STATIC_ASSERT(internal::is_integer_gemm_scalar<typename Lhs::Scalar>::value && internal::is_integer_gemm_scalar<typename Rhs::Scalar>::value,
+                      THE_MATRIX_OR_EXPRESSION_THAT_YOU_PASSED_DOES_NOT_HAVE_THE_EXPECTED_TYPE);
+  eigen_assert(lhs.cols()==rhs.rows() && "invalid matrix product");
+  eigen_assert((internal::extract_data(dst.derived())==0
+               || ((const void*)internal::extract_data(dst.derived())!=(const void*)internal::extract_data(lhs.derived())
+                   && (const void*)internal::extract_data(dst.derived())!=(const void*)internal::extract_data(rhs.derived())))
+               && "the destination of integerProduct cannot alias the factors");
+
+  // the factors are packed from their coefficients in memory, expressions being evaluated once
+  typedef typename Lhs::Scalar LhsScalar;
+  typedef typename Rhs::Scalar RhsScalar;
+  enum {
+    LhsStorageOrder = (Lhs::Flags&RowMajorBit) ? RowMajor : ColMajor,
+    RhsStorageOrder = (Rhs::Flags&RowMajorBit) ? RowMajor : ColMajor
+  };
+  Ref<const Matrix<LhsScalar,Dynamic,Dynamic,LhsStorageOrder>, 0, OuterStride<> > actualLhs(lhs.derived());
+  Ref<const Matrix<RhsScalar,Dynamic,Dynamic,RhsStorageOrder>, 0, OuterStride<> > actualRhs(rhs.derived());
+  internal::const_blas_data_mapper<LhsScalar,Index,LhsStorageOrder> lhsMapper(actualLhs.data(), actualLhs.outerStride());
+  internal::const_blas_data_mapper<RhsScalar,Index,RhsStorageOrder> rhsMapper(actualRhs.data(), actualRhs.outerStride());
+
+  dst.derived().resize(lhs.rows(), rhs.cols());
+  if(dst.size()==0)
+    return;
+  if(lhs.cols()==0)
+  {
+    for(Index j=0; j<dst.cols(); ++j)
+      for(Index i=0; i<dst.rows(); ++i)
+        dst.coeffRef(i,j) = stage(0, i, j);
+    return;
+  }
+
+  const Index kc = 512;
+  if(internal::is_same<OutputStage,internal::integer_gemm_no_stage>::value || lhs.cols()<=kc)
+    internal::integer_gemm_product(lhsMapper, rhsMapper, lhs.rows(), rhs.cols(), lhs.cols(), dst.derived(), dst.derived(), stage, kc);
+  else
+  {
+    // the partial sums of the depth blocks are kept in 32-bit integers
+    Matrix<int,Dynamic,Dynamic> acc(dst.rows(), dst.cols());
+    internal::integer_gemm_product(lhsMapper, rhsMapper, lhs.rows(), rhs.cols(), lhs.cols(), acc, dst.derived(), stage, kc);
+  }
+}
+
+} // end namespace Eigen
+
+#endif // EIGEN_INTEGER_MATRIX_MATRIX_H
@@ -0,0 +1,359 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_PACKED_LHS_H
+#define EIGEN_PACKED_LHS_H
+
+namespace Eigen {
+
+namespace internal {
+
+template<typename MatrixType, typename Rhs> struct packed_lhs_product;
+
+template<typename MatrixType, typename Rhs>
+struct traits<packed_lhs_product<MatrixType,Rhs> >
+{
+  typedef Matrix<typename MatrixType::Scalar, MatrixType::RowsAtCompileTime, Rhs::ColsAtCompileTime, ColMajor,
+                 MatrixType::MaxRowsAtCompileTime, Rhs::MaxColsAtCompileTime> ReturnType;
+};
+
+/* Computes res += alpha * A * rhs for the row blocks [start,end) of a PackedLhs A.
+ * Unlike general_matrix_matrix_product, the loop over the blocks of the lhs is the inner one:
+ * each block of the rhs is packed only once and multiplied by all the lhs blocks of the same depth. */
+template<typename PackedType, typename Index, int RhsStorageOrder, bool ConjugateRhs>
+struct packed_lhs_gemm
+{
+  typedef typename PackedType::Scalar Scalar;
+  typedef gebp_traits<Scalar,Scalar> Traits;
+  typedef const_blas_data_mapper<Scalar, Index, RhsStorageOrder> RhsMapper;
+  typedef blas_data_mapper<Scalar, Index, ColMajor> ResMapper;
+
+  packed_lhs_gemm(const PackedType& lhs, Index cols, const Scalar* rhs, Index rhsStride, Scalar* res, Index resStride, Scalar alpha)
+    : m_lhs(lhs), m_cols(cols), m_rhs(rhs, rhsStride), m_res(res, resStride), m_alpha(alpha)
+  {
+    Index k = lhs.cols(), m = lhs.rows();
+    m_nc = cols;
+    computeProductBlockingSizes<Scalar,Scalar>(k, m, m_nc, 1);
+  }
+
+  void operator()(Index start, Index end) const
+  {
+    gemm_pack_rhs<Scalar, Index, RhsMapper, Traits::nr, RhsStorageOrder> pack_rhs;
+    gebp_kernel<Scalar, Scalar, Index, ResMapper, Traits::mr, Traits::nr, false, ConjugateRhs> gebp;
+
+    const Index rows = m_lhs.rows();
+    const Index depth = m_lhs.cols();
+    const Index kc = m_lhs.kc();
+    const Index mc = m_lhs.mc();
+
+    std::size_t sizeB = kc*m_nc;
+    ei_declare_aligned_stack_constructed_variable(Scalar, blockB, sizeB, 0);
+
+    for(Index k2=0; k2<depth; k2+=kc)
+    {
+      const Index actual_kc = (std::min)(k2+kc,depth)-k2;
+
+      for(Index j2=0; j2<m_cols; j2+=m_nc)
+      {
+        const Index actual_nc = (std::min)(j2+m_nc,m_cols)-j2;
+
+        pack_rhs(blockB, m_rhs.getSubMapper(k2,j2), actual_kc, actual_nc);
+
+        // the lhs blocks are already packed, so we only have to stream them through the kernel
+        for(Index b=start; b<end; ++b)
+        {
+          const Index i2 = b*mc;
+          const Index actual_mc = (std::min)(i2+mc,rows)-i2;
+          gebp(m_res.getSubMapper(i2, j2), m_lhs.block(b, k2/kc), blockB, actual_mc, actual_kc, actual_nc, m_alpha);
+        }
+      }
+    }
+  }
+
+  const PackedType& m_lhs;
+  Index m_cols;
+  RhsMapper m_rhs;
+  ResMapper m_res;
+  Scalar m_alpha;
+  Index m_nc;
+};
+
+#ifdef EIGEN_HAS_PARALLELIZER
+// Splits the row blocks of a packed_lhs_gemm among the threads. The parts are independent.
+template<typename Gemm, typename Index>
+class packed_lhs_gemm_task : public ParallelTask
+{
+  public:
+    packed_lhs_gemm_task(const Gemm& gemm, Index blocks) : m_gemm(gemm), m_blocks(blocks) {}
+
+    void operator()(int id, int count)
+    {
+      m_gemm(m_blocks*id/count, m_blocks*(id+1)/count);
+    }
+
+  protected:
+    const Gemm& m_gemm;
+    Index m_blocks;
+};
+#endif // EIGEN_HAS_PARALLELIZER
+
+template<typename Gemm, typename Index>
+void parallelize_packed_lhs_gemm(const Gemm& gemm, Index rows, Index blocks)
+{
+#ifdef EIGEN_HAS_PARALLELIZER
+  ParallelScheduler* scheduler = parallelScheduler();
+  if(scheduler!=0 && !scheduler->inParallelRegion())
+  {
+    // same heuristic as parallelize_gemm, and at least one row block per thread
+    Index threads = (std::min)((std::min)(Index(nbThreads()), blocks), (std::max)(Index(1), rows/32));
+    if(threads>1)
+    {
+      packed_lhs_gemm_task<Gemm,Index> task(gemm, blocks);
+      scheduler->run(int(threads), task);
+      return;
+    }
+  }
+#else
+  EIGEN_UNUSED_VARIABLE(rows);
+#endif
+  gemm(0, blocks);
+}
+
+template<typename Dest, bool DirectColMajor = (int(Dest::Flags)&(RowMajorBit|DirectAccessBit))==DirectAccessBit
+                                              && int(Dest::InnerStrideAtCompileTime)==1>
+struct packed_lhs_apply_selector
+{
+  template<typename PackedType, typename Rhs>
+  static void run(const PackedType& lhs, Dest& dst, const Rhs& a_rhs, const typename PackedType::Scalar& alpha)
+  {
+    typedef typename PackedType::Scalar Scalar;
+    typedef blas_traits<Rhs> RhsBlasTraits;
+    typedef typename RhsBlasTraits::DirectLinearAccessType ActualRhsType;
+    typedef typename remove_all<ActualRhsType>::type ActualRhsTypeCleaned;
+
+    typename add_const_on_value_type<ActualRhsType>::type rhs = RhsBlasTraits::extract(a_rhs);
+    Scalar actualAlpha = alpha * lhs.scaleFactor() * RhsBlasTraits::extractScalarFactor(a_rhs);
+
+    typedef packed_lhs_gemm<PackedType, Index, (ActualRhsTypeCleaned::Flags&RowMajorBit) ? RowMajor : ColMajor,
+                            bool(RhsBlasTraits::NeedToConjugate)> Gemm;
+    Gemm gemm(lhs, rhs.cols(), &rhs.coeffRef(0,0), rhs.outerStride(), &dst.coeffRef(0,0), dst.outerStride(), actualAlpha);
+    parallelize_packed_lhs_gemm(gemm, lhs.rows(), lhs.rowBlocks());
+  }
+};
+
+// row-major or non directly accessible destination => go through a column-major temporary
+template<typename Dest>
+struct packed_lhs_apply_selector<Dest,false>
+{
+  template<typename PackedType, typename Rhs>
+  static void run(const PackedType& lhs, Dest& dst, const Rhs& rhs, const typename PackedType::Scalar& alpha)
+  {
+    typedef Matrix<typename PackedType::Scalar,Dynamic,Dynamic,ColMajor> Temp;
+    Temp tmp = Temp::Zero(dst.rows(), dst.cols());
+    packed_lhs_apply_selector<Temp>::run(lhs, tmp, rhs, alpha);
+    dst += tmp;
+  }
+};
+
+} // end namespace internal
+
+/** \class PackedLhs
+  * \ingroup Core_Module
+  *
+  * \brief A matrix stored in the packed layout of the left-hand side of the matrix product kernels
+  *
+  * \tparam _MatrixType the type of the matrix to pack, only its scalar type matters
+  *
+  * A general matrix product starts by copying blocks of both operands into a layout suited to the
+  * product kernel. When the same matrix is multiplied by many right-hand sides, e.g., the weights of a
+  * layer in an inference workload, this class allows to pack it once and reuse the packed blocks across
+  * all the subsequent products:
+  * \code
+  * PackedLhs<MatrixXf> packedW(W);   // packs W
+  * for(...)
+  *   Y = packedW * X;                // equivalent to Y = W * X, without repacking W
+  * \endcode
+  *
+  * The packing pass can dominate the cost of a product with a skinny right-hand side. The products
+  * with a PackedLhs also pack each block of the right-hand side only once. They are multi-threaded
+  * like the other matrix products, and since they only read the packed data, a PackedLhs object can be
+  * shared by several threads computing their products concurrently.
+  *
+  * Scaling factors and conjugations of the input expression are taken into account, such that
+  * \c PackedLhs<MatrixXcf>(2*A.adjoint()) is valid. The blocking sizes are those of the general
+  * matrix product at the time of the packing, see computeProductBlockingSizes().
+  */
+template<typename _MatrixType> class PackedLhs
+{
+  public:
+    typedef _MatrixType MatrixType;
+    typedef typename MatrixType::Scalar Scalar;
+    typedef internal::gebp_traits<Scalar,Scalar> Traits;
+
+    /** \brief Default constructor
+      *
+      * The object must be initialized with compute() before being used in a product.
+      */
+    PackedLhs()
+      : m_rows(0), m_cols(0), m_mc(0), m_kc(0), m_blockStride(0), m_scale(1), m_isInitialized(false)
+    {}
+
+    /** Packs the matrix \a matrix, see compute() */
+    template<typename InputType>
+    explicit PackedLhs(const MatrixBase<InputType>& matrix)
+      : m_rows(0), m_cols(0), m_mc(0), m_kc(0), m_blockStride(0), m_scale(1), m_isInitialized(false)
+    {
+      compute(matrix);
+    }
+
+    /** Packs the matrix \a matrix. Any previously packed data is discarded,
+      * but the storage is reused if it is large enough.
+      *
+      * The row blocking takes into account the current number of threads, see nbThreads(),
+      * such that the products can be split among them.
+      */
+    template<typename InputType>
+    PackedLhs& compute(const MatrixBase<InputType>& matrix);
+
+    /** \returns the product of \c *this by \a rhs. */
+    template<typename Rhs>
+    inline const internal::packed_lhs_product<MatrixType,Rhs> operator*(const MatrixBase<Rhs>& rhs) const
+    {
+      eigen_assert(m_isInitialized && "PackedLhs is not initialized.");
+      eigen_assert(m_cols==rhs.rows() && "invalid matrix product");
+      return internal::packed_lhs_product<MatrixType,Rhs>(*this, rhs.derived());
+    }
+
+    /** Computes \a dst += \a alpha * \c *this * \a rhs.
+      *
+      * This is the fastest way to perform a product with a PackedLhs when \a dst is a column-major matrix.
+      * \a dst must not alias \a rhs. */
+    template<typename Dest, typename Rhs>
+    void applyTo(MatrixBase<Dest>& dst, const MatrixBase<Rhs>& rhs, const Scalar& alpha = Scalar(1)) const
+    {
+      eigen_assert(m_isInitialized && "PackedLhs is not initialized.");
+      eigen_assert(m_cols==rhs.rows() && m_rows==dst.rows() && rhs.cols()==dst.cols());
+      if(m_rows==0 || m_cols==0 || rhs.cols()==0)
+        return;
+      internal::packed_lhs_apply_selector<Dest>::run(*this, dst.derived(), rhs.derived(), alpha);
+    }
+
+    inline Index rows() const { return m_rows; }
+    inline Index cols() const { return m_cols; }
+
+    /** \returns the number of rows of the packed blocks, except the last row of blocks */
+    inline Index mc() const { return m_mc; }
+    /** \returns the number of columns of the packed blocks, except the last column of blocks */
+    inline Index kc() const { return m_kc; }
+
+    /** \internal \returns the number of rows of blocks */
+    inline Index rowBlocks() const { return m_mc==0 ? 0 : (m_rows+m_mc-1)/m_mc; }
+    /** \internal \returns the scaling factor extracted from the packed expression */
+    inline const Scalar& scaleFactor() const { return m_scale; }
+    /** \internal \returns the packed block at the row block \a i and column block \a k */
+    inline const Scalar* block(Index i, Index k) const
+    {
+      return m_data.data() + (i*colBlocks() + k)*m_blockStride;
+    }
+
+  protected:
+    inline Index colBlocks() const { return m_kc==0 ? 0 : (m_cols+m_kc-1)/m_kc; }
+
+    Matrix<Scalar,Dynamic,1> m_data;
+    Index m_rows, m_cols;
+    Index m_mc, m_kc;
+    Index m_blockStride;
+    Scalar m_scale;
+    bool m_isInitialized;
+};
+
+template<typename MatrixType>
+template<typename InputType>
+PackedLhs<MatrixType>& PackedLhs<MatrixType>::compute(const MatrixBase<InputType>& a_matrix)
+{
+  typedef internal::blas_traits<InputType> LhsBlasTraits;
+  typedef typename LhsBlasTraits::DirectLinearAccessType ActualLhsType;
+  typedef typename internal::remove_all<ActualLhsType>::type ActualLhsTypeCleaned;
+  enum { LhsStorageOrder = (ActualLhsTypeCleaned::Flags&RowMajorBit) ? RowMajor : ColMajor };
+  typedef internal::const_blas_data_mapper<Scalar, Index, LhsStorageOrder> LhsMapper;
+
+  typename internal::add_const_on_value_type<ActualLhsType>::type lhs = LhsBlasTraits::extract(a_matrix.derived());
+  m_scale = LhsBlasTraits::extractScalarFactor(a_matrix.derived());
+  m_rows = lhs.rows();
+  m_cols = lhs.cols();
+
+  // the columns of the result are not known yet, so assume a square product
+  m_kc = m_cols;
+  m_mc = m_rows;
+  Index nc = m_rows;
+  internal::computeProductBlockingSizes<Scalar,Scalar>(m_kc, m_mc, nc, nbThreads());
+
+  // each block starts on an aligned address, as required by the kernel
+  enum { Alignment = EIGEN_ALIGN_BYTES/sizeof(Scalar) > 1 ? EIGEN_ALIGN_BYTES/sizeof(Scalar) : 1 };
+  m_blockStride = ((m_mc*m_kc + Alignment-1)/Alignment)*Alignment;
+  m_data.resize(rowBlocks()*colBlocks()*m_blockStride);
+
+  LhsMapper mapper(lhs.size()==0 ? 0 : &lhs.coeffRef(0,0), lhs.outerStride());
+  internal::gemm_pack_lhs<Scalar, Index, LhsMapper, Traits::mr, Traits::LhsProgress, LhsStorageOrder,
+                          bool(LhsBlasTraits::NeedToConjugate)> pack_lhs;
+  for(Index i2=0, b=0; i2<m_rows; i2+=m_mc, ++b)
+  {
+    const Index actual_mc = (std::min)(i2+m_mc,m_rows)-i2;
+    for(Index k2=0; k2<m_cols; k2+=m_kc)
+    {
+      const Index actual_kc = (std::min)(k2+m_kc,m_cols)-k2;
+      pack_lhs(const_cast<Scalar*>(block(b, k2/m_kc)), mapper.getSubMapper(i2,k2), actual_kc, actual_mc);
+    }
+  }
+
+  m_isInitialized = true;
+  return *this;
+}
+
+namespace internal {
+
+template<typename MatrixType, typename Rhs>
+struct packed_lhs_product
+  : public ReturnByValue<packed_lhs_product<MatrixType,Rhs> >
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename traits<packed_lhs_product>::ReturnType ReturnType;
+
+  packed_lhs_product(const PackedLhs<MatrixType>& lhs, const Rhs& rhs)
+    : m_lhs(lhs), m_rhs(rhs)
+  {}
+
+  inline Index rows() const { return m_lhs.rows(); }
+  inline Index cols() const { return m_rhs.cols(); }
+
+  template<typename Dest> void evalTo(Dest& dst) const
+  {
+    if(extract_data(dst)!=0 && extract_data(dst)==extract_data(m_rhs))
+    {
+      // dst aliases the rhs
+      ReturnType tmp = ReturnType::Zero(rows(), cols());
+      m_lhs.applyTo(tmp, m_rhs);
+      dst = tmp;
+    }
+    else
+    {
+      dst.setZero();
+      m_lhs.applyTo(dst, m_rhs);
+    }
+  }
+
+  const PackedLhs<MatrixType>& m_lhs;
+  typename Rhs::Nested m_rhs;
+};
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_PACKED_LHS_H
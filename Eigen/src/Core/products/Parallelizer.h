@@ -10,10 +10,254 @@
 #ifndef EIGEN_PARALLELIZER_H
 #define EIGEN_PARALLELIZER_H
 
-namespace Eigen { 
+namespace Eigen {
+
+/** \class ParallelTask
+  * \ingroup Core_Module
+  *
+  * \brief Interface of the work dispatched by a ParallelScheduler
+  *
+  * \sa ParallelScheduler
+  */
+class ParallelTask
+{
+  public:
+    virtual ~ParallelTask() {}
+
+    /** Executes the part \a id of the task, where \a id is in [0,\a count) and \a count
+      * is the actual number of parts run concurrently by the scheduler. */
+    virtual void operator()(int id, int count) = 0;
+};
+
+/** \class ParallelScheduler
+  * \ingroup Core_Module
+  *
+  * \brief Abstract interface to the threads running Eigen's multi-threaded kernels
+  *
+  * A scheduler runs the parts of a ParallelTask concurrently and returns once all of them
+  * have completed. The parts of a task might wait on each other (e.g., the threads of a matrix product
+  * share their packed blocks), so they must really run simultaneously on distinct threads:
+  * running them one after the other would dead-lock. The calling thread is expected to run
+  * one of the parts.
+  *
+  * Eigen provides an OpenMPScheduler when OpenMP is enabled, and a ThreadPoolScheduler based on
+  * std::thread when EIGEN_USE_THREADS is defined. Any other thread pool can be plugged
+  * by implementing this interface.
+  *
+  * \sa setParallelScheduler(), ScopedParallelScheduler
+  */
+class ParallelScheduler
+{
+  public:
+    virtual ~ParallelScheduler() {}
+
+    /** \returns the number of threads of the scheduler */
+    virtual int numThreads() const = 0;
+
+    /** \returns true if the calling thread is already running a part of a parallel task,
+      * in which case the nested kernels are run sequentially. */
+    virtual bool inParallelRegion() const { return false; }
+
+    /** Concurrently runs at most \a count parts of \a task, and returns once all of them have completed.
+      * The actual number of parts, which might be lower than \a count, is passed to each of them. */
+    virtual void run(int count, ParallelTask& task) = 0;
+};
+
+#ifdef EIGEN_HAS_OPENMP
+/** \class OpenMPScheduler
+  * \ingroup Core_Module
+  *
+  * \brief ParallelScheduler running the tasks in an OpenMP parallel region
+  *
+  * This is the default scheduler when OpenMP is enabled.
+  */
+class OpenMPScheduler : public ParallelScheduler
+{
+  public:
+    int numThreads() const { return omp_get_max_threads(); }
+
+    // FIXME omp_get_num_threads()>1 only works for openmp, what if the user does not use openmp?
+    bool inParallelRegion() const { return omp_get_num_threads()>1; }
+
+    void run(int count, ParallelTask& task)
+    {
+      #pragma omp parallel num_threads(count)
+      task(omp_get_thread_num(), omp_get_num_threads());
+    }
+};
+#endif // EIGEN_HAS_OPENMP
+
+#if (defined EIGEN_USE_THREADS) && EIGEN_HAS_CXX11_ATOMIC && (defined EIGEN_HAS_PARALLELIZER)
+/** \class ThreadPoolScheduler
+  * \ingroup Core_Module
+  *
+  * \brief ParallelScheduler running the tasks on a pool of std::thread
+  *
+  * The calling thread runs the first part of each task, and the other parts are dispatched to
+  * the worker threads of the pool. All the parts of a task are queued at once and picked in FIFO order,
+  * so that several threads can share the same pool without dead-locking.
+  *
+  * This class is only available when EIGEN_USE_THREADS is defined, and requires C++11.
+  *
+  * Example:
+  * \code
+  * #define EIGEN_USE_THREADS
+  * #include <Eigen/Core>
+  * ...
+  * Eigen::ThreadPoolScheduler pool(8);
+  * Eigen::setParallelScheduler(&pool);
+  * C.noalias() = A * B; // runs on the 8 threads of pool
+  * \endcode
+  */
+class ThreadPoolScheduler : public ParallelScheduler
+{
+  public:
+    /** Creates a pool of \a num_threads threads, including the calling thread of run(). */
+    explicit ThreadPoolScheduler(int num_threads = std::thread::hardware_concurrency())
+      : m_exiting(false)
+    {
+      for(int i=1; i<num_threads; ++i)
+        m_workers.push_back(std::thread(&ThreadPoolScheduler::workerLoop, this));
+    }
+
+    /** Waits for the completion of the running tasks and joins the threads. */
+    ~ThreadPoolScheduler()
+    {
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_exiting = true;
+      }
+      m_work.notify_all();
+      for(std::size_t i=0; i<m_workers.size(); ++i)
+        m_workers[i].join();
+    }
+
+    int numThreads() const { return int(m_workers.size())+1; }
+
+    bool inParallelRegion() const { return currentPool()==this; }
+
+    void run(int count, ParallelTask& task)
+    {
+      count = (std::min)(count, numThreads());
+      Batch batch(task, count);
+      if(count>1)
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for(int i=1; i<count; ++i)
+          m_queue.push_back(Job(&batch, i));
+      }
+      m_work.notify_all();
+
+      runPart(task, 0, count);
+
+      std::unique_lock<std::mutex> lock(m_mutex);
+      while(batch.pending>0)
+        m_done.wait(lock);
+    }
+
+  protected:
+    struct Batch
+    {
+      Batch(ParallelTask& t, int c) : task(t), count(c), pending(c-1) {}
+      ParallelTask& task;
+      int count;
+      int pending;
+    };
+    typedef std::pair<Batch*,int> Job;
+
+    static const ThreadPoolScheduler*& currentPool()
+    {
+      static EIGEN_THREAD_LOCAL const ThreadPoolScheduler* pool = 0;
+      return pool;
+    }
+
+    void runPart(ParallelTask& task, int id, int count)
+    {
+      const ThreadPoolScheduler* previous = currentPool();
+      currentPool() = this;
+      task(id, count);
+      currentPool() = previous;
+    }
+
+    void workerLoop()
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      for(;;)
+      {
+        while(m_queue.empty() && !m_exiting)
+          m_work.wait(lock);
+        if(m_queue.empty())
+          return;
+        Job job = m_queue.front();
+        m_queue.pop_front();
+        lock.unlock();
+        runPart(job.first->task, job.second, job.first->count);
+        lock.lock();
+        if(--(job.first->pending)==0)
+          m_done.notify_all();
+      }
+    }
+
+    std::vector<std::thread> m_workers;
+    std::deque<Job> m_queue;
+    std::mutex m_mutex;
+    std::condition_variable m_work;
+    std::condition_variable m_done;
+    bool m_exiting;
+
+  private:
+    ThreadPoolScheduler(const ThreadPoolScheduler&);
+    ThreadPoolScheduler& operator=(const ThreadPoolScheduler&);
+};
+#endif // EIGEN_USE_THREADS
 
 namespace internal {
 
+/** \internal \returns the scheduler used when none has been set by the user */
+inline ParallelScheduler* default_parallel_scheduler()
+{
+#ifdef EIGEN_HAS_OPENMP
+  static OpenMPScheduler scheduler;
+  return &scheduler;
+#else
+  return 0;
+#endif
+}
+
+#ifdef EIGEN_THREAD_LOCAL
+/** \internal \returns the scheduler of the calling thread set by ScopedParallelScheduler, if any */
+inline ParallelScheduler*& local_parallel_scheduler()
+{
+  static EIGEN_THREAD_LOCAL ParallelScheduler* m_scheduler = 0;
+  return m_scheduler;
+}
+#endif
+
+/** \internal */
+inline void manage_parallel_scheduler(Action action, ParallelScheduler** s)
+{
+  static ParallelScheduler* m_scheduler = default_parallel_scheduler();
+
+  eigen_internal_assert(s!=0);
+  if(action==SetAction)
+  {
+    m_scheduler = *s ? *s : default_parallel_scheduler();
+  }
+  else if(action==GetAction)
+  {
+    *s = m_scheduler;
+#ifdef EIGEN_THREAD_LOCAL
+    // the scheduler of the calling thread has the priority over the global one
+    if(local_parallel_scheduler())
+      *s = local_parallel_scheduler();
+#endif
+  }
+  else
+  {
+    eigen_internal_assert(false);
+  }
+}
+
 /** \internal */
 inline void manage_multi_threading(Action action, int* v)
 {
@@ -27,11 +271,15 @@ inline void manage_multi_threading(Action action, int* v)
   else if(action==GetAction)
   {
     eigen_internal_assert(v!=0);
-    #ifdef EIGEN_HAS_OPENMP
-    if(m_maxThreads>0)
+    #ifdef EIGEN_HAS_PARALLELIZER
+    ParallelScheduler* scheduler;
+    manage_parallel_scheduler(GetAction, &scheduler);
+    if(scheduler==0)
+      *v = 1;
+    else if(m_maxThreads>0)
       *v = m_maxThreads;
     else
-      *v = omp_get_max_threads();
+      *v = scheduler->numThreads();
     #else
     *v = 1;
     #endif
@@ -51,6 +299,7 @@ inline void initParallel()
   internal::manage_multi_threading(GetAction, &nbt);
   std::ptrdiff_t l1, l2, l3;
   internal::manage_caching_sizes(GetAction, &l1, &l2, &l3);
+  internal::product_blocking_sizes_table::instance();
 }
 
 /** \returns the max number of threads reserved for Eigen
@@ -69,25 +318,142 @@ inline void setNbThreads(int v)
   internal::manage_multi_threading(SetAction, &v);
 }
 
+/** \returns the scheduler running the multi-threaded kernels of the calling thread,
+  * or a null pointer if multi-threading is not available.
+  * \sa setParallelScheduler(), ScopedParallelScheduler */
+inline ParallelScheduler* parallelScheduler()
+{
+  ParallelScheduler* ret;
+  internal::manage_parallel_scheduler(GetAction, &ret);
+  return ret;
+}
+
+/** Sets the scheduler running Eigen's multi-threaded kernels for all threads.
+  * A null pointer restores the default scheduler, i.e., OpenMP if enabled.
+  *
+  * The scheduler must outlive its use by Eigen, and multi-threading must be available, i.e., either
+  * OpenMP or C++11 must be enabled, and EIGEN_DONT_PARALLELIZE must not be defined.
+  *
+  * \sa parallelScheduler(), ScopedParallelScheduler, setNbThreads() */
+inline void setParallelScheduler(ParallelScheduler* scheduler)
+{
+  internal::manage_parallel_scheduler(SetAction, &scheduler);
+}
+
+#ifdef EIGEN_THREAD_LOCAL
+/** \class ScopedParallelScheduler
+  * \ingroup Core_Module
+  *
+  * \brief Overrides the scheduler of the calling thread for the lifetime of this object
+  *
+  * This allows to run the products of a given call on a specific pool:
+  * \code
+  * {
+  *   Eigen::ScopedParallelScheduler guard(&my_pool);
+  *   C.noalias() = A * B; // runs on my_pool
+  * }
+  * \endcode
+  *
+  * \sa setParallelScheduler()
+  */
+class ScopedParallelScheduler
+{
+  public:
+    explicit ScopedParallelScheduler(ParallelScheduler* scheduler)
+      : m_previous(internal::local_parallel_scheduler())
+    {
+      internal::local_parallel_scheduler() = scheduler;
+    }
+
+    ~ScopedParallelScheduler()
+    {
+      internal::local_parallel_scheduler() = m_previous;
+    }
+
+  private:
+    ParallelScheduler* m_previous;
+
+    ScopedParallelScheduler(const ScopedParallelScheduler&);
+    ScopedParallelScheduler& operator=(const ScopedParallelScheduler&);
+};
+#endif // EIGEN_THREAD_LOCAL
+
 namespace internal {
 
-template<typename Index> struct GemmParallelInfo
+template<typename Index> struct GemmParallelTaskInfo
 {
-  GemmParallelInfo() : sync(-1), users(0), lhs_start(0), lhs_length(0) {}
+  GemmParallelTaskInfo() : sync(-1), users(0), lhs_start(0), lhs_length(0) {}
 
-  int volatile sync;
+#if EIGEN_HAS_CXX11_ATOMIC && (defined EIGEN_HAS_PARALLELIZER)
+  std::atomic<Index> sync;
+  std::atomic<int> users;
+#else
+  Index volatile sync;
   int volatile users;
+#endif
 
   Index lhs_start;
   Index lhs_length;
 };
 
+template<typename Index> struct GemmParallelInfo
+{
+  GemmParallelInfo(Index id, Index threads, GemmParallelTaskInfo<Index>* info)
+    : logical_thread_id(id), num_threads(threads), task_info(info)
+  {}
+
+  Index logical_thread_id;
+  Index num_threads;
+  GemmParallelTaskInfo<Index>* task_info;
+};
+
+#ifdef EIGEN_HAS_PARALLELIZER
+template<typename Functor, typename Index>
+class gemm_parallel_task : public ParallelTask
+{
+  public:
+    gemm_parallel_task(const Functor& func, Index rows, Index cols, bool transpose, GemmParallelTaskInfo<Index>* info)
+      : m_func(func), m_rows(rows), m_cols(cols), m_transpose(transpose), m_info(info)
+    {}
+
+    void operator()(int id, int count)
+    {
+      Index i = id;
+      // Note that the actual number of threads might be lower than the number of request ones.
+      Index actual_threads = count;
+
+      Index blockCols = (m_cols / actual_threads) & ~Index(0x3);
+      Index blockRows = (m_rows / actual_threads);
+      blockRows = (blockRows/Functor::Traits::mr)*Functor::Traits::mr;
+
+      Index r0 = i*blockRows;
+      Index actualBlockRows = (i+1==actual_threads) ? m_rows-r0 : blockRows;
+
+      Index c0 = i*blockCols;
+      Index actualBlockCols = (i+1==actual_threads) ? m_cols-c0 : blockCols;
+
+      m_info[i].lhs_start = r0;
+      m_info[i].lhs_length = actualBlockRows;
+
+      GemmParallelInfo<Index> info(i, actual_threads, m_info);
+      if(m_transpose) m_func(c0, actualBlockCols, 0, m_rows, &info);
+      else            m_func(0, m_rows, c0, actualBlockCols, &info);
+    }
+
+  protected:
+    const Functor& m_func;
+    Index m_rows, m_cols;
+    bool m_transpose;
+    GemmParallelTaskInfo<Index>* m_info;
+};
+#endif // EIGEN_HAS_PARALLELIZER
+
 template<bool Condition, typename Functor, typename Index>
 void parallelize_gemm(const Functor& func, Index rows, Index cols, bool transpose)
 {
   // TODO when EIGEN_USE_BLAS is defined,
   // we should still enable OMP for other scalar types
-#if !(defined (EIGEN_HAS_OPENMP)) || defined (EIGEN_USE_BLAS)
+#if !(defined (EIGEN_HAS_PARALLELIZER)) || defined (EIGEN_USE_BLAS)
   // FIXME the transpose variable is only needed to properly split
   // the matrix product when multithreading is enabled. This is a temporary
   // fix to support row-major destination matrices. This whole
@@ -96,15 +462,16 @@ void parallelize_gemm(const Functor& func, Index rows, Index cols, bool transpos
   func(0,rows, 0,cols);
 #else
 
-  // Dynamically check whether we should enable or disable OpenMP.
+  // Dynamically check whether we should enable or disable multi-threading.
   // The conditions are:
+  // - a scheduler is available
   // - the max number of threads we can create is greater than 1
   // - we are not already in a parallel code
   // - the sizes are large enough
 
   // 1- are we already in a parallel session?
-  // FIXME omp_get_num_threads()>1 only works for openmp, what if the user does not use openmp?
-  if((!Condition) || (omp_get_num_threads()>1))
+  ParallelScheduler* scheduler = parallelScheduler();
+  if((!Condition) || (scheduler==0) || scheduler->inParallelRegion())
     return func(0,rows, 0,cols);
 
   Index size = transpose ? rows : cols;
@@ -124,32 +491,137 @@ void parallelize_gemm(const Functor& func, Index rows, Index cols, bool transpos
 
   if(transpose)
     std::swap(rows,cols);
-  
-  ei_declare_aligned_stack_constructed_variable(GemmParallelInfo<Index>,info,threads,0);
-  
-  #pragma omp parallel num_threads(threads)
+
+  ei_declare_aligned_stack_constructed_variable(GemmParallelTaskInfo<Index>,info,threads,0);
+
+  gemm_parallel_task<Functor,Index> task(func, rows, cols, transpose, info);
+  scheduler->run(int(threads), task);
+#endif
+}
+
+#ifdef EIGEN_HAS_PARALLELIZER
+template<typename Functor, typename Index>
+class parallel_range_task : public ParallelTask
+{
+  public:
+    parallel_range_task(const Functor& func, Index size, Index granularity)
+      : m_func(func), m_size(size), m_granularity(granularity)
+    {}
+
+    void operator()(int id, int count)
+    {
+      Index chunk = ((m_size / count) / m_granularity) * m_granularity;
+      Index start = id * chunk;
+      Index length = (id+1==count) ? m_size-start : chunk;
+      if(length>0)
+        m_func(start, length);
+    }
+
+  protected:
+    const Functor& m_func;
+    Index m_size;
+    Index m_granularity;
+};
+#endif // EIGEN_HAS_PARALLELIZER
+
+/* Splits the range [0,size) into one contiguous sub-range per thread, and calls func(start,length) for each of them.
+ * The bounds of the sub-ranges are multiples of granularity, and each of them has at least minSizePerThread
+ * elements. As for parallelize_gemm, the range is processed by the calling thread if multi-threading is disabled
+ * or if we are already in a parallel region. */
+template<typename Functor, typename Index>
+void parallelize_range(const Functor& func, Index size, Index granularity, Index minSizePerThread)
+{
+#ifdef EIGEN_HAS_PARALLELIZER
+  ParallelScheduler* scheduler = parallelScheduler();
+  if(scheduler!=0 && !scheduler->inParallelRegion())
   {
-    Index i = omp_get_thread_num();
-    // Note that the actual number of threads might be lower than the number of request ones.
-    Index actual_threads = omp_get_num_threads();
-    
-    Index blockCols = (cols / actual_threads) & ~Index(0x3);
-    Index blockRows = (rows / actual_threads);
-    blockRows = (blockRows/Functor::Traits::mr)*Functor::Traits::mr;
-  
-    Index r0 = i*blockRows;
-    Index actualBlockRows = (i+1==actual_threads) ? rows-r0 : blockRows;
-
-    Index c0 = i*blockCols;
-    Index actualBlockCols = (i+1==actual_threads) ? cols-c0 : blockCols;
-
-    info[i].lhs_start = r0;
-    info[i].lhs_length = actualBlockRows;
-
-    if(transpose) func(c0, actualBlockCols, 0, rows, info);
-    else          func(0, rows, c0, actualBlockCols, info);
+    Index threads = (std::min)(Index(nbThreads()), size / (std::max)(minSizePerThread, granularity));
+    if(threads>1)
+    {
+      Eigen::initParallel();
+      parallel_range_task<Functor,Index> task(func, size, granularity);
+      scheduler->run(int(threads), task);
+      return;
+    }
   }
+#else
+  EIGEN_UNUSED_VARIABLE(granularity);
+  EIGEN_UNUSED_VARIABLE(minSizePerThread);
+#endif
+  func(0, size);
+}
+
+#ifdef EIGEN_HAS_PARALLELIZER
+template<typename Functor, typename Scalar, typename Index>
+class parallel_accumulate_task : public ParallelTask
+{
+  public:
+    parallel_accumulate_task(const Functor& func, Scalar* res, Scalar* buffers, Index resSize, Index bufferStride)
+      : m_func(func), m_res(res), m_buffers(buffers), m_resSize(resSize), m_bufferStride(bufferStride), m_count(1)
+    {}
+
+    void operator()(int id, int count)
+    {
+      // the calling thread runs the part 0
+      if(id==0)
+        m_count = count;
+      Index start = m_func.bound(id, count);
+      Index end = m_func.bound(id+1, count);
+      Scalar* res = m_res;
+      if(id>0)
+      {
+        res = m_buffers + (id-1)*m_bufferStride;
+        Map<Matrix<Scalar,Dynamic,1> >(res, m_resSize).setZero();
+      }
+      if(end>start)
+        m_func(start, end-start, res);
+    }
+
+    int count() const { return m_count; }
+
+  protected:
+    const Functor& m_func;
+    Scalar* m_res;
+    Scalar* m_buffers;
+    Index m_resSize;
+    Index m_bufferStride;
+    int m_count;
+};
+#endif // EIGEN_HAS_PARALLELIZER
+
+/* Splits a range into at most maxThreads contiguous sub-ranges, whose bounds are given by func.bound(t,count) for t
+ * in [0,count], and calls func(start,length,res) for each of them. Every sub-range scatters its contribution over
+ * the whole result vector: the first one accumulates directly into res, while the other ones accumulate into
+ * zero-initialized buffers of resSize scalars which are then added to res one after the other, so that the result
+ * does not depend on the scheduling of the threads. */
+template<typename Functor, typename Scalar, typename Index>
+void parallelize_accumulate(const Functor& func, Index maxThreads, Scalar* res, Index resSize)
+{
+#ifdef EIGEN_HAS_PARALLELIZER
+  ParallelScheduler* scheduler = parallelScheduler();
+  if(scheduler!=0 && !scheduler->inParallelRegion())
+  {
+    Index threads = (std::min)(Index(nbThreads()), maxThreads);
+    if(threads>1)
+    {
+      Eigen::initParallel();
+      // keep the buffers aligned
+      Index bufferStride = (resSize + 15) & ~Index(15);
+      ei_declare_aligned_stack_constructed_variable(Scalar, buffers, (threads-1)*bufferStride, 0);
+      parallel_accumulate_task<Functor,Scalar,Index> task(func, res, buffers, resSize, bufferStride);
+      scheduler->run(int(threads), task);
+      for(int t=1; t<task.count(); ++t)
+        Map<Matrix<Scalar,Dynamic,1> >(res, resSize) += Map<Matrix<Scalar,Dynamic,1> >(buffers + (t-1)*bufferStride, resSize);
+      return;
+    }
+  }
+#else
+  EIGEN_UNUSED_VARIABLE(maxThreads);
+  EIGEN_UNUSED_VARIABLE(resSize);
 #endif
+  Index end = func.bound(1, 1);
+  if(end>0)
+    func(0, end, res);
 }
 
 } // end namespace internal
@@ -33,6 +33,17 @@ static EIGEN_DONT_INLINE void run(
   const Scalar* _rhs, Index rhsIncr,
   Scalar* res,
   Scalar alpha);
+
+// Processes the columns [start,end) of the stored triangular part only. The pairs of columns processed together
+// must not be split, i.e., the bounds must be even for a col-major lower (or row-major upper) matrix, and have the
+// parity of size otherwise.
+static EIGEN_DONT_INLINE void run_columns(
+  Index size,
+  const Scalar* lhs, Index lhsStride,
+  const Scalar* rhs,
+  Scalar* res,
+  Scalar alpha,
+  Index start, Index end);
 };
 
 template<typename Scalar, typename Index, int StorageOrder, int UpLo, bool ConjugateLhs, bool ConjugateRhs, int Version>
@@ -42,6 +53,29 @@ EIGEN_DONT_INLINE void selfadjoint_matrix_vector_product<Scalar,Index,StorageOrd
   const Scalar* _rhs, Index rhsIncr,
   Scalar* res,
   Scalar alpha)
+{
+  // FIXME this copy is now handled outside product_selfadjoint_vector, so it could probably be removed.
+  // if the rhs is not sequentially stored in memory we copy it to a temporary buffer,
+  // this is because we need to extract packets
+  ei_declare_aligned_stack_constructed_variable(Scalar,rhs,size,rhsIncr==1 ? const_cast<Scalar*>(_rhs) : 0);  
+  if (rhsIncr!=1)
+  {
+    const Scalar* it = _rhs;
+    for (Index i=0; i<size; ++i, it+=rhsIncr)
+      rhs[i] = *it;
+  }
+
+  run_columns(size, lhs, lhsStride, rhs, res, alpha, 0, size);
+}
+
+template<typename Scalar, typename Index, int StorageOrder, int UpLo, bool ConjugateLhs, bool ConjugateRhs, int Version>
+EIGEN_DONT_INLINE void selfadjoint_matrix_vector_product<Scalar,Index,StorageOrder,UpLo,ConjugateLhs,ConjugateRhs,Version>::run_columns(
+  Index size,
+  const Scalar* lhs, Index lhsStride,
+  const Scalar* rhs,
+  Scalar* res,
+  Scalar alpha,
+  Index start, Index end)
 {
   typedef typename packet_traits<Scalar>::type Packet;
   const Index PacketSize = sizeof(Packet)/sizeof(Scalar);
@@ -61,23 +95,12 @@ EIGEN_DONT_INLINE void selfadjoint_matrix_vector_product<Scalar,Index,StorageOrd
 
   Scalar cjAlpha = ConjugateRhs ? numext::conj(alpha) : alpha;
 
-  // FIXME this copy is now handled outside product_selfadjoint_vector, so it could probably be removed.
-  // if the rhs is not sequentially stored in memory we copy it to a temporary buffer,
-  // this is because we need to extract packets
-  ei_declare_aligned_stack_constructed_variable(Scalar,rhs,size,rhsIncr==1 ? const_cast<Scalar*>(_rhs) : 0);  
-  if (rhsIncr!=1)
-  {
-    const Scalar* it = _rhs;
-    for (Index i=0; i<size; ++i, it+=rhsIncr)
-      rhs[i] = *it;
-  }
-
   Index bound = (std::max)(Index(0),size-8) & 0xfffffffe;
   if (FirstTriangular)
     bound = size - bound;
 
-  for (Index j=FirstTriangular ? bound : 0;
-       j<(FirstTriangular ? size : bound);j+=2)
+  for (Index j=FirstTriangular ? (std::max)(bound,start) : start;
+       j<(FirstTriangular ? end : (std::min)(bound,end));j+=2)
   {
     const Scalar* EIGEN_RESTRICT A0 = lhs + j*lhsStride;
     const Scalar* EIGEN_RESTRICT A1 = lhs + (j+1)*lhsStride;
@@ -145,7 +168,7 @@ EIGEN_DONT_INLINE void selfadjoint_matrix_vector_product<Scalar,Index,StorageOrd
     res[j]   += alpha * (t2 + predux(ptmp2));
     res[j+1] += alpha * (t3 + predux(ptmp3));
   }
-  for (Index j=FirstTriangular ? 0 : bound;j<(FirstTriangular ? bound : size);j++)
+  for (Index j=FirstTriangular ? start : (std::max)(bound,start);j<(FirstTriangular ? (std::min)(bound,end) : end);j++)
   {
     const Scalar* EIGEN_RESTRICT A0 = lhs + j*lhsStride;
 
@@ -162,6 +185,37 @@ EIGEN_DONT_INLINE void selfadjoint_matrix_vector_product<Scalar,Index,StorageOrd
   }
 }
 
+// Processes a range of columns for the multi-threaded product, the bounds of the ranges balancing the number of
+// coefficients of the triangular part, i.e., the column j has size-j coefficients if FirstTriangular is false, and j otherwise.
+template<typename Kernel, typename Scalar, typename Index, bool FirstTriangular>
+struct symv_columns_functor
+{
+  symv_columns_functor(Index size, const Scalar* lhs, Index lhsStride, const Scalar* rhs, Scalar alpha)
+    : m_size(size), m_lhs(lhs), m_lhsStride(lhsStride), m_rhs(rhs), m_alpha(alpha)
+  {}
+
+  Index bound(Index t, Index count) const
+  {
+    if(t==0)     return 0;
+    if(t==count) return m_size;
+    double r = double(t)/double(count);
+    Index b = Index(double(m_size) * (FirstTriangular ? std::sqrt(r) : 1.-std::sqrt(1.-r)));
+    // do not split the pairs of columns of the kernel
+    return FirstTriangular ? b + ((m_size-b)&1) : b & ~Index(1);
+  }
+
+  void operator()(Index start, Index length, Scalar* res) const
+  {
+    Kernel::run_columns(m_size, m_lhs, m_lhsStride, m_rhs, res, m_alpha, start, start+length);
+  }
+
+  Index m_size;
+  const Scalar* m_lhs;
+  Index m_lhsStride;
+  const Scalar* m_rhs;
+  Scalar m_alpha;
+};
+
 } // end namespace internal 
 
 /***************************************************************************
@@ -233,15 +287,29 @@ struct selfadjoint_product_impl<Lhs,LhsMode,false,Rhs,0,true>
     }
       
       
-    internal::selfadjoint_matrix_vector_product<Scalar, Index, (internal::traits<ActualLhsTypeCleaned>::Flags&RowMajorBit) ? RowMajor : ColMajor,
-                                                int(LhsUpLo), bool(LhsBlasTraits::NeedToConjugate), bool(RhsBlasTraits::NeedToConjugate)>::run
-      (
-        lhs.rows(),                             // size
-        &lhs.coeffRef(0,0),  lhs.outerStride(), // lhs info
-        actualRhsPtr, 1,                        // rhs info
-        actualDestPtr,                          // result info
-        actualAlpha                             // scale factor
-      );
+    enum { LhsStorageOrder = (internal::traits<ActualLhsTypeCleaned>::Flags&RowMajorBit) ? RowMajor : ColMajor };
+    typedef internal::selfadjoint_matrix_vector_product<Scalar, Index, LhsStorageOrder,
+                                                int(LhsUpLo), bool(LhsBlasTraits::NeedToConjugate), bool(RhsBlasTraits::NeedToConjugate)> Symv;
+
+#if (defined EIGEN_HAS_PARALLELIZER) && (defined EIGEN_PARALLEL_GEMV_THRESHOLD) && !(defined EIGEN_USE_BLAS)
+    // large products are split across threads by ranges of columns, see parallelize_accumulate()
+    if(double(lhs.rows())*double(lhs.rows()) >= double(EIGEN_PARALLEL_GEMV_THRESHOLD))
+    {
+      enum { FirstTriangular = (int(LhsStorageOrder)==RowMajor) == (int(LhsUpLo)==Lower) };
+      internal::symv_columns_functor<Symv, Scalar, Index, bool(FirstTriangular)>
+        func(lhs.rows(), &lhs.coeffRef(0,0), lhs.outerStride(), actualRhsPtr, actualAlpha);
+      internal::parallelize_accumulate(func, lhs.rows()/64, actualDestPtr, lhs.rows());
+    }
+    else
+#endif
+      Symv::run
+        (
+          lhs.rows(),                             // size
+          &lhs.coeffRef(0,0),  lhs.outerStride(), // lhs info
+          actualRhsPtr, 1,                        // rhs info
+          actualDestPtr,                          // result info
+          actualAlpha                             // scale factor
+        );
     
     if(!EvalToDest)
       dest = MappedDest(actualDestPtr, dest.size());
@@ -392,10 +392,8 @@ struct triangular_product_impl<Mode,LhsIsTriangular,Lhs,false,Rhs,false>
     
     typedef internal::blas_traits<Lhs> LhsBlasTraits;
     typedef typename LhsBlasTraits::DirectLinearAccessType ActualLhsType;
-    typedef typename internal::remove_all<ActualLhsType>::type ActualLhsTypeCleaned;
     typedef internal::blas_traits<Rhs> RhsBlasTraits;
     typedef typename RhsBlasTraits::DirectLinearAccessType ActualRhsType;
-    typedef typename internal::remove_all<ActualRhsType>::type ActualRhsTypeCleaned;
     
     typename internal::add_const_on_value_type<ActualLhsType>::type lhs = LhsBlasTraits::extract(a_lhs);
     typename internal::add_const_on_value_type<ActualRhsType>::type rhs = RhsBlasTraits::extract(a_rhs);
@@ -403,30 +401,75 @@ struct triangular_product_impl<Mode,LhsIsTriangular,Lhs,false,Rhs,false>
     Scalar actualAlpha = alpha * LhsBlasTraits::extractScalarFactor(a_lhs)
                                * RhsBlasTraits::extractScalarFactor(a_rhs);
 
-    typedef internal::gemm_blocking_space<(Dest::Flags&RowMajorBit) ? RowMajor : ColMajor,Scalar,Scalar,
-              Lhs::MaxRowsAtCompileTime, Rhs::MaxColsAtCompileTime, Lhs::MaxColsAtCompileTime,4> BlockingType;
-
     enum { IsLower = (Mode&Lower) == Lower };
     Index stripedRows  = ((!LhsIsTriangular) || (IsLower))  ? lhs.rows() : (std::min)(lhs.rows(),lhs.cols());
     Index stripedCols  = ((LhsIsTriangular)  || (!IsLower)) ? rhs.cols() : (std::min)(rhs.cols(),rhs.rows());
     Index stripedDepth = LhsIsTriangular ? ((!IsLower) ? lhs.cols() : (std::min)(lhs.cols(),lhs.rows()))
                                          : ((IsLower)  ? rhs.rows() : (std::min)(rhs.rows(),rhs.cols()));
 
-    BlockingType blocking(stripedRows, stripedCols, stripedDepth, 1, false);
-
-    internal::product_triangular_matrix_matrix<Scalar, Index,
-      Mode, LhsIsTriangular,
-      (internal::traits<ActualLhsTypeCleaned>::Flags&RowMajorBit) ? RowMajor : ColMajor, LhsBlasTraits::NeedToConjugate,
-      (internal::traits<ActualRhsTypeCleaned>::Flags&RowMajorBit) ? RowMajor : ColMajor, RhsBlasTraits::NeedToConjugate,
-      (internal::traits<Dest          >::Flags&RowMajorBit) ? RowMajor : ColMajor>
-      ::run(
-        stripedRows, stripedCols, stripedDepth,   // sizes
-        &lhs.coeffRef(0,0), lhs.outerStride(),    // lhs info
-        &rhs.coeffRef(0,0), rhs.outerStride(),    // rhs info
-        &dst.coeffRef(0,0), dst.outerStride(),    // result info
-        actualAlpha, blocking
-      );
+    // The columns of the result are independent when the lhs is triangular, and so are its rows when the rhs is triangular.
+    // They are split among the threads.
+    typedef panel_product<Dest, typename remove_reference<ActualLhsType>::type, typename remove_reference<ActualRhsType>::type> PanelProduct;
+    PanelProduct product(dst, lhs, rhs, actualAlpha, stripedRows, stripedCols, stripedDepth);
+    enum {
+      OtherMaxSize = LhsIsTriangular ? Rhs::MaxColsAtCompileTime : Lhs::MaxRowsAtCompileTime,
+      Parallelizable = OtherMaxSize==Dynamic || OtherMaxSize>32
+    };
+    if(Parallelizable && stripedDepth>=32)
+      internal::parallelize_range(product, LhsIsTriangular ? stripedCols : stripedRows,
+                                  Index(LhsIsTriangular ? gebp_traits<Scalar,Scalar>::nr : gebp_traits<Scalar,Scalar>::mr), Index(32));
+    else
+      product(0, LhsIsTriangular ? stripedCols : stripedRows);
   }
+
+  // Computes the columns (resp. rows) [start,start+length) of the result when the lhs (resp. rhs) is triangular
+  template<typename Dest, typename ActualLhs, typename ActualRhs>
+  struct panel_product
+  {
+    typedef typename Dest::Scalar Scalar;
+    typedef typename remove_all<ActualLhs>::type ActualLhsTypeCleaned;
+    typedef typename remove_all<ActualRhs>::type ActualRhsTypeCleaned;
+    typedef internal::blas_traits<Lhs> LhsBlasTraits;
+    typedef internal::blas_traits<Rhs> RhsBlasTraits;
+
+    panel_product(Dest& dst, const ActualLhs& lhs, const ActualRhs& rhs, const Scalar& alpha,
+                  Index stripedRows, Index stripedCols, Index stripedDepth)
+      : m_dst(dst), m_lhs(lhs), m_rhs(rhs), m_alpha(alpha),
+        m_stripedRows(stripedRows), m_stripedCols(stripedCols), m_stripedDepth(stripedDepth)
+    {}
+
+    void operator()(Index start, Index length) const
+    {
+      typedef internal::gemm_blocking_space<(Dest::Flags&RowMajorBit) ? RowMajor : ColMajor,Scalar,Scalar,
+                Lhs::MaxRowsAtCompileTime, Rhs::MaxColsAtCompileTime, Lhs::MaxColsAtCompileTime,4> BlockingType;
+
+      const Index rows = LhsIsTriangular ? m_stripedRows : length;
+      const Index cols = LhsIsTriangular ? length : m_stripedCols;
+      const Index lhsRow = LhsIsTriangular ? 0 : start;
+      const Index rhsCol = LhsIsTriangular ? start : 0;
+
+      BlockingType blocking(rows, cols, m_stripedDepth, 1, false);
+
+      internal::product_triangular_matrix_matrix<Scalar, Index,
+        Mode, LhsIsTriangular,
+        (internal::traits<ActualLhsTypeCleaned>::Flags&RowMajorBit) ? RowMajor : ColMajor, LhsBlasTraits::NeedToConjugate,
+        (internal::traits<ActualRhsTypeCleaned>::Flags&RowMajorBit) ? RowMajor : ColMajor, RhsBlasTraits::NeedToConjugate,
+        (internal::traits<Dest          >::Flags&RowMajorBit) ? RowMajor : ColMajor>
+        ::run(
+          rows, cols, m_stripedDepth,                                       // sizes
+          &m_lhs.coeffRef(lhsRow,0), m_lhs.outerStride(),                   // lhs info
+          &m_rhs.coeffRef(0,rhsCol), m_rhs.outerStride(),                   // rhs info
+          &m_dst.coeffRef(lhsRow,rhsCol), m_dst.outerStride(),              // result info
+          m_alpha, blocking
+        );
+    }
+
+    Dest& m_dst;
+    const ActualLhs& m_lhs;
+    const ActualRhs& m_rhs;
+    Scalar m_alpha;
+    Index m_stripedRows, m_stripedCols, m_stripedDepth;
+  };
 };
 
 } // end namespace internal
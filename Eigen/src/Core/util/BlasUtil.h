@@ -39,6 +39,9 @@ template<typename Index,
          typename RhsScalar, typename RhsMapper, bool ConjugateRhs, int Version=Specialized>
 struct general_matrix_vector_product;
 
+template<typename Kernel, int LhsStorageOrder>
+struct parallel_gemv;
+
 
 template<bool Conjugate> struct conj_if;
 
@@ -250,6 +253,104 @@ class const_blas_data_mapper : public blas_data_mapper<const Scalar, Index, Stor
 };
 
 
+/* Epilogue of the matrix products: the gebp kernel writes its result tiles through the data mapper,
+ * so a mapper applying an epilogue functor to each register tile before storing it fuses coefficient-wise
+ * operations into the product. An epilogue functor provides:
+ *   Scalar operator()(const Scalar& x, Index row, Index col) const;
+ *   template<typename Packet> Packet packetOp(const Packet& x, Index row, Index col) const;
+ * where \a packetOp processes the coefficients \a row to \a row + packet size - 1 of the column \a col.
+ * It is only called for the last panel of the depth dimension, i.e., on final results. */
+struct gemm_no_epilogue {};
+
+template<typename Scalar, typename Index, typename Epilogue>
+class EpilogueLinearMapper : public BlasLinearMapper<Scalar, Index, Unaligned> {
+  public:
+  typedef typename packet_traits<Scalar>::type Packet;
+
+  EIGEN_ALWAYS_INLINE EpilogueLinearMapper(Scalar *data, Index row, Index col, const Epilogue& epilogue)
+    : BlasLinearMapper<Scalar, Index, Unaligned>(data), m_row(row), m_col(col), m_epilogue(epilogue) {}
+
+  EIGEN_ALWAYS_INLINE void storePacket(Index i, const Packet &p) const {
+    pstoreu<Scalar, Packet>(this->m_data + i, m_epilogue.packetOp(p, m_row + i, m_col));
+  }
+
+  protected:
+  Index m_row, m_col;
+  const Epilogue& m_epilogue;
+};
+
+// Reference to a coefficient of the result whose update goes through the epilogue
+template<typename Scalar, typename Index, typename Epilogue>
+class epilogue_coeff_ref {
+  public:
+  EIGEN_ALWAYS_INLINE epilogue_coeff_ref(Scalar& ref, Index row, Index col, const Epilogue& epilogue)
+    : m_ref(ref), m_row(row), m_col(col), m_epilogue(epilogue) {}
+
+  EIGEN_ALWAYS_INLINE void operator+=(const Scalar& other) const {
+    m_ref = m_epilogue(m_ref + other, m_row, m_col);
+  }
+
+  protected:
+  Scalar& m_ref;
+  Index m_row, m_col;
+  const Epilogue& m_epilogue;
+};
+
+// Column-major result mapper applying an epilogue, row and col being the position of data in the whole result
+template<typename Scalar, typename Index, typename Epilogue>
+class epilogue_data_mapper : public blas_data_mapper<Scalar, Index, ColMajor> {
+  typedef blas_data_mapper<Scalar, Index, ColMajor> Base;
+  public:
+  typedef EpilogueLinearMapper<Scalar, Index, Epilogue> LinearMapper;
+
+  EIGEN_ALWAYS_INLINE epilogue_data_mapper(Scalar* data, Index stride, Index row, Index col, const Epilogue& epilogue)
+    : Base(data, stride), m_row(row), m_col(col), m_epilogue(epilogue) {}
+
+  EIGEN_ALWAYS_INLINE epilogue_data_mapper getSubMapper(Index i, Index j) const {
+    return epilogue_data_mapper(&Base::operator()(i, j), this->m_stride, m_row + i, m_col + j, m_epilogue);
+  }
+
+  EIGEN_ALWAYS_INLINE LinearMapper getLinearMapper(Index i, Index j) const {
+    return LinearMapper(&Base::operator()(i, j), m_row + i, m_col + j, m_epilogue);
+  }
+
+  EIGEN_ALWAYS_INLINE epilogue_coeff_ref<Scalar, Index, Epilogue> operator()(Index i, Index j) const {
+    return epilogue_coeff_ref<Scalar, Index, Epilogue>(Base::operator()(i, j), m_row + i, m_col + j, m_epilogue);
+  }
+
+  // the coefficients of a scattered packet belong to a row, so they are processed one by one
+  template<typename SubPacket>
+  EIGEN_ALWAYS_INLINE void scatterPacket(Index i, Index j, const SubPacket &p) const {
+    enum { Size = unpacket_traits<SubPacket>::size };
+    Scalar values[Size];
+    pstoreu<Scalar, SubPacket>(values, p);
+    for(Index k = 0; k < Size; ++k)
+      Base::operator()(i, j + k) = m_epilogue(values[k], m_row + i, m_col + j + k);
+  }
+
+  protected:
+  Index m_row, m_col;
+  const Epilogue& m_epilogue;
+};
+
+// Selects the result mapper of the last depth panel of a matrix product
+template<typename Scalar, typename Index, typename Epilogue>
+struct gemm_epilogue_traits {
+  typedef epilogue_data_mapper<Scalar, Index, Epilogue> Mapper;
+  static EIGEN_ALWAYS_INLINE Mapper mapper(Scalar* data, Index stride, Index row, Index col, const Epilogue& epilogue) {
+    return Mapper(data, stride, row, col, epilogue);
+  }
+};
+
+template<typename Scalar, typename Index>
+struct gemm_epilogue_traits<Scalar, Index, gemm_no_epilogue> {
+  typedef blas_data_mapper<Scalar, Index, ColMajor> Mapper;
+  static EIGEN_ALWAYS_INLINE Mapper mapper(Scalar* data, Index stride, Index, Index, const gemm_no_epilogue&) {
+    return Mapper(data, stride);
+  }
+};
+
+
 /* Helper class to analyze the factors of a Product expression.
  * In particular it allows to pop out operator-, scalar multiples,
  * and conjugate */
@@ -296,7 +296,14 @@ enum {
   /** Align the matrix itself if it is vectorizable fixed-size */
   AutoAlign = 0,
   /** Don't require alignment for the matrix itself (the array of coefficients, if dynamically allocated, may still be requested to be aligned) */ // FIXME --- clarify the situation
-  DontAlign = 0x2
+  DontAlign = 0x2,
+  /** Align the dynamically allocated array of coefficients on huge page boundaries, and advise the system to
+    * back it with transparent huge pages (Linux only). See also setAllocationPolicy(). */
+  HugePages = 0x4,
+  /** First touch the pages of the dynamically allocated array of coefficients from the threads of the parallel
+    * scheduler, in the same ranges as the multi-threaded assignments, so that a first-touch NUMA policy spreads them
+    * over the nodes of these threads. See also setAllocationPolicy(). */
+  ParallelFirstTouch = 0x8
 };
 
 /** \ingroup enums
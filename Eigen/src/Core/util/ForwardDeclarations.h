@@ -130,6 +130,7 @@ template<typename MatrixType> class SparseView;
 template<typename ExpressionType> class WithFormat;
 template<typename MatrixType> struct CommaInitializer;
 template<typename Derived> class ReturnByValue;
+template<typename MatrixType> class PackedLhs;
 template<typename ExpressionType> class ArrayWrapper;
 template<typename ExpressionType> class MatrixWrapper;
 template<typename XprType> class InnerIterator;
@@ -139,12 +140,19 @@ template<typename DecompositionType> struct kernel_retval_base;
 template<typename DecompositionType> struct kernel_retval;
 template<typename DecompositionType> struct image_retval_base;
 template<typename DecompositionType> struct image_retval;
+template<typename ProductType, typename Epilogue> struct product_epilogue_retval;
 } // end namespace internal
 
 namespace internal {
 template<typename _Scalar, int Rows=Dynamic, int Cols=Dynamic, int Supers=Dynamic, int Subs=Dynamic, int Options=0> class BandMatrix;
 }
 
+namespace internal {
+// defined in products/Parallelizer.h, and used by the multi-threaded coefficient-wise loops
+template<typename Functor, typename Index>
+void parallelize_range(const Functor& func, Index size, Index granularity, Index minSizePerThread);
+}
+
 namespace internal {
 template<typename Lhs, typename Rhs> struct product_type;
 
@@ -426,6 +426,24 @@
   #endif
 #endif
 
+// Does the compiler support C++11 atomics?
+#ifndef EIGEN_HAS_CXX11_ATOMIC
+  #if (defined(__cplusplus) && __cplusplus >= 201103L) || (EIGEN_COMP_MSVC >= 1700)
+    #define EIGEN_HAS_CXX11_ATOMIC 1
+  #else
+    #define EIGEN_HAS_CXX11_ATOMIC 0
+  #endif
+#endif
+
+// Storage class specifier for thread local POD variables (left undefined if not supported)
+#ifndef EIGEN_THREAD_LOCAL
+  #if EIGEN_COMP_MSVC
+    #define EIGEN_THREAD_LOCAL __declspec(thread)
+  #elif EIGEN_COMP_GNUC || EIGEN_COMP_CLANG || EIGEN_COMP_ICC
+    #define EIGEN_THREAD_LOCAL __thread
+  #endif
+#endif
+
 /** Allows to disable some optimizations which might affect the accuracy of the result.
   * Such optimization are enabled by default, and set EIGEN_FAST_MATH to 0 to disable them.
   * They currently include:
@@ -632,6 +650,16 @@ namespace Eigen {
 #define EIGEN_STACK_ALLOCATION_LIMIT 131072
 #endif
 
+#ifndef EIGEN_PARALLEL_SPARSE_DENSE_THRESHOLD
+// minimal number of nonzeros times dense columns processed by each thread of a sparse * dense product
+#define EIGEN_PARALLEL_SPARSE_DENSE_THRESHOLD 20000
+#endif
+
+#ifndef EIGEN_PARALLEL_SPARSE_SPARSE_THRESHOLD
+// minimal number of multiply-adds performed by each thread of a sparse * sparse product
+#define EIGEN_PARALLEL_SPARSE_SPARSE_THRESHOLD 20000
+#endif
+
 #ifndef EIGEN_DEFAULT_IO_FORMAT
 #ifdef EIGEN_MAKING_DOCS
 // format used in Eigen's documentation
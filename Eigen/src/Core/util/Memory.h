@@ -81,6 +81,20 @@
   #define EIGEN_HAS_MM_MALLOC 0
 #endif
 
+// Huge page aligned buffers are allocated with posix_memalign, so that aligned_free can release them.
+#ifndef EIGEN_HAS_HUGE_PAGE_MALLOC
+  #if EIGEN_OS_LINUX && EIGEN_HAS_POSIX_MEMALIGN
+    #include <sys/mman.h>
+    #define EIGEN_HAS_HUGE_PAGE_MALLOC 1
+  #else
+    #define EIGEN_HAS_HUGE_PAGE_MALLOC 0
+  #endif
+#endif
+
+#ifndef EIGEN_HUGE_PAGE_BYTES
+  #define EIGEN_HUGE_PAGE_BYTES (2*1024*1024)
+#endif
+
 namespace Eigen {
 
 namespace internal {
@@ -504,6 +518,117 @@ template<typename T, bool Align> EIGEN_DEVICE_FUNC inline void conditional_align
   conditional_aligned_free<Align>(ptr);
 }
 
+/*****************************************************************************
+*** Implementation of the allocation policies of the dense storage         ***
+*****************************************************************************/
+
+/** \internal Gets or sets the global allocation policy, see setAllocationPolicy() */
+inline void manage_allocation_policy(Action action, int* policy, std::size_t* threshold)
+{
+  static int m_policy = 0;
+  static std::size_t m_threshold = 16 * EIGEN_HUGE_PAGE_BYTES;
+  if(action==SetAction)
+  {
+    eigen_internal_assert(policy!=0 && threshold!=0);
+    m_policy = *policy;
+    m_threshold = *threshold;
+  }
+  else if(action==GetAction)
+  {
+    eigen_internal_assert(policy!=0 && threshold!=0);
+    *policy = m_policy;
+    *threshold = m_threshold;
+  }
+  else
+  {
+    eigen_internal_assert(false);
+  }
+}
+
+/** \internal \returns the #HugePages and #ParallelFirstTouch flags which apply to a dynamic array of \a size
+  * objects of type \c T allocated by a DenseStorage with the given \a Options. The policies are restricted to
+  * the types which do not require initialization, so that the buffers can be released by aligned_free(). */
+template<typename T, int Options> inline int dense_storage_allocation_policy(std::size_t size)
+{
+  if(NumTraits<T>::RequireInitialization || size==0)
+    return 0;
+  int policy;
+  std::size_t threshold;
+  manage_allocation_policy(GetAction, &policy, &threshold);
+  if(size < threshold / sizeof(T))
+    policy = 0;
+  return (policy | Options) & (HugePages|ParallelFirstTouch);
+}
+
+/** \internal Allocates \a size bytes aligned on a huge page boundary, and advises the system to back them with
+  * transparent huge pages. Falls back to conditional_aligned_malloc() if huge pages are not supported. */
+template<bool Align> inline void* huge_page_aligned_malloc(std::size_t size)
+{
+#if EIGEN_HAS_HUGE_PAGE_MALLOC
+  check_that_malloc_is_allowed();
+  void* result;
+  if(posix_memalign(&result, EIGEN_HUGE_PAGE_BYTES, size))
+    throw_std_bad_alloc();
+  #ifdef MADV_HUGEPAGE
+  // this is only a hint, the buffer is still valid if the kernel does not support it
+  madvise(result, size, MADV_HUGEPAGE);
+  #endif
+  return result;
+#else
+  return conditional_aligned_malloc<Align>(size);
+#endif
+}
+
+template<typename T> struct first_touch_range
+{
+  first_touch_range(T* data) : m_data(data) {}
+  void operator()(Index start, Index length) const
+  {
+    std::memset(static_cast<void*>(m_data+start), 0, sizeof(T)*length);
+  }
+  T* m_data;
+};
+
+/** \internal Zeroes the \a size objects of \a data from the threads of the parallel scheduler, in the same ranges
+  * as a multi-threaded linear assignment to \a data, see dense_assignment_chunk. */
+template<typename T> inline void parallel_first_touch(T* data, std::size_t size)
+{
+  // chunks of 16 packets, and 4096 coefficients per thread at least
+  parallelize_range(first_touch_range<T>(data), Index(size), Index(16*packet_traits<T>::size), Index(4096));
+}
+
+template<typename T, int Options> inline T* dense_storage_new_auto(std::size_t size)
+{
+  enum { Align = (Options&DontAlign)==0 };
+  int policy = dense_storage_allocation_policy<T,Options>(size);
+  if(policy==0)
+    return conditional_aligned_new_auto<T,Align>(size);
+  check_size_for_overflow<T>(size);
+  T* result = reinterpret_cast<T*>((policy&HugePages) ? huge_page_aligned_malloc<Align>(sizeof(T)*size)
+                                                      : conditional_aligned_malloc<Align>(sizeof(T)*size));
+  if(policy&ParallelFirstTouch)
+    parallel_first_touch(result, size);
+  return result;
+}
+
+template<typename T, int Options> inline T* dense_storage_realloc_new_auto(T* ptr, std::size_t new_size, std::size_t old_size)
+{
+  enum { Align = (Options&DontAlign)==0 };
+  if(dense_storage_allocation_policy<T,Options>(new_size)==0)
+    return conditional_aligned_realloc_new_auto<T,Align>(ptr, new_size, old_size);
+  // a reallocation would not preserve the alignment nor the placement of the pages
+  T* result = dense_storage_new_auto<T,Options>(new_size);
+  if(ptr!=0)
+    std::memcpy(static_cast<void*>(result), static_cast<const void*>(ptr), sizeof(T)*(std::min)(new_size,old_size));
+  conditional_aligned_delete_auto<T,Align>(ptr, old_size);
+  return result;
+}
+
+template<typename T, int Options> inline void dense_storage_delete_auto(T* ptr, std::size_t size)
+{
+  conditional_aligned_delete_auto<T,(Options&DontAlign)==0>(ptr, size);
+}
+
 /****************************************************************************/
 
 /** \internal Returns the index of the first element of the array that is well aligned for vectorization.
@@ -603,6 +728,396 @@ template<typename T> struct smart_memmove_helper<T,false> {
 };
 
 
+/*****************************************************************************
+*** Implementation of the scratch allocator of temporary buffers           ***
+*****************************************************************************/
+
+} // end namespace internal
+
+/** Sets the allocation policy of the dynamic arrays of coefficients of all the matrices and arrays of at least
+  * \a threshold bytes. \a policy is a combination of #HugePages and #ParallelFirstTouch, or 0 to restore the plain
+  * aligned allocation. Each matrix type can also opt-in with these flags in its \c _Options template parameter, whatever
+  * its size:
+  * \code
+  * typedef Matrix<double,Dynamic,Dynamic,ColMajor|HugePages|ParallelFirstTouch> BigMatrix;
+  * \endcode
+  *
+  * With #ParallelFirstTouch, the arrays are zeroed by the threads of parallelScheduler() in the same ranges as
+  * a multi-threaded assignment to the whole array. On a NUMA system with a first-touch policy, and a scheduler
+  * running the same part of the tasks on the same threads such as an OpenMP scheduler with bound threads, the pages
+  * are thus local to the threads which later assign them.
+  *
+  * The policies only apply to the scalar types which do not require initialization, such as the builtin types.
+  * Huge pages are only supported on Linux, and are otherwise ignored. This function is not thread-safe.
+  *
+  * \sa allocationPolicy() */
+inline void setAllocationPolicy(int policy, std::size_t threshold = 16 * EIGEN_HUGE_PAGE_BYTES)
+{
+  eigen_assert((policy & ~(HugePages|ParallelFirstTouch))==0 && "invalid allocation policy");
+  internal::manage_allocation_policy(SetAction, &policy, &threshold);
+}
+
+/** \returns the global allocation policy of the dynamic arrays of coefficients
+  * \sa setAllocationPolicy() */
+inline int allocationPolicy()
+{
+  int policy;
+  std::size_t threshold;
+  internal::manage_allocation_policy(GetAction, &policy, &threshold);
+  return policy;
+}
+
+/** \class ScratchAllocator
+  * \ingroup Core_Module
+  *
+  * \brief Interface of the allocators of Eigen's internal scratch buffers
+  *
+  * Scratch buffers are short-lived buffers used internally by Eigen's kernels, such as the packed panels
+  * of the matrix products, or the temporary vectors of the matrix-vector products, triangular solvers and
+  * decompositions which are too large to be allocated on the stack. By default, they are allocated on the
+  * heap with the same functions as the matrices. Installing a ScratchAllocator with setScratchAllocator()
+  * or ScopedScratchAllocator allows to serve them from a custom memory pool.
+  *
+  * Buffers are released in the reverse order of their allocation within a given thread.
+  *
+  * \sa ScratchArena, setScratchAllocator(), ScopedScratchAllocator
+  */
+class ScratchAllocator
+{
+  public:
+    virtual ~ScratchAllocator() {}
+
+    /** \returns a buffer of \a size bytes aligned on EIGEN_ALIGN_BYTES. On failure, std::bad_alloc is thrown. */
+    virtual void* allocate(std::size_t size) = 0;
+
+    /** Releases the buffer \a ptr of \a size bytes returned by allocate() */
+    virtual void deallocate(void* ptr, std::size_t size) = 0;
+};
+
+namespace internal {
+
+#ifdef EIGEN_THREAD_LOCAL
+/** \internal \returns the scratch allocator of the calling thread set by ScopedScratchAllocator, if any */
+inline ScratchAllocator*& local_scratch_allocator()
+{
+  static EIGEN_THREAD_LOCAL ScratchAllocator* m_allocator = 0;
+  return m_allocator;
+}
+#endif
+
+/** \internal */
+inline void manage_scratch_allocator(Action action, ScratchAllocator** a)
+{
+  static ScratchAllocator* m_allocator = 0;
+
+  eigen_internal_assert(a!=0);
+  if(action==SetAction)
+  {
+    m_allocator = *a;
+  }
+  else if(action==GetAction)
+  {
+    *a = m_allocator;
+#ifdef EIGEN_THREAD_LOCAL
+    // the allocator of the calling thread has the priority over the global one
+    if(local_scratch_allocator())
+      *a = local_scratch_allocator();
+#endif
+  }
+  else
+  {
+    eigen_internal_assert(false);
+  }
+}
+
+/** \internal \returns the current scratch allocator of the calling thread, or a null pointer for the heap */
+inline ScratchAllocator* current_scratch_allocator()
+{
+  ScratchAllocator* allocator;
+  manage_scratch_allocator(GetAction, &allocator);
+  return allocator;
+}
+
+/** \internal Allocates a scratch buffer of \a size bytes aligned like aligned_malloc(), through the current
+  * ScratchAllocator if any. The caller records this allocator with current_scratch_allocator() to free the buffer. */
+inline void* scratch_malloc(std::size_t size)
+{
+  ScratchAllocator* allocator = current_scratch_allocator();
+  return allocator ? allocator->allocate(size) : aligned_malloc(size);
+}
+
+/** \internal Frees a buffer of \a size bytes allocated with scratch_malloc() while \a owner was the current
+  * scratch allocator. The buffer goes back to \a owner even if the current allocator has changed since. */
+inline void scratch_free(void* ptr, std::size_t size, ScratchAllocator* owner)
+{
+  if(ptr==0)
+    return;
+  if(owner)
+    owner->deallocate(ptr, size);
+  else
+    aligned_free(ptr);
+}
+
+/** \internal Same as aligned_new() for a scratch buffer, see scratch_malloc() */
+template<typename T> inline T* scratch_new(size_t size)
+{
+  check_size_for_overflow<T>(size);
+  T *result = reinterpret_cast<T*>(scratch_malloc(sizeof(T)*size));
+  EIGEN_TRY
+  {
+    return construct_elements_of_array(result, size);
+  }
+  EIGEN_CATCH(...)
+  {
+    scratch_free(result, sizeof(T)*size, current_scratch_allocator());
+    EIGEN_THROW;
+  }
+}
+
+/** \internal Deletes objects constructed with scratch_new() while \a owner was the current scratch allocator */
+template<typename T> inline void scratch_delete(T *ptr, size_t size, ScratchAllocator* owner)
+{
+  destruct_elements_of_array<T>(ptr, size);
+  scratch_free(ptr, sizeof(T)*size, owner);
+}
+
+} // end namespace internal
+
+/** \returns the allocator of the scratch buffers of the calling thread, or a null pointer if they are allocated
+  * on the heap.
+  * \sa setScratchAllocator(), ScopedScratchAllocator */
+inline ScratchAllocator* scratchAllocator()
+{
+  return internal::current_scratch_allocator();
+}
+
+/** Sets the allocator of Eigen's scratch buffers for all threads. A null pointer restores the heap allocation.
+  *
+  * The allocator must outlive its use by Eigen, and be thread-safe if Eigen is called from several threads,
+  * including the threads of the multi-threaded products. A ScratchArena is not, and should rather be installed
+  * for a single thread with ScopedScratchAllocator.
+  *
+  * \sa scratchAllocator(), ScopedScratchAllocator */
+inline void setScratchAllocator(ScratchAllocator* allocator)
+{
+  internal::manage_scratch_allocator(SetAction, &allocator);
+}
+
+/** \class ScratchArena
+  * \ingroup Core_Module
+  *
+  * \brief A ScratchAllocator serving the scratch buffers from a preallocated block of memory
+  *
+  * The buffers are carved out of a single block of \a capacity bytes allocated at construction, by bumping an
+  * offset, so that allocating and releasing them is only a few instructions and never touches the heap.
+  * A buffer which does not fit in the remaining space falls back to the heap.
+  *
+  * An arena is not thread-safe: it is meant to be installed for a given thread with ScopedScratchAllocator,
+  * which also releases all the buffers allocated during its lifetime:
+  * \code
+  * Eigen::ScratchArena arena(32*1024*1024);
+  * for(int k=0; k<n; ++k)
+  * {
+  *   Eigen::ScopedScratchAllocator guard(&arena);
+  *   C.noalias() = A * B;   // the packed panels are taken from the arena
+  *   x = lu.compute(M).solve(b);
+  * }
+  * \endcode
+  * The peak() usage of the arena allows to tune its capacity.
+  *
+  * \sa ScratchAllocator, ScopedScratchAllocator
+  */
+class ScratchArena : public ScratchAllocator
+{
+  public:
+    /** Constructs an arena of \a capacity bytes */
+    explicit ScratchArena(std::size_t capacity = 0)
+      : m_data(capacity ? static_cast<char*>(internal::aligned_malloc(capacity)) : 0), m_capacity(capacity), m_used(0), m_overflow(0), m_peak(0)
+    {}
+
+    ~ScratchArena()
+    {
+      internal::aligned_free(m_data);
+    }
+
+    void* allocate(std::size_t size)
+    {
+      std::size_t bytes = internal::first_multiple<std::size_t>(size, EIGEN_ALIGN_BYTES);
+      void* result;
+      if(bytes > m_capacity - m_used)
+      {
+        result = internal::aligned_malloc(size);
+        m_overflow += bytes;
+      }
+      else
+      {
+        result = m_data + m_used;
+        m_used += bytes;
+      }
+      m_peak = (std::max)(m_peak, m_used + m_overflow);
+      return result;
+    }
+
+    void deallocate(void* ptr, std::size_t size)
+    {
+      char* p = static_cast<char*>(ptr);
+      std::size_t bytes = internal::first_multiple<std::size_t>(size, EIGEN_ALIGN_BYTES);
+      if(p<m_data || p>=m_data+m_capacity)
+      {
+        internal::aligned_free(ptr);
+        m_overflow -= (std::min)(m_overflow, bytes);
+      }
+      else if(p + bytes == m_data + m_used)
+        m_used = p - m_data;
+    }
+
+    /** \returns the size in bytes of the arena */
+    std::size_t capacity() const { return m_capacity; }
+
+    /** \returns the number of bytes currently allocated from the arena */
+    std::size_t used() const { return m_used; }
+
+    /** \returns the largest number of bytes requested at once, including the buffers which did not fit in the arena */
+    std::size_t peak() const { return m_peak; }
+
+    /** Grows the arena to at least \a capacity bytes. This must not be called while some buffers are allocated. */
+    void reserve(std::size_t capacity)
+    {
+      eigen_assert(m_used==0 && "the buffers of the arena must be released before growing it");
+      if(capacity <= m_capacity)
+        return;
+      internal::aligned_free(m_data);
+      m_data = 0;
+      m_capacity = 0;
+      m_data = static_cast<char*>(internal::aligned_malloc(capacity));
+      m_capacity = capacity;
+    }
+
+    /** Releases all the buffers allocated from the arena */
+    void reset() { m_used = 0; }
+
+    /** \internal */
+    void resetTo(std::size_t used) { eigen_assert(used<=m_used); m_used = used; }
+
+  private:
+    char* m_data;
+    std::size_t m_capacity;
+    std::size_t m_used;
+    std::size_t m_overflow;
+    std::size_t m_peak;
+
+    ScratchArena(const ScratchArena&);
+    ScratchArena& operator=(const ScratchArena&);
+};
+
+#ifdef EIGEN_THREAD_LOCAL
+/** \class ScopedScratchAllocator
+  * \ingroup Core_Module
+  *
+  * \brief Overrides the scratch allocator of the calling thread for the lifetime of this object
+  *
+  * When the allocator is a ScratchArena, all the buffers allocated from it during the lifetime of this object
+  * are released at its destruction.
+  *
+  * \sa ScratchArena, setScratchAllocator()
+  */
+class ScopedScratchAllocator
+{
+  public:
+    explicit ScopedScratchAllocator(ScratchAllocator* allocator)
+      : m_previous(internal::local_scratch_allocator()), m_arena(0), m_used(0)
+    {
+      internal::local_scratch_allocator() = allocator;
+    }
+
+    explicit ScopedScratchAllocator(ScratchArena* arena)
+      : m_previous(internal::local_scratch_allocator()), m_arena(arena), m_used(arena ? arena->used() : 0)
+    {
+      internal::local_scratch_allocator() = arena;
+    }
+
+    ~ScopedScratchAllocator()
+    {
+      internal::local_scratch_allocator() = m_previous;
+      if(m_arena)
+        m_arena->resetTo(m_used);
+    }
+
+  private:
+    ScratchAllocator* m_previous;
+    ScratchArena* m_arena;
+    std::size_t m_used;
+
+    ScopedScratchAllocator(const ScopedScratchAllocator&);
+    ScopedScratchAllocator& operator=(const ScopedScratchAllocator&);
+};
+#endif // EIGEN_THREAD_LOCAL
+
+namespace internal {
+
+/** \internal Holds the scratch buffers of the repeated calls to a function, typically the compute() method
+  * of a decomposition, see scoped_scratch_workspace. Copies start with an empty workspace. */
+class scratch_workspace
+{
+  public:
+    scratch_workspace() {}
+    scratch_workspace(const scratch_workspace&) {}
+    scratch_workspace& operator=(const scratch_workspace&) { return *this; }
+    ScratchArena& arena() { return m_arena; }
+  protected:
+    ScratchArena m_arena;
+};
+
+/** \internal Serves the scratch buffers of the calling thread from \a workspace during the lifetime of this
+  * object, and then grows the workspace to the peak usage. Therefore, a subsequent call requesting the same
+  * scratch buffers does not allocate on the heap, as long as the products are not multi-threaded. */
+class scoped_scratch_workspace : noncopyable
+{
+  public:
+#ifdef EIGEN_THREAD_LOCAL
+    explicit scoped_scratch_workspace(scratch_workspace& workspace)
+      : m_arena(workspace.arena()), m_previous(local_scratch_allocator())
+    {
+      local_scratch_allocator() = &m_arena;
+    }
+
+    ~scoped_scratch_workspace()
+    {
+      local_scratch_allocator() = m_previous;
+      EIGEN_TRY
+      {
+        if(m_arena.used()==0)
+          m_arena.reserve(m_arena.peak());
+      }
+      EIGEN_CATCH(...) {}
+    }
+
+  protected:
+    ScratchArena& m_arena;
+    ScratchAllocator* m_previous;
+#else
+    explicit scoped_scratch_workspace(scratch_workspace&) {}
+#endif
+};
+
+/** \internal Stands for scratch_workspace in the fixed-size decompositions, whose temporaries are not allocated */
+struct no_scratch_workspace {};
+
+/** \internal Stands for scoped_scratch_workspace in the fixed-size decompositions, and does nothing */
+struct no_scoped_scratch_workspace : noncopyable
+{
+  explicit no_scoped_scratch_workspace(no_scratch_workspace&) {}
+};
+
+/** \internal The type of the workspace of a decomposition of \a MatrixType, and of the scope serving the scratch
+  * buffers of its compute() method from it. Only the dynamic-size decompositions keep a workspace. */
+template<typename MatrixType> struct decomposition_workspace
+{
+  enum { HasWorkspace = MatrixType::SizeAtCompileTime==Dynamic };
+  typedef typename conditional<HasWorkspace, scratch_workspace, no_scratch_workspace>::type type;
+  typedef typename conditional<HasWorkspace, scoped_scratch_workspace, no_scoped_scratch_workspace>::type scope_type;
+};
+
 /*****************************************************************************
 *** Implementation of runtime stack allocation (falling back to malloc)    ***
 *****************************************************************************/
@@ -629,7 +1144,7 @@ template<typename T> class aligned_stack_memory_handler : noncopyable
      * Finally, if \a dealloc is true, then the pointer \a ptr is freed.
      **/
     aligned_stack_memory_handler(T* ptr, size_t size, bool dealloc)
-      : m_ptr(ptr), m_size(size), m_deallocate(dealloc)
+      : m_ptr(ptr), m_size(size), m_deallocate(dealloc), m_allocator(dealloc ? current_scratch_allocator() : 0)
     {
       if(NumTraits<T>::RequireInitialization && m_ptr)
         Eigen::internal::construct_elements_of_array(m_ptr, size);
@@ -639,12 +1154,13 @@ template<typename T> class aligned_stack_memory_handler : noncopyable
       if(NumTraits<T>::RequireInitialization && m_ptr)
         Eigen::internal::destruct_elements_of_array<T>(m_ptr, m_size);
       if(m_deallocate)
-        Eigen::internal::aligned_free(m_ptr);
+        Eigen::internal::scratch_free(m_ptr, sizeof(T)*m_size, m_allocator);
     }
   protected:
     T* m_ptr;
     size_t m_size;
     bool m_deallocate;
+    ScratchAllocator* m_allocator;
 };
 
 template<typename T> class scoped_array : noncopyable
@@ -676,7 +1192,8 @@ template<typename T> void swap(scoped_array<T> &a,scoped_array<T> &b)
 /** \internal
   * Declares, allocates and construct an aligned buffer named NAME of SIZE elements of type TYPE on the stack
   * if SIZE is smaller than EIGEN_STACK_ALLOCATION_LIMIT, and if stack allocation is supported by the platform
-  * (currently, this is Linux and Visual Studio only). Otherwise the memory is allocated on the heap.
+  * (currently, this is Linux and Visual Studio only). Otherwise the memory is allocated with scratch_malloc(),
+  * i.e., on the heap unless a ScratchAllocator is installed.
   * The allocated buffer is automatically deleted when exiting the scope of this declaration.
   * If BUFFER is non null, then the declared variable is simply an alias for BUFFER, and no allocation/deletion occurs.
   * Here is an example:
@@ -698,14 +1215,14 @@ template<typename T> void swap(scoped_array<T> &a,scoped_array<T> &b)
     TYPE* NAME = (BUFFER)!=0 ? (BUFFER) \
                : reinterpret_cast<TYPE*>( \
                       (sizeof(TYPE)*SIZE<=EIGEN_STACK_ALLOCATION_LIMIT) ? EIGEN_ALIGNED_ALLOCA(sizeof(TYPE)*SIZE) \
-                    : Eigen::internal::aligned_malloc(sizeof(TYPE)*SIZE) );  \
+                    : Eigen::internal::scratch_malloc(sizeof(TYPE)*SIZE) );  \
     Eigen::internal::aligned_stack_memory_handler<TYPE> EIGEN_CAT(NAME,_stack_memory_destructor)((BUFFER)==0 ? NAME : 0,SIZE,sizeof(TYPE)*SIZE>EIGEN_STACK_ALLOCATION_LIMIT)
 
 #else
 
   #define ei_declare_aligned_stack_constructed_variable(TYPE,NAME,SIZE,BUFFER) \
     Eigen::internal::check_size_for_overflow<TYPE>(SIZE); \
-    TYPE* NAME = (BUFFER)!=0 ? BUFFER : reinterpret_cast<TYPE*>(Eigen::internal::aligned_malloc(sizeof(TYPE)*SIZE));    \
+    TYPE* NAME = (BUFFER)!=0 ? BUFFER : reinterpret_cast<TYPE*>(Eigen::internal::scratch_malloc(sizeof(TYPE)*SIZE));    \
     Eigen::internal::aligned_stack_memory_handler<TYPE> EIGEN_CAT(NAME,_stack_memory_destructor)((BUFFER)==0 ? NAME : 0,SIZE,true)
     
 #endif
@@ -1032,8 +1549,134 @@ inline int queryTopLevelCacheSize()
   return (std::max)(l2,l3);
 }
 
+//---------- CPU features ----------
+
+#if !defined(EIGEN_NO_CPUID) && defined(EIGEN_CPUID)
+#  if EIGEN_COMP_GNUC
+#    define EIGEN_XGETBV(eax,edx) __asm__ __volatile__ (".byte 0x0f, 0x01, 0xd0": "=a" (eax), "=d" (edx) : "c" (0))
+#  elif EIGEN_COMP_MSVC >= 1600
+#    define EIGEN_XGETBV(eax,edx) { unsigned __int64 xcr0 = _xgetbv(0); eax = int(xcr0); edx = int(xcr0>>32); }
+#  endif
+#endif
+
+/** \internal Flags of the SIMD instruction sets reported by queryCpuFeatures() */
+enum CpuFeatures {
+  CpuSSE2   = 0x1,
+  CpuSSE3   = 0x2,
+  CpuSSSE3  = 0x4,
+  CpuSSE4_1 = 0x8,
+  CpuSSE4_2 = 0x10,
+  CpuAVX    = 0x20,
+  CpuAVX2   = 0x40,
+  CpuFMA    = 0x80,
+  CpuF16C   = 0x100
+};
+
+/** \internal
+ * Queries the SIMD instruction sets supported by the CPU and the OS.
+ * \returns a combination of CpuFeatures flags, or -1 if they cannot be queried */
+inline int queryCpuFeatures()
+{
+  #ifdef EIGEN_CPUID
+  int abcd[4];
+  abcd[0] = abcd[1] = abcd[2] = abcd[3] = 0;
+  EIGEN_CPUID(abcd,0x0,0);
+  int max_std_funcs = abcd[0];
+  if(max_std_funcs<1)
+    return 0;
+
+  int features = 0;
+  EIGEN_CPUID(abcd,0x1,0);
+  if(abcd[3] & (1<<26)) features |= CpuSSE2;
+  if(abcd[2] & (1<<0))  features |= CpuSSE3;
+  if(abcd[2] & (1<<9))  features |= CpuSSSE3;
+  if(abcd[2] & (1<<19)) features |= CpuSSE4_1;
+  if(abcd[2] & (1<<20)) features |= CpuSSE4_2;
+
+  // AVX registers must also be saved and restored by the OS, as reported by XCR0
+  bool os_saves_ymm = false;
+  #ifdef EIGEN_XGETBV
+  if(abcd[2] & (1<<27))
+  {
+    int xcr0_lo, xcr0_hi;
+    EIGEN_XGETBV(xcr0_lo,xcr0_hi);
+    EIGEN_UNUSED_VARIABLE(xcr0_hi);
+    os_saves_ymm = (xcr0_lo & 0x6) == 0x6;
+  }
+  #endif
+  if(os_saves_ymm)
+  {
+    if(abcd[2] & (1<<28)) features |= CpuAVX;
+    if(abcd[2] & (1<<12)) features |= CpuFMA;
+    if(abcd[2] & (1<<29)) features |= CpuF16C;
+    if(max_std_funcs>=7)
+    {
+      EIGEN_CPUID(abcd,0x7,0);
+      if(abcd[1] & (1<<5)) features |= CpuAVX2;
+    }
+  }
+  return features;
+  #else
+  return -1;
+  #endif
+}
+
+/** \internal
+ * \returns the combination of CpuFeatures flags required by the SIMD instruction sets Eigen has been compiled for */
+inline int requiredCpuFeatures()
+{
+  int features = 0;
+  #ifdef EIGEN_VECTORIZE_SSE2
+  features |= CpuSSE2;
+  #endif
+  #ifdef EIGEN_VECTORIZE_SSE3
+  features |= CpuSSE3;
+  #endif
+  #ifdef EIGEN_VECTORIZE_SSSE3
+  features |= CpuSSSE3;
+  #endif
+  #ifdef EIGEN_VECTORIZE_SSE4_1
+  features |= CpuSSE4_1;
+  #endif
+  #ifdef EIGEN_VECTORIZE_SSE4_2
+  features |= CpuSSE4_2;
+  #endif
+  #ifdef EIGEN_VECTORIZE_AVX
+  features |= CpuAVX;
+  #endif
+  #ifdef EIGEN_VECTORIZE_AVX2
+  features |= CpuAVX2;
+  #endif
+  #ifdef EIGEN_VECTORIZE_FMA
+  features |= CpuFMA;
+  #endif
+  #ifdef EIGEN_VECTORIZE_F16C
+  features |= CpuF16C;
+  #endif
+  return features;
+}
+
 } // end namespace internal
 
+/** \returns true if the CPU running the program supports all the SIMD instruction sets Eigen has been compiled for,
+  * or if this cannot be determined (e.g., on non x86 platforms).
+  *
+  * This allows a program shipping several builds of its Eigen kernels, each compiled for a different instruction set,
+  * to pick at runtime the fastest one supported by the host. Each build must be compiled in its own translation unit with
+  * the respective compiler flags (e.g., \c -msse2, \c -mavx, \c -mavx2 \c -mfma), and its Eigen symbols must not
+  * be shared with the other builds, see \ref TopicVectorization_RuntimeDispatch.
+  *
+  * \sa SimdInstructionSetsInUse()
+  */
+inline bool cpuSupportsInstructionSetsInUse()
+{
+  static int features = internal::queryCpuFeatures();
+  if(features<0)
+    return true;
+  int required = internal::requiredCpuFeatures();
+  return (features & required) == required;
+}
+
 } // end namespace Eigen
 
 #endif // EIGEN_MEMORY_H
@@ -362,6 +362,9 @@ template<typename _MatrixType> class SelfAdjointEigenSolver
     RealVectorType m_eivalues;
     typename TridiagonalizationType::SubDiagonalType m_subdiag;
     ComputationInfo m_info;
+#ifndef __CUDACC__
+    typename internal::decomposition_workspace<MatrixType>::type m_workspace;
+#endif
     bool m_isInitialized;
     bool m_eigenvectorsOk;
 };
@@ -415,6 +418,11 @@ SelfAdjointEigenSolver<MatrixType>& SelfAdjointEigenSolver<MatrixType>
     return *this;
   }
 
+#ifndef __CUDACC__
+  // the temporaries of the tridiagonalization are kept for the next calls
+  typename internal::decomposition_workspace<MatrixType>::scope_type workspace(m_workspace);
+#endif
+
   // declare some aliases
   RealVectorType& diag = m_eivalues;
   EigenvectorsType& mat = m_eivec;
@@ -434,12 +434,29 @@ void tridiagonalization_inplace(MatrixType& mat, DiagonalType& diag, SubDiagonal
 template<typename MatrixType, int Size, bool IsComplex>
 struct tridiagonalization_inplace_selector
 {
+  typedef typename MatrixType::Scalar Scalar;
   typedef typename Tridiagonalization<MatrixType>::CoeffVectorType CoeffVectorType;
-  typedef typename Tridiagonalization<MatrixType>::HouseholderSequenceType HouseholderSequenceType;
   template<typename DiagonalType, typename SubDiagonalType>
   static void run(MatrixType& mat, DiagonalType& diag, SubDiagonalType& subdiag, bool extractQ)
   {
-    CoeffVectorType hCoeffs(mat.cols()-1);
+    if(MatrixType::MaxColsAtCompileTime!=Dynamic)
+    {
+      CoeffVectorType hCoeffs(mat.cols()-1);
+      run(mat, diag, subdiag, hCoeffs, extractQ);
+    }
+    else
+    {
+      // dynamic Householder coefficients are a scratch buffer, see SelfAdjointEigenSolver::compute()
+      ei_declare_aligned_stack_constructed_variable(Scalar, hCoeffsData, mat.cols()-1, 0);
+      Map<CoeffVectorType> hCoeffs(hCoeffsData, mat.cols()-1);
+      run(mat, diag, subdiag, hCoeffs, extractQ);
+    }
+  }
+
+  template<typename DiagonalType, typename SubDiagonalType, typename HCoeffsType>
+  static void run(MatrixType& mat, DiagonalType& diag, SubDiagonalType& subdiag, HCoeffsType& hCoeffs, bool extractQ)
+  {
+    typedef HouseholderSequence<MatrixType,typename internal::remove_all<typename HCoeffsType::ConjugateReturnType>::type> HouseholderSequenceType;
     tridiagonalization_inplace(mat,hCoeffs);
     diag = mat.diagonal().real();
     subdiag = mat.template diagonal<-1>().real();
@@ -50,9 +50,13 @@ namespace internal {
 template<typename TriangularFactorType,typename VectorsType,typename CoeffsType>
 void make_block_householder_triangular_factor(TriangularFactorType& triFactor, const VectorsType& vectors, const CoeffsType& hCoeffs)
 {
+  typedef typename TriangularFactorType::Scalar Scalar;
   const Index nbVecs = vectors.cols();
   eigen_assert(triFactor.rows() == nbVecs && triFactor.cols() == nbVecs && vectors.rows()>=nbVecs);
 
+  // the triangular product cannot work inplace
+  ei_declare_aligned_stack_constructed_variable(Scalar, tmpData, nbVecs, 0);
+
   for(Index i = nbVecs-1; i >=0 ; --i)
   {
     Index rs = vectors.rows() - i - 1;
@@ -60,12 +64,10 @@ void make_block_householder_triangular_factor(TriangularFactorType& triFactor, c
 
     if(rt>0)
     {
-      triFactor.row(i).tail(rt).noalias() = -hCoeffs(i) * vectors.col(i).tail(rs).adjoint()
-                                                        * vectors.bottomRightCorner(rs, rt).template triangularView<UnitLower>();
-            
-      // FIXME add .noalias() once the triangular product can work inplace
-      triFactor.row(i).tail(rt) = triFactor.row(i).tail(rt) * triFactor.bottomRightCorner(rt,rt).template triangularView<Upper>();
-      
+      Map<Matrix<Scalar,1,Dynamic> > tmp(tmpData, rt);
+      tmp.noalias() = -hCoeffs(i) * vectors.col(i).tail(rs).adjoint()
+                                  * vectors.bottomRightCorner(rs, rt).template triangularView<UnitLower>();
+      triFactor.row(i).tail(rt).noalias() = tmp * triFactor.bottomRightCorner(rt,rt).template triangularView<Upper>();
     }
     triFactor(i,i) = hCoeffs(i);
   }
@@ -78,21 +80,29 @@ void make_block_householder_triangular_factor(TriangularFactorType& triFactor, c
 template<typename MatrixType,typename VectorsType,typename CoeffsType>
 void apply_block_householder_on_the_left(MatrixType& mat, const VectorsType& vectors, const CoeffsType& hCoeffs, bool forward)
 {
+  typedef typename MatrixType::Scalar Scalar;
   enum { TFactorSize = MatrixType::ColsAtCompileTime };
+  typedef Matrix<Scalar,VectorsType::ColsAtCompileTime,MatrixType::ColsAtCompileTime,0,
+                 VectorsType::MaxColsAtCompileTime,MatrixType::MaxColsAtCompileTime> TmpType;
   Index nbVecs = vectors.cols();
-  Matrix<typename MatrixType::Scalar, TFactorSize, TFactorSize, RowMajor> T(nbVecs,nbVecs);
+
+  // the temporaries are scratch buffers, so that they can be kept by the callers, see scoped_scratch_workspace
+  ei_declare_aligned_stack_constructed_variable(Scalar, tData, nbVecs*nbVecs, 0);
+  ei_declare_aligned_stack_constructed_variable(Scalar, tmpData, nbVecs*mat.cols(), 0);
+  ei_declare_aligned_stack_constructed_variable(Scalar, ttmpData, nbVecs*mat.cols(), 0);
+  Map<Matrix<Scalar, TFactorSize, TFactorSize, RowMajor> > T(tData, nbVecs, nbVecs);
+  Map<TmpType> tmp(tmpData, nbVecs, mat.cols());
+  Map<TmpType> ttmp(ttmpData, nbVecs, mat.cols());
   
   if(forward) make_block_householder_triangular_factor(T, vectors, hCoeffs);
   else        make_block_householder_triangular_factor(T, vectors, hCoeffs.conjugate());  
   const TriangularView<const VectorsType, UnitLower> V(vectors);
 
   // A -= V T V^* A
-  Matrix<typename MatrixType::Scalar,VectorsType::ColsAtCompileTime,MatrixType::ColsAtCompileTime,0,
-         VectorsType::MaxColsAtCompileTime,MatrixType::MaxColsAtCompileTime> tmp = V.adjoint() * mat;
-  // FIXME add .noalias() once the triangular product can work inplace
-  if(forward) tmp = T.template triangularView<Upper>()           * tmp;
-  else        tmp = T.template triangularView<Upper>().adjoint() * tmp;
-  mat.noalias() -= V * tmp;
+  tmp.noalias() = V.adjoint() * mat;
+  if(forward) ttmp.noalias() = T.template triangularView<Upper>()           * tmp;
+  else        ttmp.noalias() = T.template triangularView<Upper>().adjoint() * tmp;
+  mat.noalias() -= V * ttmp;
 }
 
 } // end namespace internal
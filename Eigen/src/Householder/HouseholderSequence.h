@@ -232,9 +232,20 @@ template<typename VectorsType, typename CoeffsType, int Side> class HouseholderS
     /** \internal */
     template<typename DestType> inline void evalTo(DestType& dst) const
     {
-      Matrix<Scalar, DestType::RowsAtCompileTime, 1,
-             AutoAlign|ColMajor, DestType::MaxRowsAtCompileTime, 1> workspace(rows());
-      evalTo(dst, workspace);
+      typedef Matrix<Scalar, DestType::RowsAtCompileTime, 1,
+                     AutoAlign|ColMajor, DestType::MaxRowsAtCompileTime, 1> WorkspaceType;
+      if(DestType::MaxRowsAtCompileTime!=Dynamic)
+      {
+        WorkspaceType workspace(rows());
+        evalTo(dst, workspace);
+      }
+      else
+      {
+        // dynamic workspaces are scratch buffers, so that they can be kept by the callers
+        ei_declare_aligned_stack_constructed_variable(Scalar, workspaceData, rows(), 0);
+        Map<WorkspaceType> workspace(workspaceData, rows());
+        evalTo(dst, workspace);
+      }
     }
 
     /** \internal */
@@ -12,6 +12,102 @@
 
 namespace Eigen { 
 
+namespace internal {
+
+// the matrices which can be held by a Ref<const MatrixType>
+template<typename MatrixType>
+struct is_ref_compatible
+{
+  enum { value = is_same<typename traits<MatrixType>::StorageKind, Dense>::value };
+};
+
+template<typename _Scalar, int _Options, typename _StorageIndex>
+struct is_ref_compatible<SparseMatrix<_Scalar,_Options,_StorageIndex> >
+{
+  enum { value = true };
+};
+
+/** \internal Holds the matrix of an iterative solver: matrices compatible with Ref<> are referenced through a
+  * Ref<const MatrixType>, while any other matrix type, e.g., a matrix-free operator or a sparse format providing its
+  * own products, is referenced through a plain pointer and used as is. In the latter case, the matrix is always used
+  * as a full matrix, so that ConjugateGradient requires the \c Lower|Upper mode.
+  */
+template<typename MatrixType, bool MatrixFree = !is_ref_compatible<MatrixType>::value>
+class generic_matrix_wrapper;
+
+template<typename MatrixType>
+class generic_matrix_wrapper<MatrixType,false>
+{
+  public:
+    typedef Ref<const MatrixType> ActualMatrixType;
+    template<int UpLo> struct ConstSelfAdjointViewReturnType {
+      typedef typename ActualMatrixType::template ConstSelfAdjointViewReturnType<UpLo>::Type Type;
+    };
+    enum { MatrixFree = false };
+
+    generic_matrix_wrapper() : m_dummy(0,0), m_matrix(m_dummy) {}
+
+    template<typename InputType>
+    explicit generic_matrix_wrapper(const InputType& mat) : m_matrix(mat) {}
+
+    const ActualMatrixType& matrix() const { return m_matrix; }
+
+    Index rows() const { return m_matrix.rows(); }
+    Index cols() const { return m_matrix.cols(); }
+
+    template<typename MatrixDerived>
+    void grab(const EigenBase<MatrixDerived>& mat)
+    {
+      m_matrix.~Ref<const MatrixType>();
+      ::new (&m_matrix) Ref<const MatrixType>(mat.derived());
+    }
+
+    void grab(const Ref<const MatrixType>& mat)
+    {
+      if(&(mat.derived()) != &m_matrix)
+      {
+        m_matrix.~Ref<const MatrixType>();
+        ::new (&m_matrix) Ref<const MatrixType>(mat);
+      }
+    }
+
+  protected:
+    MatrixType m_dummy;
+    ActualMatrixType m_matrix;
+};
+
+template<typename MatrixType>
+class generic_matrix_wrapper<MatrixType,true>
+{
+  public:
+    typedef MatrixType ActualMatrixType;
+    template<int UpLo> struct ConstSelfAdjointViewReturnType {
+      typedef const ActualMatrixType& Type;
+    };
+    enum { MatrixFree = true };
+
+    generic_matrix_wrapper() : mp_matrix(0) {}
+
+    explicit generic_matrix_wrapper(const MatrixType& mat) : mp_matrix(&mat) {}
+
+    const ActualMatrixType& matrix() const
+    {
+      eigen_assert(mp_matrix && "The solver has not been given a matrix");
+      return *mp_matrix;
+    }
+
+    // a default constructed solver has no matrix yet
+    Index rows() const { return mp_matrix ? mp_matrix->rows() : 0; }
+    Index cols() const { return mp_matrix ? mp_matrix->cols() : 0; }
+
+    void grab(const MatrixType& mat) { mp_matrix = &mat; }
+
+  protected:
+    const ActualMatrixType* mp_matrix;
+};
+
+} // end namespace internal
+
 /** \ingroup IterativeLinearSolvers_Module
   * \brief Base class for linear iterative solvers
   *
@@ -37,7 +133,6 @@ public:
 
   /** Default constructor. */
   IterativeSolverBase()
-    : m_dummy(0,0), mp_matrix(m_dummy)
   {
     init();
   }
@@ -51,13 +146,16 @@ public:
     * precomputed values that depend on it. Therefore, if \a A is changed
     * this class becomes invalid. Call compute() to update it with the new
     * matrix A, or modify a copy of A.
+    *
+    * Besides the dense and sparse matrices, \a A can be of any matrix type providing rows(), cols() and the products
+    * with dense vectors, e.g., a SlicedEllpackMatrix. Such matrices are used as full matrices.
     */
   template<typename MatrixDerived>
   explicit IterativeSolverBase(const EigenBase<MatrixDerived>& A)
-    : mp_matrix(A.derived())
+    : m_matrixWrapper(A.derived())
   {
     init();
-    compute(mp_matrix);
+    compute(matrix());
   }
 
   ~IterativeSolverBase() {}
@@ -71,7 +169,7 @@ public:
   Derived& analyzePattern(const EigenBase<MatrixDerived>& A)
   {
     grab(A.derived());
-    m_preconditioner.analyzePattern(mp_matrix);
+    m_preconditioner.analyzePattern(matrix());
     m_isInitialized = true;
     m_analysisIsOk = true;
     m_info = Success;
@@ -92,7 +190,7 @@ public:
   {
     eigen_assert(m_analysisIsOk && "You must first call analyzePattern()"); 
     grab(A.derived());
-    m_preconditioner.factorize(mp_matrix);
+    m_preconditioner.factorize(matrix());
     m_factorizationIsOk = true;
     m_info = Success;
     return derived();
@@ -112,7 +210,7 @@ public:
   Derived& compute(const EigenBase<MatrixDerived>& A)
   {
     grab(A.derived());
-    m_preconditioner.compute(mp_matrix);
+    m_preconditioner.compute(matrix());
     m_isInitialized = true;
     m_analysisIsOk = true;
     m_factorizationIsOk = true;
@@ -121,10 +219,10 @@ public:
   }
 
   /** \internal */
-  Index rows() const { return mp_matrix.rows(); }
+  Index rows() const { return m_matrixWrapper.rows(); }
 
   /** \internal */
-  Index cols() const { return mp_matrix.cols(); }
+  Index cols() const { return m_matrixWrapper.cols(); }
 
   /** \returns the tolerance threshold used by the stopping criteria.
     * \sa setTolerance()
@@ -154,7 +252,7 @@ public:
     */
   Index maxIterations() const
   {
-    return (m_maxIterations<0) ? 2*mp_matrix.cols() : m_maxIterations;
+    return (m_maxIterations<0) ? 2*cols() : m_maxIterations;
   }
   
   /** Sets the max number of iterations.
@@ -231,24 +329,21 @@ protected:
     m_tolerance = NumTraits<Scalar>::epsilon();
   }
   
-  template<typename MatrixDerived>
-  void grab(const EigenBase<MatrixDerived> &A)
+  typedef internal::generic_matrix_wrapper<MatrixType> MatrixWrapper;
+  typedef typename MatrixWrapper::ActualMatrixType ActualMatrixType;
+
+  const ActualMatrixType& matrix() const
   {
-    mp_matrix.~Ref<const MatrixType>();
-    ::new (&mp_matrix) Ref<const MatrixType>(A.derived());
+    return m_matrixWrapper.matrix();
   }
   
-  void grab(const Ref<const MatrixType> &A)
+  template<typename InputType>
+  void grab(const InputType &A)
   {
-    if(&(A.derived()) != &mp_matrix)
-    {
-      mp_matrix.~Ref<const MatrixType>();
-      ::new (&mp_matrix) Ref<const MatrixType>(A);
-    }
+    m_matrixWrapper.grab(A);
   }
   
-  MatrixType m_dummy;
-  Ref<const MatrixType> mp_matrix;
+  MatrixWrapper m_matrixWrapper;
   Preconditioner m_preconditioner;
 
   Index m_maxIterations;
@@ -218,6 +218,7 @@ template<typename _MatrixType> class PartialPivLU
     MatrixType m_lu;
     PermutationType m_p;
     TranspositionType m_rowsTranspositions;
+    typename internal::decomposition_workspace<MatrixType>::type m_workspace;
     Index m_det_p;
     bool m_isInitialized;
 };
@@ -436,6 +437,9 @@ PartialPivLU<MatrixType>& PartialPivLU<MatrixType>::compute(const MatrixType& ma
   // the row permutation is stored as int indices, so just to be sure:
   eigen_assert(matrix.rows()<NumTraits<int>::highest());
   
+  // the temporaries of the blocked algorithm are kept for the next calls
+  typename internal::decomposition_workspace<MatrixType>::scope_type workspace(m_workspace);
+
   m_lu = matrix;
 
   eigen_assert(matrix.rows() == matrix.cols() && "PartialPivLU is only for square (and moreover invertible) matrices");
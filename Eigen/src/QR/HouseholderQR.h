@@ -205,6 +205,7 @@ template<typename _MatrixType> class HouseholderQR
     MatrixType m_qr;
     HCoeffsType m_hCoeffs;
     RowVectorType m_temp;
+    typename internal::decomposition_workspace<MatrixType>::type m_workspace;
     bool m_isInitialized;
 };
 
@@ -360,6 +361,8 @@ HouseholderQR<MatrixType>& HouseholderQR<MatrixType>::compute(const MatrixType&
   Index cols = matrix.cols();
   Index size = (std::min)(rows,cols);
 
+  // the block reflectors and the products allocate from the workspace, which is kept for the next call
+  typename internal::decomposition_workspace<MatrixType>::scope_type workspace(m_workspace);
   m_qr = matrix;
   m_hCoeffs.resize(size);
 
@@ -14,15 +14,245 @@ namespace Eigen {
 
 namespace internal {
 
+/* Multi-threaded sparse * sparse products:
+ * The products performing enough multiply-adds are computed column by column of the result in two passes, the
+ * columns being split into one contiguous range per thread so that the threads perform about as many multiply-adds:
+ * - a symbolic pass counts the nonzeros of each column of the result, which is then allocated at once,
+ * - a numeric pass computes each column in a dense accumulator and writes it in place into the result.
+ * Each thread has its own accumulator, marker and index vectors of the size of a column. The pruned products
+ * drop the small coefficients in the numeric pass, and the columns are then packed together. The multi-threaded
+ * result does not depend on the number of threads, but it may differ in the last bits from the one of the sequential
+ * code, which is used for smaller products, SparseVector results and when a single thread is available.
+ */
+
+/** \internal \returns whether the sparse * sparse products may be multi-threaded */
+inline bool sparse_sparse_product_parallelizable()
+{
+#ifdef EIGEN_HAS_PARALLELIZER
+  ParallelScheduler* scheduler = parallelScheduler();
+  return scheduler!=0 && !scheduler->inParallelRegion() && nbThreads()>1;
+#else
+  return false;
+#endif
+}
+
+/** \internal \returns whether the product \a lhs * \a rhs, whose storage orders are faked like in
+  * conservative_sparse_sparse_product_impl, may be large enough to be multi-threaded. Its multiply-adds are only bounded
+  * from the numbers of nonzeros of the factors, sparse_sparse_product_parallel() counting them afterwards. */
+template<typename Lhs, typename Rhs>
+bool sparse_sparse_product_parallelizable(const Lhs& lhs, const Rhs& rhs)
+{
+  if(!sparse_sparse_product_parallelizable())
+    return false;
+  typename evaluator<Lhs>::type lhsEval(lhs);
+  typename evaluator<Rhs>::type rhsEval(rhs);
+  double lhsNnz = double(lhsEval.nonZerosEstimate());
+  double rhsNnz = double(rhsEval.nonZerosEstimate());
+  // each nonzero of a factor is multiplied by at most a full vector of the other one
+  double work = (std::min)(lhsNnz * (std::min)(double(rhs.outerSize()), rhsNnz),
+                           rhsNnz * (std::min)(double(lhs.innerSize()), lhsNnz));
+  return work >= 2. * double((std::max)(Index(EIGEN_PARALLEL_SPARSE_SPARSE_THRESHOLD), lhs.innerSize()));
+}
+
+#ifdef EIGEN_HAS_PARALLELIZER
+template<typename LhsEval, typename RhsEval, typename ResultType, bool Numeric>
+struct sparse_sparse_product_pass
+{
+  typedef typename ResultType::Scalar Scalar;
+  typedef typename ResultType::RealScalar RealScalar;
+  typedef typename ResultType::StorageIndex StorageIndex;
+
+  sparse_sparse_product_pass(const LhsEval& lhsEval, const RhsEval& rhsEval, Index rows, const Index* bounds,
+                             ResultType& res, StorageIndex* counts, bool sorted, bool prune, const RealScalar& tolerance)
+    : m_lhsEval(lhsEval), m_rhsEval(rhsEval), m_rows(rows), m_bounds(bounds), m_res(res), m_counts(counts),
+      m_sorted(sorted), m_prune(prune), m_tolerance(tolerance)
+  {}
+
+  // processes the column ranges [start,start+length) of m_bounds
+  void operator()(Index start, Index length) const
+  {
+    using std::abs;
+    // the last column having a nonzero at each row
+    ei_declare_aligned_stack_constructed_variable(Index,        mask,    m_rows,          0);
+    ei_declare_aligned_stack_constructed_variable(Scalar,       values,  (Numeric?m_rows:0), 0);
+    ei_declare_aligned_stack_constructed_variable(StorageIndex, indices, (Numeric?m_rows:0), 0);
+    std::fill(mask, mask+m_rows, Index(-1));
+
+    for(Index j=m_bounds[start]; j<m_bounds[start+length]; ++j)
+    {
+      Index nnz = 0;
+      for(typename RhsEval::InnerIterator rhsIt(m_rhsEval, j); rhsIt; ++rhsIt)
+      {
+        Scalar y = rhsIt.value();
+        for(typename LhsEval::InnerIterator lhsIt(m_lhsEval, rhsIt.index()); lhsIt; ++lhsIt)
+        {
+          Index i = lhsIt.index();
+          if(mask[i]!=j)
+          {
+            mask[i] = j;
+            if(Numeric)
+            {
+              values[i] = lhsIt.value() * y;
+              indices[nnz] = StorageIndex(i);
+            }
+            ++nnz;
+          }
+          else if(Numeric)
+            values[i] += lhsIt.value() * y;
+        }
+      }
+      if(Numeric)
+      {
+        if(m_sorted && nnz>1)
+          std::sort(indices, indices+nnz);
+        StorageIndex* resIndices = m_res.innerIndexPtr() + m_res.outerIndexPtr()[j];
+        Scalar* resValues = m_res.valuePtr() + m_res.outerIndexPtr()[j];
+        Index k = 0;
+        for(Index p=0; p<nnz; ++p)
+        {
+          Index i = indices[p];
+          if(!m_prune || abs(values[i])>m_tolerance)
+          {
+            resIndices[k] = StorageIndex(i);
+            resValues[k] = values[i];
+            ++k;
+          }
+        }
+        nnz = k;
+      }
+      m_counts[j] = StorageIndex(nnz);
+    }
+  }
+
+  const LhsEval& m_lhsEval;
+  const RhsEval& m_rhsEval;
+  Index m_rows;
+  const Index* m_bounds;
+  ResultType& m_res;
+  StorageIndex* m_counts;
+  bool m_sorted;
+  bool m_prune;
+  RealScalar m_tolerance;
+};
+#endif // EIGEN_HAS_PARALLELIZER
+
+// results which cannot be filled in place
+template<typename Lhs, typename Rhs, typename ResultType>
+bool sparse_sparse_product_parallel(const Lhs&, const Rhs&, ResultType&, bool, bool, const typename ResultType::RealScalar&)
+{
+  return false;
+}
+
+/** \internal Computes res = lhs * rhs, faking the storage orders like conservative_sparse_sparse_product_impl, if the
+  * product is worth being multi-threaded. The coefficients whose magnitude is not larger than \a tolerance are dropped
+  * if \a prune is true, and the inner indices are sorted if \a sorted or \a prune is true.
+  * \returns false, leaving \a res untouched, if the product has to be computed by the sequential code. */
+template<typename Lhs, typename Rhs, typename Scalar, int Options, typename StorageIndex>
+bool sparse_sparse_product_parallel(const Lhs& lhs, const Rhs& rhs, SparseMatrix<Scalar,Options,StorageIndex>& res,
+                                    bool sorted, bool prune, const typename NumTraits<Scalar>::Real& tolerance)
+{
+#ifdef EIGEN_HAS_PARALLELIZER
+  if(!sparse_sparse_product_parallelizable(lhs, rhs))
+    return false;
+
+  typedef SparseMatrix<Scalar,Options,StorageIndex> ResultType;
+  typedef typename evaluator<Lhs>::type LhsEval;
+  typedef typename evaluator<Rhs>::type RhsEval;
+  Index rows = lhs.innerSize();
+  Index cols = rhs.outerSize();
+  LhsEval lhsEval(lhs);
+  RhsEval rhsEval(rhs);
+
+  // count the multiply-adds of the columns of the result
+  Matrix<Index,Dynamic,1> lhsNnz(lhs.outerSize()), work(cols+1);
+  for(Index k=0; k<lhs.outerSize(); ++k)
+  {
+    Index nnz = 0;
+    for(typename LhsEval::InnerIterator lhsIt(lhsEval, k); lhsIt; ++lhsIt)
+      ++nnz;
+    lhsNnz(k) = nnz;
+  }
+  work(0) = 0;
+  for(Index j=0; j<cols; ++j)
+  {
+    Index w = 0;
+    for(typename RhsEval::InnerIterator rhsIt(rhsEval, j); rhsIt; ++rhsIt)
+      w += lhsNnz(rhsIt.index());
+    work(j+1) = work(j) + w;
+  }
+
+  // every thread has to clear its own vectors of the size of a column
+  Index threads = (std::min)(Index(nbThreads()), work(cols) / (std::max)(Index(EIGEN_PARALLEL_SPARSE_SPARSE_THRESHOLD), rows));
+  if(threads<2)
+    return false;
+  Matrix<Index,Dynamic,1> bounds(threads+1);
+  for(Index t=0; t<threads; ++t)
+    bounds(t) = std::lower_bound(work.data(), work.data()+cols+1, double(t)*double(work(cols))/double(threads)) - work.data();
+  bounds(threads) = cols;
+
+  Matrix<StorageIndex,Dynamic,1> counts(cols);
+  sparse_sparse_product_pass<LhsEval,RhsEval,ResultType,false> symbolic(lhsEval, rhsEval, rows, bounds.data(), res, counts.data(),
+                                                                        false, false, tolerance);
+  parallelize_range(symbolic, threads, Index(1), Index(1));
+
+  // mimics a resizeByInnerOuter
+  if(ResultType::IsRowMajor)
+    res.resize(cols, rows);
+  else
+    res.resize(rows, cols);
+  StorageIndex* outerIndex = res.outerIndexPtr();
+  outerIndex[0] = 0;
+  for(Index j=0; j<cols; ++j)
+    outerIndex[j+1] = outerIndex[j] + counts(j);
+  res.resizeNonZeros(outerIndex[cols]);
+
+  sparse_sparse_product_pass<LhsEval,RhsEval,ResultType,true> numeric(lhsEval, rhsEval, rows, bounds.data(), res, counts.data(),
+                                                                      sorted || prune, prune, tolerance);
+  parallelize_range(numeric, threads, Index(1), Index(1));
+
+  if(prune)
+  {
+    // pack the remaining nonzeros
+    Index dst = 0;
+    for(Index j=0; j<cols; ++j)
+    {
+      Index src = outerIndex[j];
+      outerIndex[j] = StorageIndex(dst);
+      if(src!=dst)
+      {
+        std::copy(res.innerIndexPtr()+src, res.innerIndexPtr()+src+counts(j), res.innerIndexPtr()+dst);
+        std::copy(res.valuePtr()+src, res.valuePtr()+src+counts(j), res.valuePtr()+dst);
+      }
+      dst += counts(j);
+    }
+    outerIndex[cols] = StorageIndex(dst);
+    res.resizeNonZeros(dst);
+  }
+  return true;
+#else
+  EIGEN_UNUSED_VARIABLE(lhs);
+  EIGEN_UNUSED_VARIABLE(rhs);
+  EIGEN_UNUSED_VARIABLE(res);
+  EIGEN_UNUSED_VARIABLE(sorted);
+  EIGEN_UNUSED_VARIABLE(prune);
+  EIGEN_UNUSED_VARIABLE(tolerance);
+  return false;
+#endif
+}
+
 template<typename Lhs, typename Rhs, typename ResultType>
 static void conservative_sparse_sparse_product_impl(const Lhs& lhs, const Rhs& rhs, ResultType& res, bool sortedInsertion = false)
 {
   typedef typename remove_all<Lhs>::type::Scalar Scalar;
+  typedef typename ResultType::RealScalar RealScalar;
 
   // make sure to call innerSize/outerSize since we fake the storage order.
   Index rows = lhs.innerSize();
   Index cols = rhs.outerSize();
   eigen_assert(lhs.outerSize() == rhs.innerSize());
+
+  if(sparse_sparse_product_parallel(lhs, rhs, res, sortedInsertion, false, RealScalar(0)))
+    return;
   
   ei_declare_aligned_stack_constructed_variable(bool,   mask,     rows, 0);
   ei_declare_aligned_stack_constructed_variable(Scalar, values,   rows, 0);
@@ -142,8 +372,9 @@ struct conservative_sparse_sparse_product_selector<Lhs,Rhs,ResultType,ColMajor,C
     
     // If the result is tall and thin (in the extreme case a column vector)
     // then it is faster to sort the coefficients inplace instead of transposing twice.
+    // The multi-threaded products also sort the coefficients of each column in parallel.
     // FIXME, the following heuristic is probably not very good.
-    if(lhs.rows()>=rhs.cols())
+    if(lhs.rows()>=rhs.cols() || sparse_sparse_product_parallelizable(lhs, rhs))
     {
       ColMajorMatrix resCol(lhs.rows(),rhs.cols());
       // perform sorted insertion
@@ -17,6 +17,96 @@ namespace internal {
 template <> struct product_promote_storage_type<Sparse,Dense, OuterProduct> { typedef Sparse ret; };
 template <> struct product_promote_storage_type<Dense,Sparse, OuterProduct> { typedef Sparse ret; };
 
+/* Multi-threaded sparse * dense products:
+ * The products whose amount of work, i.e., the number of nonzeros times the number of columns of the dense
+ * operand, is large enough are split across the threads of the parallel scheduler by ranges of outer vectors of
+ * the sparse matrix, each thread processing at least EIGEN_PARALLEL_SPARSE_DENSE_THRESHOLD of this work:
+ * - when the outer vectors of the sparse matrix are the rows of the result, each thread computes its own rows,
+ * - otherwise, each thread scatters the contribution of its outer vectors to the whole result into a local buffer,
+ *   the buffers being then summed in thread order (see parallelize_accumulate()), so that the result does not
+ *   depend on the scheduling. This also holds for the products with a sparse selfadjoint view.
+ * The sequential kernels are the processRows() and processOuter() members of the implementations below.
+ */
+
+template<typename Impl, typename LhsEval, typename Rhs, typename Res, typename AlphaType>
+struct sparse_dense_rows_functor
+{
+  sparse_dense_rows_functor(const LhsEval& lhsEval, const Rhs& rhs, Res& res, const AlphaType& alpha)
+    : m_lhsEval(lhsEval), m_rhs(rhs), m_res(res), m_alpha(alpha)
+  {}
+
+  void operator()(Index start, Index length) const
+  {
+    Impl::processRows(m_lhsEval, m_rhs, m_res, m_alpha, start, start+length);
+  }
+
+  const LhsEval& m_lhsEval;
+  const Rhs& m_rhs;
+  Res& m_res;
+  const AlphaType& m_alpha;
+};
+
+template<typename Impl, typename LhsEval, typename Rhs, typename ResScalar, typename AlphaType>
+struct sparse_dense_scatter_functor
+{
+  sparse_dense_scatter_functor(const LhsEval& lhsEval, Index outerSize, const Rhs& rhs, const AlphaType& alpha, Index resRows, Index resCols)
+    : m_lhsEval(lhsEval), m_outerSize(outerSize), m_rhs(rhs), m_alpha(alpha), m_resRows(resRows), m_resCols(resCols)
+  {}
+
+  Index bound(Index t, Index count) const { return t==count ? m_outerSize : t*(m_outerSize/count); }
+
+  void operator()(Index start, Index length, ResScalar* res) const
+  {
+    Map<Matrix<ResScalar,Dynamic,Dynamic> > resMap(res, m_resRows, m_resCols);
+    Impl::processOuter(m_lhsEval, m_rhs, resMap, m_alpha, start, start+length);
+  }
+
+  const LhsEval& m_lhsEval;
+  Index m_outerSize;
+  const Rhs& m_rhs;
+  const AlphaType& m_alpha;
+  Index m_resRows, m_resCols;
+};
+
+template<typename Impl, typename LhsEval, typename Rhs, typename Res, typename AlphaType>
+void sparse_dense_product_rows(const LhsEval& lhsEval, Index outerSize, double work, const Rhs& rhs, Res& res, const AlphaType& alpha)
+{
+#ifdef EIGEN_HAS_PARALLELIZER
+  if(work >= 2*double(EIGEN_PARALLEL_SPARSE_DENSE_THRESHOLD))
+  {
+    Index minRowsPerThread = (std::max)(Index(1), Index(double(outerSize) * double(EIGEN_PARALLEL_SPARSE_DENSE_THRESHOLD) / work));
+    sparse_dense_rows_functor<Impl,LhsEval,Rhs,Res,AlphaType> func(lhsEval, rhs, res, alpha);
+    parallelize_range(func, outerSize, Index(1), minRowsPerThread);
+    return;
+  }
+#else
+  EIGEN_UNUSED_VARIABLE(work);
+#endif
+  Impl::processRows(lhsEval, rhs, res, alpha, 0, outerSize);
+}
+
+template<typename Impl, typename LhsEval, typename Rhs, typename Res, typename AlphaType>
+void sparse_dense_product_scatter(const LhsEval& lhsEval, Index outerSize, double work, const Rhs& rhs, Res& res, const AlphaType& alpha)
+{
+#ifdef EIGEN_HAS_PARALLELIZER
+  // every thread has to clear and to add its own copy of the result
+  Index maxThreads = Index(work / (std::max)(double(EIGEN_PARALLEL_SPARSE_DENSE_THRESHOLD), 2*double(res.size())));
+  if(maxThreads>1 && nbThreads()>1)
+  {
+    typedef typename Res::Scalar ResScalar;
+    typedef Matrix<ResScalar,Dynamic,Dynamic> ResBuffer;
+    ResBuffer buffer = ResBuffer::Zero(res.rows(), res.cols());
+    sparse_dense_scatter_functor<Impl,LhsEval,Rhs,ResScalar,AlphaType> func(lhsEval, outerSize, rhs, alpha, res.rows(), res.cols());
+    parallelize_accumulate(func, maxThreads, buffer.data(), buffer.size());
+    res += buffer;
+    return;
+  }
+#else
+  EIGEN_UNUSED_VARIABLE(work);
+#endif
+  Impl::processOuter(lhsEval, rhs, res, alpha, 0, outerSize);
+}
+
 template<typename SparseLhsType, typename DenseRhsType, typename DenseResType,
          typename AlphaType,
          int LhsStorageOrder = ((SparseLhsType::Flags&RowMajorBit)==RowMajorBit) ? RowMajor : ColMajor,
@@ -34,31 +124,14 @@ struct sparse_time_dense_product_impl<SparseLhsType,DenseRhsType,DenseResType, t
   static void run(const SparseLhsType& lhs, const DenseRhsType& rhs, DenseResType& res, const typename Res::Scalar& alpha)
   {
     LhsEval lhsEval(lhs);
-    
-    Index n = lhs.outerSize();
-#ifdef EIGEN_HAS_OPENMP
-    Eigen::initParallel();
-    Index threads = Eigen::nbThreads();
-#endif
-    
+    sparse_dense_product_rows<sparse_time_dense_product_impl>(lhsEval, lhs.outerSize(), double(lhsEval.nonZerosEstimate())*double(rhs.cols()), rhs, res, alpha);
+  }
+
+  static void processRows(const LhsEval& lhsEval, const DenseRhsType& rhs, DenseResType& res, const typename Res::Scalar& alpha, Index begin, Index end)
+  {
     for(Index c=0; c<rhs.cols(); ++c)
-    {
-#ifdef EIGEN_HAS_OPENMP
-      // This 20000 threshold has been found experimentally on 2D and 3D Poisson problems.
-      // It basically represents the minimal amount of work to be done to be worth it.
-      if(threads>1 && lhs.nonZeros() > 20000)
-      {
-        #pragma omp parallel for schedule(static) num_threads(threads)
-        for(Index i=0; i<n; ++i)
-          processRow(lhsEval,rhs,res,alpha,i,c);
-      }
-      else
-#endif
-      {
-        for(Index i=0; i<n; ++i)
-          processRow(lhsEval,rhs,res,alpha,i,c);
-      }
-    }
+      for(Index i=begin; i<end; ++i)
+        processRow(lhsEval,rhs,res,alpha,i,c);
   }
   
   static void processRow(const LhsEval& lhsEval, const DenseRhsType& rhs, DenseResType& res, const typename Res::Scalar& alpha, Index i, Index col)
@@ -87,12 +160,19 @@ struct sparse_time_dense_product_impl<SparseLhsType,DenseRhsType,DenseResType, A
   typedef typename internal::remove_all<DenseRhsType>::type Rhs;
   typedef typename internal::remove_all<DenseResType>::type Res;
   typedef typename evaluator<Lhs>::InnerIterator LhsInnerIterator;
+  typedef typename evaluator<Lhs>::type LhsEval;
   static void run(const SparseLhsType& lhs, const DenseRhsType& rhs, DenseResType& res, const AlphaType& alpha)
   {
-    typename evaluator<Lhs>::type lhsEval(lhs);
+    LhsEval lhsEval(lhs);
+    sparse_dense_product_scatter<sparse_time_dense_product_impl>(lhsEval, lhs.outerSize(), double(lhsEval.nonZerosEstimate())*double(rhs.cols()), rhs, res, alpha);
+  }
+
+  template<typename Dest>
+  static void processOuter(const LhsEval& lhsEval, const DenseRhsType& rhs, Dest& res, const AlphaType& alpha, Index begin, Index end)
+  {
     for(Index c=0; c<rhs.cols(); ++c)
     {
-      for(Index j=0; j<lhs.outerSize(); ++j)
+      for(Index j=begin; j<end; ++j)
       {
 //        typename Res::Scalar rhs_j = alpha * rhs.coeff(j,c);
         typename internal::scalar_product_traits<AlphaType, typename Rhs::Scalar>::ReturnType rhs_j(alpha * rhs.coeff(j,c));
@@ -110,10 +190,16 @@ struct sparse_time_dense_product_impl<SparseLhsType,DenseRhsType,DenseResType, t
   typedef typename internal::remove_all<DenseRhsType>::type Rhs;
   typedef typename internal::remove_all<DenseResType>::type Res;
   typedef typename evaluator<Lhs>::InnerIterator LhsInnerIterator;
+  typedef typename evaluator<Lhs>::type LhsEval;
   static void run(const SparseLhsType& lhs, const DenseRhsType& rhs, DenseResType& res, const typename Res::Scalar& alpha)
   {
-    typename evaluator<Lhs>::type lhsEval(lhs);
-    for(Index j=0; j<lhs.outerSize(); ++j)
+    LhsEval lhsEval(lhs);
+    sparse_dense_product_rows<sparse_time_dense_product_impl>(lhsEval, lhs.outerSize(), double(lhsEval.nonZerosEstimate())*double(rhs.cols()), rhs, res, alpha);
+  }
+
+  static void processRows(const LhsEval& lhsEval, const DenseRhsType& rhs, DenseResType& res, const typename Res::Scalar& alpha, Index begin, Index end)
+  {
+    for(Index j=begin; j<end; ++j)
     {
       typename Res::RowXpr res_j(res.row(j));
       for(LhsInnerIterator it(lhsEval,j); it ;++it)
@@ -129,10 +215,17 @@ struct sparse_time_dense_product_impl<SparseLhsType,DenseRhsType,DenseResType, t
   typedef typename internal::remove_all<DenseRhsType>::type Rhs;
   typedef typename internal::remove_all<DenseResType>::type Res;
   typedef typename evaluator<Lhs>::InnerIterator LhsInnerIterator;
+  typedef typename evaluator<Lhs>::type LhsEval;
   static void run(const SparseLhsType& lhs, const DenseRhsType& rhs, DenseResType& res, const typename Res::Scalar& alpha)
   {
-    typename evaluator<Lhs>::type lhsEval(lhs);
-    for(Index j=0; j<lhs.outerSize(); ++j)
+    LhsEval lhsEval(lhs);
+    sparse_dense_product_scatter<sparse_time_dense_product_impl>(lhsEval, lhs.outerSize(), double(lhsEval.nonZerosEstimate())*double(rhs.cols()), rhs, res, alpha);
+  }
+
+  template<typename Dest>
+  static void processOuter(const LhsEval& lhsEval, const DenseRhsType& rhs, Dest& res, const typename Res::Scalar& alpha, Index begin, Index end)
+  {
+    for(Index j=begin; j<end; ++j)
     {
       typename Rhs::ConstRowXpr rhs_j(rhs.row(j));
       for(LhsInnerIterator it(lhsEval,j); it ;++it)
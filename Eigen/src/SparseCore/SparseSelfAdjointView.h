@@ -248,13 +248,9 @@ struct Assignment<DstXprType, SrcXprType, Functor, SparseSelfAdjoint2Sparse, Sca
 
 namespace internal {
 
-template<int Mode, typename SparseLhsType, typename DenseRhsType, typename DenseResType, typename AlphaType>
-inline void sparse_selfadjoint_time_dense_product(const SparseLhsType& lhs, const DenseRhsType& rhs, DenseResType& res, const AlphaType& alpha)
+template<int Mode, typename SparseLhsType, typename DenseRhsType>
+struct sparse_selfadjoint_time_dense_product_impl
 {
-  EIGEN_ONLY_USED_FOR_DEBUG(alpha);
-  // TODO use alpha
-  eigen_assert(alpha==AlphaType(1) && "alpha != 1 is not implemented yet, sorry");
-  
   typedef typename evaluator<SparseLhsType>::type LhsEval;
   typedef typename evaluator<SparseLhsType>::InnerIterator LhsIterator;
   typedef typename SparseLhsType::Scalar LhsScalar;
@@ -267,32 +263,47 @@ inline void sparse_selfadjoint_time_dense_product(const SparseLhsType& lhs, cons
           || ( (Mode&Lower) && LhsIsRowMajor),
     ProcessSecondHalf = !ProcessFirstHalf
   };
-  
-  LhsEval lhsEval(lhs);
-  
-  for (Index j=0; j<lhs.outerSize(); ++j)
+
+  // each stored coefficient contributes to two rows of the result, see sparse_dense_product_scatter()
+  template<typename Dest, typename AlphaType>
+  static void processOuter(const LhsEval& lhsEval, const DenseRhsType& rhs, Dest& res, const AlphaType&, Index begin, Index end)
   {
-    LhsIterator i(lhsEval,j);
-    if (ProcessSecondHalf)
+    for (Index j=begin; j<end; ++j)
     {
-      while (i && i.index()<j) ++i;
-      if(i && i.index()==j)
+      LhsIterator i(lhsEval,j);
+      if (ProcessSecondHalf)
       {
-        res.row(j) += i.value() * rhs.row(j);
-        ++i;
+        while (i && i.index()<j) ++i;
+        if(i && i.index()==j)
+        {
+          res.row(j) += i.value() * rhs.row(j);
+          ++i;
+        }
       }
+      for(; (ProcessFirstHalf ? i && i.index() < j : i) ; ++i)
+      {
+        Index a = LhsIsRowMajor ? j : i.index();
+        Index b = LhsIsRowMajor ? i.index() : j;
+        LhsScalar v = i.value();
+        res.row(a) += (v) * rhs.row(b);
+        res.row(b) += numext::conj(v) * rhs.row(a);
+      }
+      if (ProcessFirstHalf && i && (i.index()==j))
+        res.row(j) += i.value() * rhs.row(j);
     }
-    for(; (ProcessFirstHalf ? i && i.index() < j : i) ; ++i)
-    {
-      Index a = LhsIsRowMajor ? j : i.index();
-      Index b = LhsIsRowMajor ? i.index() : j;
-      LhsScalar v = i.value();
-      res.row(a) += (v) * rhs.row(b);
-      res.row(b) += numext::conj(v) * rhs.row(a);
-    }
-    if (ProcessFirstHalf && i && (i.index()==j))
-      res.row(j) += i.value() * rhs.row(j);
   }
+};
+
+template<int Mode, typename SparseLhsType, typename DenseRhsType, typename DenseResType, typename AlphaType>
+inline void sparse_selfadjoint_time_dense_product(const SparseLhsType& lhs, const DenseRhsType& rhs, DenseResType& res, const AlphaType& alpha)
+{
+  EIGEN_ONLY_USED_FOR_DEBUG(alpha);
+  // TODO use alpha
+  eigen_assert(alpha==AlphaType(1) && "alpha != 1 is not implemented yet, sorry");
+  
+  typedef sparse_selfadjoint_time_dense_product_impl<Mode,SparseLhsType,DenseRhsType> Impl;
+  typename Impl::LhsEval lhsEval(lhs);
+  sparse_dense_product_scatter<Impl>(lhsEval, lhs.outerSize(), 2*double(lhsEval.nonZerosEstimate())*double(rhs.cols()), rhs, res, alpha);
 }
 
 
@@ -326,9 +337,10 @@ struct generic_product_impl<Lhs, RhsView, DenseShape, SparseSelfAdjointShape, Pr
     RhsNested rhsNested(rhsView.matrix());
     
     dst.setZero();
-    // transpoe everything
+    // transpose everything, the stored triangle of the transposed matrix being the opposite one
+    enum { TransposeMode = ((RhsView::Mode&Upper) ? Lower : 0) | ((RhsView::Mode&Lower) ? Upper : 0) };
     Transpose<Dest> dstT(dst);
-    internal::sparse_selfadjoint_time_dense_product<RhsView::Mode>(rhsNested.transpose(), lhsNested.transpose(), dstT, typename Dest::Scalar(1));
+    internal::sparse_selfadjoint_time_dense_product<TransposeMode>(rhsNested.transpose(), lhsNested.transpose(), dstT, typename Dest::Scalar(1));
   }
 };
 
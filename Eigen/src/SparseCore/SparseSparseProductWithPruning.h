@@ -30,6 +30,9 @@ static void sparse_sparse_product_with_pruning_impl(const Lhs& lhs, const Rhs& r
   //Index size = lhs.outerSize();
   eigen_assert(lhs.outerSize() == rhs.innerSize());
 
+  if(sparse_sparse_product_parallel(lhs, rhs, res, true, true, tolerance))
+    return;
+
   // allocate a temporary buffer
   AmbiVector<Scalar,StorageIndex> tempVector(rows);
 
@@ -113,6 +113,10 @@ struct unary_evaluator<SparseView<ArgType>, IteratorBased>
     
     explicit unary_evaluator(const XprType& xpr) : m_argImpl(xpr.nestedExpression()), m_view(xpr) {}
 
+    inline Index nonZerosEstimate() const {
+      return m_argImpl.nonZerosEstimate();
+    }
+
   protected:
     typename evaluator<ArgType>::nestedType m_argImpl;
     const XprType &m_view;
@@ -181,6 +185,10 @@ struct unary_evaluator<SparseView<ArgType>, IndexBased>
     
     explicit unary_evaluator(const XprType& xpr) : m_argImpl(xpr.nestedExpression()), m_view(xpr) {}
 
+    inline Index nonZerosEstimate() const {
+      return m_view.size();
+    }
+
   protected:
     typename evaluator<ArgType>::nestedType m_argImpl;
     const XprType &m_view;
@@ -0,0 +1,77 @@
+// Compares the vectorized double precision transcendental functions of the Array API
+// with the same loops calling the C library coefficient by coefficient.
+//
+// g++ -O3 -DNDEBUG -mavx -mfma -I.. bench_math_functions.cpp -o bench_math_functions
+
+#include <iostream>
+#include <cmath>
+#include <Eigen/Core>
+#include "BenchTimer.h"
+using namespace Eigen;
+using namespace std;
+
+#ifndef SIZE
+#define SIZE 4096
+#endif
+
+#ifndef REPEAT
+#define REPEAT 2000
+#endif
+
+#ifndef TRIES
+#define TRIES 5
+#endif
+
+double libm_log(double x) { return std::log(x); }
+double libm_sin(double x) { return std::sin(x); }
+double libm_cos(double x) { return std::cos(x); }
+double libm_tanh(double x) { return std::tanh(x); }
+double libm_erf(double x) { return numext::erf(x); }
+double libm_pow(double x) { return std::pow(x, 2.5); }
+
+template<typename Func>
+EIGEN_DONT_INLINE void eigen_func(const ArrayXd& x, ArrayXd& y, Func func)
+{
+  y = x.unaryExpr(func);
+}
+
+EIGEN_DONT_INLINE void libm_func(const ArrayXd& x, ArrayXd& y, double (*func)(double))
+{
+  for(Index i=0; i<x.size(); ++i)
+    y(i) = func(x(i));
+}
+
+template<typename Func>
+void bench(const char* name, const ArrayXd& x, Func func, double (*ref)(double))
+{
+  ArrayXd y(x.size()), y_ref(x.size());
+  BenchTimer t_eigen, t_libm;
+  BENCH(t_eigen, TRIES, REPEAT, eigen_func(x, y, func));
+  BENCH(t_libm, TRIES, REPEAT, libm_func(x, y_ref, ref));
+
+  // largest error relatively to the magnitude of the reference
+  double err = ((y - y_ref).abs() / y_ref.abs().max((std::numeric_limits<double>::min)())).maxCoeff();
+  double n = double(x.size()) * REPEAT;
+  cout << name << "\t"
+       << "Eigen: " << 1e9 * t_eigen.best() / n << " ns   "
+       << "libm: " << 1e9 * t_libm.best() / n << " ns   "
+       << "speedup: " << t_libm.best() / t_eigen.best() << "   "
+       << "max rel error: " << err << "\n";
+}
+
+int main()
+{
+  cout << "SIMD: " << SimdInstructionSetsInUse() << ", " << SIZE << " doubles\n";
+
+  ArrayXd positive = (ArrayXd::Random(SIZE) * 300.).exp();
+  ArrayXd angles = ArrayXd::Random(SIZE) * 100.;
+  ArrayXd small = ArrayXd::Random(SIZE) * 5.;
+
+  bench("log ", positive, internal::scalar_log_op<double>(), libm_log);
+  bench("sin ", angles, internal::scalar_sin_op<double>(), libm_sin);
+  bench("cos ", angles, internal::scalar_cos_op<double>(), libm_cos);
+  bench("tanh", small, internal::scalar_tanh_op<double>(), libm_tanh);
+  bench("erf ", small, internal::scalar_erf_op<double>(), libm_erf);
+  bench("pow ", positive.log().abs(), internal::scalar_pow_op<double>(2.5), libm_pow);
+  return 0;
+}
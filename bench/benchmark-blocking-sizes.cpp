@@ -43,6 +43,9 @@ const float min_accurate_time = 1e-2f;
 // See --min-working-set-size command line parameter.
 size_t min_working_set_size = 0;
 
+// See --output command line parameter.
+const char* autotune_output_filename = "blocking-sizes.txt";
+
 float max_clock_speed = 0.0f;
 
 // range of sizes that we will benchmark (in all 3 K,M,N dimensions)
@@ -291,6 +294,10 @@ void show_usage_and_exit(int /*argc*/, char* argv[],
   cerr << "       set to likely outsize caches." << endl;
   cerr << "       A value of 1 (that is, 1 byte) would mean don't do anything to" << endl;
   cerr << "       avoid warm caches." << endl;
+  cerr << "  --output=FILE:" << endl;
+  cerr << "       With the autotune action, write the best blocking sizes to FILE" << endl;
+  cerr << "       (default: " << autotune_output_filename << "), in the format read by" << endl;
+  cerr << "       Eigen::loadProductBlockingSizes()." << endl;
   exit(1);
 }
      
@@ -618,6 +625,54 @@ struct measure_default_sizes_action_t : action_t
   }
 };
 
+struct autotune_action_t : action_t
+{
+  virtual const char* invokation_name() const { return "autotune"; }
+  virtual void run() const
+  {
+    vector<benchmark_t> benchmarks;
+    for (int repetition = 0; repetition < measurement_repetitions; repetition++) {
+      for (size_t ksize = minsize; ksize <= maxsize; ksize *= 2) {
+        for (size_t msize = minsize; msize <= maxsize; msize *= 2) {
+          for (size_t nsize = minsize; nsize <= maxsize; nsize *= 2) {
+            for (size_t kblock = minsize; kblock <= ksize; kblock *= 2) {
+              for (size_t mblock = minsize; mblock <= msize; mblock *= 2) {
+                for (size_t nblock = minsize; nblock <= nsize; nblock *= 2) {
+                  benchmarks.emplace_back(ksize, msize, nsize, kblock, mblock, nblock);
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+
+    run_benchmarks(benchmarks);
+
+    // benchmarks are now sorted by product size, so keep the fastest block size for each product size
+    clearProductBlockingSizes();
+    cout << "BEGIN AUTOTUNED BLOCKING SIZES" << endl;
+    for (auto it = benchmarks.begin(); it != benchmarks.end(); ) {
+      auto best = it;
+      for (; it != benchmarks.end() && it->compact_product_size == best->compact_product_size; ++it) {
+        if (it->gflops > best->gflops) {
+          best = it;
+        }
+      }
+      size_triple_t p(best->compact_product_size);
+      size_triple_t b(best->compact_block_size);
+      setProductBlockingSizes<Scalar>(p.k, p.m, p.n, nbThreads(), b.k, b.m, b.n);
+      cout << *best << endl;
+    }
+
+    if (!saveProductBlockingSizes(autotune_output_filename)) {
+      cerr << "Could not write blocking sizes to " << autotune_output_filename << endl;
+      exit(1);
+    }
+    cerr << "Blocking sizes written to " << autotune_output_filename << endl;
+  }
+};
+
 int main(int argc, char* argv[])
 {
   double time_start = timer.getRealTime();
@@ -627,6 +682,7 @@ int main(int argc, char* argv[])
   vector<unique_ptr<action_t>> available_actions;
   available_actions.emplace_back(new measure_all_pot_sizes_action_t);
   available_actions.emplace_back(new measure_default_sizes_action_t);
+  available_actions.emplace_back(new autotune_action_t);
 
   auto action = available_actions.end();
 
@@ -648,6 +704,8 @@ int main(int argc, char* argv[])
     if (argv[i] == strstr(argv[i], "--min-working-set-size=")) {
       const char* equals_sign = strchr(argv[i], '=');
       min_working_set_size = strtoul(equals_sign+1, nullptr, 10);
+    } else if (argv[i] == strstr(argv[i], "--output=")) {
+      autotune_output_filename = strchr(argv[i], '=') + 1;
     } else {
       cerr << "unrecognized option: " << argv[i] << endl << endl;
       show_usage_and_exit(argc, argv, available_actions);
@@ -0,0 +1,2 @@
+ArrayXd v = ArrayXd::LinSpaced(5,0,2);
+cout << erf(v) << endl;
@@ -217,6 +217,7 @@ template<typename ArrayType> void array_real(const ArrayType& m)
   VERIFY_IS_APPROX(m1.sinh(), sinh(m1));
   VERIFY_IS_APPROX(m1.cosh(), cosh(m1));
   VERIFY_IS_APPROX(m1.tanh(), tanh(m1));
+  VERIFY_IS_APPROX(m1.erf(), erf(m1));
   VERIFY_IS_APPROX(m1.arg(), arg(m1));
   VERIFY_IS_APPROX(m1.round(), round(m1));
   VERIFY_IS_APPROX(m1.floor(), floor(m1));
@@ -420,6 +421,51 @@ template<typename ArrayType> void min_max(const ArrayType& m)
 
 }
 
+// vectorized select() and boolean reductions of comparisons, including NaNs and partial packets
+template<typename ArrayType> void vectorized_comparisons(Index rows, Index cols)
+{
+  typedef typename ArrayType::Scalar Scalar;
+  ArrayType m1 = ArrayType::Random(rows, cols), m2 = ArrayType::Random(rows, cols);
+  for(Index k = 0; k < m1.size(); k += 3)
+    m2(k) = m1(k);
+  if(!NumTraits<Scalar>::IsInteger && m1.size()>1)
+    m1(internal::random<Index>(0,m1.size()-1)) = std::numeric_limits<Scalar>::quiet_NaN();
+
+  ArrayType ref(rows, cols);
+  Index lt = 0, le = 0, eq = 0, neq = 0;
+  for(Index j = 0; j < cols; ++j)
+    for(Index i = 0; i < rows; ++i)
+    {
+      ref(i,j) = m1(i,j) > m2(i,j) ? m1(i,j) : Scalar(0);
+      lt += m1(i,j) < m2(i,j);
+      le += m1(i,j) <= m2(i,j);
+      eq += m1(i,j) == m2(i,j);
+      neq += m1(i,j) != m2(i,j);
+    }
+
+  ArrayType res = (m1 > m2).select(m1, 0);
+  VERIFY((res == ref || (res != res && ref != ref)).all());
+  VERIFY_IS_EQUAL((m1 < m2).count(), lt);
+  VERIFY_IS_EQUAL((m1 <= m2).count(), le);
+  VERIFY_IS_EQUAL((m1 == m2).count(), eq);
+  VERIFY_IS_EQUAL((m1 != m2).count(), neq);
+  VERIFY_IS_EQUAL((m1 < m2).all(), lt == m1.size());
+  VERIFY_IS_EQUAL((m1 < m2).any(), lt > 0);
+  VERIFY_IS_EQUAL((m1 == m2).any(), eq > 0);
+  VERIFY_IS_EQUAL((m2 == m2).all(), true);
+  VERIFY_IS_EQUAL((m2 != m2).any(), false);
+  VERIFY_IS_EQUAL((m1 == m1).all(), NumTraits<Scalar>::IsInteger || m1.size()==1);
+  VERIFY_IS_EQUAL(m1.hasNaN(), !NumTraits<Scalar>::IsInteger && m1.size()>1);
+
+  // clamping of a sub-block
+  if(rows>2 && cols>2)
+  {
+    ArrayType c = m2;
+    c.block(1,1,rows-2,cols-2) = (m2.block(1,1,rows-2,cols-2) < Scalar(0)).select(Scalar(0), m2.block(1,1,rows-2,cols-2));
+    VERIFY_IS_EQUAL((c < Scalar(0)).count(), (m2 < Scalar(0)).count() - (m2.block(1,1,rows-2,cols-2) < Scalar(0)).count());
+  }
+}
+
 void test_array()
 {
   for(int i = 0; i < g_repeat; i++) {
@@ -450,6 +496,13 @@ void test_array()
     CALL_SUBTEST_3( array_real(Array44d()) );
     CALL_SUBTEST_5( array_real(ArrayXXf(internal::random<int>(1,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,EIGEN_TEST_MAX_SIZE))) );
   }
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_5(( vectorized_comparisons<ArrayXXf>(internal::random<int>(1,100), internal::random<int>(1,100)) ));
+    CALL_SUBTEST_5(( vectorized_comparisons<ArrayXf>(internal::random<int>(1,1000), 1) ));
+    CALL_SUBTEST_6(( vectorized_comparisons<ArrayXXi>(internal::random<int>(1,100), internal::random<int>(1,100)) ));
+    CALL_SUBTEST_7(( vectorized_comparisons<ArrayXXd>(internal::random<int>(1,100), internal::random<int>(1,100)) ));
+    CALL_SUBTEST_7(( vectorized_comparisons<Array<double,Dynamic,Dynamic,RowMajor> >(internal::random<int>(1,100), internal::random<int>(1,100)) ));
+  }
   for(int i = 0; i < g_repeat; i++) {
     CALL_SUBTEST_4( array_complex(ArrayXXcf(internal::random<int>(1,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,EIGEN_TEST_MAX_SIZE))) );
   }
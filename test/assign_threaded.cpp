@@ -0,0 +1,114 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#define EIGEN_USE_THREADS
+#define EIGEN_PARALLEL_ASSIGN_THRESHOLD 1000
+#include "main.h"
+#include "threaded_common.h"
+
+template<typename ArrayType> void assign_threaded_linear(Index size, counting_scheduler& scheduler)
+{
+  typedef typename ArrayType::Scalar Scalar;
+  ArrayType b = ArrayType::Random(size), c = ArrayType::Random(size), d = ArrayType::Random(size);
+
+  setNbThreads(1);
+  int runs = scheduler.m_runs;
+  ArrayType ref = b*c + d.exp();
+  ArrayType ref2 = ref;
+  ref2.segment(1,size-3) -= Scalar(2) * b.segment(2,size-3);
+  VERIFY_IS_EQUAL(scheduler.m_runs, runs);
+  setNbThreads(0);
+
+  // each coefficient is computed by the same code whatever the thread, so that the result is exactly the same
+  ArrayType a(size);
+  a = b*c + d.exp();
+  VERIFY(scheduler.m_runs > runs);
+  VERIFY_IS_EQUAL(a.matrix(), ref.matrix());
+
+  // unaligned head and tail
+  a.segment(1,size-3) -= Scalar(2) * b.segment(2,size-3);
+  VERIFY_IS_EQUAL(a.matrix(), ref2.matrix());
+
+  ArrayType b1 = b, c1 = c;
+  b1.segment(1,size-2).swap(c1.segment(1,size-2));
+  VERIFY_IS_EQUAL(b1.segment(1,size-2).matrix(), c.segment(1,size-2).matrix());
+  VERIFY_IS_EQUAL(c1.segment(1,size-2).matrix(), b.segment(1,size-2).matrix());
+  VERIFY_IS_EQUAL(b1(0), b(0));
+}
+
+template<typename MatrixType> void assign_threaded_outer(Index rows, Index cols)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> RowMajorMatrix;
+  MatrixType b = MatrixType::Random(rows,cols), c = MatrixType::Random(rows,cols);
+  RowMajorMatrix br = b;
+
+  setNbThreads(1);
+  MatrixType ref = b + Scalar(3)*c;
+  MatrixType ref2 = ref;
+  ref2.block(1,2,rows-1,cols-3) = c.block(0,1,rows-1,cols-3) - b.block(1,0,rows-1,cols-3);
+  MatrixType ref3 = b.transpose().transpose() * Scalar(2);
+  setNbThreads(0);
+
+  MatrixType a(rows,cols);
+  a = b + Scalar(3)*c;
+  VERIFY_IS_EQUAL(a, ref);
+
+  // sub-blocks are split by outer vectors
+  a.block(1,2,rows-1,cols-3) = c.block(0,1,rows-1,cols-3) - b.block(1,0,rows-1,cols-3);
+  VERIFY_IS_EQUAL(a, ref2);
+
+  // storage order mismatch
+  a = br * Scalar(2);
+  VERIFY_IS_EQUAL(a, ref3);
+}
+
+// runs assignments from within the tasks of a scheduler
+struct nested_assign_task : ParallelTask
+{
+  nested_assign_task(const ArrayXf& a, std::vector<ArrayXf>& res) : m_a(a), m_res(res) {}
+  void operator()(int id, int)
+  {
+    m_res[id] = m_a.square() + m_a;
+  }
+  const ArrayXf& m_a;
+  std::vector<ArrayXf>& m_res;
+};
+
+void assign_threaded_nested(counting_scheduler& scheduler)
+{
+  ArrayXf a = ArrayXf::Random(100000);
+  ArrayXf ref = a.square() + a;
+  std::vector<ArrayXf> res(scheduler.numThreads());
+  nested_assign_task task(a, res);
+  int runs = scheduler.m_runs;
+  scheduler.run(scheduler.numThreads(), task);
+  // the nested assignments are not split
+  VERIFY_IS_EQUAL(scheduler.m_runs, runs+1);
+  for(std::size_t k=0; k<res.size(); ++k)
+    VERIFY_IS_EQUAL(res[k].matrix(), ref.matrix());
+}
+
+void test_assign_threaded()
+{
+  ThreadPoolScheduler pool(internal::random<int>(2,8));
+  counting_scheduler scheduler(pool);
+  setParallelScheduler(&scheduler);
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(( assign_threaded_linear<ArrayXf>(internal::random<Index>(20000,100000), scheduler) ));
+    CALL_SUBTEST_2(( assign_threaded_linear<ArrayXd>(internal::random<Index>(20000,100000), scheduler) ));
+    CALL_SUBTEST_3(( assign_threaded_linear<Array<long double,Dynamic,1> >(internal::random<Index>(20000,40000), scheduler) ));
+    CALL_SUBTEST_4(( assign_threaded_outer<MatrixXf>(internal::random<Index>(2,300), internal::random<Index>(1000,3000)) ));
+    CALL_SUBTEST_4(( assign_threaded_outer<Matrix<float,8,Dynamic> >(8, internal::random<Index>(1000,3000)) ));
+    CALL_SUBTEST_5(( assign_threaded_outer<MatrixXcd>(internal::random<Index>(2,300), internal::random<Index>(1000,3000)) ));
+    CALL_SUBTEST_5(( assign_threaded_outer<Matrix<double,Dynamic,Dynamic,RowMajor> >(internal::random<Index>(1000,3000), internal::random<Index>(4,300)) ));
+  }
+  CALL_SUBTEST_6( assign_threaded_nested(scheduler) );
+  setParallelScheduler(0);
+}
@@ -0,0 +1,46 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "float16_common.h"
+
+// the relative precision of the products and sums in bfloat16
+static const float bfloat16_prec = 1e-2f;
+
+void bfloat16_conversion()
+{
+  float16_round_trip<bfloat16>();
+
+  VERIFY_IS_EQUAL(bfloat16(1.f).x, 0x3f80);
+  VERIFY_IS_EQUAL(bfloat16(-2.f).x, 0xc000);
+  VERIFY_IS_EQUAL(bfloat16((std::numeric_limits<float>::max)()).x, 0x7f80);
+  // round to nearest even
+  VERIFY_IS_EQUAL(bfloat16(1.f + 1.f/256).x, 0x3f80);
+  VERIFY_IS_EQUAL(bfloat16(1.f + 3.f/256).x, 0x3f82);
+  VERIFY_IS_EQUAL(float(NumTraits<bfloat16>::epsilon()), std::ldexp(1.f, -7));
+
+  // the vectorized conversions, including the roundings of values close to the ties, the overflows and the NaNs
+  VectorXf f = VectorXf::Random(internal::random<Index>(1,1000)) * 1000.f;
+  for(Index i = 0; i < f.size(); i += 7)
+    f(i) = bfloat16(f(i)) + std::ldexp(float(bfloat16(f(i))), -8);
+  f(0) = std::numeric_limits<float>::quiet_NaN();
+  f(f.size()-1) = -(std::numeric_limits<float>::max)();
+  float16_vectorized_conversion<bfloat16>(f);
+}
+
+void test_bfloat16_float()
+{
+  CALL_SUBTEST_1( bfloat16_conversion() );
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_2( float16_cwise<bfloat16>(internal::random<Index>(1,EIGEN_TEST_MAX_SIZE), internal::random<Index>(1,EIGEN_TEST_MAX_SIZE)) );
+    CALL_SUBTEST_3( float16_redux<bfloat16>(internal::random<Index>(2,100000), bfloat16_prec) );
+    CALL_SUBTEST_4( float16_product<bfloat16>(internal::random<Index>(1,EIGEN_TEST_MAX_SIZE), internal::random<Index>(1,EIGEN_TEST_MAX_SIZE), internal::random<Index>(1,EIGEN_TEST_MAX_SIZE), bfloat16_prec) );
+    CALL_SUBTEST_4( float16_product<bfloat16>(internal::random<Index>(1,4), internal::random<Index>(1,4), internal::random<Index>(1,4), bfloat16_prec) );
+  }
+  CALL_SUBTEST_5( float16_product_blocking<bfloat16>(bfloat16_prec) );
+}
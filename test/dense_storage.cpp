@@ -52,6 +52,69 @@ void dense_storage_assignment()
     VERIFY_IS_EQUAL(raw_reference[i], raw_copied_reference[i]);
 }
 
+// runs the parts of the tasks one after the other while recording their ranges
+struct recording_scheduler : ParallelScheduler
+{
+  int numThreads() const { return 4; }
+  bool inParallelRegion() const { return false; }
+  void run(int count, ParallelTask& task) { m_counts.push_back(count); for(int i=0; i<count; ++i) task(i, count); }
+  std::vector<int> m_counts;
+};
+
+template<typename MatrixType> bool is_huge_page_aligned(const MatrixType& m)
+{
+  return (std::size_t(m.data()) % EIGEN_HUGE_PAGE_BYTES) == 0;
+}
+
+void dense_storage_allocation_policy()
+{
+  typedef Matrix<double,Dynamic,Dynamic,ColMajor|HugePages|ParallelFirstTouch> BigMatrix;
+  recording_scheduler scheduler;
+  setParallelScheduler(&scheduler);
+  setNbThreads(4);
+
+  // the pages are first touched by the threads of the scheduler
+  BigMatrix a(300,200);
+#ifdef EIGEN_HAS_PARALLELIZER
+  VERIFY_IS_EQUAL(scheduler.m_counts.size(), std::size_t(1));
+  VERIFY_IS_EQUAL(scheduler.m_counts[0], 4);
+#endif
+  VERIFY_IS_EQUAL(a, BigMatrix::Zero(300,200));
+  MatrixXd ref = MatrixXd::Random(300,200);
+  a = ref;
+#if EIGEN_HAS_HUGE_PAGE_MALLOC
+  VERIFY(is_huge_page_aligned(a));
+#endif
+
+  // the copies and reallocations follow the same policy
+  BigMatrix b(a);
+  VERIFY_IS_EQUAL(b, ref);
+  b.conservativeResize(400,200);
+  VERIFY_IS_EQUAL(b.topRows(300), ref);
+  b.conservativeResize(400,250);
+  VERIFY_IS_EQUAL(b.topLeftCorner(300,200), ref);
+#if EIGEN_HAS_HUGE_PAGE_MALLOC
+  VERIFY(is_huge_page_aligned(b));
+#endif
+  setParallelScheduler(0);
+  setNbThreads(0);
+
+  // global policy above a threshold
+  VERIFY_IS_EQUAL(allocationPolicy(), 0);
+  setAllocationPolicy(HugePages, 1024*sizeof(float));
+  VERIFY_IS_EQUAL(allocationPolicy(), int(HugePages));
+  VectorXf large = VectorXf::Ones(2000);
+  VERIFY_IS_EQUAL(large.sum(), 2000.f);
+#if EIGEN_HAS_HUGE_PAGE_MALLOC
+  VERIFY(is_huge_page_aligned(large));
+#endif
+  large.resize(500);
+  large.setOnes();
+  VERIFY_IS_EQUAL(large.sum(), 500.f);
+  setAllocationPolicy(0);
+  VERIFY_IS_EQUAL(allocationPolicy(), 0);
+}
+
 void test_dense_storage()
 {
   dense_storage_copy<int,Dynamic,Dynamic>();  
@@ -73,4 +136,6 @@ void test_dense_storage()
   dense_storage_assignment<float,Dynamic,3>();
   dense_storage_assignment<float,4,Dynamic>();  
   dense_storage_assignment<float,4,3>();  
+
+  dense_storage_allocation_policy();
 }
@@ -0,0 +1,136 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "main.h"
+
+// Checks shared by the 16-bit floating point types, i.e., half and bfloat16, which are stored on 16 bits and
+// computed in single precision. The tolerance \a prec is the relative precision of the type.
+
+// the results computed in 16-bit precision are rounded once from the single precision ones
+template<typename A, typename B> bool float16_is_approx(const A& a, const B& ref, float scale, float prec)
+{
+  return (a.template cast<float>() - ref).cwiseAbs().maxCoeff() <= prec * scale;
+}
+
+template<typename T> void float16_round_trip()
+{
+  // round trip of all the non NaN values
+  for(int i = 0; i < 0x10000; ++i)
+  {
+    T h;
+    h.x = static_cast<unsigned short>(i);
+    if(!(numext::isnan)(h))
+      VERIFY_IS_EQUAL(T(float(h)).x, h.x);
+  }
+  VERIFY((numext::isnan)(T(std::numeric_limits<float>::quiet_NaN())));
+  VERIFY((numext::isinf)(-NumTraits<T>::infinity()));
+}
+
+// the vectorized conversions of \a f match the scalar ones, except for the NaNs
+template<typename T> void float16_vectorized_conversion(const VectorXf& f)
+{
+  Matrix<T,Dynamic,1> h = f.template cast<T>();
+  VectorXf g = h.template cast<float>();
+  for(Index i = 0; i < f.size(); ++i)
+  {
+    if((numext::isnan)(f(i)))
+    {
+      VERIFY((numext::isnan)(h(i)));
+      continue;
+    }
+    VERIFY_IS_EQUAL(h(i).x, T(f(i)).x);
+    VERIFY_IS_EQUAL(g(i), float(h(i)));
+  }
+}
+
+template<typename T> void float16_cwise(Index rows, Index cols)
+{
+  typedef Matrix<T,Dynamic,Dynamic> MatrixType;
+  MatrixType a = MatrixXf::Random(rows,cols).template cast<T>(), b = MatrixXf::Random(rows,cols).template cast<T>();
+  MatrixXf af = a.template cast<float>(), bf = b.template cast<float>();
+
+  MatrixType c = a + b;
+  MatrixType d = a.cwiseProduct(b) - T(2.f) * b;
+  MatrixType e = -a.cwiseAbs();
+  for(Index j = 0; j < cols; ++j)
+    for(Index i = 0; i < rows; ++i)
+    {
+      VERIFY_IS_EQUAL(c(i,j).x, T(af(i,j) + bf(i,j)).x);
+      VERIFY_IS_EQUAL(d(i,j).x, T(float(T(af(i,j) * bf(i,j))) - float(T(2.f * bf(i,j)))).x);
+      VERIFY_IS_EQUAL(float(e(i,j)), -std::abs(af(i,j)));
+    }
+  VERIFY_IS_EQUAL(float(a.maxCoeff()), af.maxCoeff());
+  VERIFY_IS_EQUAL(float(a.minCoeff()), af.minCoeff());
+  VERIFY_IS_EQUAL(MatrixXf(a.colwise().reverse().template cast<float>()), MatrixXf(af.colwise().reverse()));
+}
+
+template<typename T> void float16_redux(Index size, float prec)
+{
+  // the sums are accumulated in single precision, so that they are accurate even when the partial sums are large
+  // (but still below the largest half for up to 65504 coefficients)
+  Matrix<T,Dynamic,1> v = ((VectorXf::Random(size).array() + 1.f) * 0.5f).matrix().template cast<T>();
+  VectorXf vf = v.template cast<float>();
+  float ref = vf.sum();
+  VERIFY(std::abs(float(v.sum()) - ref) <= prec * ref);
+  VERIFY(std::abs(float(v.tail(size-1).sum()) - vf.tail(size-1).sum()) <= prec * ref);
+
+  Index rows = internal::random<Index>(3,100);
+  Matrix<T,Dynamic,Dynamic> m = MatrixXf::Random(rows, internal::random<Index>(3,100)).template cast<T>();
+  MatrixXf mf = m.template cast<float>();
+  VERIFY(std::abs(float(m.sum()) - mf.sum()) <= prec * mf.cwiseAbs().sum());
+  VERIFY(std::abs(float(m.block(1,1,rows-2,m.cols()-2).sum()) - mf.block(1,1,rows-2,m.cols()-2).sum()) <= prec * mf.cwiseAbs().sum());
+}
+
+template<typename T> void float16_product(Index rows, Index cols, Index depth, float prec)
+{
+  typedef Matrix<T,Dynamic,Dynamic> MatrixType;
+  typedef Matrix<T,Dynamic,Dynamic,RowMajor> RowMatrixType;
+  typedef Matrix<T,Dynamic,1> VectorType;
+  MatrixType a = MatrixXf::Random(rows,depth).template cast<T>(), b = MatrixXf::Random(depth,cols).template cast<T>();
+  MatrixXf af = a.template cast<float>(), bf = b.template cast<float>();
+  MatrixXf ref = af * bf;
+  float scale = (af.cwiseAbs() * bf.cwiseAbs()).maxCoeff() + 1.f;
+
+  MatrixType c = a * b;
+  VERIFY(float16_is_approx(c, ref, scale, prec));
+
+  RowMatrixType cr(rows,cols);
+  cr.noalias() = a * b;
+  VERIFY(float16_is_approx(cr, ref, scale, prec));
+
+  RowMatrixType ar = a;
+  c.noalias() = ar * b.transpose().transpose();
+  VERIFY(float16_is_approx(c, ref, scale, prec));
+
+  MatrixType c2 = MatrixXf::Random(rows,cols).template cast<T>();
+  MatrixXf c2f = c2.template cast<float>();
+  c2.noalias() -= T(2.f) * a * b;
+  VERIFY(float16_is_approx(c2, c2f - 2.f * ref, 2.f * scale + 1.f, prec));
+
+  // matrix-vector products, with a strided destination
+  VectorType x = VectorXf::Random(depth).template cast<T>();
+  VectorXf xf = x.template cast<float>();
+  VectorType y = a * x;
+  VERIFY(float16_is_approx(y, af * xf, scale, prec));
+  y.noalias() = ar * x;
+  VERIFY(float16_is_approx(y, af * xf, scale, prec));
+  MatrixType yt(2, cols);
+  yt.row(1).noalias() = x.transpose() * b;
+  VERIFY(float16_is_approx(yt.row(1), xf.transpose() * bf, scale, prec));
+}
+
+template<typename T> void float16_product_blocking(float prec)
+{
+  // force several blocks in all directions
+  std::ptrdiff_t l1, l2, l3;
+  internal::manage_caching_sizes(GetAction, &l1, &l2, &l3);
+  setCpuCacheSizes(4096, 32768, 65536);
+  float16_product<T>(internal::random<Index>(200,300), internal::random<Index>(200,300), internal::random<Index>(600,700), prec);
+  setCpuCacheSizes(l1, l2, l3);
+}
@@ -0,0 +1,43 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "float16_common.h"
+
+// the relative precision of the products in half precision
+static const float half_prec = 2e-3f;
+
+void half_conversion()
+{
+  float16_round_trip<half>();
+
+  VERIFY_IS_EQUAL(half(1.f).x, 0x3c00);
+  VERIFY_IS_EQUAL(half(-2.f).x, 0xc000);
+  VERIFY_IS_EQUAL(half(65504.f).x, 0x7bff);
+  VERIFY_IS_EQUAL(half(1e6f).x, 0x7c00);
+  VERIFY_IS_EQUAL(half(5.96046448e-8f).x, 0x0001);
+  // round to nearest even
+  VERIFY_IS_EQUAL(half(1.f + 1.f/2048).x, 0x3c00);
+  VERIFY_IS_EQUAL(half(1.f + 3.f/2048).x, 0x3c02);
+  VERIFY_IS_EQUAL(float(NumTraits<half>::epsilon()), std::ldexp(1.f, -10));
+
+  // vectorized conversions
+  float16_vectorized_conversion<half>(VectorXf::Random(internal::random<Index>(1,1000)) * 1000.f);
+}
+
+void test_half_float()
+{
+  CALL_SUBTEST_1( half_conversion() );
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_2( float16_cwise<half>(internal::random<Index>(1,EIGEN_TEST_MAX_SIZE), internal::random<Index>(1,EIGEN_TEST_MAX_SIZE)) );
+    CALL_SUBTEST_3( float16_redux<half>(internal::random<Index>(2,50000), 1e-3f) );
+    CALL_SUBTEST_4( float16_product<half>(internal::random<Index>(1,EIGEN_TEST_MAX_SIZE), internal::random<Index>(1,EIGEN_TEST_MAX_SIZE), internal::random<Index>(1,EIGEN_TEST_MAX_SIZE), half_prec) );
+    CALL_SUBTEST_4( float16_product<half>(internal::random<Index>(1,4), internal::random<Index>(1,4), internal::random<Index>(1,4), half_prec) );
+  }
+  CALL_SUBTEST_5( float16_product_blocking<half>(half_prec) );
+}
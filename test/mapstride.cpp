@@ -146,6 +146,56 @@ template<int Alignment,typename MatrixType> void map_class_matrix(const MatrixTy
   internal::aligned_delete(a_array1, arraysize+1);
 }
 
+// dynamic size expressions with a non unit inner stride are vectorized through pgather/pscatter
+template<typename Scalar> void map_gather_scatter(Index size)
+{
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+  typedef Matrix<Scalar,Dynamic,Dynamic> MatrixType;
+  typedef Map<VectorType, Unaligned, InnerStride<3> > StridedMap;
+  typedef Map<VectorType, Unaligned, InnerStride<Dynamic> > DynStridedMap;
+  enum { PacketAccess = internal::packet_traits<Scalar>::Vectorizable };
+
+  VERIFY(bool(internal::evaluator<StridedMap>::Flags & PacketAccessBit) == bool(PacketAccess));
+  VERIFY(bool(internal::evaluator<DynStridedMap>::Flags & PacketAccessBit) == bool(PacketAccess));
+  VERIFY(!(internal::evaluator<StridedMap>::Flags & AlignedBit));
+  VERIFY(bool(internal::evaluator<typename MatrixType::RowXpr>::Flags & PacketAccessBit) == bool(PacketAccess));
+
+  // xyz layout
+  VectorType xyz = VectorType::Random(3*size), v = VectorType::Random(size);
+  StridedMap x(xyz.data(), size), y(xyz.data()+1, size), z(xyz.data()+2, size);
+  VectorType ref = xyz;
+  for(Index i=0; i<size; ++i)
+    ref(3*i+1) = ref(3*i) * Scalar(2) + ref(3*i+2) - v(i);
+  y = x * Scalar(2) + z - v;
+  VERIFY_IS_EQUAL(xyz, ref);
+
+  Scalar sum(0);
+  for(Index i=0; i<size; ++i)
+    sum += xyz(3*i);
+  VERIFY_IS_APPROX(x.sum(), sum);
+  VERIFY_IS_APPROX(x.dot(v), VectorType(x).dot(v));
+  VERIFY_IS_EQUAL(x.reverse().eval(), VectorType(x).reverse());
+
+  Index stride = internal::random<Index>(2,5);
+  VectorType w = VectorType::Random(stride*size);
+  DynStridedMap s(w.data(), size, InnerStride<Dynamic>(stride));
+  s.reverse() = v;
+  for(Index i=0; i<size; ++i)
+    VERIFY_IS_EQUAL(w(stride*(size-1-i)), v(i));
+
+  // rows of a column-major matrix
+  MatrixType m = MatrixType::Random(internal::random<Index>(2,5), size), m1 = m;
+  Index r = internal::random<Index>(1,m.rows()-1);
+  m.row(r) = m.row(r) * Scalar(2) - v.transpose();
+  for(Index j=0; j<size; ++j)
+    m1(r,j) = m1(r,j) * Scalar(2) - v(j);
+  VERIFY_IS_EQUAL(m, m1);
+  VERIFY_IS_APPROX(m.row(r).squaredNorm(), m1.row(r).eval().squaredNorm());
+  m.row(r).tail(size-1).swap(m.row(0).head(size-1));
+  VERIFY_IS_EQUAL(m.row(r).tail(size-1), m1.row(0).head(size-1));
+  VERIFY_IS_EQUAL(m.row(0).head(size-1), m1.row(r).tail(size-1));
+}
+
 void test_mapstride()
 {
   for(int i = 0; i < g_repeat; i++) {
@@ -176,6 +226,11 @@ void test_mapstride()
     CALL_SUBTEST_6( map_class_matrix<Aligned>(MatrixXcd(internal::random<int>(1,maxn),internal::random<int>(1,maxn))) );
     CALL_SUBTEST_6( map_class_matrix<Unaligned>(MatrixXcd(internal::random<int>(1,maxn),internal::random<int>(1,maxn))) );
     
+    CALL_SUBTEST_7( map_gather_scatter<float>(internal::random<int>(1,1000)) );
+    CALL_SUBTEST_7( map_gather_scatter<double>(internal::random<int>(1,1000)) );
+    CALL_SUBTEST_8( map_gather_scatter<int>(internal::random<int>(1,1000)) );
+    CALL_SUBTEST_8( map_gather_scatter<std::complex<float> >(internal::random<int>(1,1000)) );
+
     TEST_SET_BUT_UNUSED_VARIABLE(maxn);
   }
 }
@@ -202,6 +202,122 @@ template<typename MatrixType> void test_reference(const MatrixType& m) {
 
 }
 
+// counts the buffers taken from and returned to the heap through this allocator
+struct counting_scratch_allocator : ScratchAllocator
+{
+  counting_scratch_allocator() : m_allocated(0), m_deallocated(0) {}
+  void* allocate(std::size_t size) { ++m_allocated; return internal::aligned_malloc(size); }
+  void deallocate(void* ptr, std::size_t) { ++m_deallocated; internal::aligned_free(ptr); }
+  int m_allocated, m_deallocated;
+};
+
+void scratch_owner()
+{
+  // the scratch buffers go back to the allocator they were taken from, even if the current one has changed since
+  Eigen::internal::set_is_malloc_allowed(true);
+  const Index size = EIGEN_STACK_ALLOCATION_LIMIT/sizeof(float) + 1;
+  counting_scratch_allocator allocator;
+  {
+    ei_declare_aligned_stack_constructed_variable(float, heapBuffer, size, 0);
+    setScratchAllocator(&allocator);
+    heapBuffer[size-1] = 0.f;
+  }
+  setScratchAllocator(0);
+  VERIFY_IS_EQUAL(allocator.m_allocated, 0);
+  VERIFY_IS_EQUAL(allocator.m_deallocated, 0);
+  {
+    setScratchAllocator(&allocator);
+    ei_declare_aligned_stack_constructed_variable(float, ownedBuffer, size, 0);
+    setScratchAllocator(0);
+    ownedBuffer[size-1] = 0.f;
+  }
+  VERIFY_IS_EQUAL(allocator.m_allocated, 1);
+  VERIFY_IS_EQUAL(allocator.m_deallocated, 1);
+  Eigen::internal::set_is_malloc_allowed(false);
+}
+
+#ifdef EIGEN_THREAD_LOCAL
+void scratch_arena()
+{
+  // the scratch buffers of the products and solvers are taken from the arena instead of the heap
+  Eigen::internal::set_is_malloc_allowed(true);
+  MatrixXf A = MatrixXf::Random(100,80), B = MatrixXf::Random(80,60), C(100,60), L(60,60), X(60,60);
+  MatrixXf refC = A.lazyProduct(B);
+  L = MatrixXf::Random(60,60).triangularView<Lower>();
+  L.diagonal().array() += 60.f;
+  VectorXf x = VectorXf::Random(80), y(100);
+  ScratchArena arena(1024*1024), tiny(64);
+  Eigen::internal::set_is_malloc_allowed(false);
+
+  {
+    ScopedScratchAllocator guard(&arena);
+    VERIFY(scratchAllocator()==&arena);
+    C.noalias() = A * B;
+    y.noalias() = A.transpose().transpose() * x;
+    X = C.topRows(60);
+    L.triangularView<Lower>().solveInPlace(X);
+  }
+  VERIFY(scratchAllocator()==0);
+  VERIFY(arena.peak() > 0);
+  VERIFY_IS_EQUAL(arena.used(), std::size_t(0));
+  VERIFY_IS_APPROX(C, refC);
+  VERIFY_RAISES_ASSERT(C.noalias() = A * B);
+
+  Eigen::internal::set_is_malloc_allowed(true);
+  VERIFY_IS_APPROX(y, A.lazyProduct(x));
+  VERIFY_IS_APPROX(L*X, refC.topRows(60));
+
+  // buffers which do not fit in the arena fall back to the heap
+  {
+    ScopedScratchAllocator guard(&tiny);
+    C.noalias() = A * B;
+  }
+  VERIFY_IS_APPROX(C, refC);
+  VERIFY_IS_EQUAL(tiny.used(), std::size_t(0));
+  Eigen::internal::set_is_malloc_allowed(false);
+}
+
+template<typename MatrixType> void workspace_decompositions(Index size)
+{
+  // once computed, the decompositions keep their temporaries for the next calls of compute()
+  Eigen::internal::set_is_malloc_allowed(true);
+  MatrixType A = MatrixType::Random(size,size), B = MatrixType::Random(size,size);
+  A = A * A.adjoint();
+  A.diagonal().array() += typename MatrixType::RealScalar(size);
+  B = B * B.adjoint();
+  B.diagonal().array() += typename MatrixType::RealScalar(size);
+
+  PartialPivLU<MatrixType> lu(A);
+  HouseholderQR<MatrixType> qr(A);
+  LLT<MatrixType> llt(A);
+  SelfAdjointEigenSolver<MatrixType> eig(A);
+  JacobiSVD<MatrixType> svd(A, ComputeFullU|ComputeFullV);
+  Eigen::internal::set_is_malloc_allowed(false);
+
+  lu.compute(B);
+  qr.compute(B);
+  llt.compute(B);
+  eig.compute(B);
+  svd.compute(B, ComputeFullU|ComputeFullV);
+
+  Eigen::internal::set_is_malloc_allowed(true);
+  VERIFY_IS_APPROX(lu.reconstructedMatrix(), B);
+  VERIFY_IS_APPROX(MatrixType(qr.householderQ()) * MatrixType(qr.matrixQR().template triangularView<Upper>()), B);
+  VERIFY_IS_APPROX(llt.reconstructedMatrix(), B);
+  VERIFY_IS_APPROX(eig.eigenvectors() * eig.eigenvalues().asDiagonal() * eig.eigenvectors().adjoint(), B);
+  VERIFY_IS_APPROX(svd.matrixU() * svd.singularValues().asDiagonal() * svd.matrixV().adjoint(), B);
+  Eigen::internal::set_is_malloc_allowed(false);
+}
+#endif
+
+void fixed_size_workspaces()
+{
+  // the fixed-size decompositions do not keep a workspace
+  VERIFY(sizeof(LLT<Matrix2d>) < sizeof(Matrix2d) + sizeof(internal::scratch_workspace));
+  VERIFY(sizeof(PartialPivLU<Matrix3f>) < sizeof(Matrix3f) + 2*sizeof(Matrix<int,3,1>) + sizeof(internal::scratch_workspace));
+  VERIFY(sizeof(HouseholderQR<Matrix3d>) < sizeof(Matrix3d) + 2*sizeof(Vector3d) + sizeof(internal::scratch_workspace));
+}
+
 void test_nomalloc()
 {
   // create some dynamic objects
@@ -219,10 +335,19 @@ void test_nomalloc()
   
   // Check decomposition modules with dynamic matrices that have a known compile-time max size (ctms)
   CALL_SUBTEST_4(ctms_decompositions<float>());
+  CALL_SUBTEST_4(fixed_size_workspaces());
 
   CALL_SUBTEST_5(test_zerosized());
 
   CALL_SUBTEST_6(test_reference(Matrix<float,32,32>()));
   CALL_SUBTEST_7(test_reference(R1));
   CALL_SUBTEST_8(Ref<MatrixXd> R2 = M1.topRows<2>(); test_reference(R2));
+  CALL_SUBTEST_9(scratch_owner());
+#ifdef EIGEN_THREAD_LOCAL
+  CALL_SUBTEST_9(scratch_arena());
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_10(workspace_decompositions<MatrixXd>(internal::random<Index>(1,200)));
+    CALL_SUBTEST_10(workspace_decompositions<MatrixXcf>(internal::random<Index>(1,100)));
+  }
+#endif
 }
@@ -298,6 +298,8 @@ template<typename Scalar> void packetmath_real()
   CHECK_CWISE1_IF(internal::packet_traits<Scalar>::HasSin, std::sin, internal::psin);
   CHECK_CWISE1_IF(internal::packet_traits<Scalar>::HasCos, std::cos, internal::pcos);
   CHECK_CWISE1_IF(internal::packet_traits<Scalar>::HasTan, std::tan, internal::ptan);
+  CHECK_CWISE1_IF(internal::packet_traits<Scalar>::HasTanh, std::tanh, internal::ptanh);
+  CHECK_CWISE1_IF(internal::packet_traits<Scalar>::HasErf, numext::erf, internal::perf);
   
   for (int i=0; i<size; ++i)
   {
@@ -384,6 +386,19 @@ template<typename Scalar> void packetmath_real()
     VERIFY(numext::isnan(data2[1]));
 #endif
   }
+
+  for (int i=0; i<PacketSize; ++i)
+  {
+    data1[i] = internal::random<Scalar>(0,1) * std::pow(Scalar(10), internal::random<Scalar>(-6,6));
+    data1[i+PacketSize] = internal::random<Scalar>(-3,3);
+    ref[i] = std::pow(data1[i], data1[i+PacketSize]);
+  }
+  {
+    packet_helper<internal::packet_traits<Scalar>::HasPow,Packet> h;
+    h.store(data2, internal::ppow(h.load(data1), h.load(data1+PacketSize)));
+    if(internal::packet_traits<Scalar>::HasPow)
+      VERIFY(areApprox(ref, data2, PacketSize) && "internal::ppow");
+  }
 }
 
 template<typename Scalar> void packetmath_notcomplex()
@@ -416,6 +431,28 @@ template<typename Scalar> void packetmath_notcomplex()
     ref[i] = data1[0]+Scalar(i);
   internal::pstore(data2, internal::plset(data1[0]));
   VERIFY(areApprox(ref, data2, PacketSize) && "internal::plset");
+
+  if (internal::packet_traits<Scalar>::HasCmp) {
+    // make some coefficients equal
+    Array<Scalar,Dynamic,1>::Map(data2, PacketSize).setRandom();
+    for (int i = 0; i < PacketSize; i += 2)
+      data2[i] = data1[i];
+    Packet a = internal::pload<Packet>(data1);
+    Packet b = internal::pload<Packet>(data2);
+    int eq = internal::pmovemask(internal::pcmp_eq(a,b));
+    int neq = internal::pmovemask(internal::pcmp_neq(a,b));
+    int lt = internal::pmovemask(internal::pcmp_lt(a,b));
+    int le = internal::pmovemask(internal::pcmp_le(a,b));
+    EIGEN_ALIGN_DEFAULT Scalar result[internal::packet_traits<Scalar>::size];
+    internal::pstore(result, internal::pselect(internal::pcmp_lt(a,b), a, b));
+    for (int i = 0; i < PacketSize; ++i) {
+      VERIFY(((eq >> i) & 1) == (data1[i] == data2[i]) && "internal::pcmp_eq");
+      VERIFY(((neq >> i) & 1) == (data1[i] != data2[i]) && "internal::pcmp_neq");
+      VERIFY(((lt >> i) & 1) == (data1[i] < data2[i]) && "internal::pcmp_lt");
+      VERIFY(((le >> i) & 1) == (data1[i] <= data2[i]) && "internal::pcmp_le");
+      VERIFY(result[i] == (data1[i] < data2[i] ? data1[i] : data2[i]) && "internal::pselect");
+    }
+  }
 }
 
 template<typename Scalar,bool ConjLhs,bool ConjRhs> void test_conj_helper(Scalar* data1, Scalar* data2, Scalar* ref, Scalar* pval)
@@ -509,6 +546,38 @@ template<typename Scalar> void packetmath_scatter_gather() {
   for (int i = 0; i < PacketSize; ++i) {
     VERIFY(isApproxAbs(data1[i], buffer[i*7], refvalue) && "pgather");
   }
+
+  // gather through arbitrary, possibly repeated, indices
+  int indices[PacketSize];
+  for (int i = 0; i < PacketSize; ++i) {
+    indices[i] = internal::random<int>(0,PacketSize*7-1);
+  }
+  packet = internal::pgather<Scalar, Packet>(buffer, indices);
+  internal::pstore(data1, packet);
+  for (int i = 0; i < PacketSize; ++i) {
+    VERIFY(isApproxAbs(data1[i], buffer[indices[i]], refvalue) && "pgather indexed");
+  }
+}
+
+void cpu_features()
+{
+  // the test itself is running, so the CPU must support the instruction sets it has been compiled for
+  VERIFY(cpuSupportsInstructionSetsInUse());
+  int features = internal::queryCpuFeatures();
+  if(features>=0)
+  {
+    int required = internal::requiredCpuFeatures();
+    VERIFY_IS_EQUAL(features & required, required);
+    if(features & internal::CpuAVX2)
+      VERIFY(features & internal::CpuAVX);
+    if(features & internal::CpuF16C)
+      VERIFY(features & internal::CpuAVX);
+  }
+#ifdef EIGEN_VECTORIZE_F16C
+  // the half conversions use the F16C instructions
+  VERIFY(internal::requiredCpuFeatures() & internal::CpuF16C);
+  VERIFY(std::strstr(SimdInstructionSetsInUse(), "F16C") != 0);
+#endif
 }
 
 void test_packetmath()
@@ -536,4 +605,5 @@ void test_packetmath()
     CALL_SUBTEST_4( packetmath_scatter_gather<std::complex<float> >() );
     CALL_SUBTEST_5( packetmath_scatter_gather<std::complex<double> >() );
   }
+  CALL_SUBTEST_1( cpu_features() );
 }
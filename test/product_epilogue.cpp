@@ -0,0 +1,136 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "main.h"
+
+// adds a bias per row and clamps the negative values
+template<typename Scalar> struct bias_relu_op
+{
+  bias_relu_op(const Matrix<Scalar,Dynamic,1>& bias) : m_bias(bias) {}
+  Scalar operator()(const Scalar& x, Index row, Index) const
+  {
+    return (std::max)(x + m_bias(row), Scalar(0));
+  }
+  template<typename Packet> Packet packetOp(const Packet& x, Index row, Index) const
+  {
+    return internal::pmax(internal::padd(x, internal::ploadu<Packet>(m_bias.data()+row)), internal::pset1<Packet>(Scalar(0)));
+  }
+  const Matrix<Scalar,Dynamic,1>& m_bias;
+};
+
+// scales each column by a different factor
+template<typename Scalar> struct column_scaling_op
+{
+  column_scaling_op(const Matrix<Scalar,Dynamic,1>& factors) : m_factors(factors) {}
+  Scalar operator()(const Scalar& x, Index, Index col) const
+  {
+    return x * m_factors(col);
+  }
+  template<typename Packet> Packet packetOp(const Packet& x, Index, Index col) const
+  {
+    return internal::pmul(x, internal::pset1<Packet>(m_factors(col)));
+  }
+  const Matrix<Scalar,Dynamic,1>& m_factors;
+};
+
+template<typename MatrixType, typename Epilogue>
+void check_epilogue(const MatrixType& a, const MatrixType& b, const Epilogue& op)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic,ColMajor> MatrixColMaj;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> MatrixRowMaj;
+
+  MatrixColMaj ref = a*b;
+  internal::apply_product_epilogue(ref, op);
+
+  MatrixColMaj c(a.rows(),b.cols());
+  c.noalias() = (a*b).withEpilogue(op);
+  VERIFY_IS_APPROX(c, ref);
+
+  MatrixColMaj c2 = (a*b).withEpilogue(op);
+  VERIFY_IS_APPROX(c2, ref);
+
+  MatrixRowMaj cr(a.rows(),b.cols());
+  cr.noalias() = (a*b).withEpilogue(op);
+  VERIFY_IS_APPROX(cr, ref);
+
+  // scaled and conjugated factors
+  Scalar s = internal::random<Scalar>();
+  c.noalias() = (s*a.conjugate()*b).withEpilogue(op);
+  MatrixColMaj ref2 = s*a.conjugate()*b;
+  internal::apply_product_epilogue(ref2, op);
+  VERIFY_IS_APPROX(c, ref2);
+}
+
+template<typename MatrixType> void product_epilogue(Index rows, Index cols, Index depth)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+
+  MatrixType a = MatrixType::Random(rows,depth);
+  MatrixType b = MatrixType::Random(depth,cols);
+  VectorType factors = VectorType::Random(cols);
+  check_epilogue(a, b, column_scaling_op<Scalar>(factors));
+
+  // the indices passed to the epilogue are relative to the destination block
+  MatrixType c = MatrixType::Random(rows+2,cols+3), ref = c;
+  c.block(1,2,rows,cols).noalias() = (a*b).withEpilogue(column_scaling_op<Scalar>(factors));
+  ref.block(1,2,rows,cols) = (a*b) * factors.asDiagonal();
+  VERIFY_IS_APPROX(c, ref);
+
+  // aliasing between the result and a factor
+  if(rows==depth)
+  {
+    MatrixType sq = MatrixType::Random(rows,rows), a2 = a;
+    VectorType sq_factors = VectorType::Random(rows);
+    ref = (a*sq) * sq_factors.asDiagonal();
+    a2 = (a2*sq).withEpilogue(column_scaling_op<Scalar>(sq_factors));
+    VERIFY_IS_APPROX(a2, ref);
+  }
+}
+
+template<typename MatrixType> void product_epilogue_real(Index rows, Index cols, Index depth)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+
+  MatrixType a = MatrixType::Random(rows,depth);
+  MatrixType b = MatrixType::Random(depth,cols);
+  VectorType bias = VectorType::Random(rows);
+  check_epilogue(a, b, bias_relu_op<Scalar>(bias));
+
+  MatrixType c(rows,cols);
+  c.noalias() = (a*b).withEpilogue(bias_relu_op<Scalar>(bias));
+  VERIFY((c.array()>=Scalar(0)).all());
+  VERIFY_IS_APPROX(c, ((a*b).colwise()+bias).cwiseMax(Scalar(0)));
+}
+
+void product_epilogue_blocking()
+{
+  // force several panels along the depth dimension
+  std::ptrdiff_t l1, l2, l3;
+  internal::manage_caching_sizes(GetAction, &l1, &l2, &l3);
+  setCpuCacheSizes(4096, 32768, 65536);
+  product_epilogue_real<MatrixXf>(internal::random<Index>(200,400), internal::random<Index>(200,400), internal::random<Index>(200,400));
+  product_epilogue<MatrixXcd>(internal::random<Index>(100,200), internal::random<Index>(100,200), internal::random<Index>(100,200));
+  setCpuCacheSizes(l1, l2, l3);
+}
+
+void test_product_epilogue()
+{
+  for(int i = 0; i < g_repeat; i++) {
+    int rows = internal::random<int>(1,EIGEN_TEST_MAX_SIZE); TEST_SET_BUT_UNUSED_VARIABLE(rows)
+    CALL_SUBTEST_1( product_epilogue_real<MatrixXf>(rows, internal::random<int>(1,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,EIGEN_TEST_MAX_SIZE)) );
+    CALL_SUBTEST_2( product_epilogue_real<MatrixXd>(rows, internal::random<int>(1,EIGEN_TEST_MAX_SIZE), rows) );
+    CALL_SUBTEST_2( product_epilogue<MatrixXd>(rows, internal::random<int>(1,EIGEN_TEST_MAX_SIZE), rows) );
+    CALL_SUBTEST_3( product_epilogue<MatrixXcf>(internal::random<int>(1,EIGEN_TEST_MAX_SIZE/2), internal::random<int>(1,EIGEN_TEST_MAX_SIZE/2), internal::random<int>(1,EIGEN_TEST_MAX_SIZE/2)) );
+    CALL_SUBTEST_4( product_epilogue<MatrixXi>(rows, internal::random<int>(1,EIGEN_TEST_MAX_SIZE), rows) );
+  }
+  CALL_SUBTEST_5( product_epilogue_blocking() );
+}
@@ -0,0 +1,95 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "main.h"
+
+template<typename Scalar> Matrix<Scalar,Dynamic,Dynamic> random_integer_matrix(Index rows, Index cols, int range)
+{
+  Matrix<Scalar,Dynamic,Dynamic> m(rows,cols);
+  for(Index j=0; j<cols; ++j)
+    for(Index i=0; i<rows; ++i)
+      m(i,j) = Scalar(internal::random<int>(-range,range));
+  return m;
+}
+
+template<typename LhsScalar, typename RhsScalar> void product_integer(Index rows, Index cols, Index depth, int range)
+{
+  typedef Matrix<int,Dynamic,Dynamic> MatrixXi32;
+  typedef Matrix<int,Dynamic,Dynamic,RowMajor> RowMatrixXi32;
+  typedef Matrix<signed char,Dynamic,Dynamic> MatrixXi8;
+
+  Matrix<LhsScalar,Dynamic,Dynamic> a = random_integer_matrix<LhsScalar>(rows, depth, range);
+  Matrix<RhsScalar,Dynamic,Dynamic> b = random_integer_matrix<RhsScalar>(depth, cols, range);
+  MatrixXi32 ref = a.template cast<int>() * b.template cast<int>();
+
+  MatrixXi32 c;
+  integerProduct(a, b, c);
+  VERIFY_IS_EQUAL(c, ref);
+
+  RowMatrixXi32 cr(rows, cols);
+  integerProduct(a, b, cr);
+  VERIFY_IS_EQUAL(MatrixXi32(cr), ref);
+
+  // expressions as operands
+  integerProduct(a.transpose().transpose(), b.leftCols(cols/2), c);
+  VERIFY_IS_EQUAL(c, ref.leftCols(cols/2));
+
+  // row-major operands, and blocks read with their outer stride
+  Matrix<LhsScalar,Dynamic,Dynamic,RowMajor> ar = a;
+  Matrix<RhsScalar,Dynamic,Dynamic,RowMajor> br = b;
+  integerProduct(ar, br, c);
+  VERIFY_IS_EQUAL(c, ref);
+  integerProduct(ar.bottomRows(rows/2), b.rightCols(cols-cols/2), c);
+  VERIFY_IS_EQUAL(c, ref.bottomRightCorner(rows/2, cols-cols/2));
+  integerProduct(a.bottomRows(rows/2), br.rightCols(cols-cols/2), c);
+  VERIFY_IS_EQUAL(c, ref.bottomRightCorner(rows/2, cols-cols/2));
+
+  // requantization to 8-bit integers
+  double scale = 1. / (1 + internal::random<int>(0,range*range));
+  int zero = internal::random<int>(-10,10);
+  Requantize<signed char> requantize(scale, zero);
+  MatrixXi8 q;
+  integerProduct(a, b, q, requantize);
+  VERIFY_IS_EQUAL(q.rows(), rows);
+  VERIFY_IS_EQUAL(q.cols(), cols);
+  for(Index j=0; j<cols; ++j)
+    for(Index i=0; i<rows; ++i)
+      VERIFY_IS_EQUAL(q(i,j), requantize(ref(i,j), i, j));
+}
+
+void product_integer_requantize()
+{
+  Requantize<signed char> r(0.5, 3);
+  VERIFY_IS_EQUAL(r(10, 0, 0), 8);
+  VERIFY_IS_EQUAL(r(-11, 0, 0), -2);
+  VERIFY_IS_EQUAL(r(1000, 0, 0), 127);
+  VERIFY_IS_EQUAL(r(-1000, 0, 0), -128);
+}
+
+void product_integer_blocking()
+{
+  // force several blocks in all directions
+  std::ptrdiff_t l1, l2, l3;
+  internal::manage_caching_sizes(GetAction, &l1, &l2, &l3);
+  setCpuCacheSizes(4096, 32768, 65536);
+  product_integer<signed char,signed char>(internal::random<Index>(200,400), internal::random<Index>(200,400), internal::random<Index>(1100,1300), 127);
+  product_integer<short,short>(internal::random<Index>(100,200), internal::random<Index>(100,200), internal::random<Index>(600,700), 1000);
+  setCpuCacheSizes(l1, l2, l3);
+}
+
+void test_product_integer()
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(( product_integer<signed char,signed char>(internal::random<int>(1,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,EIGEN_TEST_MAX_SIZE), internal::random<int>(0,EIGEN_TEST_MAX_SIZE), 127) ));
+    CALL_SUBTEST_2(( product_integer<short,short>(internal::random<int>(1,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,EIGEN_TEST_MAX_SIZE), internal::random<int>(0,EIGEN_TEST_MAX_SIZE), 2000) ));
+    CALL_SUBTEST_3(( product_integer<signed char,short>(internal::random<int>(1,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,EIGEN_TEST_MAX_SIZE), 100) ));
+  }
+  CALL_SUBTEST_4( product_integer_requantize() );
+  CALL_SUBTEST_5( product_integer_blocking() );
+}
@@ -51,6 +51,47 @@ void test_product_large()
     internal::computeProductBlockingSizes<float,float>(k1,m1,n1,1);
   }
 
+  {
+    // check tabulated blocking sizes are used for products of similar sizes
+    setProductBlockingSizes<double>(256, 512, 128, 1, 64, 96, 32);
+    Index k = 250, m = 600, n = 100;
+    internal::computeProductBlockingSizes<double,double,1>(k,m,n,1);
+    VERIFY_IS_EQUAL(k, 64);
+    VERIFY_IS_EQUAL(m, 96);
+    VERIFY_IS_EQUAL(n, 32);
+
+    // products of neighboring size classes use the closest tabulated sizes, while much different products,
+    // other scalar types or thread counts are not affected
+    k = 500; m = 1000; n = 64;
+    internal::computeProductBlockingSizes<double,double,1>(k,m,n,1);
+    VERIFY(k==64 && m==96 && n==32);
+    k = 4000; m = 4000; n = 4000;
+    internal::computeProductBlockingSizes<double,double,1>(k,m,n,1);
+    VERIFY(k!=64 || m!=96 || n!=32);
+    k = 250; m = 600; n = 100;
+    internal::computeProductBlockingSizes<float,float,1>(k,m,n,1);
+    VERIFY(k!=64 || m!=96 || n!=32);
+
+    MatrixXd a = MatrixXd::Random(250,300), b = MatrixXd::Random(300,100);
+    MatrixXd c = a*b;
+    VERIFY_IS_APPROX(c, a.lazyProduct(b));
+
+    // text format
+    internal::product_blocking_sizes_table& table = internal::product_blocking_sizes_table::instance();
+    clearProductBlockingSizes();
+    VERIFY_IS_EQUAL(table.size(), 0);
+    // the blocking sizes are multiples of the register blocking sizes of all the architectures, so that they are not rounded
+    VERIFY(table.parse("# comment\nfloat 1 64 64 64 48 48 16\n\ncdouble 2 1024 1024 1024 128 256 512\n"));
+    VERIFY_IS_EQUAL(table.size(), 2);
+    k = 64; m = 64; n = 64;
+    internal::computeProductBlockingSizes<float,float,1>(k,m,n,1);
+    VERIFY(k==48 && m==48 && n==16);
+    VERIFY(!table.parse("half 1 64 64 64 48 32 16"));
+    VERIFY(!table.parse("float 1 64 64 64 48 32"));
+    VERIFY(!loadProductBlockingSizes("this-file-does-not-exist"));
+    clearProductBlockingSizes();
+  }
+
   {
     // test regression in row-vector by matrix (bad Map type)
     MatrixXf mat1(10,32); mat1.setRandom();
@@ -0,0 +1,93 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "main.h"
+
+template<typename Scalar> void packed_lhs(Index rows, Index depth)
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic,ColMajor> MatrixColMaj;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> MatrixRowMaj;
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+
+  Index cols = internal::random<Index>(1,EIGEN_TEST_MAX_SIZE);
+  Index skinny = internal::random<Index>(1,8);
+  Scalar s = internal::random<Scalar>();
+
+  MatrixColMaj a = MatrixColMaj::Random(rows,depth);
+  MatrixRowMaj ar = MatrixRowMaj::Random(depth,rows);
+  MatrixColMaj b = MatrixColMaj::Random(depth,cols);
+  MatrixRowMaj br = MatrixRowMaj::Random(depth,skinny);
+  VectorType v = VectorType::Random(depth);
+
+  PackedLhs<MatrixColMaj> pa(a);
+  VERIFY_IS_EQUAL(pa.rows(), rows);
+  VERIFY_IS_EQUAL(pa.cols(), depth);
+
+  MatrixColMaj c(rows,cols);
+  c = pa * b;
+  VERIFY_IS_APPROX(c, a*b);
+
+  // the packed matrix is reused with several right-hand sides
+  MatrixRowMaj cr(rows,skinny);
+  cr = pa * br;
+  VERIFY_IS_APPROX(cr, a*br);
+  VectorType r = pa * v;
+  VERIFY_IS_APPROX(r, a*v);
+  cr = pa * (s*br.conjugate());
+  VERIFY_IS_APPROX(cr, a*(s*br.conjugate()));
+
+  MatrixColMaj c2 = MatrixColMaj::Random(rows,cols), c3 = c2;
+  pa.applyTo(c2, b, s);
+  c3 += s*a*b;
+  VERIFY_IS_APPROX(c2, c3);
+  Ref<MatrixColMaj> c2_left(c2.leftCols(cols/2));
+  pa.applyTo(c2_left, b.leftCols(cols/2), -s);
+  c3.leftCols(cols/2) -= s*a*b.leftCols(cols/2);
+  VERIFY_IS_APPROX(c2, c3);
+
+  // scaling factor, conjugation and row-major storage of the packed expression
+  pa.compute(s*ar.adjoint());
+  c = pa * b;
+  VERIFY_IS_APPROX(c, s*ar.adjoint()*b);
+
+  PackedLhs<MatrixColMaj> pb(a.block(0,0,rows/2,depth/2));
+  MatrixColMaj block_res = pb * b.topRows(depth/2);
+  VERIFY_IS_APPROX(block_res, a.block(0,0,rows/2,depth/2) * b.topRows(depth/2));
+
+  // aliasing between the result and the rhs
+  if(rows==depth)
+  {
+    MatrixColMaj sq = MatrixColMaj::Random(depth,skinny), ref = ar.adjoint()*sq;
+    sq = pa * sq;
+    VERIFY_IS_APPROX(sq, s*ref);
+  }
+}
+
+void packed_lhs_blocking()
+{
+  // force several blocks in both directions
+  std::ptrdiff_t l1, l2, l3;
+  internal::manage_caching_sizes(GetAction, &l1, &l2, &l3);
+  setCpuCacheSizes(4096, 32768, 65536);
+  packed_lhs<float>(internal::random<Index>(200,400), internal::random<Index>(200,400));
+  packed_lhs<std::complex<double> >(internal::random<Index>(100,200), internal::random<Index>(100,200));
+  setCpuCacheSizes(l1, l2, l3);
+}
+
+void test_product_packed()
+{
+  for(int i = 0; i < g_repeat; i++) {
+    int rows = internal::random<int>(1,EIGEN_TEST_MAX_SIZE); TEST_SET_BUT_UNUSED_VARIABLE(rows)
+    CALL_SUBTEST_1( packed_lhs<float>(rows, internal::random<int>(1,EIGEN_TEST_MAX_SIZE)) );
+    CALL_SUBTEST_2( packed_lhs<double>(rows, rows) );
+    CALL_SUBTEST_3( packed_lhs<std::complex<float> >(internal::random<int>(1,EIGEN_TEST_MAX_SIZE/2), internal::random<int>(1,EIGEN_TEST_MAX_SIZE/2)) );
+    CALL_SUBTEST_4( packed_lhs<int>(rows, rows) );
+  }
+  CALL_SUBTEST_5( packed_lhs_blocking() );
+}
@@ -0,0 +1,233 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#define EIGEN_USE_THREADS
+#define EIGEN_PARALLEL_GEMV_THRESHOLD 65536
+#include "main.h"
+
+template<typename Scalar> struct column_scaling_op
+{
+  column_scaling_op(const Matrix<Scalar,Dynamic,1>& factors) : m_factors(factors) {}
+  Scalar operator()(const Scalar& x, Index, Index col) const { return x * m_factors(col); }
+  template<typename Packet> Packet packetOp(const Packet& x, Index, Index col) const
+  { return internal::pmul(x, internal::pset1<Packet>(m_factors(col))); }
+  const Matrix<Scalar,Dynamic,1>& m_factors;
+};
+
+template<typename MatrixType> void gemm_threaded(Index rows, Index cols, Index depth)
+{
+  typedef Matrix<typename MatrixType::Scalar,Dynamic,Dynamic,ColMajor> ColMajorMatrix;
+  typedef Matrix<typename MatrixType::Scalar,Dynamic,Dynamic,RowMajor> RowMajorMatrix;
+  MatrixType a = MatrixType::Random(rows,depth);
+  MatrixType b = MatrixType::Random(depth,cols);
+
+  setNbThreads(1);
+  MatrixType ref = a*b;
+  setNbThreads(0);
+
+  MatrixType c(rows,cols);
+  c.noalias() = a*b;
+  VERIFY_IS_APPROX(c, ref);
+
+  ColMajorMatrix c1(rows,cols);
+  c1.noalias() = a*b;
+  VERIFY_IS_APPROX(c1, ref);
+
+  RowMajorMatrix c2(rows,cols);
+  c2.noalias() = a*b;
+  VERIFY_IS_APPROX(c2, ref);
+
+  // the row blocks of a packed lhs are split among the threads
+  PackedLhs<MatrixType> pa(a);
+  c1 = pa * b;
+  VERIFY_IS_APPROX(c1, ref);
+
+  // the epilogue is applied to each block computed by the threads
+  Matrix<typename MatrixType::Scalar,Dynamic,1> factors = Matrix<typename MatrixType::Scalar,Dynamic,1>::Random(cols);
+  c1.noalias() = (a*b).withEpilogue(column_scaling_op<typename MatrixType::Scalar>(factors));
+  VERIFY_IS_APPROX(c1, ref * factors.asDiagonal());
+
+  c.setRandom();
+  MatrixType c3 = c;
+  c3.noalias() -= a*b;
+  VERIFY_IS_APPROX(c3, c-ref);
+}
+
+template<typename MatrixType> void trsm_trmm_threaded(Index size, Index cols)
+{
+  typedef Matrix<typename MatrixType::Scalar,Dynamic,Dynamic,RowMajor> RowMajorMatrix;
+  MatrixType tri = MatrixType::Random(size,size);
+  tri.diagonal().array() += typename MatrixType::Scalar(size);
+  MatrixType b = MatrixType::Random(size,cols);
+  MatrixType bt = b.transpose();
+
+  setNbThreads(1);
+  MatrixType x_ref = tri.template triangularView<Lower>().solve(b);
+  MatrixType xt_ref = bt * tri.template triangularView<Upper>().solve(MatrixType::Identity(size,size));
+  MatrixType p_ref = tri.template triangularView<Upper>() * b;
+  MatrixType pt_ref = bt * tri.template triangularView<Lower>();
+  setNbThreads(0);
+
+  // the columns of the rhs are split among the threads
+  MatrixType x = b;
+  tri.template triangularView<Lower>().solveInPlace(x);
+  VERIFY_IS_APPROX(x, x_ref);
+  RowMajorMatrix xr = b;
+  tri.template triangularView<Lower>().solveInPlace(xr);
+  VERIFY_IS_APPROX(MatrixType(xr), x_ref);
+  x = bt;
+  tri.template triangularView<Upper>().template solveInPlace<OnTheRight>(x);
+  VERIFY_IS_APPROX(x, xt_ref);
+
+  MatrixType p(size,cols);
+  p.noalias() = tri.template triangularView<Upper>() * b;
+  VERIFY_IS_APPROX(p, p_ref);
+  MatrixType pt(cols,size);
+  pt.noalias() = bt * tri.template triangularView<Lower>();
+  VERIFY_IS_APPROX(pt, pt_ref);
+}
+
+template<typename MatrixType> void gemv_symv_threaded(Index rows, Index cols)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> RowMajorMatrix;
+  MatrixType a = MatrixType::Random(rows,cols);
+  RowMajorMatrix ar = a;
+  MatrixType s = MatrixType::Random(cols,cols);
+  RowMajorMatrix sr = s;
+  // tall and skinny matrix whose rows are split
+  MatrixType t = MatrixType::Random(rows*cols/8,8);
+  VectorType v = VectorType::Random(cols), w = VectorType::Random(rows), u = VectorType::Random(rows*cols/8);
+  VectorType v8 = VectorType::Random(8);
+  Scalar alpha = internal::random<Scalar>();
+
+  setNbThreads(1);
+  VectorType av_ref = a*v, atw_ref = a.adjoint()*w, tv_ref = t*v8, blk_ref = a.bottomRightCorner(rows-3,cols-5)*v.tail(cols-5);
+  VectorType slv_ref = s.template selfadjointView<Lower>()*v, suv_ref = s.template selfadjointView<Upper>()*v;
+  setNbThreads(0);
+
+  // the columns of a col-major matrix are split, and the rows of a row-major one
+  VectorType r = w;
+  r.noalias() += alpha * a * v;
+  VERIFY_IS_APPROX(r, w + alpha * av_ref);
+  r.noalias() = ar * v;
+  VERIFY_IS_APPROX(r, av_ref);
+  r.noalias() = a.adjoint() * w;
+  VERIFY_IS_APPROX(r, atw_ref);
+  r.noalias() = t * v8;
+  VERIFY_IS_APPROX(r, tv_ref);
+  r.noalias() = a.bottomRightCorner(rows-3,cols-5) * v.tail(cols-5);
+  VERIFY_IS_APPROX(r, blk_ref);
+
+  r.noalias() = s.template selfadjointView<Lower>() * v;
+  VERIFY_IS_APPROX(r, slv_ref);
+  r.noalias() = s.template selfadjointView<Upper>() * v;
+  VERIFY_IS_APPROX(r, suv_ref);
+  r.noalias() = sr.template selfadjointView<Lower>() * v;
+  VERIFY_IS_APPROX(r, slv_ref);
+  r.noalias() = sr.template selfadjointView<Upper>() * v;
+  VERIFY_IS_APPROX(r, suv_ref);
+
+  // the result does not depend on the scheduling of the threads
+  VectorType r1 = a*v, r2 = a*v;
+  VERIFY_IS_EQUAL(r1, r2);
+  r1 = s.template selfadjointView<Lower>()*v;
+  r2 = s.template selfadjointView<Lower>()*v;
+  VERIFY_IS_EQUAL(r1, r2);
+}
+
+// runs products from within the tasks of a scheduler
+struct nested_product_task : ParallelTask
+{
+  nested_product_task(const MatrixXf& a, const MatrixXf& b, std::vector<MatrixXf>& res) : m_a(a), m_b(b), m_res(res) {}
+  void operator()(int id, int)
+  {
+    m_res[id].noalias() = m_a * m_b;
+  }
+  const MatrixXf& m_a;
+  const MatrixXf& m_b;
+  std::vector<MatrixXf>& m_res;
+};
+
+void scheduler_api(int threads)
+{
+  Index size = internal::random<Index>(64*threads, 96*threads);
+  MatrixXf a = MatrixXf::Random(size,size);
+  MatrixXf b = MatrixXf::Random(size,size);
+  MatrixXf ref = a.lazyProduct(b);
+
+  {
+    ThreadPoolScheduler pool(threads);
+    VERIFY_IS_EQUAL(pool.numThreads(), threads);
+
+    setParallelScheduler(&pool);
+    VERIFY(parallelScheduler()==&pool);
+    VERIFY_IS_EQUAL(nbThreads(), threads);
+    setNbThreads(2);
+    VERIFY_IS_EQUAL(nbThreads(), 2);
+    setNbThreads(0);
+
+    MatrixXf c(size,size);
+    c.noalias() = a*b;
+    VERIFY_IS_APPROX(c, ref);
+
+    // products run within the pool are sequential
+    std::vector<MatrixXf> res(threads);
+    nested_product_task task(a, b, res);
+    pool.run(threads, task);
+    for(int i=0; i<threads; ++i)
+      VERIFY_IS_APPROX(res[i], ref);
+
+    // several threads sharing the same pool
+    std::vector<MatrixXf> res2(4, MatrixXf(size,size));
+    std::vector<std::thread> users;
+    for(int i=0; i<4; ++i)
+      users.push_back(std::thread([&,i]() { res2[i].noalias() = a*b; }));
+    for(int i=0; i<4; ++i)
+    {
+      users[i].join();
+      VERIFY_IS_APPROX(res2[i], ref);
+    }
+
+    // per call scheduler
+    {
+      ThreadPoolScheduler local_pool(2);
+      ScopedParallelScheduler guard(&local_pool);
+      VERIFY(parallelScheduler()==&local_pool);
+      c.noalias() = a*b;
+      VERIFY_IS_APPROX(c, ref);
+    }
+    VERIFY(parallelScheduler()==&pool);
+
+    setParallelScheduler(0);
+  }
+  VERIFY(parallelScheduler()==internal::default_parallel_scheduler());
+}
+
+typedef Matrix<float,Dynamic,Dynamic,RowMajor> RowMajorMatrixXf;
+
+void test_product_threaded()
+{
+  ThreadPoolScheduler pool(internal::random<int>(2,8));
+  setParallelScheduler(&pool);
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1( gemm_threaded<MatrixXf>(internal::random<int>(1,EIGEN_TEST_MAX_SIZE), internal::random<int>(64,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,EIGEN_TEST_MAX_SIZE)) );
+    CALL_SUBTEST_2( gemm_threaded<MatrixXd>(internal::random<int>(64,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,EIGEN_TEST_MAX_SIZE)) );
+    CALL_SUBTEST_3( gemm_threaded<MatrixXcf>(internal::random<int>(64,EIGEN_TEST_MAX_SIZE), internal::random<int>(64,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,EIGEN_TEST_MAX_SIZE/2)) );
+    CALL_SUBTEST_4( gemm_threaded<RowMajorMatrixXf>(internal::random<int>(64,EIGEN_TEST_MAX_SIZE), internal::random<int>(64,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,EIGEN_TEST_MAX_SIZE)) );
+    CALL_SUBTEST_6( trsm_trmm_threaded<MatrixXd>(internal::random<int>(32,EIGEN_TEST_MAX_SIZE), internal::random<int>(64,4*EIGEN_TEST_MAX_SIZE)) );
+    CALL_SUBTEST_6( trsm_trmm_threaded<MatrixXcf>(internal::random<int>(32,EIGEN_TEST_MAX_SIZE), internal::random<int>(64,4*EIGEN_TEST_MAX_SIZE)) );
+    CALL_SUBTEST_7( gemv_symv_threaded<MatrixXf>(internal::random<int>(256,700), internal::random<int>(512,1000)) );
+    CALL_SUBTEST_7( gemv_symv_threaded<MatrixXcd>(internal::random<int>(256,700), internal::random<int>(512,1000)) );
+  }
+  setParallelScheduler(0);
+
+  CALL_SUBTEST_5( scheduler_api(internal::random<int>(2,6)) );
+}
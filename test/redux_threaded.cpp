@@ -0,0 +1,82 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#define EIGEN_USE_THREADS
+#define EIGEN_PARALLEL_REDUX_THRESHOLD 1000
+#include "main.h"
+
+// the reductions must give exactly the same result whatever the number of threads
+template<typename VectorType> void redux_threaded_vector(Index size, int maxThreads)
+{
+  typedef typename VectorType::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  VectorType a = VectorType::Random(size), b = VectorType::Random(size);
+
+  setNbThreads(1);
+  Scalar sum = a.sum(), dot = a.dot(b), tail = a.tail(size-3).sum();
+  RealScalar norm = a.squaredNorm(), maxAbs = a.cwiseAbs().maxCoeff();
+  setNbThreads(0);
+
+  // the chunked reduction is as accurate as the sequential one, relatively to the magnitude of the summands
+  Scalar ref = Scalar(0);
+  for(Index i=0; i<size; ++i)
+    ref += a(i);
+  VERIFY_IS_MUCH_SMALLER_THAN(sum - ref, a.cwiseAbs().sum());
+
+  for(int t=2; t<=maxThreads; ++t)
+  {
+    setNbThreads(t);
+    VERIFY_IS_EQUAL(a.sum(), sum);
+    VERIFY_IS_EQUAL(a.dot(b), dot);
+    VERIFY_IS_EQUAL(a.tail(size-3).sum(), tail);
+    VERIFY_IS_EQUAL(a.squaredNorm(), norm);
+    VERIFY_IS_EQUAL(a.cwiseAbs().maxCoeff(), maxAbs);
+  }
+  setNbThreads(0);
+}
+
+template<typename MatrixType> void redux_threaded_matrix(Index rows, Index cols, int maxThreads)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  MatrixType m = MatrixType::Random(rows,cols);
+
+  setNbThreads(1);
+  Scalar sum = m.sum(), prod = (m.array()*Scalar(0.01)+Scalar(1)).prod();
+  Scalar blockSum = m.block(1,1,rows-2,cols-2).sum(), minCoeff = m.minCoeff();
+  setNbThreads(0);
+
+  VERIFY_IS_MUCH_SMALLER_THAN(blockSum - m.block(1,1,rows-2,cols-2).eval().sum(), m.cwiseAbs().sum());
+
+  for(int t=2; t<=maxThreads; ++t)
+  {
+    setNbThreads(t);
+    VERIFY_IS_EQUAL(m.sum(), sum);
+    VERIFY_IS_EQUAL((m.array()*Scalar(0.01)+Scalar(1)).prod(), prod);
+    // sub-blocks are split by outer vectors
+    VERIFY_IS_EQUAL(m.block(1,1,rows-2,cols-2).sum(), blockSum);
+    VERIFY_IS_EQUAL(m.minCoeff(), minCoeff);
+  }
+  setNbThreads(0);
+}
+
+void test_redux_threaded()
+{
+  int maxThreads = internal::random<int>(2,8);
+  ThreadPoolScheduler pool(maxThreads);
+  setParallelScheduler(&pool);
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(( redux_threaded_vector<VectorXf>(internal::random<Index>(1000,200000), maxThreads) ));
+    CALL_SUBTEST_2(( redux_threaded_vector<VectorXd>(internal::random<Index>(1000,200000), maxThreads) ));
+    CALL_SUBTEST_3(( redux_threaded_vector<VectorXcf>(internal::random<Index>(1000,100000), maxThreads) ));
+    CALL_SUBTEST_4(( redux_threaded_matrix<MatrixXf>(internal::random<Index>(3,300), internal::random<Index>(100,1000), maxThreads) ));
+    CALL_SUBTEST_4(( redux_threaded_matrix<Matrix<float,Dynamic,Dynamic,RowMajor> >(internal::random<Index>(100,1000), internal::random<Index>(3,300), maxThreads) ));
+    CALL_SUBTEST_5(( redux_threaded_matrix<MatrixXd>(internal::random<Index>(3,20000), internal::random<Index>(3,20), maxThreads) ));
+  }
+  setParallelScheduler(0);
+}
@@ -202,6 +202,18 @@ initSparse(double density,
   }
 }
 
+// checks that the inner indices of each outer vector are strictly increasing
+template<typename SparseMatrixType> bool is_sorted_compressed(const SparseMatrixType& m)
+{
+  if(!m.isCompressed())
+    return false;
+  for(Index j=0; j<m.outerSize(); ++j)
+    for(Index k=m.outerIndexPtr()[j]+1; k<m.outerIndexPtr()[j+1]; ++k)
+      if(m.innerIndexPtr()[k-1]>=m.innerIndexPtr()[k])
+        return false;
+  return true;
+}
+
 
 #include <unsupported/Eigen/SparseExtra>
 #endif // EIGEN_TESTSPARSE_H
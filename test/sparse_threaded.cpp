@@ -0,0 +1,204 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#define EIGEN_USE_THREADS
+#define EIGEN_PARALLEL_SPARSE_DENSE_THRESHOLD 500
+#define EIGEN_PARALLEL_SPARSE_SPARSE_THRESHOLD 500
+#include "sparse.h"
+#include "threaded_common.h"
+#include <Eigen/IterativeLinearSolvers>
+
+template<typename SparseMatrixType> void sparse_dense_threaded(Index rows, Index cols, counting_scheduler& scheduler)
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> RowMajorDenseMatrix;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+
+  SparseMatrixType m(rows, cols), s(cols, cols);
+  DenseMatrix refM = DenseMatrix::Zero(rows, cols), refS = DenseMatrix::Zero(cols, cols);
+  initSparse<Scalar>(0.1, refM, m);
+  initSparse<Scalar>(0.1, refS, s);
+  refS = refS.template selfadjointView<Lower>();
+
+  DenseVector v = DenseVector::Random(cols), w = DenseVector::Random(rows);
+  DenseMatrix b = DenseMatrix::Random(cols, 5), bt = b.transpose();
+  RowMajorDenseMatrix br = b;
+  Scalar alpha = internal::random<Scalar>();
+
+  // the outer vectors of the sparse matrix are split across the threads
+  int runs = scheduler.m_runs;
+  DenseVector r = w;
+  r.noalias() += alpha * m * v;
+  VERIFY(scheduler.m_runs > runs);
+  VERIFY_IS_APPROX(r, w + alpha * refM * v);
+  r.noalias() = m.adjoint() * w;
+  VERIFY_IS_APPROX(r, refM.adjoint() * w);
+
+  DenseMatrix res(rows, 5);
+  res.noalias() = m * b;
+  VERIFY_IS_APPROX(res, refM * b);
+  res.noalias() = m * br;
+  VERIFY_IS_APPROX(res, refM * b);
+  DenseMatrix rest(5, rows);
+  rest.noalias() = bt * m.transpose();
+  VERIFY_IS_APPROX(rest, bt * refM.transpose());
+
+  // selfadjoint views
+  DenseVector u(cols);
+  u.noalias() = s.template selfadjointView<Lower>() * v;
+  VERIFY_IS_APPROX(u, refS * v);
+  SparseMatrixType su = s.transpose();
+  DenseMatrix refSu = DenseMatrix(su).template selfadjointView<Upper>();
+  u.noalias() = su.template selfadjointView<Upper>() * v;
+  VERIFY_IS_APPROX(u, refSu * v);
+  DenseMatrix sb(cols, 5);
+  sb.noalias() = s.template selfadjointView<Lower>() * br;
+  VERIFY_IS_APPROX(sb, refS * b);
+  DenseMatrix bs(5, cols);
+  bs.noalias() = bt * s.template selfadjointView<Lower>();
+  VERIFY_IS_APPROX(bs, bt * refS);
+
+  // the result does not depend on the scheduling of the threads
+  DenseVector r1 = m*v, r2 = m*v;
+  VERIFY_IS_EQUAL(r1, r2);
+  DenseVector u1 = s.template selfadjointView<Lower>()*v, u2 = s.template selfadjointView<Lower>()*v;
+  VERIFY_IS_EQUAL(u1, u2);
+
+  // small products are run on the calling thread
+  runs = scheduler.m_runs;
+  r1 = m.topLeftCorner(3,3) * v.head(3);
+  VERIFY_IS_EQUAL(scheduler.m_runs, runs);
+}
+
+template<typename SparseMatrixType> void sparse_sparse_threaded(Index rows, Index depth, Index cols, counting_scheduler& scheduler)
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef SparseMatrix<Scalar,ColMajor> ColMajorMatrix;
+  typedef SparseMatrix<Scalar,RowMajor> RowMajorMatrix;
+
+  SparseMatrixType a(rows, depth), b(depth, cols);
+  DenseMatrix refA = DenseMatrix::Zero(rows, depth), refB = DenseMatrix::Zero(depth, cols);
+  initSparse<Scalar>(0.05, refA, a);
+  initSparse<Scalar>(0.05, refB, b);
+  ColMajorMatrix ac = a, bc = b;
+  RowMajorMatrix ar = a, br = b;
+  DenseMatrix refC = refA * refB;
+
+  // the columns of the result are split across the threads, for all the storage orders
+  int runs = scheduler.m_runs;
+  ColMajorMatrix c = ac * bc;
+  VERIFY(scheduler.m_runs > runs);
+  VERIFY(is_sorted_compressed(c));
+  VERIFY_IS_APPROX(DenseMatrix(c), refC);
+  c = ar * bc;
+  VERIFY(is_sorted_compressed(c));
+  VERIFY_IS_APPROX(DenseMatrix(c), refC);
+  c = ac * br;
+  VERIFY(is_sorted_compressed(c));
+  VERIFY_IS_APPROX(DenseMatrix(c), refC);
+  c = ar * br;
+  VERIFY(is_sorted_compressed(c));
+  VERIFY_IS_APPROX(DenseMatrix(c), refC);
+  RowMajorMatrix cr = ac * bc;
+  VERIFY(is_sorted_compressed(cr));
+  VERIFY_IS_APPROX(DenseMatrix(cr), refC);
+  cr = ar * br;
+  VERIFY(is_sorted_compressed(cr));
+  VERIFY_IS_APPROX(DenseMatrix(cr), refC);
+  cr = ar * bc;
+  VERIFY(is_sorted_compressed(cr));
+  VERIFY_IS_APPROX(DenseMatrix(cr), refC);
+
+  // Galerkin products
+  ColMajorMatrix rap = bc.transpose() * (ac.transpose() * ac) * bc;
+  VERIFY_IS_APPROX(DenseMatrix(rap), refB.transpose() * (refA.transpose() * refA) * refB);
+
+  // pruned products, with exact cancellations
+  DenseMatrix refA2 = refA, refB2 = refB;
+  refA2.col(0) = -refA2.col(depth-1);
+  refB2.row(0) = refB2.row(depth-1);
+  ColMajorMatrix a2 = refA2.sparseView(), b2 = refB2.sparseView();
+  DenseMatrix refC2 = refA2 * refB2;
+  c = (a2 * b2).pruned();
+  VERIFY(is_sorted_compressed(c));
+  VERIFY_IS_APPROX(DenseMatrix(c), refC2);
+  RealScalar ref = refC2.cwiseAbs().maxCoeff();
+  cr = (ar * br).pruned(ref, RealScalar(0.1));
+  VERIFY(is_sorted_compressed(cr));
+  for(Index j=0; j<cr.outerSize(); ++j)
+    for(typename RowMajorMatrix::InnerIterator it(cr,j); it; ++it)
+      VERIFY(std::abs(it.value()) > RealScalar(0.1)*ref);
+  c = ((ar * br).pruned(ref, RealScalar(0.1))).eval();
+  VERIFY(DenseMatrix(c).isApprox(DenseMatrix(cr)) || cr.nonZeros()==0);
+
+  // the sequential code may round differently, e.g., when it gets contracted to FMA
+  setNbThreads(1);
+  runs = scheduler.m_runs;
+  ColMajorMatrix cseq = ac * bc;
+  VERIFY_IS_EQUAL(scheduler.m_runs, runs);
+  setNbThreads(0);
+  c = ac * bc;
+  VERIFY_IS_EQUAL(c.nonZeros(), cseq.nonZeros());
+  VERIFY_IS_APPROX(DenseMatrix(c), DenseMatrix(cseq));
+
+  // but the multi-threaded result does not depend on the number of threads
+  setNbThreads(2);
+  runs = scheduler.m_runs;
+  ColMajorMatrix c2 = ac * bc;
+  VERIFY(scheduler.m_runs > runs);
+  setNbThreads(0);
+  VERIFY_IS_EQUAL(c2.nonZeros(), c.nonZeros());
+  VERIFY_IS_EQUAL(DenseMatrix(c2), DenseMatrix(c));
+}
+
+template<typename SparseMatrixType> void cg_threaded(Index size)
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+  // 1D Laplacian
+  SparseMatrixType a(size, size);
+  a.reserve(VectorXi::Constant(size, 3));
+  for(Index j=0; j<size; ++j)
+  {
+    if(j>0) a.insert(j-1,j) = Scalar(-1);
+    a.insert(j,j) = Scalar(2.5);
+    if(j+1<size) a.insert(j+1,j) = Scalar(-1);
+  }
+  DenseVector b = DenseVector::Random(size);
+
+  ConjugateGradient<SparseMatrixType, Lower> cg(a);
+  DenseVector x = cg.solve(b);
+  VERIFY(cg.info()==Success);
+  VERIFY_IS_APPROX(a*x, b);
+
+  ConjugateGradient<SparseMatrixType, Lower|Upper> cg_full(a);
+  x = cg_full.solve(b);
+  VERIFY(cg_full.info()==Success);
+  VERIFY_IS_APPROX(a*x, b);
+}
+
+void test_sparse_threaded()
+{
+  ThreadPoolScheduler pool(internal::random<int>(2,8));
+  counting_scheduler scheduler(pool);
+  setParallelScheduler(&scheduler);
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(( sparse_dense_threaded<SparseMatrix<double> >(internal::random<int>(200,400), internal::random<int>(200,400), scheduler) ));
+    CALL_SUBTEST_2(( sparse_dense_threaded<SparseMatrix<double,RowMajor> >(internal::random<int>(200,400), internal::random<int>(200,400), scheduler) ));
+    CALL_SUBTEST_3(( sparse_dense_threaded<SparseMatrix<std::complex<float> > >(internal::random<int>(200,400), internal::random<int>(200,400), scheduler) ));
+    CALL_SUBTEST_4(( cg_threaded<SparseMatrix<double> >(internal::random<int>(2000,5000)) ));
+    CALL_SUBTEST_4(( cg_threaded<SparseMatrix<double,RowMajor> >(internal::random<int>(2000,5000)) ));
+    CALL_SUBTEST_5(( sparse_sparse_threaded<SparseMatrix<double> >(internal::random<int>(200,400), internal::random<int>(200,400), internal::random<int>(200,400), scheduler) ));
+    CALL_SUBTEST_5(( sparse_sparse_threaded<SparseMatrix<std::complex<double>,RowMajor> >(internal::random<int>(200,400), internal::random<int>(200,400), internal::random<int>(200,400), scheduler) ));
+  }
+  setParallelScheduler(0);
+}
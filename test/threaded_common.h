@@ -0,0 +1,26 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_TEST_THREADED_COMMON_H
+#define EIGEN_TEST_THREADED_COMMON_H
+
+// Fixtures of the tests of the multi-threaded kernels, to be included after main.h with EIGEN_USE_THREADS defined.
+
+// forwards the tasks to a pool while counting them
+struct counting_scheduler : ParallelScheduler
+{
+  counting_scheduler(ParallelScheduler& pool) : m_pool(pool), m_runs(0) {}
+  int numThreads() const { return m_pool.numThreads(); }
+  bool inParallelRegion() const { return m_pool.inParallelRegion(); }
+  void run(int count, ParallelTask& task) { ++m_runs; m_pool.run(count, task); }
+  ParallelScheduler& m_pool;
+  int m_runs;
+};
+
+#endif // EIGEN_TEST_THREADED_COMMON_H
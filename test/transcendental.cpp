@@ -0,0 +1,150 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "main.h"
+
+// accuracy of the coefficient-wise functions of arrays of doubles, which are vectorized, against the C library
+
+double ref_log(double x) { return std::log(x); }
+double ref_sin(double x) { return std::sin(x); }
+double ref_cos(double x) { return std::cos(x); }
+double ref_tanh(double x) { return std::tanh(x); }
+double ref_erf(double x) { return numext::erf(x); }
+
+// distance between a and b in units in the last place of b
+double ulp_error(double a, double b)
+{
+  if(a==b || ((numext::isnan)(a) && (numext::isnan)(b)))
+    return 0;
+  if(!(numext::isfinite)(a) || !(numext::isfinite)(b))
+    return NumTraits<double>::highest();
+  int e;
+  std::frexp(b, &e);
+  return std::abs(a-b) / std::ldexp(1.0, (std::max)(e-53, -1074));
+}
+
+double max_ulp_error(const ArrayXd& res, const ArrayXd& ref)
+{
+  double err = 0;
+  for(Index i=0; i<res.size(); ++i)
+    err = (std::max)(err, ulp_error(res(i), ref(i)));
+  return err;
+}
+
+void check_accuracy(const ArrayXd& x, const ArrayXd& res, double (*func)(double), double tol)
+{
+  ArrayXd ref(x.size());
+  for(Index i=0; i<x.size(); ++i)
+    ref(i) = func(x(i));
+  double err = max_ulp_error(res, ref);
+  if(err > tol)
+    std::cerr << "max error of " << err << " ulps\n";
+  VERIFY(err <= tol);
+}
+
+// random doubles whose magnitudes are uniformly distributed in [2^min_exp, 2^max_exp]
+ArrayXd random_magnitudes(Index size, double min_exp, double max_exp, bool positive)
+{
+  ArrayXd x(size);
+  for(Index i=0; i<size; ++i)
+  {
+    x(i) = std::ldexp(internal::random<double>(0.5, 1), int(internal::random<double>(min_exp, max_exp)));
+    if(!positive && internal::random<bool>())
+      x(i) = -x(i);
+  }
+  return x;
+}
+
+void transcendental_accuracy(Index size)
+{
+  ArrayXd x = random_magnitudes(size, -1074, 1024, true);
+  check_accuracy(x, x.log(), ref_log, 2);
+  x = ArrayXd::Random(size) + 1.5;
+  check_accuracy(x, x.log(), ref_log, 2);
+
+  x = ArrayXd::Random(size) * 100;
+  check_accuracy(x, x.sin(), ref_sin, 3);
+  check_accuracy(x, x.cos(), ref_cos, 3);
+  // the huge arguments are reduced by the C library
+  x = random_magnitudes(size, -30, 1024, false);
+  check_accuracy(x, x.sin(), ref_sin, 3);
+  check_accuracy(x, x.cos(), ref_cos, 3);
+
+  x = ArrayXd::Random(size) * 25;
+  check_accuracy(x, x.tanh(), ref_tanh, 3);
+  x = random_magnitudes(size, -1074, 8, false);
+  check_accuracy(x, x.tanh(), ref_tanh, 3);
+
+  x = ArrayXd::Random(size) * 7;
+  check_accuracy(x, x.erf(), ref_erf, 4);
+  x = random_magnitudes(size, -1074, 3, false);
+  check_accuracy(x, x.erf(), ref_erf, 4);
+
+  ArrayXd y = ArrayXd::Random(size) * 40;
+  x = random_magnitudes(size, -30, 30, true);
+  ArrayXd ref(size);
+  for(Index i=0; i<size; ++i)
+    ref(i) = std::pow(x(i), y(i));
+  VERIFY(max_ulp_error(pow(x, y), ref) <= 4);
+  for(Index i=0; i<size; ++i)
+    ref(i) = std::pow(x(i), 2.5);
+  VERIFY(max_ulp_error(x.pow(2.5), ref) <= 4);
+}
+
+void transcendental_special_values()
+{
+  const double inf = std::numeric_limits<double>::infinity();
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const double denorm_min = std::numeric_limits<double>::denorm_min();
+  const double min = (std::numeric_limits<double>::min)();
+  const double max = (std::numeric_limits<double>::max)();
+  // enough coefficients for the packets and a scalar tail
+  ArrayXd x(13);
+  x << 0., -0., 1., -1., inf, -inf, nan, denorm_min, -denorm_min, min, max, -max, 1e-310;
+
+  ArrayXd ref(x.size());
+  for(Index i=0; i<x.size(); ++i) ref(i) = std::log(x(i));
+  VERIFY(max_ulp_error(x.log(), ref) <= 2);
+  for(Index i=0; i<x.size(); ++i) ref(i) = std::sin(x(i));
+  VERIFY(max_ulp_error(x.sin(), ref) <= 3);
+  for(Index i=0; i<x.size(); ++i) ref(i) = std::cos(x(i));
+  VERIFY(max_ulp_error(x.cos(), ref) <= 3);
+  for(Index i=0; i<x.size(); ++i) ref(i) = std::tanh(x(i));
+  VERIFY(max_ulp_error(x.tanh(), ref) <= 3);
+  for(Index i=0; i<x.size(); ++i) ref(i) = numext::erf(x(i));
+  VERIFY(max_ulp_error(x.erf(), ref) <= 4);
+
+  // the signs of the zeros are preserved
+  VERIFY(1. / ArrayXd::Constant(5, -0.).sin()(2) < 0);
+  VERIFY(1. / ArrayXd::Constant(5, -0.).tanh()(2) < 0);
+  VERIFY(1. / ArrayXd::Constant(5, -0.).erf()(2) < 0);
+
+  // all the combinations of special bases and exponents
+  ArrayXd y(x.size());
+  y << 0., -0., 1., -1., inf, -inf, nan, 2., -2., 0.5, 3., -3., 1e-310;
+  ArrayXd bases(x.size()*y.size()), exponents(x.size()*y.size());
+  for(Index i=0; i<x.size(); ++i)
+    for(Index j=0; j<y.size(); ++j)
+    {
+      bases(i*y.size()+j) = x(i);
+      exponents(i*y.size()+j) = y(j);
+    }
+  ref.resize(bases.size());
+  for(Index i=0; i<bases.size(); ++i)
+    ref(i) = std::pow(bases(i), exponents(i));
+  VERIFY(max_ulp_error(pow(bases, exponents), ref) <= 4);
+}
+
+void test_transcendental()
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1( transcendental_accuracy(internal::random<Index>(1000,20000)) );
+  }
+  CALL_SUBTEST_2( transcendental_special_values() );
+}
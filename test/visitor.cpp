@@ -110,6 +110,50 @@ template<typename VectorType> void vectorVisitor(const VectorType& w)
   VERIFY(eigen_maxidx == (std::min)(idx0,idx2));
 }
 
+// compares to a plain loop on expressions having many equal coefficients
+template<typename MatrixType> void checkVisitor(const MatrixType& m)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename MatrixType::Index Index;
+  Scalar minc = m(0,0), maxc = m(0,0);
+  Index minrow=0, mincol=0, maxrow=0, maxcol=0;
+  for(Index j = 0; j < m.cols(); j++)
+  for(Index i = 0; i < m.rows(); i++)
+  {
+    if(m(i,j) < minc) { minc = m(i,j); minrow = i; mincol = j; }
+    if(m(i,j) > maxc) { maxc = m(i,j); maxrow = i; maxcol = j; }
+  }
+  Index eigen_minrow, eigen_mincol, eigen_maxrow, eigen_maxcol;
+  VERIFY_IS_EQUAL(m.minCoeff(&eigen_minrow,&eigen_mincol), minc);
+  VERIFY_IS_EQUAL(m.maxCoeff(&eigen_maxrow,&eigen_maxcol), maxc);
+  VERIFY_IS_EQUAL(eigen_minrow, minrow);
+  VERIFY_IS_EQUAL(eigen_mincol, mincol);
+  VERIFY_IS_EQUAL(eigen_maxrow, maxrow);
+  VERIFY_IS_EQUAL(eigen_maxcol, maxcol);
+}
+
+template<typename MatrixType> void vectorizedVisitor(Index rows, Index cols)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  MatrixType m(rows, cols);
+  for(Index k = 0; k < m.size(); k++)
+    m(k) = Scalar(internal::random<int>(-20,20));
+
+  checkVisitor(m);
+  if(rows>2 && cols>2)
+    checkVisitor(m.block(1,1,rows-2,cols-2));
+  checkVisitor(m.array().abs());
+  checkVisitor(m.row(rows-1));
+  checkVisitor(m.col(cols-1));
+
+  // single extremum in the tail or in the last block
+  m.setZero();
+  m(m.size()-1) = Scalar(1);
+  checkVisitor(m);
+  m(m.size()/2) = Scalar(-1);
+  checkVisitor(m);
+}
+
 void test_visitor()
 {
   for(int i = 0; i < g_repeat; i++) {
@@ -127,4 +171,12 @@ void test_visitor()
     CALL_SUBTEST_9( vectorVisitor(RowVectorXd(10)) );
     CALL_SUBTEST_10( vectorVisitor(VectorXf(33)) );
   }
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_11(( vectorizedVisitor<VectorXf>(internal::random<int>(1,2000), 1) ));
+    CALL_SUBTEST_11(( vectorizedVisitor<RowVectorXf>(1, internal::random<int>(1,2000)) ));
+    CALL_SUBTEST_11(( vectorizedVisitor<MatrixXf>(internal::random<int>(1,200), internal::random<int>(1,50)) ));
+    CALL_SUBTEST_12(( vectorizedVisitor<MatrixXd>(internal::random<int>(1,200), internal::random<int>(1,50)) ));
+    CALL_SUBTEST_12(( vectorizedVisitor<Matrix<double,Dynamic,Dynamic,RowMajor> >(internal::random<int>(1,50), internal::random<int>(1,200)) ));
+    CALL_SUBTEST_13(( vectorizedVisitor<MatrixXi>(internal::random<int>(1,200), internal::random<int>(1,50)) ));
+  }
 }
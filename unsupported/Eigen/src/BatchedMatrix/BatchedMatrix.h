@@ -0,0 +1,201 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_BATCHED_MATRIX_H
+#define EIGEN_BATCHED_MATRIX_H
+
+namespace Eigen {
+
+/** \ingroup BatchedMatrix_Module
+  *
+  * \class BatchedMatrix
+  *
+  * \brief A batch of small fixed size matrices stored in an interleaved layout
+  *
+  * \tparam _Scalar the type of the coefficients
+  * \tparam _Rows the number of rows of each matrix
+  * \tparam _Cols the number of columns of each matrix
+  *
+  * The matrices are gathered in groups of \c Lanes matrices, \c Lanes being the number of scalars
+  * in a SIMD packet (e.g., 4 floats with SSE, 8 floats with AVX). Within a group, the coefficients are stored
+  * in column-major order, and each coefficient is a packet holding the value of this coefficient for all the
+  * matrices of the group. The operations of the batch, such as batchedProduct(), thus process each group in
+  * lock-step, one matrix per SIMD lane, without any shuffling, which is much faster than evaluating small
+  * products one after the other.
+  *
+  * Each matrix is accessed through a strided Map returned by matrix():
+  * \code
+  * BatchedMatrix<float,3,3> J(n);
+  * for(Index k=0; k<n; ++k)
+  *   J.matrix(k) = computeJacobian(k);
+  * \endcode
+  *
+  * Column vectors are batches with a single column, so that batchedProduct() also provides batched
+  * matrix-vector products.
+  *
+  * \sa batchedProduct(), batchedTranspose()
+  */
+template<typename _Scalar, int _Rows, int _Cols>
+class BatchedMatrix
+{
+  public:
+    typedef _Scalar Scalar;
+    typedef typename internal::packet_traits<Scalar>::type Packet;
+    enum {
+      Rows = _Rows,
+      Cols = _Cols,
+      Lanes = internal::packet_traits<Scalar>::size,
+      GroupSize = Rows * Cols * Lanes
+    };
+    typedef Matrix<Scalar,Rows,Cols> MatrixType;
+    typedef Map<MatrixType, Unaligned, Stride<Rows*Lanes,Lanes> > MapType;
+    typedef Map<const MatrixType, Unaligned, Stride<Rows*Lanes,Lanes> > ConstMapType;
+
+    /** Default constructor of an empty batch */
+    BatchedMatrix() : m_size(0) {}
+
+    /** Constructs a batch of \a size uninitialized matrices */
+    explicit BatchedMatrix(Index size) : m_size(0) { resize(size); }
+
+    /** Resizes the batch to \a size matrices. The padding lanes of the last group are set to zero,
+      * while the matrices themselves are left uninitialized. */
+    void resize(Index size)
+    {
+      EIGEN_STATIC_ASSERT(Rows!=Dynamic && Cols!=Dynamic, THIS_METHOD_IS_ONLY_FOR_MATRICES_OF_A_SPECIFIC_SIZE);
+      eigen_assert(size>=0);
+      m_size = size;
+      m_data.resize(groups() * GroupSize);
+      for(Index k=size; k<groups()*Lanes; ++k)
+        matrix(k).setZero();
+    }
+
+    /** \returns the number of matrices */
+    inline Index size() const { return m_size; }
+
+    /** \returns the number of groups of \c Lanes matrices, the last one being possibly incomplete */
+    inline Index groups() const { return (m_size + Lanes - 1) / Lanes; }
+
+    /** \returns a read-write view of the matrix \a k */
+    inline MapType matrix(Index k)
+    {
+      return MapType(m_data.data() + (k/Lanes)*GroupSize + k%Lanes);
+    }
+
+    /** \returns a read-only view of the matrix \a k */
+    inline ConstMapType matrix(Index k) const
+    {
+      return ConstMapType(m_data.data() + (k/Lanes)*GroupSize + k%Lanes);
+    }
+
+    /** Sets all the matrices of the batch to zero */
+    void setZero() { m_data.setZero(); }
+
+    /** \returns a pointer to the \c Rows*Cols packets of the group \a g */
+    inline Scalar* group(Index g) { return m_data.data() + g*GroupSize; }
+    inline const Scalar* group(Index g) const { return m_data.data() + g*GroupSize; }
+
+  protected:
+    Matrix<Scalar,Dynamic,1> m_data;
+    Index m_size;
+};
+
+namespace internal {
+
+template<typename Scalar, int Rows, int Depth, int Cols>
+struct batched_product_kernel
+{
+  typedef typename packet_traits<Scalar>::type Packet;
+  enum { Lanes = packet_traits<Scalar>::size };
+
+  // computes the product of the group of lhs matrices a by the group of rhs matrices b
+  static EIGEN_STRONG_INLINE void run(const Scalar* a, const Scalar* b, Scalar* c)
+  {
+    enum { PeeledRows = (Rows/4)*4 };
+    for(Index j=0; j<Cols; ++j)
+    {
+      // four rows at once to hide the latency of the multiply-adds and reuse the coefficients of b
+      for(Index i=0; i<PeeledRows; i+=4)
+      {
+        Packet b0 = pload<Packet>(b + j*Depth*Lanes);
+        Packet acc0 = pmul(pload<Packet>(a + (i+0)*Lanes), b0);
+        Packet acc1 = pmul(pload<Packet>(a + (i+1)*Lanes), b0);
+        Packet acc2 = pmul(pload<Packet>(a + (i+2)*Lanes), b0);
+        Packet acc3 = pmul(pload<Packet>(a + (i+3)*Lanes), b0);
+        for(Index k=1; k<Depth; ++k)
+        {
+          Packet bk = pload<Packet>(b + (j*Depth+k)*Lanes);
+          const Scalar* ak = a + (k*Rows+i)*Lanes;
+          acc0 = pmadd(pload<Packet>(ak + 0*Lanes), bk, acc0);
+          acc1 = pmadd(pload<Packet>(ak + 1*Lanes), bk, acc1);
+          acc2 = pmadd(pload<Packet>(ak + 2*Lanes), bk, acc2);
+          acc3 = pmadd(pload<Packet>(ak + 3*Lanes), bk, acc3);
+        }
+        pstore(c + (j*Rows+i+0)*Lanes, acc0);
+        pstore(c + (j*Rows+i+1)*Lanes, acc1);
+        pstore(c + (j*Rows+i+2)*Lanes, acc2);
+        pstore(c + (j*Rows+i+3)*Lanes, acc3);
+      }
+      for(Index i=PeeledRows; i<Rows; ++i)
+      {
+        Packet acc = pmul(pload<Packet>(a + i*Lanes), pload<Packet>(b + j*Depth*Lanes));
+        for(Index k=1; k<Depth; ++k)
+          acc = pmadd(pload<Packet>(a + (k*Rows+i)*Lanes), pload<Packet>(b + (j*Depth+k)*Lanes), acc);
+        pstore(c + (j*Rows+i)*Lanes, acc);
+      }
+    }
+  }
+};
+
+} // end namespace internal
+
+/** \ingroup BatchedMatrix_Module
+  *
+  * Computes the products \f$ c_k = a_k b_k \f$ of the matrices of the batches \a a and \a b.
+  * \a c is resized to the size of the batches if needed, and must not be \a a or \a b.
+  *
+  * Batched matrix-vector products are obtained with \a b and \a c having a single column.
+  */
+template<typename Scalar, int Rows, int Depth, int Cols>
+void batchedProduct(const BatchedMatrix<Scalar,Rows,Depth>& a, const BatchedMatrix<Scalar,Depth,Cols>& b,
+                    BatchedMatrix<Scalar,Rows,Cols>& c)
+{
+  eigen_assert(a.size()==b.size() && "the batches must have the same size");
+  eigen_assert((void*)&c!=(void*)&a && (void*)&c!=(void*)&b && "the result cannot alias a factor");
+  if(c.size()!=a.size())
+    c.resize(a.size());
+  for(Index g=0; g<a.groups(); ++g)
+    internal::batched_product_kernel<Scalar,Rows,Depth,Cols>::run(a.group(g), b.group(g), c.group(g));
+}
+
+/** \ingroup BatchedMatrix_Module
+  *
+  * Sets \a at to the transposes of the matrices of the batch \a a.
+  * \a at is resized to the size of \a a if needed, and must not be \a a.
+  */
+template<typename Scalar, int Rows, int Cols>
+void batchedTranspose(const BatchedMatrix<Scalar,Rows,Cols>& a, BatchedMatrix<Scalar,Cols,Rows>& at)
+{
+  typedef typename internal::packet_traits<Scalar>::type Packet;
+  enum { Lanes = internal::packet_traits<Scalar>::size };
+  eigen_assert((void*)&at!=(void*)&a && "the result cannot alias the argument");
+  if(at.size()!=a.size())
+    at.resize(a.size());
+  for(Index g=0; g<a.groups(); ++g)
+  {
+    const Scalar* src = a.group(g);
+    Scalar* dst = at.group(g);
+    for(Index j=0; j<Cols; ++j)
+      for(Index i=0; i<Rows; ++i)
+        internal::pstore(dst + (i*Cols+j)*Lanes, internal::pload<Packet>(src + (j*Rows+i)*Lanes));
+  }
+}
+
+} // end namespace Eigen
+
+#endif // EIGEN_BATCHED_MATRIX_H
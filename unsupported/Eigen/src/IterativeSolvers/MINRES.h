@@ -198,7 +198,7 @@ namespace Eigen {
     {
         
         typedef IterativeSolverBase<MINRES> Base;
-        using Base::mp_matrix;
+        using Base::matrix;
         using Base::m_error;
         using Base::m_iterations;
         using Base::m_info;
@@ -250,7 +250,7 @@ namespace Eigen {
                 m_error = Base::m_tolerance;
                 
                 typename Dest::ColXpr xj(x,j);
-                internal::minres(MatrixWrapperType(mp_matrix), b.col(j), xj,
+                internal::minres(MatrixWrapperType(matrix()), b.col(j), xj,
                                  Base::m_preconditioner, m_iterations, m_error);
             }
             
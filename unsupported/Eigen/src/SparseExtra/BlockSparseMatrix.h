@@ -45,6 +45,14 @@ namespace Eigen {
   * A regular sparse matrix can be converted to a block sparse matrix and vice versa.
   * It is obviously required to describe the block layout beforehand by calling either
   * setBlockSize() for fixed-size blocks or setBlockLayout for variable-size blocks.
+  * The constructor from a sparse matrix picks the block size given by detectBlockSize()
+  * when it is not known at compile time.
+  *
+  * The products with dense matrices only read one index per block, the blocks of a same
+  * size being multiplied by vectorized micro-kernels which are selected at compile time,
+  * or at runtime for the blocks of size 2 to 6. Large products are multi-threaded by ranges
+  * of block rows (resp. block columns), see \ref TopicMultiThreading.
+  * The diagonal blocks can serve as a preconditioner through BlockDiagonalPreconditioner.
   *
   * \tparam _Scalar The Scalar type
   * \tparam _BlockAtCompileTime The block layout option. It takes the following values
@@ -61,6 +69,7 @@ struct traits<BlockSparseMatrix<_Scalar,_BlockAtCompileTime,_Options, _Index> >
 {
   typedef _Scalar Scalar;
   typedef _Index Index;
+  typedef _Index StorageIndex;
   typedef Sparse StorageKind; // FIXME Where is it used ??
   typedef MatrixXpr XprKind;
   enum {
@@ -236,50 +245,6 @@ class BlockVectorReturn
     VectorType& m_vec;
 };
 
-// Block version of the sparse dense product
-template<typename Lhs, typename Rhs>
-class BlockSparseTimeDenseProduct;
-
-namespace internal {
-
-template<typename BlockSparseMatrixT, typename VecType>
-struct traits<BlockSparseTimeDenseProduct<BlockSparseMatrixT, VecType> >
-{
-  typedef Dense StorageKind;
-  typedef MatrixXpr XprKind;
-  typedef typename BlockSparseMatrixT::Scalar Scalar;
-  typedef typename BlockSparseMatrixT::Index Index;
-  enum {
-    RowsAtCompileTime = Dynamic,
-    ColsAtCompileTime = Dynamic,
-    MaxRowsAtCompileTime = Dynamic,
-    MaxColsAtCompileTime = Dynamic,
-    Flags = 0,
-    CoeffReadCost = internal::traits<BlockSparseMatrixT>::CoeffReadCost
-  };
-};
-} // end namespace internal
-
-template<typename Lhs, typename Rhs>
-class BlockSparseTimeDenseProduct
-  : public ProductBase<BlockSparseTimeDenseProduct<Lhs,Rhs>, Lhs, Rhs>
-{
-  public:
-    EIGEN_PRODUCT_PUBLIC_INTERFACE(BlockSparseTimeDenseProduct)
-
-    BlockSparseTimeDenseProduct(const Lhs& lhs, const Rhs& rhs) : Base(lhs,rhs)
-    {}
-
-    template<typename Dest> void scaleAndAddTo(Dest& dest, const typename Rhs::Scalar& alpha) const
-    {
-      BlockVectorReturn<Lhs,Dest> tmpDest(m_lhs, dest);
-      internal::sparse_time_dense_product( BlockSparseMatrixView<Lhs>(m_lhs),  BlockVectorView<Lhs, Rhs>(m_lhs, m_rhs), tmpDest, alpha);
-    }
-
-  private:
-    BlockSparseTimeDenseProduct& operator=(const BlockSparseTimeDenseProduct&);
-};
-
 template<typename _Scalar, int _BlockAtCompileTime, int _Options, typename _StorageIndex>
 class BlockSparseMatrix : public SparseMatrixBase<BlockSparseMatrix<_Scalar,_BlockAtCompileTime, _Options,_StorageIndex> >
 {
@@ -308,7 +273,7 @@ class BlockSparseMatrix : public SparseMatrixBase<BlockSparseMatrix<_Scalar,_Blo
     // Default constructor
     BlockSparseMatrix()
     : m_innerBSize(0),m_outerBSize(0),m_innerOffset(0),m_outerOffset(0),
-      m_nonzerosblocks(0),m_values(0),m_blockPtr(0),m_indices(0),
+      m_nonzerosblocks(0),m_nonzeros(0),m_values(0),m_blockPtr(0),m_indices(0),
       m_outerIndex(0),m_blockSize(BlockSize)
     { }
 
@@ -320,7 +285,7 @@ class BlockSparseMatrix : public SparseMatrixBase<BlockSparseMatrix<_Scalar,_Blo
     BlockSparseMatrix(Index brow, Index bcol)
       : m_innerBSize(IsColMajor ? brow : bcol),
         m_outerBSize(IsColMajor ? bcol : brow),
-        m_innerOffset(0),m_outerOffset(0),m_nonzerosblocks(0),
+        m_innerOffset(0),m_outerOffset(0),m_nonzerosblocks(0),m_nonzeros(0),
         m_values(0),m_blockPtr(0),m_indices(0),
         m_outerIndex(0),m_blockSize(BlockSize)
     { }
@@ -330,22 +295,15 @@ class BlockSparseMatrix : public SparseMatrixBase<BlockSparseMatrix<_Scalar,_Blo
      */
     BlockSparseMatrix(const BlockSparseMatrix& other)
       : m_innerBSize(other.m_innerBSize),m_outerBSize(other.m_outerBSize),
+        m_innerOffset(copyArray(other.m_innerOffset, m_innerBSize+1)),
+        m_outerOffset(copyArray(other.m_outerOffset, m_outerBSize+1)),
         m_nonzerosblocks(other.m_nonzerosblocks),m_nonzeros(other.m_nonzeros),
-        m_blockPtr(0),m_blockSize(other.m_blockSize)
-    {
-      // should we allow copying between variable-size blocks and fixed-size blocks ??
-      eigen_assert(m_blockSize == BlockSize && " CAN NOT COPY BETWEEN FIXED-SIZE AND VARIABLE-SIZE BLOCKS");
-
-      std::copy(other.m_innerOffset, other.m_innerOffset+m_innerBSize+1, m_innerOffset);
-      std::copy(other.m_outerOffset, other.m_outerOffset+m_outerBSize+1, m_outerOffset);
-      std::copy(other.m_values, other.m_values+m_nonzeros, m_values);
-
-      if(m_blockSize != Dynamic)
-        std::copy(other.m_blockPtr, other.m_blockPtr+m_nonzerosblocks, m_blockPtr);
-
-      std::copy(other.m_indices, other.m_indices+m_nonzerosblocks, m_indices);
-      std::copy(other.m_outerIndex, other.m_outerIndex+m_outerBSize, m_outerIndex);
-    }
+        m_values(copyArray(other.m_values, m_nonzeros)),
+        m_blockPtr(copyArray(other.m_blockPtr, m_nonzerosblocks+1)),
+        m_indices(copyArray(other.m_indices, m_nonzerosblocks+1)),
+        m_outerIndex(copyArray(other.m_outerIndex, m_outerBSize+1)),
+        m_blockSize(other.m_blockSize)
+    { }
 
     friend void swap(BlockSparseMatrix& first, BlockSparseMatrix& second)
     {
@@ -359,7 +317,7 @@ class BlockSparseMatrix : public SparseMatrixBase<BlockSparseMatrix<_Scalar,_Blo
       std::swap(first.m_blockPtr, second.m_blockPtr);
       std::swap(first.m_indices, second.m_indices);
       std::swap(first.m_outerIndex, second.m_outerIndex);
-      std::swap(first.m_BlockSize, second.m_blockSize);
+      std::swap(first.m_blockSize, second.m_blockSize);
     }
 
     BlockSparseMatrix& operator=(BlockSparseMatrix other)
@@ -384,15 +342,66 @@ class BlockSparseMatrix : public SparseMatrixBase<BlockSparseMatrix<_Scalar,_Blo
     /**
       * \brief Constructor from a sparse matrix
       *
+      * The matrix is split into square blocks of size \c BlockSize, or, if the block size is not known at
+      * compile time, of the size given by detectBlockSize(). In both cases, the dimensions of \a spmat must be
+      * multiples of the block size.
       */
     template<typename MatrixType>
-    inline BlockSparseMatrix(const MatrixType& spmat) : m_blockSize(BlockSize)
+    inline BlockSparseMatrix(const MatrixType& spmat)
+      : m_innerBSize(0),m_outerBSize(0),m_innerOffset(0),m_outerOffset(0),
+        m_nonzerosblocks(0),m_nonzeros(0),m_values(0),m_blockPtr(0),m_indices(0),
+        m_outerIndex(0),m_blockSize(BlockSize)
     {
-      EIGEN_STATIC_ASSERT((m_blockSize != Dynamic), THIS_METHOD_IS_ONLY_FOR_FIXED_SIZE);
-
+      if(m_blockSize == Dynamic)
+        m_blockSize = detectBlockSize(spmat);
+      eigen_assert(spmat.rows()%m_blockSize == 0 && spmat.cols()%m_blockSize == 0
+                   && "THE DIMENSIONS MUST BE MULTIPLES OF THE BLOCK SIZE");
+      resize(spmat.rows()/m_blockSize, spmat.cols()/m_blockSize);
       *this = spmat;
     }
 
+    /**
+      * \brief Detects the size of the blocks of a sparse matrix
+      *
+      * \returns the block size, not larger than \a maxBlockSize, which minimizes the memory footprint of the
+      * values and indices of \a spmat once stored by square blocks, every nonzero block being stored as a dense
+      * block. Only the sizes dividing both dimensions of \a spmat are considered, and 1 is returned when no
+      * block size saves memory compared to the storage of the individual nonzeros.
+      */
+    template<typename MatrixType>
+    static Index detectBlockSize(const MatrixType& spmat, Index maxBlockSize = 8)
+    {
+      const double indexSize = double(sizeof(StorageIndex));
+      double bestSize = double(spmat.nonZeros())*(double(sizeof(Scalar))+indexSize) + double(spmat.outerSize()+1)*indexSize;
+      Index best = 1;
+      std::vector<Index> marker;
+      for(Index b = 2; b <= maxBlockSize; ++b)
+      {
+        if(spmat.rows()%b != 0 || spmat.cols()%b != 0)
+          continue;
+        // count the nonzero blocks, the marker recording the last outer block having a nonzero in each inner block
+        marker.assign(spmat.innerSize()/b, -1);
+        Index blocks = 0;
+        for(Index j = 0; j < spmat.outerSize(); ++j)
+          for(typename MatrixType::InnerIterator it(spmat, j); it; ++it)
+          {
+            Index bi = it.index()/b;
+            if(marker[bi] != j/b)
+            {
+              marker[bi] = j/b;
+              ++blocks;
+            }
+          }
+        double size = double(blocks)*(double(b*b*sizeof(Scalar))+indexSize) + double(spmat.outerSize()/b+1)*indexSize;
+        if(size < bestSize)
+        {
+          bestSize = size;
+          best = b;
+        }
+      }
+      return best;
+    }
+
     /**
       * \brief Assignment from a sparse matrix with the same storage order
       *
@@ -406,27 +415,30 @@ class BlockSparseMatrix : public SparseMatrixBase<BlockSparseMatrix<_Scalar,_Blo
     {
       eigen_assert((m_innerBSize != 0 && m_outerBSize != 0)
                    && "Trying to assign to a zero-size matrix, call resize() first");
-      eigen_assert(((MatrixType::Options&RowMajorBit) != IsColMajor) && "Wrong storage order");
-      typedef SparseMatrix<bool,MatrixType::Options,typename MatrixType::Index> MatrixPatternType;
+      // the nonzeros are browsed in the storage order of the block sparse matrix
+      typedef SparseMatrix<Scalar,IsColMajor ? ColMajor : RowMajor,StorageIndex> SparseMatrixType;
+      typename internal::conditional<internal::is_same<MatrixType,SparseMatrixType>::value,
+                                     const SparseMatrixType&, SparseMatrixType>::type mat(spmat);
+      typedef SparseMatrix<bool,IsColMajor ? ColMajor : RowMajor,StorageIndex> MatrixPatternType;
       MatrixPatternType  blockPattern(blockRows(), blockCols());
       m_nonzeros = 0;
 
       // First, compute the number of nonzero blocks and their locations
+      std::vector<StorageIndex> nzblocksFlag(m_innerBSize,-1);  // Record the last outer block having each inner block
       for(StorageIndex bj = 0; bj < m_outerBSize; ++bj)
       {
         // Browse each outer block and compute the structure
-        std::vector<bool> nzblocksFlag(m_innerBSize,false);  // Record the existing blocks
         blockPattern.startVec(bj);
         for(StorageIndex j = blockOuterIndex(bj); j < blockOuterIndex(bj+1); ++j)
         {
-          typename MatrixType::InnerIterator it_spmat(spmat, j);
+          typename SparseMatrixType::InnerIterator it_spmat(mat, j);
           for(; it_spmat; ++it_spmat)
           {
             StorageIndex bi = innerToBlock(it_spmat.index()); // Index of the current nonzero block
-            if(!nzblocksFlag[bi])
+            if(nzblocksFlag[bi] != bj)
             {
               // Save the index of this nonzero block
-              nzblocksFlag[bi] = true;
+              nzblocksFlag[bi] = bj;
               blockPattern.insertBackByOuterInnerUnordered(bj, bi) = true;
               // Compute the total number of nonzeros (including explicit zeros in blocks)
               m_nonzeros += blockOuterSize(bj) * blockInnerSize(bi);
@@ -446,7 +458,7 @@ class BlockSparseMatrix : public SparseMatrixBase<BlockSparseMatrix<_Scalar,_Blo
         for(StorageIndex j = blockOuterIndex(bj); j < blockOuterIndex(bj+1); ++j)
         {
           // Browse the outer block column by column (for column-major matrices)
-          typename MatrixType::InnerIterator it_spmat(spmat, j);
+          typename SparseMatrixType::InnerIterator it_spmat(mat, j);
           for(; it_spmat; ++it_spmat)
           {
             StorageIndex idx = 0; // Position of this block in the column block
@@ -459,7 +471,7 @@ class BlockSparseMatrix : public SparseMatrixBase<BlockSparseMatrix<_Scalar,_Blo
               // Offset from all blocks before ...
               idxVal =  m_blockPtr[m_outerIndex[bj]+idx];
               // ... and offset inside the block
-              idxVal += (j - blockOuterIndex(bj)) * blockOuterSize(bj) + it_spmat.index() - m_innerOffset[bi];
+              idxVal += (j - blockOuterIndex(bj)) * blockInnerSize(bi) + it_spmat.index() - m_innerOffset[bi];
             }
             else
             {
@@ -524,7 +536,7 @@ class BlockSparseMatrix : public SparseMatrixBase<BlockSparseMatrix<_Scalar,_Blo
           StorageIndex offset = m_outerIndex[bj]+idx; // offset in m_indices
           m_indices[offset] = nzBlockIdx[idx];
           if(m_blockSize == Dynamic)
-            m_blockPtr[offset] = m_blockPtr[offset-1] + blockInnerSize(nzBlockIdx[idx]) * blockOuterSize(bj);
+            m_blockPtr[offset+1] = m_blockPtr[offset] + blockInnerSize(nzBlockIdx[idx]) * blockOuterSize(bj);
           // There is no blockPtr for fixed-size blocks... not needed !???
         }
         // Save the pointer to the next outer block
@@ -568,6 +580,8 @@ class BlockSparseMatrix : public SparseMatrixBase<BlockSparseMatrix<_Scalar,_Blo
       eigen_assert(m_outerBSize == outerBlocks.size() && "CHECK THE NUMBER OF ROW OR COLUMN BLOCKS");
       m_outerBSize = outerBlocks.size();
       //  starting index of blocks... cumulative sums
+      delete[] m_innerOffset;
+      delete[] m_outerOffset;
       m_innerOffset = new StorageIndex[m_innerBSize+1];
       m_outerOffset = new StorageIndex[m_outerBSize+1];
       m_innerOffset[0] = 0;
@@ -598,7 +612,10 @@ class BlockSparseMatrix : public SparseMatrixBase<BlockSparseMatrix<_Scalar,_Blo
       eigen_assert((m_innerBSize != 0 && m_outerBSize != 0) &&
           "TRYING TO RESERVE ZERO-SIZE MATRICES, CALL resize() first");
 
-      //FIXME Should free if already allocated
+      delete[] m_outerIndex;
+      delete[] m_blockPtr;
+      delete[] m_indices;
+      delete[] m_values;
       m_outerIndex = new StorageIndex[m_outerBSize+1];
 
       m_nonzerosblocks = nonzerosblocks;
@@ -808,22 +825,16 @@ class BlockSparseMatrix : public SparseMatrixBase<BlockSparseMatrix<_Scalar,_Blo
       eigen_assert(brow < blockRows() && "BLOCK ROW INDEX OUT OF BOUNDS");
       eigen_assert(bcol < blockCols() && "BLOCK nzblocksFlagCOLUMN OUT OF BOUNDS");
 
-      StorageIndex rsize = IsColMajor ? blockInnerSize(brow): blockOuterSize(bcol);
-      StorageIndex csize = IsColMajor ? blockOuterSize(bcol) : blockInnerSize(brow);
+      StorageIndex rsize = IsColMajor ? blockInnerSize(brow): blockOuterSize(brow);
+      StorageIndex csize = IsColMajor ? blockOuterSize(bcol) : blockInnerSize(bcol);
       StorageIndex inner = IsColMajor ? brow : bcol;
       StorageIndex outer = IsColMajor ? bcol : brow;
       StorageIndex offset = m_outerIndex[outer];
       while(offset < m_outerIndex[outer+1] && m_indices[offset] != inner)
         offset++;
-      if(m_indices[offset] == inner)
-      {
-        return Map<BlockScalar>(&(m_values[blockPtr(offset)]), rsize, csize);
-      }
-      else
-      {
-        //FIXME the block does not exist, Insert it !!!!!!!!!
-        eigen_assert("DYNAMIC INSERTION IS NOT YET SUPPORTED");
-      }
+      //FIXME the block does not exist, Insert it !!!!!!!!!
+      eigen_assert(offset < m_outerIndex[outer+1] && "DYNAMIC INSERTION IS NOT YET SUPPORTED");
+      return Map<BlockScalar>(&(m_values[blockPtr(offset)]), rsize, csize);
     }
 
     /**
@@ -834,35 +845,29 @@ class BlockSparseMatrix : public SparseMatrixBase<BlockSparseMatrix<_Scalar,_Blo
       eigen_assert(brow < blockRows() && "BLOCK ROW INDEX OUT OF BOUNDS");
       eigen_assert(bcol < blockCols() && "BLOCK COLUMN OUT OF BOUNDS");
 
-      StorageIndex rsize = IsColMajor ? blockInnerSize(brow): blockOuterSize(bcol);
-      StorageIndex csize = IsColMajor ? blockOuterSize(bcol) : blockInnerSize(brow);
+      StorageIndex rsize = IsColMajor ? blockInnerSize(brow): blockOuterSize(brow);
+      StorageIndex csize = IsColMajor ? blockOuterSize(bcol) : blockInnerSize(bcol);
       StorageIndex inner = IsColMajor ? brow : bcol;
       StorageIndex outer = IsColMajor ? bcol : brow;
       StorageIndex offset = m_outerIndex[outer];
       while(offset < m_outerIndex[outer+1] && m_indices[offset] != inner) offset++;
-      if(m_indices[offset] == inner)
-      {
-        return Map<const BlockScalar> (&(m_values[blockPtr(offset)]), rsize, csize);
-      }
-      else
-//        return BlockScalar::Zero(rsize, csize);
-        eigen_assert("NOT YET SUPPORTED");
+//      return BlockScalar::Zero(rsize, csize);
+      eigen_assert(offset < m_outerIndex[outer+1] && "NOT YET SUPPORTED");
+      return Map<const BlockScalar> (&(m_values[blockPtr(offset)]), rsize, csize);
     }
 
-    // Block Matrix times vector product
-    template<typename VecType>
-    BlockSparseTimeDenseProduct<BlockSparseMatrix, VecType> operator*(const VecType& lhs) const
-    {
-      return BlockSparseTimeDenseProduct<BlockSparseMatrix, VecType>(*this, lhs);
-    }
+    /** \returns the size of the blocks, or \c Dynamic for blocks of variable sizes */
+    inline Index blockSize() const { return m_blockSize; }
 
     /** \returns the number of nonzero blocks */
     inline Index nonZerosBlocks() const { return m_nonzerosblocks; }
     /** \returns the total number of nonzero elements, including eventual explicit zeros in blocks */
     inline Index nonZeros() const { return m_nonzeros; }
 
-    inline BlockScalarReturnType *valuePtr() {return static_cast<BlockScalarReturnType *>(m_values);}
-//    inline Scalar *valuePtr(){ return m_values; }
+    /** \returns a pointer to the values, the blocks being stored one after the other in the storage order of the
+      * matrix. The block \a id starts at the position blockPtr(id). */
+    inline Scalar *valuePtr() { return m_values; }
+    inline const Scalar *valuePtr() const { return m_values; }
     inline StorageIndex *innerIndexPtr() {return m_indices; }
     inline const StorageIndex *innerIndexPtr() const {return m_indices; }
     inline StorageIndex *outerIndexPtr() {return m_outerIndex; }
@@ -955,6 +960,15 @@ class BlockSparseMatrix : public SparseMatrixBase<BlockSparseMatrix<_Scalar,_Blo
     // Insert a block at a particular location... need to make a room for that
     Map<BlockScalar> insert(Index brow, Index bcol);
 
+    template<typename T>
+    static T* copyArray(const T* src, Index size)
+    {
+      if(src == 0) return 0;
+      T* dst = new T[size];
+      std::copy(src, src+size, dst);
+      return dst;
+    }
+
     Index m_innerBSize; // Number of block rows
     Index m_outerBSize; // Number of block columns
     StorageIndex *m_innerOffset; // Starting index of each inner block (size m_innerBSize+1)
@@ -1000,13 +1014,13 @@ class BlockSparseMatrix<_Scalar, _BlockAtCompileTime, _Options, _StorageIndex>::
     inline Index index() const {return m_mat.m_indices[m_id]; }
     inline Index outer() const { return m_outer; }
     // block row index
-    inline Index row() const  {return index(); }
+    inline Index row() const  {return IsColMajor ? index() : outer(); }
     // block column index
-    inline Index col() const {return outer(); }
-    // FIXME Number of rows in the current block
-    inline Index rows() const { return (m_mat.m_blockSize==Dynamic) ? (m_mat.m_innerOffset[index()+1] - m_mat.m_innerOffset[index()]) : m_mat.m_blockSize; }
-    // Number of columns in the current block ...
-    inline Index cols() const { return (m_mat.m_blockSize==Dynamic) ? (m_mat.m_outerOffset[m_outer+1]-m_mat.m_outerOffset[m_outer]) : m_mat.m_blockSize;}
+    inline Index col() const {return IsColMajor ? outer() : index(); }
+    // Number of rows in the current block
+    inline Index rows() const { return IsColMajor ? m_mat.blockInnerSize(index()) : m_mat.blockOuterSize(m_outer); }
+    // Number of columns in the current block
+    inline Index cols() const { return IsColMajor ? m_mat.blockOuterSize(m_outer) : m_mat.blockInnerSize(index()); }
     inline operator bool() const { return (m_id < m_end); }
 
   protected:
@@ -1021,7 +1035,7 @@ class BlockSparseMatrix<_Scalar, _BlockAtCompileTime, _Options, _StorageIndex>::
 {
   public:
     InnerIterator(const BlockSparseMatrix& mat, Index outer)
-    : m_mat(mat),m_outerB(mat.outerToBlock(outer)),m_outer(outer),
+    : m_mat(mat),m_outer(outer),m_outerB(mat.outerToBlock(outer)),
       itb(mat, mat.outerToBlock(outer)),
       m_offset(outer - mat.blockOuterIndex(m_outerB))
      {
@@ -1049,16 +1063,16 @@ class BlockSparseMatrix<_Scalar, _BlockAtCompileTime, _Options, _StorageIndex>::
     }
     inline const Scalar& value() const
     {
-      return itb.value().coeff(m_id - m_start, m_offset);
+      return IsColMajor ? itb.value().coeffRef(m_id - m_start, m_offset) : itb.value().coeffRef(m_offset, m_id - m_start);
     }
     inline Scalar& valueRef()
     {
-      return itb.valueRef().coeff(m_id - m_start, m_offset);
+      return IsColMajor ? itb.valueRef().coeffRef(m_id - m_start, m_offset) : itb.valueRef().coeffRef(m_offset, m_id - m_start);
     }
     inline Index index() const { return m_id; }
     inline Index outer() const {return m_outer; }
-    inline Index col() const {return outer(); }
-    inline Index row() const { return index();}
+    inline Index col() const {return IsColMajor ? outer() : index(); }
+    inline Index row() const { return IsColMajor ? index() : outer(); }
     inline operator bool() const
     {
       return itb;
@@ -1074,6 +1088,417 @@ class BlockSparseMatrix<_Scalar, _BlockAtCompileTime, _Options, _StorageIndex>::
     Index m_end; // starting inner index of the next block
 
 };
+
+namespace internal {
+
+template<typename _Scalar, int _BlockAtCompileTime, int _Options, typename _StorageIndex>
+struct evaluator<BlockSparseMatrix<_Scalar,_BlockAtCompileTime,_Options,_StorageIndex> >
+  : evaluator_base<BlockSparseMatrix<_Scalar,_BlockAtCompileTime,_Options,_StorageIndex> >
+{
+  typedef _Scalar Scalar;
+  typedef BlockSparseMatrix<_Scalar,_BlockAtCompileTime,_Options,_StorageIndex> SparseMatrixType;
+  typedef typename SparseMatrixType::InnerIterator InnerIterator;
+
+  enum {
+    CoeffReadCost = NumTraits<_Scalar>::ReadCost,
+    Flags = SparseMatrixType::Flags
+  };
+
+  evaluator() : m_matrix(0) {}
+  evaluator(const SparseMatrixType &mat) : m_matrix(&mat) {}
+
+  operator const SparseMatrixType&() const { return *m_matrix; }
+
+  Index nonZerosEstimate() const { return m_matrix->nonZeros(); }
+
+  const SparseMatrixType *m_matrix;
+};
+
+/* The products of block sparse matrices with blocks of a same size B known at compile time, or dispatched at
+ * runtime for the common sizes, go through the following micro-kernels working on the raw arrays of blocks.
+ * A block row accumulates the products of its row-major blocks with B consecutive coefficients of the right hand
+ * side into one packet per row of the block, which is reduced once the block row is complete, whereas a column-major
+ * block is multiplied by broadcasting each coefficient of the right hand side against a column of the block.
+ * The only index read per block is the one of the block.
+ */
+template<typename Scalar, typename StorageIndex, int BlockSize,
+         bool Vectorize = packet_traits<Scalar>::Vectorizable && (BlockSize >= packet_traits<Scalar>::size)>
+struct block_sparse_kernel
+{
+  typedef typename packet_traits<Scalar>::type Packet;
+  enum {
+    PacketSize = packet_traits<Scalar>::size,
+    Packets = BlockSize / PacketSize,
+    Peeled = Packets * PacketSize
+  };
+
+  // res = sum_k block_k * x.segment(indices[k]*BlockSize, BlockSize), the blocks being row-major
+  static void rowBlocks(const Scalar* values, const StorageIndex* indices, Index count, const Scalar* x, Scalar* res)
+  {
+    Packet acc[BlockSize];
+    Scalar tail[BlockSize];
+    for(Index r=0; r<BlockSize; ++r)
+    {
+      acc[r] = pset1<Packet>(Scalar(0));
+      tail[r] = Scalar(0);
+    }
+    for(Index k=0; k<count; ++k, values+=BlockSize*BlockSize)
+    {
+      const Scalar* xb = x + indices[k]*BlockSize;
+      for(Index p=0; p<Peeled; p+=PacketSize)
+      {
+        Packet xp = ploadu<Packet>(xb+p);
+        for(Index r=0; r<BlockSize; ++r)
+          acc[r] = pmadd(ploadu<Packet>(values+r*BlockSize+p), xp, acc[r]);
+      }
+      for(Index c=Peeled; c<BlockSize; ++c)
+        for(Index r=0; r<BlockSize; ++r)
+          tail[r] += values[r*BlockSize+c] * xb[c];
+    }
+    for(Index r=0; r<BlockSize; ++r)
+      res[r] = predux(acc[r]) + tail[r];
+  }
+
+  // res = block * x.head(BlockSize), the block being column-major
+  static void colBlock(const Scalar* block, const Scalar* x, Scalar* res)
+  {
+    Packet acc[Packets];
+    for(Index p=0; p<Packets; ++p)
+      acc[p] = pset1<Packet>(Scalar(0));
+    for(Index r=Peeled; r<BlockSize; ++r)
+      res[r] = Scalar(0);
+    for(Index c=0; c<BlockSize; ++c, block+=BlockSize)
+    {
+      Packet xc = pset1<Packet>(x[c]);
+      for(Index p=0; p<Packets; ++p)
+        acc[p] = pmadd(ploadu<Packet>(block+p*PacketSize), xc, acc[p]);
+      for(Index r=Peeled; r<BlockSize; ++r)
+        res[r] += block[r] * x[c];
+    }
+    for(Index p=0; p<Packets; ++p)
+      pstoreu(res+p*PacketSize, acc[p]);
+  }
+};
+
+template<typename Scalar, typename StorageIndex, int BlockSize>
+struct block_sparse_kernel<Scalar,StorageIndex,BlockSize,false>
+{
+  static void rowBlocks(const Scalar* values, const StorageIndex* indices, Index count, const Scalar* x, Scalar* res)
+  {
+    for(Index r=0; r<BlockSize; ++r)
+      res[r] = Scalar(0);
+    for(Index k=0; k<count; ++k, values+=BlockSize*BlockSize)
+    {
+      const Scalar* xb = x + indices[k]*BlockSize;
+      for(Index r=0; r<BlockSize; ++r)
+        for(Index c=0; c<BlockSize; ++c)
+          res[r] += values[r*BlockSize+c] * xb[c];
+    }
+  }
+
+  static void colBlock(const Scalar* block, const Scalar* x, Scalar* res)
+  {
+    for(Index r=0; r<BlockSize; ++r)
+      res[r] = Scalar(0);
+    for(Index c=0; c<BlockSize; ++c, block+=BlockSize)
+      for(Index r=0; r<BlockSize; ++r)
+        res[r] += block[r] * x[c];
+  }
+};
+
+// Computes the rows [begin*B,end*B) of res += alpha * lhs * rhs for a row-major lhs
+template<int BlockSize>
+struct block_sparse_rows_kernel
+{
+  template<typename Lhs, typename Rhs, typename Dest, typename AlphaType>
+  static void run(const Lhs& lhs, const Rhs& rhs, Dest& res, const AlphaType& alpha, Index begin, Index end)
+  {
+    typedef typename Lhs::Scalar Scalar;
+    typedef block_sparse_kernel<Scalar,typename Lhs::StorageIndex,BlockSize> Kernel;
+    const typename Lhs::StorageIndex* outerIndex = lhs.outerIndexPtr();
+    Scalar tmp[BlockSize];
+    for(Index c=0; c<rhs.cols(); ++c)
+    {
+      const Scalar* x = rhs.data() + c*rhs.outerStride();
+      for(Index bi=begin; bi<end; ++bi)
+      {
+        Kernel::rowBlocks(lhs.valuePtr() + outerIndex[bi]*BlockSize*BlockSize, lhs.innerIndexPtr() + outerIndex[bi],
+                          outerIndex[bi+1]-outerIndex[bi], x, tmp);
+        for(Index r=0; r<BlockSize; ++r)
+          res.coeffRef(bi*BlockSize+r,c) += alpha * tmp[r];
+      }
+    }
+  }
+};
+
+template<>
+struct block_sparse_rows_kernel<Dynamic>
+{
+  template<typename Lhs, typename Rhs, typename Dest, typename AlphaType>
+  static void run(const Lhs& lhs, const Rhs& rhs, Dest& res, const AlphaType& alpha, Index begin, Index end)
+  {
+    for(Index bi=begin; bi<end; ++bi)
+      for(typename Lhs::BlockInnerIterator it(lhs, bi); it; ++it)
+        res.middleRows(lhs.blockOuterIndex(bi), it.rows()).noalias()
+          += alpha * it.value() * rhs.middleRows(lhs.blockInnerIndex(it.index()), it.cols());
+  }
+};
+
+// Adds to res the contributions of the outer blocks [begin,end) of alpha * lhs * rhs for a column-major lhs
+template<int BlockSize>
+struct block_sparse_outer_kernel
+{
+  template<typename Lhs, typename Rhs, typename Dest, typename AlphaType>
+  static void run(const Lhs& lhs, const Rhs& rhs, Dest& res, const AlphaType& alpha, Index begin, Index end)
+  {
+    typedef typename Lhs::Scalar Scalar;
+    typedef block_sparse_kernel<Scalar,typename Lhs::StorageIndex,BlockSize> Kernel;
+    const typename Lhs::StorageIndex* outerIndex = lhs.outerIndexPtr();
+    const typename Lhs::StorageIndex* indices = lhs.innerIndexPtr();
+    Scalar tmp[BlockSize];
+    for(Index c=0; c<rhs.cols(); ++c)
+    {
+      const Scalar* x = rhs.data() + c*rhs.outerStride();
+      for(Index bj=begin; bj<end; ++bj)
+        for(Index k=outerIndex[bj]; k<outerIndex[bj+1]; ++k)
+        {
+          Kernel::colBlock(lhs.valuePtr() + k*BlockSize*BlockSize, x + bj*BlockSize, tmp);
+          for(Index r=0; r<BlockSize; ++r)
+            res.coeffRef(indices[k]*BlockSize+r,c) += alpha * tmp[r];
+        }
+    }
+  }
+};
+
+template<>
+struct block_sparse_outer_kernel<Dynamic>
+{
+  template<typename Lhs, typename Rhs, typename Dest, typename AlphaType>
+  static void run(const Lhs& lhs, const Rhs& rhs, Dest& res, const AlphaType& alpha, Index begin, Index end)
+  {
+    for(Index bj=begin; bj<end; ++bj)
+      for(typename Lhs::BlockInnerIterator it(lhs, bj); it; ++it)
+        res.middleRows(lhs.blockInnerIndex(it.index()), it.rows()).noalias()
+          += alpha * it.value() * rhs.middleRows(lhs.blockOuterIndex(bj), it.cols());
+  }
+};
+
+// Selects the kernel of the block size, the common block sizes given at runtime having their own kernels
+template<template<int> class Kernel, int BlockSize>
+struct block_sparse_dispatch
+{
+  template<typename Lhs, typename Rhs, typename Dest, typename AlphaType>
+  static void run(const Lhs& lhs, const Rhs& rhs, Dest& res, const AlphaType& alpha, Index begin, Index end)
+  {
+    Kernel<BlockSize>::run(lhs, rhs, res, alpha, begin, end);
+  }
+};
+
+template<template<int> class Kernel>
+struct block_sparse_dispatch<Kernel,Dynamic>
+{
+  template<typename Lhs, typename Rhs, typename Dest, typename AlphaType>
+  static void run(const Lhs& lhs, const Rhs& rhs, Dest& res, const AlphaType& alpha, Index begin, Index end)
+  {
+    switch(lhs.blockSize())
+    {
+      case 2: Kernel<2>::run(lhs, rhs, res, alpha, begin, end); break;
+      case 3: Kernel<3>::run(lhs, rhs, res, alpha, begin, end); break;
+      case 4: Kernel<4>::run(lhs, rhs, res, alpha, begin, end); break;
+      case 5: Kernel<5>::run(lhs, rhs, res, alpha, begin, end); break;
+      case 6: Kernel<6>::run(lhs, rhs, res, alpha, begin, end); break;
+      default: Kernel<Dynamic>::run(lhs, rhs, res, alpha, begin, end); break;
+    }
+  }
+};
+
+template<typename Lhs>
+struct block_sparse_time_dense_product_impl
+{
+  template<typename Rhs, typename Dest, typename AlphaType>
+  static void processRows(const Lhs& lhs, const Rhs& rhs, Dest& res, const AlphaType& alpha, Index begin, Index end)
+  {
+    block_sparse_dispatch<block_sparse_rows_kernel,Lhs::BlockSize>::run(lhs, rhs, res, alpha, begin, end);
+  }
+
+  template<typename Rhs, typename Dest, typename AlphaType>
+  static void processOuter(const Lhs& lhs, const Rhs& rhs, Dest& res, const AlphaType& alpha, Index begin, Index end)
+  {
+    block_sparse_dispatch<block_sparse_outer_kernel,Lhs::BlockSize>::run(lhs, rhs, res, alpha, begin, end);
+  }
+};
+
+template<typename _Scalar, int _BlockAtCompileTime, int _Options, typename _StorageIndex, typename Rhs, int ProductType>
+struct generic_product_impl<BlockSparseMatrix<_Scalar,_BlockAtCompileTime,_Options,_StorageIndex>, Rhs, SparseShape, DenseShape, ProductType>
+ : generic_product_impl_base<BlockSparseMatrix<_Scalar,_BlockAtCompileTime,_Options,_StorageIndex>, Rhs,
+                             generic_product_impl<BlockSparseMatrix<_Scalar,_BlockAtCompileTime,_Options,_StorageIndex>,Rhs,SparseShape,DenseShape,ProductType> >
+{
+  typedef BlockSparseMatrix<_Scalar,_BlockAtCompileTime,_Options,_StorageIndex> Lhs;
+  typedef typename Product<Lhs,Rhs>::Scalar Scalar;
+
+  template<typename Dest>
+  static void scaleAndAddTo(Dest& dst, const Lhs& lhs, const Rhs& rhs, const Scalar& alpha)
+  {
+    // the kernels read the blocks of the right hand side from contiguous columns
+    typedef Ref<const Matrix<Scalar,Dynamic,Dynamic> > RhsRef;
+    RhsRef actualRhs(rhs);
+    typedef block_sparse_time_dense_product_impl<Lhs> Impl;
+    double work = double(lhs.nonZeros())*double(rhs.cols());
+    if(Lhs::IsColMajor)
+      sparse_dense_product_scatter<Impl>(lhs, lhs.outerBlocks(), work, actualRhs, dst, alpha);
+    else
+      sparse_dense_product_rows<Impl>(lhs, lhs.outerBlocks(), work, actualRhs, dst, alpha);
+  }
+};
+
+} // end namespace internal
+
+/** \ingroup SparseExtra_Module
+  * \brief A block Jacobi preconditioner
+  *
+  * This preconditioner approximately solves for A.x = b problems by neglecting all the entries of A outside of the
+  * square blocks of its diagonal, each diagonal block being inverted once for all by a full pivoting LU
+  * decomposition. The singular diagonal blocks are replaced by the identity. It is a better approximation than
+  * DiagonalPreconditioner for problems coupling several unknowns per node, e.g., the 3 displacements of elasticity
+  * problems, the blocks then gathering the unknowns of a node.
+  *
+  * \tparam _Scalar the type of the scalar.
+  * \tparam _BlockSize the size of the diagonal blocks if it is known at compile time, or \c Dynamic
+  *
+  * When \a _BlockSize is \c Dynamic, the block size is the one given to setBlockSize(), or, otherwise, the one of the
+  * matrix if it is a BlockSparseMatrix with blocks of a same size, or the one returned by
+  * BlockSparseMatrix::detectBlockSize() for the other matrices. The last diagonal block is smaller if the block size
+  * does not divide the size of the matrix. The diagonal blocks are pre-inverted and stored one after the other.
+  *
+  * \code
+  * BlockSparseMatrix<double,3,RowMajor> A(...);
+  * ConjugateGradient<BlockSparseMatrix<double,3,RowMajor>, Lower|Upper, BlockDiagonalPreconditioner<double,3> > cg(A);
+  * x = cg.solve(b);
+  * \endcode
+  *
+  * This preconditioner is suitable for both selfadjoint and general problems.
+  *
+  * \sa class DiagonalPreconditioner, class BlockSparseMatrix
+  */
+template <typename _Scalar, int _BlockSize=Dynamic>
+class BlockDiagonalPreconditioner
+{
+    typedef _Scalar Scalar;
+    typedef Matrix<Scalar,Dynamic,1> Vector;
+    enum { BlockSize = _BlockSize };
+  public:
+    typedef typename Vector::StorageIndex StorageIndex;
+    // this typedef is only to export the scalar type and compile-time dimensions to solve_retval
+    typedef Matrix<Scalar,Dynamic,Dynamic> MatrixType;
+
+    BlockDiagonalPreconditioner() : m_size(0), m_blockSize(BlockSize), m_actualBlockSize(1), m_isInitialized(false) {}
+
+    template<typename MatType>
+    explicit BlockDiagonalPreconditioner(const MatType& mat) : m_size(0), m_blockSize(BlockSize), m_actualBlockSize(1), m_isInitialized(false)
+    {
+      compute(mat);
+    }
+
+    Index rows() const { return m_size; }
+    Index cols() const { return m_size; }
+
+    /** Sets the size of the diagonal blocks, which takes effect on the next call to compute() or factorize().
+      * A size of \c Dynamic restores the default choice of the block size. */
+    BlockDiagonalPreconditioner& setBlockSize(Index blockSize)
+    {
+      eigen_assert((BlockSize==Dynamic || blockSize==BlockSize) && (blockSize>0 || blockSize==Dynamic));
+      m_blockSize = blockSize;
+      return *this;
+    }
+
+    /** \returns the size of the diagonal blocks of the last factorized matrix */
+    Index blockSize() const { return m_actualBlockSize; }
+
+    template<typename MatType>
+    BlockDiagonalPreconditioner& analyzePattern(const MatType& )
+    {
+      return *this;
+    }
+
+    template<typename MatType>
+    BlockDiagonalPreconditioner& factorize(const MatType& mat)
+    {
+      typedef Matrix<Scalar,Dynamic,Dynamic> DenseBlock;
+      m_size = mat.cols();
+      m_actualBlockSize = m_blockSize!=Dynamic ? m_blockSize : defaultBlockSize(mat);
+      const Index b = m_actualBlockSize;
+      eigen_assert((BlockSize==Dynamic || m_size%b==0) && "THE SIZE OF THE MATRIX MUST BE A MULTIPLE OF THE BLOCK SIZE");
+
+      // gather the diagonal blocks side by side
+      m_invBlocks.setZero(b, m_size);
+      for(Index j=0; j<mat.outerSize(); ++j)
+        for(typename MatType::InnerIterator it(mat,j); it; ++it)
+          if(it.row()/b == it.col()/b)
+            m_invBlocks(it.row()%b, it.col()) = it.value();
+
+      FullPivLU<DenseBlock> lu;
+      for(Index k=0; k<m_size; k+=b)
+      {
+        const Index bs = (std::min)(b, m_size-k);
+        Block<DenseBlock> block(m_invBlocks, 0, k, bs, bs);
+        lu.compute(block);
+        if(lu.isInvertible())
+          block = lu.inverse();
+        else
+          block.setIdentity();
+      }
+      m_isInitialized = true;
+      return *this;
+    }
+
+    template<typename MatType>
+    BlockDiagonalPreconditioner& compute(const MatType& mat)
+    {
+      return factorize(mat);
+    }
+
+    /** \internal */
+    template<typename Rhs, typename Dest>
+    void _solve_impl(const Rhs& b, Dest& x) const
+    {
+      typedef Matrix<Scalar,BlockSize,BlockSize> InverseBlock;
+      const Index bs = m_actualBlockSize;
+      for(Index k=0; k<m_size; k+=bs)
+      {
+        const Index size = (std::min)(bs, m_size-k);
+        x.middleRows(k,size).noalias() = Map<const InverseBlock,0,OuterStride<> >(m_invBlocks.data()+k*bs, size, size, OuterStride<>(bs))
+                                       * b.middleRows(k,size);
+      }
+    }
+
+    template<typename Rhs> inline const Solve<BlockDiagonalPreconditioner, Rhs>
+    solve(const MatrixBase<Rhs>& b) const
+    {
+      eigen_assert(m_isInitialized && "BlockDiagonalPreconditioner is not initialized.");
+      eigen_assert(m_size==b.rows()
+                && "BlockDiagonalPreconditioner::solve(): invalid number of rows of the right hand side matrix b");
+      return Solve<BlockDiagonalPreconditioner, Rhs>(*this, b.derived());
+    }
+
+  protected:
+    template<typename MatType>
+    static Index defaultBlockSize(const MatType& mat)
+    {
+      return BlockSparseMatrix<Scalar,Dynamic,ColMajor,typename MatType::StorageIndex>::detectBlockSize(mat);
+    }
+    template<typename _Scalar2, int _BlockAtCompileTime, int _Options, typename _StorageIndex>
+    static Index defaultBlockSize(const BlockSparseMatrix<_Scalar2,_BlockAtCompileTime,_Options,_StorageIndex>& mat)
+    {
+      eigen_assert(mat.blockSize()!=Dynamic && "THE DIAGONAL BLOCKS OF VARIABLE SIZES ARE NOT SUPPORTED");
+      return mat.blockSize();
+    }
+
+    MatrixType m_invBlocks;
+    Index m_size;
+    Index m_blockSize;
+    Index m_actualBlockSize;
+    bool m_isInitialized;
+};
 } // end namespace Eigen
 
 #endif // EIGEN_SPARSEBLOCKMATRIX_H
@@ -0,0 +1,473 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_SLICED_ELLPACK_MATRIX_H
+#define EIGEN_SLICED_ELLPACK_MATRIX_H
+
+namespace Eigen {
+
+template<typename _Scalar, int _SliceHeight = 8, typename _StorageIndex = int> class SlicedEllpackMatrix;
+
+namespace internal {
+template<typename Scalar, int SliceHeight, typename StorageIndex, typename Rhs, typename Dest>
+struct sliced_ellpack_product_impl;
+
+template<typename _Scalar, int _SliceHeight, typename _StorageIndex>
+struct traits<SlicedEllpackMatrix<_Scalar, _SliceHeight, _StorageIndex> >
+{
+  typedef _Scalar Scalar;
+  typedef _StorageIndex StorageIndex;
+  typedef Sparse StorageKind;
+  typedef MatrixXpr XprKind;
+  enum {
+    RowsAtCompileTime = Dynamic,
+    ColsAtCompileTime = Dynamic,
+    MaxRowsAtCompileTime = Dynamic,
+    MaxColsAtCompileTime = Dynamic,
+    Flags = RowMajorBit | NestByRefBit,
+    CoeffReadCost = NumTraits<Scalar>::ReadCost,
+    SupportedAccessPatterns = OuterRandomAccessPattern
+  };
+};
+}
+
+/** \class SlicedEllpackMatrix
+  *
+  * \brief A read-only sparse matrix class designed for fast sparse matrix - dense matrix products
+  *
+  * \param _Scalar the scalar type, i.e. the type of the coefficients
+  * \param _SliceHeight the number of rows of a slice, should be a multiple of the packet size of \a _Scalar
+  * \param _StorageIndex the type of the indices. Default is \c int.
+  *
+  * This class stores a sparse matrix in the sliced ELLPACK format with local row sorting, also known as SELL-C-sigma.
+  * The rows are grouped by slices of \a _SliceHeight rows, the entries of a slice being stored column by column,
+  * every row of the slice being padded with explicit zeros to the length of the longest one. Within a slice, the
+  * i-th entries of the consecutive rows are therefore contiguous, and a sparse matrix - vector product processes
+  * whole packets of rows at once, the coefficients of the vector being gathered through their column indices.
+  * To limit the padding, the rows are sorted by decreasing number of nonzeros within windows of sortingWindow()
+  * consecutive rows before being sliced, the products scattering the results back to the original rows.
+  *
+  * Compared to SparseMatrix, this format speeds up the products of matrices whose rows are short or have
+  * irregular lengths, which is typical of the matrix - vector products of the iterative solvers:
+  * \code
+  * SparseMatrix<double> A;
+  * // fill A
+  * SlicedEllpackMatrix<double> sell(A);
+  * ConjugateGradient<SlicedEllpackMatrix<double>, Lower|Upper> cg(sell);
+  * x = cg.solve(b);
+  * \endcode
+  * As with any matrix type not supported by Ref<>, the iterative solvers consider the whole matrix, and
+  * ConjugateGradient thus requires the \c Lower|Upper mode.
+  *
+  * A SlicedEllpackMatrix is built from any sparse expression and cannot be modified afterwards. It can be read
+  * through its InnerIterator, which iterates over the nonzeros of a row of the original matrix in the order of
+  * this expression, and multiplied by dense matrices. The products stop each row at its own length, such that the
+  * padding never turns the infinite or NaN coefficients of the right hand side into NaN.
+  *
+  * Large products are multi-threaded by ranges of slices, see \ref TopicMultiThreading.
+  *
+  * \see SparseMatrix
+  */
+template<typename _Scalar, int _SliceHeight, typename _StorageIndex>
+class SlicedEllpackMatrix
+  : public SparseMatrixBase<SlicedEllpackMatrix<_Scalar, _SliceHeight, _StorageIndex> >
+{
+  public:
+    EIGEN_SPARSE_PUBLIC_INTERFACE(SlicedEllpackMatrix)
+    using Base::IsRowMajor;
+    enum {
+      SliceHeight = _SliceHeight
+    };
+    typedef Matrix<Scalar,Dynamic,1> ScalarVector;
+    typedef Matrix<StorageIndex,Dynamic,1> IndexVector;
+
+    class InnerIterator;
+    class ReverseInnerIterator;
+
+    /** Default constructor yielding an empty \c 0 \c x \c 0 matrix */
+    SlicedEllpackMatrix()
+      : m_rows(0), m_cols(0), m_nonZeros(0), m_sortingWindow(DefaultSortingWindow)
+    {
+      m_sliceStart.setZero(1);
+    }
+
+    /** Constructs a sliced ELLPACK matrix from the sparse expression \a other, the rows being sorted within
+      * windows of \a sortingWindow rows. */
+    template<typename OtherDerived>
+    explicit SlicedEllpackMatrix(const SparseMatrixBase<OtherDerived>& other, Index sortingWindow = DefaultSortingWindow)
+      : m_sortingWindow(sortingWindow)
+    {
+      *this = other;
+    }
+
+    template<typename OtherDerived>
+    SlicedEllpackMatrix& operator=(const SparseMatrixBase<OtherDerived>& other)
+    {
+      SparseMatrix<Scalar,RowMajor,StorageIndex> mat(other.derived());
+      mat.makeCompressed();
+      assign(mat);
+      return *this;
+    }
+
+    inline Index rows() const { return m_rows; }
+    inline Index cols() const { return m_cols; }
+
+    /** \returns the number of nonzero coefficients, not counting the padding */
+    inline Index nonZeros() const { return m_nonZeros; }
+
+    /** \returns the number of stored coefficients, including the padding */
+    inline Index storedSize() const { return m_values.size(); }
+
+    /** \returns the number of slices */
+    inline Index sliceCount() const { return m_sliceStart.size()-1; }
+
+    /** \returns the number of consecutive rows within which the rows are sorted by decreasing length */
+    inline Index sortingWindow() const { return m_sortingWindow; }
+
+    /** Sets the number of consecutive rows within which the rows are sorted by decreasing length. Larger windows
+      * reduce the padding but scatter the results of the products further. A window of one row keeps the original
+      * order of the rows. This setting takes effect on the next assignment.
+      */
+    void setSortingWindow(Index sortingWindow)
+    {
+      eigen_assert(sortingWindow>0);
+      m_sortingWindow = sortingWindow;
+    }
+
+    /** \returns the coefficient at given row and column, the search being linear in the length of the row */
+    Scalar coeff(Index row, Index col) const
+    {
+      for(InnerIterator it(*this,row); it && it.index()<=col; ++it)
+        if(it.index()==col)
+          return it.value();
+      return Scalar(0);
+    }
+
+    /** \internal \returns a pointer to the stored coefficients, including the padding */
+    inline const Scalar* valuePtr() const { return m_values.data(); }
+    /** \internal \returns a pointer to the column indices of the stored coefficients, including the padding */
+    inline const StorageIndex* innerIndexPtr() const { return m_indices.data(); }
+    /** \internal \returns a pointer to the positions of the first coefficient of each slice */
+    inline const StorageIndex* sliceStartPtr() const { return m_sliceStart.data(); }
+    /** \internal \returns a pointer to the original row stored at each position of the slices */
+    inline const StorageIndex* permutationPtr() const { return m_perm.data(); }
+
+  protected:
+
+    enum { DefaultSortingWindow = 32 * SliceHeight };
+
+    void assign(const SparseMatrix<Scalar,RowMajor,StorageIndex>& mat)
+    {
+      eigen_assert(m_sortingWindow>0);
+      m_rows = mat.rows();
+      m_cols = mat.cols();
+      m_nonZeros = mat.nonZeros();
+      const Index slices = (m_rows+SliceHeight-1)/SliceHeight;
+      const Index slots = slices*SliceHeight;
+
+      // sort the rows within the windows, the rows of equal lengths keeping their relative order
+      m_perm.resize(slots);
+      m_slot.resize(m_rows);
+      m_rowLength.setZero(slots);
+      std::vector<std::pair<StorageIndex,StorageIndex> > window;
+      for(Index start=0; start<m_rows; start+=m_sortingWindow)
+      {
+        Index end = (std::min)(m_rows, start+m_sortingWindow);
+        window.clear();
+        for(Index i=start; i<end; ++i)
+          window.push_back(std::make_pair(StorageIndex(-mat.outerIndexPtr()[i+1]+mat.outerIndexPtr()[i]), StorageIndex(i)));
+        std::sort(window.begin(), window.end());
+        for(Index k=0; k<end-start; ++k)
+        {
+          m_perm[start+k] = window[k].second;
+          m_rowLength[start+k] = -window[k].first;
+          m_slot[window[k].second] = StorageIndex(start+k);
+        }
+      }
+      // the padding rows are empty and never written
+      for(Index k=m_rows; k<slots; ++k)
+        m_perm[k] = -1;
+
+      m_sliceStart.resize(slices+1);
+      m_sliceStart[0] = 0;
+      for(Index s=0; s<slices; ++s)
+        m_sliceStart[s+1] = m_sliceStart[s] + SliceHeight*m_rowLength.segment(s*SliceHeight,SliceHeight).maxCoeff();
+
+      // store the slices column by column, the padding being zeros referencing the last column of their row,
+      // which are never multiplied
+      m_values.setZero(m_sliceStart[slices]);
+      m_indices.setZero(m_sliceStart[slices]);
+      for(Index s=0; s<slices; ++s)
+      {
+        const Index width = (m_sliceStart[s+1]-m_sliceStart[s])/SliceHeight;
+        for(Index l=0; l<SliceHeight; ++l)
+        {
+          const Index k = s*SliceHeight+l;
+          StorageIndex* indices = m_indices.data() + m_sliceStart[s] + l;
+          Scalar* values = m_values.data() + m_sliceStart[s] + l;
+          Index j = 0;
+          if(m_perm[k]>=0)
+          {
+            const Index p = mat.outerIndexPtr()[m_perm[k]];
+            for(; j<m_rowLength[k]; ++j)
+            {
+              indices[j*SliceHeight] = mat.innerIndexPtr()[p+j];
+              values[j*SliceHeight] = mat.valuePtr()[p+j];
+            }
+          }
+          for(StorageIndex last = j>0 ? indices[(j-1)*SliceHeight] : 0; j<width; ++j)
+            indices[j*SliceHeight] = last;
+        }
+      }
+    }
+
+    template<typename Scalar_, int SliceHeight_, typename StorageIndex_, typename Rhs, typename Dest>
+    friend struct internal::sliced_ellpack_product_impl;
+
+    Index m_rows;
+    Index m_cols;
+    Index m_nonZeros;
+    Index m_sortingWindow;
+    ScalarVector m_values;
+    IndexVector m_indices;
+    IndexVector m_sliceStart;
+    IndexVector m_rowLength;
+    IndexVector m_perm;
+    IndexVector m_slot;
+};
+
+template<typename Scalar, int _SliceHeight, typename _StorageIndex>
+class SlicedEllpackMatrix<Scalar,_SliceHeight,_StorageIndex>::InnerIterator
+{
+  public:
+    InnerIterator(const SlicedEllpackMatrix& mat, Index outer)
+      : m_values(mat.m_values.data()), m_indices(mat.m_indices.data()), m_outer(outer)
+    {
+      const Index slot = mat.m_slot[outer];
+      m_id = mat.m_sliceStart[slot/SliceHeight] + slot%SliceHeight;
+      m_end = m_id + mat.m_rowLength[slot]*SliceHeight;
+    }
+
+    inline InnerIterator& operator++() { m_id += SliceHeight; return *this; }
+
+    inline const Scalar& value() const { return m_values[m_id]; }
+
+    inline StorageIndex index() const { return m_indices[m_id]; }
+    inline Index outer() const { return m_outer; }
+    inline Index row() const { return m_outer; }
+    inline Index col() const { return index(); }
+
+    inline operator bool() const { return m_id < m_end; }
+
+  protected:
+    const Scalar* m_values;
+    const StorageIndex* m_indices;
+    const Index m_outer;
+    Index m_id;
+    Index m_end;
+};
+
+template<typename Scalar, int _SliceHeight, typename _StorageIndex>
+class SlicedEllpackMatrix<Scalar,_SliceHeight,_StorageIndex>::ReverseInnerIterator
+{
+  public:
+    ReverseInnerIterator(const SlicedEllpackMatrix& mat, Index outer)
+      : m_values(mat.m_values.data()), m_indices(mat.m_indices.data()), m_outer(outer)
+    {
+      const Index slot = mat.m_slot[outer];
+      m_start = mat.m_sliceStart[slot/SliceHeight] + slot%SliceHeight;
+      m_id = m_start + mat.m_rowLength[slot]*SliceHeight;
+    }
+
+    inline ReverseInnerIterator& operator--() { m_id -= SliceHeight; return *this; }
+
+    inline const Scalar& value() const { return m_values[m_id-SliceHeight]; }
+
+    inline StorageIndex index() const { return m_indices[m_id-SliceHeight]; }
+    inline Index outer() const { return m_outer; }
+    inline Index row() const { return m_outer; }
+    inline Index col() const { return index(); }
+
+    inline operator bool() const { return m_id > m_start; }
+
+  protected:
+    const Scalar* m_values;
+    const StorageIndex* m_indices;
+    const Index m_outer;
+    Index m_id;
+    Index m_start;
+};
+
+namespace internal {
+
+template<typename _Scalar, int _SliceHeight, typename _StorageIndex>
+struct evaluator<SlicedEllpackMatrix<_Scalar,_SliceHeight,_StorageIndex> >
+  : evaluator_base<SlicedEllpackMatrix<_Scalar,_SliceHeight,_StorageIndex> >
+{
+  typedef _Scalar Scalar;
+  typedef SlicedEllpackMatrix<_Scalar,_SliceHeight,_StorageIndex> SparseMatrixType;
+  typedef typename SparseMatrixType::InnerIterator InnerIterator;
+  typedef typename SparseMatrixType::ReverseInnerIterator ReverseInnerIterator;
+
+  enum {
+    CoeffReadCost = NumTraits<_Scalar>::ReadCost,
+    Flags = SparseMatrixType::Flags
+  };
+
+  evaluator() : m_matrix(0) {}
+  evaluator(const SparseMatrixType &mat) : m_matrix(&mat) {}
+
+  operator const SparseMatrixType&() const { return *m_matrix; }
+
+  Scalar coeff(Index row, Index col) const { return m_matrix->coeff(row,col); }
+
+  Index nonZerosEstimate() const { return m_matrix->nonZeros(); }
+
+  const SparseMatrixType *m_matrix;
+};
+
+/* The products process the slices one after the other. Within a slice, each group of PacketSize rows accumulates
+ * the products of its i-th coefficients, loaded as a packet, with the coefficients of the right hand side gathered
+ * through their column indices, the results being scattered to the original rows once the slice is complete.
+ * The padding is never accumulated: past the columns which are full in every row of the slice, the products are
+ * masked by the lengths of the rows when the packets support comparisons, and accumulated one by one otherwise.
+ */
+template<typename Scalar, int SliceHeight, typename StorageIndex,
+         bool Vectorize = packet_traits<Scalar>::Vectorizable && (SliceHeight % packet_traits<Scalar>::size == 0),
+         bool Masked = packet_traits<Scalar>::HasCmp>
+struct sliced_ellpack_slice_kernel
+{
+  typedef typename packet_traits<Scalar>::type Packet;
+  enum {
+    PacketSize = packet_traits<Scalar>::size,
+    Packets = SliceHeight / PacketSize
+  };
+
+  // the first \a full columns of the slice are not padded, the \a width - \a full next ones are padded in some rows
+  static void run(const Scalar* values, const StorageIndex* indices, const StorageIndex* lengths, Index full, Index width,
+                  const Scalar* x, Scalar* res)
+  {
+    Packet acc[Packets];
+    for(Index k=0; k<Packets; ++k)
+      acc[k] = pset1<Packet>(Scalar(0));
+    for(Index j=0; j<full; ++j)
+      for(Index k=0; k<Packets; ++k)
+        acc[k] = pmadd(pload<Packet>(values+j*SliceHeight+k*PacketSize),
+                       pgather<Scalar,Packet>(x, indices+j*SliceHeight+k*PacketSize), acc[k]);
+    accumulateTail(values, indices, lengths, full, width, x, res, acc,
+                   typename conditional<Masked,true_type,false_type>::type());
+  }
+
+  static void accumulateTail(const Scalar* values, const StorageIndex* indices, const StorageIndex* lengths, Index full,
+                             Index width, const Scalar* x, Scalar* res, Packet* acc, true_type)
+  {
+    if(full<width)
+    {
+      for(Index l=0; l<SliceHeight; ++l)
+        res[l] = Scalar(lengths[l]);
+      Packet len[Packets];
+      for(Index k=0; k<Packets; ++k)
+        len[k] = pload<Packet>(res+k*PacketSize);
+      for(Index j=full; j<width; ++j)
+      {
+        const Packet pj = pset1<Packet>(Scalar(j));
+        for(Index k=0; k<Packets; ++k)
+          acc[k] = pselect(pcmp_lt(pj,len[k]),
+                           pmadd(pload<Packet>(values+j*SliceHeight+k*PacketSize),
+                                 pgather<Scalar,Packet>(x, indices+j*SliceHeight+k*PacketSize), acc[k]),
+                           acc[k]);
+      }
+    }
+    for(Index k=0; k<Packets; ++k)
+      pstore(res+k*PacketSize, acc[k]);
+  }
+
+  static void accumulateTail(const Scalar* values, const StorageIndex* indices, const StorageIndex* lengths, Index full,
+                             Index /*width*/, const Scalar* x, Scalar* res, Packet* acc, false_type)
+  {
+    for(Index k=0; k<Packets; ++k)
+      pstore(res+k*PacketSize, acc[k]);
+    for(Index l=0; l<SliceHeight; ++l)
+      for(Index j=full; j<lengths[l]; ++j)
+        res[l] += values[j*SliceHeight+l] * x[indices[j*SliceHeight+l]];
+  }
+};
+
+template<typename Scalar, int SliceHeight, typename StorageIndex, bool Masked>
+struct sliced_ellpack_slice_kernel<Scalar,SliceHeight,StorageIndex,false,Masked>
+{
+  static void run(const Scalar* values, const StorageIndex* indices, const StorageIndex* lengths, Index full, Index /*width*/,
+                  const Scalar* x, Scalar* res)
+  {
+    for(Index l=0; l<SliceHeight; ++l)
+      res[l] = Scalar(0);
+    for(Index j=0; j<full; ++j)
+      for(Index l=0; l<SliceHeight; ++l)
+        res[l] += values[j*SliceHeight+l] * x[indices[j*SliceHeight+l]];
+    for(Index l=0; l<SliceHeight; ++l)
+      for(Index j=full; j<lengths[l]; ++j)
+        res[l] += values[j*SliceHeight+l] * x[indices[j*SliceHeight+l]];
+  }
+};
+
+template<typename Scalar, int SliceHeight, typename StorageIndex, typename Rhs, typename Dest>
+struct sliced_ellpack_product_impl
+{
+  typedef SlicedEllpackMatrix<Scalar,SliceHeight,StorageIndex> Lhs;
+
+  static void processRows(const Lhs& lhs, const Rhs& rhs, Dest& res, const Scalar& alpha, Index begin, Index end)
+  {
+    EIGEN_ALIGN_DEFAULT Scalar tmp[SliceHeight];
+    for(Index s=begin; s<end; ++s)
+    {
+      const Index start = lhs.m_sliceStart[s];
+      const StorageIndex* perm = lhs.m_perm.data() + s*SliceHeight;
+      const StorageIndex* lengths = lhs.m_rowLength.data() + s*SliceHeight;
+      const Index width = (lhs.m_sliceStart[s+1]-start)/SliceHeight;
+      // the number of columns of the slice which are not padding in any of its rows
+      Index full = width;
+      for(Index l=0; l<SliceHeight; ++l)
+        if(perm[l]>=0)
+          full = (std::min)(full, Index(lengths[l]));
+      for(Index c=0; c<rhs.cols(); ++c)
+      {
+        sliced_ellpack_slice_kernel<Scalar,SliceHeight,StorageIndex>::run(lhs.m_values.data()+start, lhs.m_indices.data()+start,
+                                                                          lengths, full, width, rhs.data()+c*rhs.outerStride(), tmp);
+        for(Index l=0; l<SliceHeight; ++l)
+          if(perm[l]>=0)
+            res.coeffRef(perm[l],c) += alpha * tmp[l];
+      }
+    }
+  }
+};
+
+template<typename _Scalar, int _SliceHeight, typename _StorageIndex, typename Rhs, int ProductType>
+struct generic_product_impl<SlicedEllpackMatrix<_Scalar,_SliceHeight,_StorageIndex>, Rhs, SparseShape, DenseShape, ProductType>
+ : generic_product_impl_base<SlicedEllpackMatrix<_Scalar,_SliceHeight,_StorageIndex>, Rhs,
+                             generic_product_impl<SlicedEllpackMatrix<_Scalar,_SliceHeight,_StorageIndex>,Rhs,SparseShape,DenseShape,ProductType> >
+{
+  typedef SlicedEllpackMatrix<_Scalar,_SliceHeight,_StorageIndex> Lhs;
+  typedef typename Product<Lhs,Rhs>::Scalar Scalar;
+
+  template<typename Dest>
+  static void scaleAndAddTo(Dest& dst, const Lhs& lhs, const Rhs& rhs, const Scalar& alpha)
+  {
+    // the coefficients of the right hand side are gathered from contiguous columns
+    typedef Ref<const Matrix<Scalar,Dynamic,Dynamic> > RhsRef;
+    RhsRef actualRhs(rhs);
+    typedef sliced_ellpack_product_impl<_Scalar,_SliceHeight,_StorageIndex,RhsRef,Dest> Impl;
+    sparse_dense_product_rows<Impl>(lhs, lhs.sliceCount(), double(lhs.storedSize())*double(rhs.cols()), actualRhs, dst, alpha);
+  }
+};
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_SLICED_ELLPACK_MATRIX_H
@@ -0,0 +1,284 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_SPARSE_PRODUCT_PLAN_H
+#define EIGEN_SPARSE_PRODUCT_PLAN_H
+
+namespace Eigen {
+
+/** \class SparseProductPlan
+  *
+  * \brief Repeated sparse * sparse products of matrices having fixed sparsity patterns
+  *
+  * \param _MatrixType the type of the factors and of the result, a SparseMatrix
+  *
+  * This class speeds up the products \c C=A*B or \c C=A^T*A which are recomputed many times with the same
+  * sparsity patterns and new values, as in time stepping or in the setup of multigrid hierarchies. The patterns of
+  * the factors are analyzed once by analyzeProduct() or analyzeGramProduct(), which record the pattern of the
+  * result as well as the position in the result of every multiply-add. The products are then evaluated by
+  * evalProduct() or evalGramProduct() in a single numeric pass, scattering the multiply-adds into the result
+  * without any search, sort or memory allocation:
+  * \code
+  * SparseMatrix<double> A, B, C;
+  * // fill A and B
+  * SparseProductPlan<SparseMatrix<double> > plan;
+  * plan.analyzeProduct(A, B);
+  * for(int step=0; step<steps; ++step)
+  * {
+  *   // update the values of A and B, keeping their patterns
+  *   plan.evalProduct(A, B, C);
+  * }
+  * \endcode
+  *
+  * The first evaluation allocates the result and copies its pattern, whose inner indices are sorted. The following
+  * ones only overwrite its values, as long as it still has the pattern of the product, which is checked at a cost
+  * proportional to its number of nonzeros. The pattern of the result is structural: the coefficients cancelling out
+  * numerically are stored as explicit zeros.
+  *
+  * The factors have to keep the patterns they had when the product was analyzed, including the positions of their
+  * nonzeros in the case of uncompressed matrices. The plan stores two indices per multiply-add of the product,
+  * i.e., about as much memory as a result having \c flops() nonzeros.
+  *
+  * \sa class SparseMatrix
+  */
+template<typename _MatrixType>
+class SparseProductPlan
+{
+  public:
+    typedef _MatrixType MatrixType;
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename MatrixType::StorageIndex StorageIndex;
+    typedef Matrix<StorageIndex,Dynamic,1> IndexVector;
+    enum { IsRowMajor = MatrixType::IsRowMajor };
+
+    SparseProductPlan()
+      : m_rows(0), m_cols(0), m_lhsRows(0), m_lhsCols(0), m_lhsNnz(0), m_rhsRows(0), m_rhsCols(0), m_rhsNnz(0),
+        m_isGram(false), m_isInitialized(false)
+    {}
+
+    /** Records the pattern of the product \a lhs * \a rhs, and how to compute it */
+    SparseProductPlan& analyzeProduct(const MatrixType& lhs, const MatrixType& rhs)
+    {
+      eigen_assert(lhs.cols()==rhs.rows() && "invalid matrix product");
+      setDimensions(lhs, rhs, false);
+      IndexVector lhsOuter, lhsInner, lhsPos, rhsOuter, rhsInner, rhsPos;
+      // the products are performed on the compressed storages, i.e. rhs * lhs for row major matrices
+      const MatrixType& first = IsRowMajor ? rhs : lhs;
+      const MatrixType& second = IsRowMajor ? lhs : rhs;
+      directPattern(first, lhsOuter, lhsInner, lhsPos);
+      directPattern(second, rhsOuter, rhsInner, rhsPos);
+      analyze(first.innerSize(), lhsOuter, lhsInner, lhsPos, rhsOuter, rhsInner, rhsPos);
+      return *this;
+    }
+
+    /** Records the pattern of the Gram product \a mat.transpose() * \a mat, and how to compute it */
+    SparseProductPlan& analyzeGramProduct(const MatrixType& mat)
+    {
+      setDimensions(mat, mat, true);
+      m_rows = mat.cols();
+      IndexVector lhsOuter, lhsInner, lhsPos, rhsOuter, rhsInner, rhsPos;
+      // the compressed storage S of mat is multiplied by its transpose, as S^T*S or S*S^T
+      if(IsRowMajor)
+      {
+        directPattern(mat, lhsOuter, lhsInner, lhsPos);
+        transposedPattern(mat, rhsOuter, rhsInner, rhsPos);
+        analyze(mat.innerSize(), lhsOuter, lhsInner, lhsPos, rhsOuter, rhsInner, rhsPos);
+      }
+      else
+      {
+        transposedPattern(mat, lhsOuter, lhsInner, lhsPos);
+        directPattern(mat, rhsOuter, rhsInner, rhsPos);
+        analyze(mat.outerSize(), lhsOuter, lhsInner, lhsPos, rhsOuter, rhsInner, rhsPos);
+      }
+      return *this;
+    }
+
+    /** Computes \a res = \a lhs * \a rhs, the patterns of \a lhs and \a rhs being the ones given to analyzeProduct() */
+    void evalProduct(const MatrixType& lhs, const MatrixType& rhs, MatrixType& res) const
+    {
+      eigen_assert(m_isInitialized && !m_isGram && "SparseProductPlan::evalProduct: call analyzeProduct() first");
+      eigen_assert(lhs.rows()==m_lhsRows && lhs.cols()==m_lhsCols && lhs.nonZeros()==m_lhsNnz
+                && "SparseProductPlan::evalProduct: the pattern of the left hand side has changed");
+      eigen_assert(rhs.rows()==m_rhsRows && rhs.cols()==m_rhsCols && rhs.nonZeros()==m_rhsNnz
+                && "SparseProductPlan::evalProduct: the pattern of the right hand side has changed");
+      eigen_assert(&res!=&lhs && &res!=&rhs && "SparseProductPlan::evalProduct: aliasing is not supported");
+      if(IsRowMajor)
+        evalTo(rhs.valuePtr(), lhs.valuePtr(), res);
+      else
+        evalTo(lhs.valuePtr(), rhs.valuePtr(), res);
+    }
+
+    /** Computes \a res = \a mat.transpose() * \a mat, the pattern of \a mat being the one given to analyzeGramProduct() */
+    void evalGramProduct(const MatrixType& mat, MatrixType& res) const
+    {
+      eigen_assert(m_isInitialized && m_isGram && "SparseProductPlan::evalGramProduct: call analyzeGramProduct() first");
+      eigen_assert(mat.rows()==m_lhsRows && mat.cols()==m_lhsCols && mat.nonZeros()==m_lhsNnz
+                && "SparseProductPlan::evalGramProduct: the pattern of the matrix has changed");
+      eigen_assert(&res!=&mat && "SparseProductPlan::evalGramProduct: aliasing is not supported");
+      evalTo(mat.valuePtr(), mat.valuePtr(), res);
+    }
+
+    /** \returns the number of rows of the result */
+    inline Index rows() const { return m_rows; }
+    /** \returns the number of columns of the result */
+    inline Index cols() const { return m_cols; }
+    /** \returns the number of nonzeros of the result */
+    inline Index nonZeros() const { return m_inner.size(); }
+    /** \returns the number of multiply-adds performed by an evaluation of the product */
+    inline Index flops() const { return m_lhsPositions.size(); }
+
+  protected:
+
+    void setDimensions(const MatrixType& lhs, const MatrixType& rhs, bool isGram)
+    {
+      m_rows = lhs.rows();
+      m_cols = rhs.cols();
+      m_lhsRows = lhs.rows();
+      m_lhsCols = lhs.cols();
+      m_lhsNnz = lhs.nonZeros();
+      m_rhsRows = rhs.rows();
+      m_rhsCols = rhs.cols();
+      m_rhsNnz = rhs.nonZeros();
+      m_isGram = isGram;
+    }
+
+    // the inner indices of each inner vector of mat, and their positions in its value array
+    static void directPattern(const MatrixType& mat, IndexVector& outer, IndexVector& inner, IndexVector& pos)
+    {
+      outer.resize(mat.outerSize()+1);
+      inner.resize(mat.nonZeros());
+      pos.resize(mat.nonZeros());
+      outer(0) = 0;
+      for(Index j=0; j<mat.outerSize(); ++j)
+      {
+        StorageIndex start = mat.outerIndexPtr()[j];
+        StorageIndex nnz = mat.isCompressed() ? mat.outerIndexPtr()[j+1]-start : mat.innerNonZeroPtr()[j];
+        outer(j+1) = outer(j) + nnz;
+        for(StorageIndex k=0; k<nnz; ++k)
+        {
+          inner(outer(j)+k) = mat.innerIndexPtr()[start+k];
+          pos(outer(j)+k) = start+k;
+        }
+      }
+    }
+
+    // the same for the transposed storage of mat
+    static void transposedPattern(const MatrixType& mat, IndexVector& outer, IndexVector& inner, IndexVector& pos)
+    {
+      IndexVector direct, directInner, directPos;
+      directPattern(mat, direct, directInner, directPos);
+      outer.setZero(mat.innerSize()+1);
+      for(Index k=0; k<directInner.size(); ++k)
+        ++outer(directInner(k)+1);
+      for(Index i=0; i<mat.innerSize(); ++i)
+        outer(i+1) += outer(i);
+      IndexVector next = outer;
+      inner.resize(directInner.size());
+      pos.resize(directInner.size());
+      for(Index j=0; j<mat.outerSize(); ++j)
+        for(StorageIndex k=direct(j); k<direct(j+1); ++k)
+        {
+          StorageIndex p = next(directInner(k))++;
+          inner(p) = StorageIndex(j);
+          pos(p) = directPos(k);
+        }
+    }
+
+    // records the product of the inner vectors of lhs by those of rhs
+    void analyze(Index innerSize, const IndexVector& lhsOuter, const IndexVector& lhsInner, const IndexVector& lhsPos,
+                 const IndexVector& rhsOuter, const IndexVector& rhsInner, const IndexVector& rhsPos)
+    {
+      Index outerSize = rhsOuter.size()-1;
+      Index flops = 0;
+      m_lhsCounts.resize(rhsInner.size());
+      for(Index q=0; q<rhsInner.size(); ++q)
+      {
+        m_lhsCounts(q) = lhsOuter(rhsInner(q)+1) - lhsOuter(rhsInner(q));
+        flops += m_lhsCounts(q);
+      }
+      m_rhsPositions = rhsPos;
+      m_lhsPositions.resize(flops);
+      m_resPositions.resize(flops);
+
+      // the last inner vector having a nonzero at each inner index, and the rank of this nonzero in the result
+      IndexVector mask = IndexVector::Constant(innerSize, -1), rank(innerSize);
+      std::vector<StorageIndex> inner;
+      m_outer.resize(outerSize+1);
+      m_outer(0) = 0;
+      Index f = 0;
+      for(Index j=0; j<outerSize; ++j)
+      {
+        for(StorageIndex q=rhsOuter(j); q<rhsOuter(j+1); ++q)
+          for(StorageIndex p=lhsOuter(rhsInner(q)); p<lhsOuter(rhsInner(q)+1); ++p)
+            if(mask(lhsInner(p))!=j)
+            {
+              mask(lhsInner(p)) = StorageIndex(j);
+              inner.push_back(lhsInner(p));
+            }
+        std::sort(inner.begin()+m_outer(j), inner.end());
+        m_outer(j+1) = StorageIndex(inner.size());
+        for(StorageIndex k=m_outer(j); k<m_outer(j+1); ++k)
+          rank(inner[k]) = k;
+        for(StorageIndex q=rhsOuter(j); q<rhsOuter(j+1); ++q)
+          for(StorageIndex p=lhsOuter(rhsInner(q)); p<lhsOuter(rhsInner(q)+1); ++p, ++f)
+          {
+            m_lhsPositions(f) = lhsPos(p);
+            m_resPositions(f) = rank(lhsInner(p));
+          }
+      }
+      m_inner.resize(inner.size());
+      if(!inner.empty())
+        std::copy(inner.begin(), inner.end(), m_inner.data());
+      m_isInitialized = true;
+    }
+
+    // copies the pattern of the result into res, unless it is already there
+    void initResult(MatrixType& res) const
+    {
+      if(res.rows()==m_rows && res.cols()==m_cols && res.isCompressed() && res.nonZeros()==nonZeros()
+         && std::equal(m_outer.data(), m_outer.data()+m_outer.size(), res.outerIndexPtr())
+         && std::equal(m_inner.data(), m_inner.data()+m_inner.size(), res.innerIndexPtr()))
+        return;
+      res.resize(m_rows, m_cols);
+      res.resizeNonZeros(nonZeros());
+      std::copy(m_outer.data(), m_outer.data()+m_outer.size(), res.outerIndexPtr());
+      std::copy(m_inner.data(), m_inner.data()+m_inner.size(), res.innerIndexPtr());
+    }
+
+    void evalTo(const Scalar* lhsValues, const Scalar* rhsValues, MatrixType& res) const
+    {
+      initResult(res);
+      Scalar* resValues = res.valuePtr();
+      std::fill(resValues, resValues+nonZeros(), Scalar(0));
+      const StorageIndex* lhsPositions = m_lhsPositions.data();
+      const StorageIndex* resPositions = m_resPositions.data();
+      for(Index q=0; q<m_rhsPositions.size(); ++q)
+      {
+        Scalar y = rhsValues[m_rhsPositions(q)];
+        const StorageIndex* end = lhsPositions + m_lhsCounts(q);
+        for(; lhsPositions<end; ++lhsPositions, ++resPositions)
+          resValues[*resPositions] += lhsValues[*lhsPositions] * y;
+      }
+    }
+
+    Index m_rows, m_cols;
+    Index m_lhsRows, m_lhsCols, m_lhsNnz;
+    Index m_rhsRows, m_rhsCols, m_rhsNnz;
+    IndexVector m_outer, m_inner;     // the pattern of the result
+    IndexVector m_rhsPositions;       // the nonzeros of the right hand side, in processing order
+    IndexVector m_lhsCounts;          // the number of multiply-adds by each of them
+    IndexVector m_lhsPositions;       // the left hand side nonzero and
+    IndexVector m_resPositions;       // the result nonzero of each multiply-add
+    bool m_isGram;
+    bool m_isInitialized;
+};
+
+} // end namespace Eigen
+
+#endif // EIGEN_SPARSE_PRODUCT_PLAN_H
@@ -0,0 +1,72 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "main.h"
+#include <unsupported/Eigen/BatchedMatrix>
+
+template<typename Scalar, int Rows, int Depth, int Cols> void batched_matrix()
+{
+  typedef BatchedMatrix<Scalar,Rows,Depth> LhsBatch;
+  typedef BatchedMatrix<Scalar,Depth,Cols> RhsBatch;
+  typedef BatchedMatrix<Scalar,Rows,Cols> ResBatch;
+  typedef BatchedMatrix<Scalar,Depth,1> VectorBatch;
+  typedef BatchedMatrix<Scalar,Rows,1> ResVectorBatch;
+
+  // include sizes which are not a multiple of the number of lanes
+  Index n = internal::random<Index>(0,100);
+  LhsBatch a(n);
+  RhsBatch b(n);
+  VectorBatch v(n);
+  VERIFY_IS_EQUAL(a.size(), n);
+  VERIFY_IS_EQUAL(a.groups(), (n+LhsBatch::Lanes-1)/LhsBatch::Lanes);
+  for(Index k=0; k<n; ++k)
+  {
+    a.matrix(k).setRandom();
+    b.matrix(k).setRandom();
+    v.matrix(k).setRandom();
+  }
+
+  ResBatch c;
+  batchedProduct(a, b, c);
+  VERIFY_IS_EQUAL(c.size(), n);
+  for(Index k=0; k<n; ++k)
+    VERIFY_IS_APPROX(c.matrix(k), a.matrix(k) * b.matrix(k));
+
+  ResVectorBatch r(n);
+  batchedProduct(a, v, r);
+  for(Index k=0; k<n; ++k)
+    VERIFY_IS_APPROX(r.matrix(k), a.matrix(k) * v.matrix(k));
+
+  BatchedMatrix<Scalar,Depth,Rows> at;
+  batchedTranspose(a, at);
+  for(Index k=0; k<n; ++k)
+    VERIFY_IS_EQUAL(at.matrix(k), a.matrix(k).transpose());
+
+  // writes through the map of a matrix do not affect its neighbours
+  if(n>=2)
+  {
+    Matrix<Scalar,Rows,Depth> a1 = a.matrix(1);
+    a.matrix(0).setZero();
+    VERIFY_IS_EQUAL(a.matrix(1), a1);
+    VERIFY(a.matrix(0).isZero());
+  }
+}
+
+void test_batched_matrix()
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(( batched_matrix<float,3,3,3>() ));
+    CALL_SUBTEST_1(( batched_matrix<float,4,2,5>() ));
+    CALL_SUBTEST_2(( batched_matrix<double,3,3,3>() ));
+    CALL_SUBTEST_2(( batched_matrix<double,6,6,6>() ));
+    CALL_SUBTEST_3(( batched_matrix<float,16,16,16>() ));
+    CALL_SUBTEST_4(( batched_matrix<std::complex<float>,3,4,2>() ));
+    CALL_SUBTEST_5(( batched_matrix<int,3,3,3>() ));
+  }
+}
@@ -0,0 +1,193 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "sparse_dense_common.h"
+#include <Eigen/SparseExtra>
+#include <Eigen/IterativeLinearSolvers>
+
+// fills the first block and about 20% of the others, a coefficient of the larger nonzero blocks being zero
+template<typename Scalar>
+Matrix<Scalar,Dynamic,Dynamic> random_block_matrix(const VectorXi& rowBlocks, const VectorXi& colBlocks)
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  DenseMatrix refMat = DenseMatrix::Zero(rowBlocks.sum(), colBlocks.sum());
+  for(Index bj=0, j=0; bj<colBlocks.size(); j+=colBlocks(bj++))
+    for(Index bi=0, i=0; bi<rowBlocks.size(); i+=rowBlocks(bi++))
+      if((bi==0 && bj==0) || internal::random<int>(0,4)==0)
+      {
+        refMat.block(i,j,rowBlocks(bi),colBlocks(bj)).setRandom();
+        if(rowBlocks(bi)*colBlocks(bj)>2)
+          refMat(i+internal::random<Index>(0,rowBlocks(bi)-1), j+internal::random<Index>(0,colBlocks(bj)-1)) = Scalar(0);
+      }
+  return refMat;
+}
+
+template<typename BlockSparseMatrixType, typename DenseMatrix>
+void check_block_products(const BlockSparseMatrixType& bmat, const DenseMatrix& refMat)
+{
+  typedef typename BlockSparseMatrixType::Scalar Scalar;
+
+  // round trip through the regular sparse matrices
+  SparseMatrix<Scalar> back(bmat);
+  VERIFY_IS_APPROX(DenseMatrix(back), refMat);
+  SparseMatrix<Scalar,RowMajor> backr(bmat);
+  VERIFY_IS_APPROX(DenseMatrix(backr), refMat);
+
+  check_sparse_dense_products(bmat, refMat);
+}
+
+template<typename BlockSparseMatrixType> void block_sparse(Index brows, Index bcols, Index blockSize)
+{
+  typedef typename BlockSparseMatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+
+  DenseMatrix refMat = random_block_matrix<Scalar>(VectorXi::Constant(brows,int(blockSize)), VectorXi::Constant(bcols,int(blockSize)));
+  SparseMatrix<Scalar> m = refMat.sparseView();
+
+  BlockSparseMatrixType bmat(m);
+  VERIFY_IS_EQUAL(bmat.blockSize(), blockSize);
+  VERIFY_IS_EQUAL(bmat.rows(), refMat.rows());
+  VERIFY_IS_EQUAL(bmat.cols(), refMat.cols());
+  VERIFY_IS_EQUAL(bmat.blockRows(), brows);
+  VERIFY_IS_EQUAL(bmat.blockCols(), bcols);
+  VERIFY_IS_EQUAL(bmat.nonZeros(), bmat.nonZerosBlocks()*blockSize*blockSize);
+  VERIFY(bmat.nonZeros() >= m.nonZeros());
+  for(Index k=0; k<10; ++k)
+  {
+    Index bi = internal::random<Index>(0,brows-1), bj = internal::random<Index>(0,bcols-1);
+    if(!refMat.block(bi*blockSize,bj*blockSize,blockSize,blockSize).isZero(0))
+      VERIFY_IS_EQUAL(DenseMatrix(bmat.coeff(bi,bj)), DenseMatrix(refMat.block(bi*blockSize,bj*blockSize,blockSize,blockSize)));
+  }
+  check_block_products(bmat, refMat);
+
+  // copies
+  BlockSparseMatrixType bcopy(bmat);
+  check_block_products(bcopy, refMat);
+  BlockSparseMatrixType bassign;
+  bassign = bmat;
+  VERIFY_IS_EQUAL(bassign.nonZerosBlocks(), bmat.nonZerosBlocks());
+  check_block_products(bassign, refMat);
+}
+
+template<typename Scalar, int Options> void block_sparse_layout(Index brows, Index bcols)
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef BlockSparseMatrix<Scalar,Dynamic,Options> BlockSparseMatrixType;
+
+  // blocks of variable sizes
+  VectorXi rowBlocks(brows), colBlocks(bcols);
+  for(Index k=0; k<brows; ++k) rowBlocks(k) = internal::random<int>(1,4);
+  for(Index k=0; k<bcols; ++k) colBlocks(k) = internal::random<int>(1,4);
+  DenseMatrix refMat = random_block_matrix<Scalar>(rowBlocks, colBlocks);
+  BlockSparseMatrixType bmat(brows, bcols);
+  bmat.setBlockLayout(rowBlocks, colBlocks);
+  bmat = SparseMatrix<Scalar>(refMat.sparseView());
+  VERIFY_IS_EQUAL(bmat.blockSize(), Index(Dynamic));
+  VERIFY_IS_EQUAL(bmat.rows(), refMat.rows());
+  check_block_products(bmat, refMat);
+
+  // blocks of the same size without a dedicated kernel
+  refMat = random_block_matrix<Scalar>(VectorXi::Constant(brows,7), VectorXi::Constant(bcols,7));
+  BlockSparseMatrixType bmat7(brows, bcols);
+  bmat7.setBlockSize(7);
+  bmat7 = SparseMatrix<Scalar>(refMat.sparseView());
+  check_block_products(bmat7, refMat);
+}
+
+void block_sparse_detection()
+{
+  typedef BlockSparseMatrix<double> BlockSparseMatrixType;
+  for(int b=1; b<=6; ++b)
+  {
+    MatrixXd refMat = random_block_matrix<double>(VectorXi::Constant(12,b), VectorXi::Constant(12,b));
+    SparseMatrix<double> m = refMat.sparseView();
+    VERIFY_IS_EQUAL(BlockSparseMatrixType::detectBlockSize(m), Index(b));
+  }
+  // a diagonal matrix is not worth splitting into blocks
+  SparseMatrix<double> id(12,12);
+  id.setIdentity();
+  VERIFY_IS_EQUAL(BlockSparseMatrixType::detectBlockSize(id), Index(1));
+}
+
+template<typename Scalar> void block_sparse_solvers(Index n)
+{
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef BlockSparseMatrix<Scalar,3,RowMajor> BlockSparseMatrixType;
+
+  // the Kronecker product of a 1D Laplacian with the coupling of 3 unknowns per node
+  DenseMatrix coupling = DenseMatrix::Random(3,3);
+  coupling = coupling * coupling.transpose() + DenseMatrix::Identity(3,3);
+  SparseMatrix<Scalar> a(3*n, 3*n);
+  a.reserve(VectorXi::Constant(3*n, 9));
+  for(Index k=0; k<n; ++k)
+    for(Index j=0; j<3; ++j)
+      for(Index i=0; i<3; ++i)
+      {
+        a.insert(3*k+i,3*k+j) = Scalar(2.5) * coupling(i,j);
+        if(k>0)   a.insert(3*(k-1)+i,3*k+j) = -coupling(i,j);
+        if(k+1<n) a.insert(3*(k+1)+i,3*k+j) = -coupling(i,j);
+      }
+  a.makeCompressed();
+  BlockSparseMatrixType bmat(a);
+  DenseVector b = DenseVector::Random(3*n);
+
+  ConjugateGradient<BlockSparseMatrixType, Lower|Upper, BlockDiagonalPreconditioner<Scalar,3> > cg(bmat);
+  DenseVector x = cg.solve(b);
+  VERIFY(cg.info()==Success);
+  VERIFY_IS_APPROX(a*x, b);
+
+  // the block size is detected from the regular sparse matrix
+  ConjugateGradient<SparseMatrix<Scalar>, Lower|Upper, BlockDiagonalPreconditioner<Scalar> > cg2(a);
+  VERIFY_IS_EQUAL(cg2.preconditioner().blockSize(), 3);
+  x = cg2.solve(b);
+  VERIFY(cg2.info()==Success);
+  VERIFY_IS_APPROX(a*x, b);
+
+  // the diagonal blocks are inverted exactly
+  BlockDiagonalPreconditioner<Scalar> precond;
+  precond.setBlockSize(3);
+  precond.compute(bmat);
+  DenseVector y = precond.solve(b);
+  for(Index k=0; k<n; ++k)
+    VERIFY_IS_APPROX(DenseMatrix(bmat.coeff(k,k)) * y.segment(3*k,3), b.segment(3*k,3));
+
+  // an unsymmetric matrix, the block size not dividing the size of the matrix
+  for(Index k=0; k+4<3*n; k+=3)
+    a.coeffRef(k,k+4) += Scalar(0.5);
+  bmat = a;
+  BiCGSTAB<BlockSparseMatrixType, BlockDiagonalPreconditioner<Scalar> > bicg;
+  bicg.preconditioner().setBlockSize(2);
+  bicg.compute(bmat);
+  x = bicg.solve(b);
+  VERIFY(bicg.info()==Success);
+  VERIFY_IS_APPROX(a*x, b);
+}
+
+void test_block_sparse()
+{
+  for(int i = 0; i < g_repeat; i++) {
+    Index br = internal::random<Index>(1,60); TEST_SET_BUT_UNUSED_VARIABLE(br)
+    Index bc = internal::random<Index>(1,60); TEST_SET_BUT_UNUSED_VARIABLE(bc)
+    CALL_SUBTEST_1(( block_sparse<BlockSparseMatrix<double,3> >(br, bc, 3) ));
+    CALL_SUBTEST_1(( block_sparse<BlockSparseMatrix<double,3,RowMajor> >(br, bc, 3) ));
+    CALL_SUBTEST_2(( block_sparse<BlockSparseMatrix<float,6> >(br, bc, 6) ));
+    CALL_SUBTEST_2(( block_sparse<BlockSparseMatrix<float,6,RowMajor> >(br, bc, 6) ));
+    CALL_SUBTEST_3(( block_sparse<BlockSparseMatrix<std::complex<double>,2,RowMajor> >(br, bc, 2) ));
+    CALL_SUBTEST_3(( block_sparse<BlockSparseMatrix<std::complex<double>,4> >(br, bc, 4) ));
+    // the block size is detected and dispatched at runtime
+    CALL_SUBTEST_4(( block_sparse<BlockSparseMatrix<double> >(br, bc, 3) ));
+    CALL_SUBTEST_4(( block_sparse<BlockSparseMatrix<double,Dynamic,RowMajor,long> >(br, bc, 6) ));
+    CALL_SUBTEST_4(( block_sparse_layout<double,ColMajor>(br, bc) ));
+    CALL_SUBTEST_4(( block_sparse_layout<double,RowMajor>(br, bc) ));
+    CALL_SUBTEST_4(( block_sparse_detection() ));
+    CALL_SUBTEST_5(( block_sparse_solvers<double>(internal::random<int>(20,200)) ));
+    CALL_SUBTEST_5(( block_sparse_solvers<float>(internal::random<int>(20,200)) ));
+  }
+}
@@ -0,0 +1,129 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "sparse_dense_common.h"
+#include <Eigen/SparseExtra>
+#include <Eigen/IterativeLinearSolvers>
+
+template<typename SellMatrixType> void sliced_ellpack(Index rows, Index cols)
+{
+  typedef typename SellMatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+  const Index C = SellMatrixType::SliceHeight;
+
+  // a few long rows among short and empty ones
+  DenseMatrix refMat = DenseMatrix::Zero(rows, cols);
+  SparseMatrix<Scalar> m(rows, cols);
+  initSparse<Scalar>(0.05, refMat, m);
+  for(Index k=0; k<rows/10; ++k)
+  {
+    Index i = internal::random<Index>(0,rows-1);
+    refMat.row(i) = DenseMatrix::Random(1,cols);
+  }
+  if(rows>0)
+    refMat.row(internal::random<Index>(0,rows-1)).setZero();
+  m = refMat.sparseView();
+
+  Index windows[] = { 1, C, internal::random<Index>(1,4*C), rows+1 };
+  for(int w=0; w<4; ++w)
+  {
+    SellMatrixType sell(m, windows[w]);
+    VERIFY_IS_EQUAL(sell.rows(), rows);
+    VERIFY_IS_EQUAL(sell.cols(), cols);
+    VERIFY_IS_EQUAL(sell.nonZeros(), m.nonZeros());
+    VERIFY(sell.storedSize() >= sell.nonZeros());
+    VERIFY_IS_EQUAL(sell.sliceCount(), (rows+C-1)/C);
+
+    // the rows are read back in their original order
+    SparseMatrix<Scalar> back(sell);
+    VERIFY_IS_EQUAL(back.nonZeros(), m.nonZeros());
+    VERIFY_IS_APPROX(DenseMatrix(back), refMat);
+    for(Index k=0; k<10 && rows*cols>0; ++k)
+    {
+      Index i = internal::random<Index>(0,rows-1), j = internal::random<Index>(0,cols-1);
+      VERIFY_IS_EQUAL(sell.coeff(i,j), refMat(i,j));
+    }
+
+    check_sparse_dense_products(sell, refMat);
+
+    // the padding does not propagate infinite coefficients to the rows which do not reference them
+    DenseVector vinf = DenseVector::Random(cols);
+    vinf(0) = std::numeric_limits<typename NumTraits<Scalar>::Real>::infinity();
+    DenseVector r = sell * vinf;
+    for(Index i=0; i<rows; ++i)
+      if(refMat(i,0)==Scalar(0))
+        VERIFY((numext::isfinite)(r(i)));
+
+    // the transposed products go through the generic sparse path
+    DenseVector w0 = DenseVector::Random(rows), u(cols);
+    u.noalias() = sell.transpose() * w0;
+    VERIFY_IS_APPROX(u, refMat.transpose() * w0);
+  }
+
+  SellMatrixType empty;
+  VERIFY_IS_EQUAL(empty.rows(), 0);
+  VERIFY_IS_EQUAL(empty.nonZeros(), 0);
+}
+
+template<typename Scalar> void sliced_ellpack_solvers(Index n)
+{
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+  typedef SlicedEllpackMatrix<Scalar> SellMatrixType;
+
+  // 2D Laplacian
+  SparseMatrix<Scalar> a(n*n, n*n);
+  a.reserve(VectorXi::Constant(n*n, 5));
+  for(Index j=0; j<n; ++j)
+    for(Index i=0; i<n; ++i)
+    {
+      Index k = i+j*n;
+      a.insert(k,k) = Scalar(4.5);
+      if(i>0)   a.insert(k-1,k) = Scalar(-1);
+      if(i+1<n) a.insert(k+1,k) = Scalar(-1);
+      if(j>0)   a.insert(k-n,k) = Scalar(-1);
+      if(j+1<n) a.insert(k+n,k) = Scalar(-1);
+    }
+  SellMatrixType sell(a);
+  DenseVector b = DenseVector::Random(n*n);
+
+  ConjugateGradient<SellMatrixType, Lower|Upper> cg;
+  VERIFY_IS_EQUAL(cg.rows(), 0);
+  VERIFY_IS_EQUAL(cg.cols(), 0);
+  cg.compute(sell);
+  VERIFY_IS_EQUAL(cg.rows(), n*n);
+  DenseVector x = cg.solve(b);
+  VERIFY(cg.info()==Success);
+  VERIFY_IS_APPROX(a*x, b);
+
+  // an unsymmetric matrix
+  for(Index k=0; k<n*n; k+=3)
+    a.coeffRef(k,(k+n+1)%(n*n)) += Scalar(0.5);
+  sell = a;
+  BiCGSTAB<SellMatrixType> bicg(sell);
+  x = bicg.solve(b);
+  VERIFY(bicg.info()==Success);
+  VERIFY_IS_APPROX(a*x, b);
+}
+
+void test_sliced_ellpack()
+{
+  for(int i = 0; i < g_repeat; i++) {
+    int r = internal::random<int>(1,300); TEST_SET_BUT_UNUSED_VARIABLE(r)
+    int c = internal::random<int>(1,300); TEST_SET_BUT_UNUSED_VARIABLE(c)
+    CALL_SUBTEST_1(( sliced_ellpack<SlicedEllpackMatrix<double> >(r, c) ));
+    CALL_SUBTEST_2(( sliced_ellpack<SlicedEllpackMatrix<float,16> >(r, c) ));
+    CALL_SUBTEST_3(( sliced_ellpack<SlicedEllpackMatrix<std::complex<double>,4> >(r, c) ));
+    // the slices are processed by the scalar kernel
+    CALL_SUBTEST_4(( sliced_ellpack<SlicedEllpackMatrix<double,3,long> >(r, c) ));
+    CALL_SUBTEST_4(( sliced_ellpack<SlicedEllpackMatrix<double> >(0, c) ));
+    CALL_SUBTEST_5(( sliced_ellpack_solvers<double>(internal::random<int>(10,40)) ));
+    CALL_SUBTEST_5(( sliced_ellpack_solvers<float>(internal::random<int>(10,40)) ));
+  }
+}
@@ -0,0 +1,52 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_TEST_SPARSE_DENSE_COMMON_H
+#define EIGEN_TEST_SPARSE_DENSE_COMMON_H
+
+#include "sparse.h"
+
+// Checks the products of the sparse matrix \a mat, of any storage format providing its own products with dense
+// matrices, by dense vectors and matrices against those of its dense copy \a refMat.
+template<typename SparseType, typename DenseMatrix>
+void check_sparse_dense_products(const SparseType& mat, const DenseMatrix& refMat)
+{
+  typedef typename SparseType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> RowMajorDenseMatrix;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+  const Index rows = refMat.rows(), cols = refMat.cols();
+
+  DenseVector v = DenseVector::Random(cols), w0 = DenseVector::Random(rows);
+  DenseMatrix b = DenseMatrix::Random(cols, 5);
+  RowMajorDenseMatrix br = b;
+  Scalar alpha = internal::random<Scalar>();
+
+  DenseVector r(rows);
+  r.noalias() = mat * v;
+  VERIFY_IS_APPROX(r, refMat * v);
+  r = w0;
+  r.noalias() += alpha * mat * v;
+  VERIFY_IS_APPROX(r, w0 + alpha * refMat * v);
+  r = w0;
+  r.noalias() -= mat * v;
+  VERIFY_IS_APPROX(r, w0 - refMat * v);
+
+  DenseMatrix res(rows, 5);
+  res.noalias() = mat * b;
+  VERIFY_IS_APPROX(res, refMat * b);
+  res.noalias() = mat * br;
+  VERIFY_IS_APPROX(res, refMat * b);
+  res.col(2).noalias() = mat * b.col(3);
+  VERIFY_IS_APPROX(res.col(2), refMat * b.col(3));
+  RowMajorDenseMatrix resr(rows, 5);
+  resr.noalias() = mat * b;
+  VERIFY_IS_APPROX(DenseMatrix(resr), refMat * b);
+}
+
+#endif // EIGEN_TEST_SPARSE_DENSE_COMMON_H
@@ -0,0 +1,131 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "sparse.h"
+#include <Eigen/SparseExtra>
+
+// new values, same pattern
+template<typename SparseMatrixType> void set_random_values(SparseMatrixType& m)
+{
+  typedef Matrix<typename SparseMatrixType::Scalar,Dynamic,1> DenseVector;
+  for(Index j=0; j<m.outerSize(); ++j)
+  {
+    Index nnz = m.isCompressed() ? m.outerIndexPtr()[j+1]-m.outerIndexPtr()[j] : m.innerNonZeroPtr()[j];
+    Map<DenseVector>(m.valuePtr()+m.outerIndexPtr()[j], nnz).setRandom();
+  }
+}
+
+template<typename SparseMatrixType> void sparse_product_plan(Index rows, Index depth, Index cols)
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+
+  SparseMatrixType a(rows, depth), b(depth, cols);
+  DenseMatrix refA = DenseMatrix::Zero(rows, depth), refB = DenseMatrix::Zero(depth, cols);
+  initSparse<Scalar>(0.1, refA, a);
+  initSparse<Scalar>(0.1, refB, b);
+
+  SparseProductPlan<SparseMatrixType> plan;
+  plan.analyzeProduct(a, b);
+  VERIFY_IS_EQUAL(plan.rows(), rows);
+  VERIFY_IS_EQUAL(plan.cols(), cols);
+
+  SparseMatrixType c;
+  plan.evalProduct(a, b, c);
+  VERIFY(is_sorted_compressed(c));
+  VERIFY_IS_EQUAL(c.rows(), rows);
+  VERIFY_IS_EQUAL(c.cols(), cols);
+  VERIFY_IS_EQUAL(c.nonZeros(), plan.nonZeros());
+  VERIFY_IS_APPROX(DenseMatrix(c), refA * refB);
+  SparseMatrixType ref = a * b;
+  VERIFY_IS_EQUAL(c.nonZeros(), ref.nonZeros());
+
+  // the next evaluations only overwrite the values of the result
+  const Scalar* values = c.valuePtr();
+  const typename SparseMatrixType::StorageIndex* indices = c.innerIndexPtr();
+  for(int step=0; step<3; ++step)
+  {
+    set_random_values(a);
+    set_random_values(b);
+    plan.evalProduct(a, b, c);
+    VERIFY(c.valuePtr()==values);
+    VERIFY(c.innerIndexPtr()==indices);
+    VERIFY_IS_APPROX(DenseMatrix(c), DenseMatrix(a) * DenseMatrix(b));
+  }
+
+  // a result whose pattern has been modified is reset
+  c.resize(rows, cols);
+  c.insert(rows-1, cols-1) = Scalar(1);
+  plan.evalProduct(a, b, c);
+  VERIFY(is_sorted_compressed(c));
+  VERIFY_IS_APPROX(DenseMatrix(c), DenseMatrix(a) * DenseMatrix(b));
+
+  // even if only its inner indices differ
+  bool modified = false;
+  for(Index j=0; j<c.outerSize() && !modified; ++j)
+  {
+    Index last = c.outerIndexPtr()[j+1]-1;
+    if(last>=c.outerIndexPtr()[j] && c.innerIndexPtr()[last]+1<c.innerSize())
+    {
+      ++c.innerIndexPtr()[last];
+      modified = true;
+    }
+  }
+  plan.evalProduct(a, b, c);
+  VERIFY(is_sorted_compressed(c));
+  VERIFY_IS_APPROX(DenseMatrix(c), DenseMatrix(a) * DenseMatrix(b));
+
+  // uncompressed factors
+  SparseMatrixType au = a, bu = b;
+  au.reserve(VectorXi::Constant(au.outerSize(), 2));
+  bu.reserve(VectorXi::Constant(bu.outerSize(), 3));
+  plan.analyzeProduct(au, bu);
+  set_random_values(au);
+  plan.evalProduct(au, bu, c);
+  VERIFY_IS_APPROX(DenseMatrix(c), DenseMatrix(au) * DenseMatrix(bu));
+
+  // Gram products
+  plan.analyzeGramProduct(a);
+  VERIFY_IS_EQUAL(plan.rows(), depth);
+  VERIFY_IS_EQUAL(plan.cols(), depth);
+  SparseMatrixType g;
+  plan.evalGramProduct(a, g);
+  VERIFY(is_sorted_compressed(g));
+  VERIFY_IS_APPROX(DenseMatrix(g), DenseMatrix(a).transpose() * DenseMatrix(a));
+  ref = a.transpose() * a;
+  VERIFY_IS_EQUAL(g.nonZeros(), ref.nonZeros());
+  values = g.valuePtr();
+  set_random_values(a);
+  plan.evalGramProduct(a, g);
+  VERIFY(g.valuePtr()==values);
+  VERIFY_IS_APPROX(DenseMatrix(g), DenseMatrix(a).transpose() * DenseMatrix(a));
+  plan.analyzeGramProduct(au);
+  plan.evalGramProduct(au, g);
+  VERIFY_IS_APPROX(DenseMatrix(g), DenseMatrix(au).transpose() * DenseMatrix(au));
+
+  // empty products
+  SparseMatrixType e(rows, depth);
+  plan.analyzeProduct(e, b);
+  VERIFY_IS_EQUAL(plan.nonZeros(), 0);
+  VERIFY_IS_EQUAL(plan.flops(), 0);
+  plan.evalProduct(e, b, c);
+  VERIFY_IS_EQUAL(c.nonZeros(), 0);
+  VERIFY_IS_EQUAL(c.rows(), rows);
+}
+
+void test_sparse_product_plan()
+{
+  for(int i = 0; i < g_repeat; i++) {
+    Index r = internal::random<Index>(1,200), d = internal::random<Index>(1,200), c = internal::random<Index>(1,200);
+    CALL_SUBTEST_1(( sparse_product_plan<SparseMatrix<double> >(r, d, c) ));
+    CALL_SUBTEST_2(( sparse_product_plan<SparseMatrix<double,RowMajor> >(r, d, c) ));
+    CALL_SUBTEST_3(( sparse_product_plan<SparseMatrix<std::complex<double> > >(r, d, c) ));
+    CALL_SUBTEST_4(( sparse_product_plan<SparseMatrix<float,RowMajor,long> >(r, d, c) ));
+  }
+}